@@ -14,6 +14,14 @@ ifeq ($(ROCINANTE_TLBREFILL_UART_BREADCRUMBS),1)
 	CXXFLAGS += -DROCINANTE_TLBREFILL_UART_BREADCRUMBS
 endif
 
+ifeq ($(ROCINANTE_PMM_COMPACT_METADATA),1)
+	CXXFLAGS += -DROCINANTE_PMM_COMPACT_METADATA
+endif
+
+ifeq ($(ROCINANTE_HEAP_DEBUG_HISTOGRAM),1)
+	CXXFLAGS += -DROCINANTE_HEAP_DEBUG_HISTOGRAM
+endif
+
 ifeq ($(ROCINANTE_TESTS),1)
 	CXXFLAGS += -DROCINANTE_TESTS
 	ALL_OBJS += $(TEST_OBJS)
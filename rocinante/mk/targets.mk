@@ -7,17 +7,31 @@ compdb:
 	@rm -f $(PROJECT_ROOT_DIRECTORY)/../compile_commands.json
 	@bear --output $(PROJECT_ROOT_DIRECTORY)/../compile_commands.json -- $(MAKE) clean all
 
+# Optional two-node NUMA topology: CPUs 0-1 and the first 128 MiB on node 0,
+# CPUs 2-3 and the second 128 MiB on node 1. QEMU then reports "numa-node-id"
+# on the /memory and /cpus nodes of the DTB.
+#
+# Usage: make run-serial ROCINANTE_QEMU_NUMA=1 (or make test ROCINANTE_QEMU_NUMA=1)
+QEMU_NUMA_ARGS :=
+ifeq ($(ROCINANTE_QEMU_NUMA),1)
+	QEMU_NUMA_ARGS := \
+		-object memory-backend-ram,id=ram-node0,size=128M \
+		-object memory-backend-ram,id=ram-node1,size=128M \
+		-numa node,memdev=ram-node0,cpus=0-1,nodeid=0 \
+		-numa node,memdev=ram-node1,cpus=2-3,nodeid=1
+endif
+
 run: $(TARGET)
-	qemu-system-loongarch64 -machine virt -cpu la464 -m 256M -smp 4 \
+	qemu-system-loongarch64 -machine virt -cpu la464 -m 256M -smp 4 $(QEMU_NUMA_ARGS) \
 		-monitor none -kernel $<
 
 run-serial: $(TARGET)
-	qemu-system-loongarch64 -machine virt -cpu la464 -m 256M -smp 4 \
+	qemu-system-loongarch64 -machine virt -cpu la464 -m 256M -smp 4 $(QEMU_NUMA_ARGS) \
 		-nographic -serial stdio -monitor none \
 		-kernel $<
 
 test:
-	@$(MAKE) -C $(PROJECT_ROOT_DIRECTORY) ROCINANTE_TESTS=1 MAKEFLAGS= clean all run-serial
+	@$(MAKE) -C $(PROJECT_ROOT_DIRECTORY) ROCINANTE_TESTS=1 ROCINANTE_QEMU_NUMA=$(ROCINANTE_QEMU_NUMA) ROCINANTE_PMM_COMPACT_METADATA=$(ROCINANTE_PMM_COMPACT_METADATA) ROCINANTE_HEAP_DEBUG_HISTOGRAM=$(ROCINANTE_HEAP_DEBUG_HISTOGRAM) MAKEFLAGS= clean all run-serial
 
 # Audit for absolute-address pointer tables.
 #
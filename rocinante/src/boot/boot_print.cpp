@@ -38,8 +38,24 @@ void PrintBootMemoryMap(const Rocinante::Uart16550& uart, const Rocinante::Memor
 		uart.write_dec_u64(r.physical_base);
 		uart.puts(" size_bytes=");
 		uart.write_dec_u64(r.size_bytes);
+		uart.puts(" node=");
+		uart.write_dec_u64(r.numa_node_id);
 		uart.putc('\n');
 	}
+
+	if (map.cpu_numa_affinity_count != 0) {
+		uart.puts("  CPU NUMA affinities: ");
+		uart.write_dec_u64(map.cpu_numa_affinity_count);
+		uart.putc('\n');
+		for (std::size_t i = 0; i < map.cpu_numa_affinity_count; i++) {
+			const auto& a = map.cpu_numa_affinities[i];
+			uart.puts("  - core=");
+			uart.write_dec_u64(a.core_id);
+			uart.puts(" node=");
+			uart.write_dec_u64(a.numa_node_id);
+			uart.putc('\n');
+		}
+	}
 }
 
 void PrintPhysicalMemoryManagerSummary(const Rocinante::Uart16550& uart, const Rocinante::Memory::PhysicalMemoryManager& pmm) {
@@ -56,6 +72,35 @@ void PrintPhysicalMemoryManagerSummary(const Rocinante::Uart16550& uart, const R
 	uart.puts("  Free pages:  ");
 	uart.write_dec_u64(pmm.FreePages());
 	uart.putc('\n');
+	if (pmm.DeferredFrameMetadataSectionCount() != 0) {
+		uart.puts("  Deferred metadata sections: ");
+		uart.write_dec_u64(pmm.DeferredFrameMetadataSectionCount());
+		uart.puts(" (free pages: ");
+		uart.write_dec_u64(pmm.DeferredFreePages());
+		uart.puts(")\n");
+	}
+	const auto init_stats = pmm.GetInitializationStatistics();
+	uart.puts("  Init ticks: placement=");
+	uart.write_dec_u64(init_stats.storage_placement_ticks);
+	uart.puts(" marking=");
+	uart.write_dec_u64(init_stats.range_marking_ticks);
+	uart.puts(" metadata=");
+	uart.write_dec_u64(init_stats.eager_metadata_ticks);
+	uart.puts(" (eager sections: ");
+	uart.write_dec_u64(init_stats.eager_sections);
+	uart.puts(")\n");
+	uart.puts("  NUMA nodes:  ");
+	uart.write_dec_u64(pmm.NumaNodeCount());
+	uart.putc('\n');
+	if (pmm.NumaNodeCount() > 1) {
+		for (std::size_t node = 0; node < pmm.NumaNodeCount(); node++) {
+			uart.puts("  - node ");
+			uart.write_dec_u64(node);
+			uart.puts(" free pages: ");
+			uart.write_dec_u64(pmm.FreePagesOnNode(node));
+			uart.putc('\n');
+		}
+	}
 }
 
 } // namespace Rocinante::Boot
@@ -10,6 +10,8 @@
 #include <src/boot/efi_system_table.h>
 #include <src/kernel/paging_bringup.h>
 #include <src/memory/memory.h>
+#include <src/memory/page_frame_cache.h>
+#include <src/memory/page_table_pool.h>
 #include <src/memory/pmm.h>
 #include <src/platform/console.h>
 #include <src/platform/power.h>
@@ -18,6 +20,7 @@
 #include <src/testing/test.h>
 #include <src/trap/trap.h>
 
+#include <cstddef>
 #include <cstdint>
 
 namespace {
@@ -82,6 +85,28 @@ void PrintCpuArchitecture(const Rocinante::Uart16550& uart, Rocinante::CPUCFG::A
 	uart.putc('\n');
 }
 
+// Pre-zeroed frames zeroed per idle-loop pass. 16 frames = 64 KiB of stores,
+// which bounds how long a wakeup interrupt can wait behind the zeroing.
+constexpr std::size_t kIdleZeroedPoolRefillBatchFrames = 16;
+
+// Boot CPU idle loop.
+//
+// There is no scheduler yet, so "idle" means "the boot CPU has nothing left to
+// do". Each pass either initializes one deferred PMM metadata section, tops
+// up this CPU's page-table page reserve, or tops up the pre-zeroed pool by one
+// batch; once all are done (or RAM is exhausted) the CPU waits for an
+// interrupt.
+[[noreturn]] void IdleLoop() {
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+	auto& page_table_pool = Rocinante::Memory::GetPageTablePagePool();
+	for (;;) {
+		if (pmm.IsInitialized() && pmm.InitializeDeferredFrameMetadata(1) != 0) continue;
+		if (page_table_pool.IsInitialized() && page_table_pool.TopUpCurrentCpu() != 0) continue;
+		if (pmm.IsInitialized() && pmm.RefillZeroedPool(kIdleZeroedPoolRefillBatchFrames) != 0) continue;
+		asm volatile("idle 0" ::: "memory");
+	}
+}
+
 [[noreturn]] void KernelMain_PostMemoryInitialization() {
 	auto& uart = Rocinante::Platform::GetEarlyUart();
 	auto& cpucfg = Rocinante::GetCPUCFG();
@@ -112,7 +137,7 @@ void PrintCpuArchitecture(const Rocinante::Uart16550& uart, Rocinante::CPUCFG::A
 
 	uart.putc('\n');
 
-	Rocinante::Platform::Halt();
+	IdleLoop();
 }
 
 } // namespace
@@ -219,6 +244,7 @@ extern "C" [[noreturn]] void kernel_main(std::uint64_t is_uefi_compliant_bootenv
 				device_tree_size_bytes
 			)) {
 				Rocinante::Boot::PrintPhysicalMemoryManagerSummary(uart, pmm);
+				Rocinante::Memory::GetPageFrameCache().Initialize(&pmm);
 
 				// Paging is now the default boot path.
 				//
@@ -8,13 +8,16 @@
 #include <src/memory/memory.h>
 #include <src/memory/heap.h>
 #include <src/memory/address_space.h>
+#include <src/memory/asid_allocator.h>
 #include <src/memory/kernel_pager.h>
 #include <src/memory/kernel_mappings.h>
 #include <src/memory/kernel_va_allocator.h>
+#include <src/memory/page_table_pool.h>
 #include <src/memory/paging.h>
 #include <src/memory/paging_hw.h>
 #include <src/memory/paging_state.h>
 #include <src/memory/pmm.h>
+#include <src/memory/slab.h>
 #include <src/memory/virtual_layout.h>
 #include <src/platform/console.h>
 #include <src/platform/power.h>
@@ -38,8 +41,19 @@ extern "C" void __exception_entry();
 // These values are populated while building the bootstrap page tables (paging
 // still off), then consumed after paging is enabled and we have switched to a
 // higher-half stack.
+//
+// The heap VA window is only reserved here; the heap maps it on demand once
+// paging is on (see Heap::InitGrowable()).
 std::uintptr_t g_paging_bringup_heap_virtual_base = 0;
-std::size_t g_paging_bringup_heap_size_bytes = 0;
+std::size_t g_paging_bringup_heap_window_size_bytes = 0;
+
+// Kernel heap window policy (bring-up).
+//
+// - The window is plain VA: reserving it costs no frames.
+// - The initial mapping matches the old fixed heap; everything past it is
+//   mapped in Heap::kGrowthChunkBytes steps as allocations need it.
+constexpr std::size_t kHeapWindowSizeBytes = 256u * 1024u * 1024u;
+constexpr std::size_t kHeapInitialSizeBytes = 64u * 1024u;
 
 // Bring-up lazy-mapped range serviced by the kernel pager.
 //
@@ -123,19 +137,28 @@ std::uintptr_t g_post_paging_continuation_low = 0;
 		uart.puts("Paging bring-up: skipping EENTRY relocation (no address_bits)\n");
 	}
 
+	// The page-table page pool is bound once the physmap is live: from here
+	// on, every kernel walk builds tables from it.
+	Rocinante::Memory::GetPageTablePagePool().Initialize(&Rocinante::Memory::GetPhysicalMemoryManager());
+
 	// Heap handoff: re-initialize the allocator to use the VM-backed heap region
 	// we mapped during paging bring-up.
-	if (g_paging_bringup_heap_virtual_base != 0 && g_paging_bringup_heap_size_bytes != 0) {
+	if (g_paging_bringup_heap_virtual_base != 0 && g_paging_bringup_heap_window_size_bytes != 0) {
 		uart.puts("Paging bring-up: initializing heap after paging; heap_base=");
 		uart.write_dec_u64(g_paging_bringup_heap_virtual_base);
-		uart.puts(" heap_size_bytes=");
-		uart.write_dec_u64(g_paging_bringup_heap_size_bytes);
+		uart.puts(" window_size_bytes=");
+		uart.write_dec_u64(g_paging_bringup_heap_window_size_bytes);
+		uart.puts(" initial_size_bytes=");
+		uart.write_dec_u64(kHeapInitialSizeBytes);
 		uart.putc('\n');
 
-		Rocinante::Memory::InitHeapAfterPaging(
-			reinterpret_cast<void*>(g_paging_bringup_heap_virtual_base),
-			g_paging_bringup_heap_size_bytes
-		);
+		if (!Rocinante::Memory::InitGrowableHeapAfterPaging(
+			g_paging_bringup_heap_virtual_base,
+			g_paging_bringup_heap_window_size_bytes,
+			kHeapInitialSizeBytes
+		)) {
+			uart.puts("Paging bring-up: failed to map initial heap chunk\n");
+		}
 
 		uart.puts("Paging bring-up: heap stats after init: total_bytes=");
 		uart.write_dec_u64(Rocinante::Memory::Heap::TotalBytes());
@@ -143,6 +166,10 @@ std::uintptr_t g_post_paging_continuation_low = 0;
 		uart.write_dec_u64(Rocinante::Memory::Heap::FreeBytes());
 		uart.putc('\n');
 
+		// Small requests go to PMM-backed size-class slabs from here on; the
+		// physmap is live, so slab pages need no mapping of their own.
+		Rocinante::Memory::GetSlabAllocator().Initialize(&Rocinante::Memory::GetPhysicalMemoryManager());
+
 		void* p = Rocinante::Memory::Heap::Alloc(64, 16);
 		uart.puts("Paging bring-up: heap alloc(64,16) returned ");
 		uart.write_hex_u64(reinterpret_cast<std::uint64_t>(p));
@@ -365,13 +392,19 @@ std::uintptr_t g_post_paging_continuation_low = 0;
 			uart.puts("Paging bring-up: WARNING: no higher-half syscon MMIO alias; keeping low-half syscon base\n");
 		}
 
-		static constexpr std::uint16_t kBringupLowHalfAsid = 1;
-		const auto low_as_or = Rocinante::Memory::AddressSpace::Create(&pmm, paging_state->address_bits, kBringupLowHalfAsid);
+		// From here on, address spaces get their ASIDs from the allocator.
+		auto& asid_allocator = Rocinante::Memory::GetAsidAllocator();
+		asid_allocator.Initialize(Rocinante::Memory::PagingHw::GetAddressSpaceIdBits());
+		uart.puts("Paging bring-up: ASID allocator; asid_count=");
+		uart.write_dec_u64(asid_allocator.AsidCount());
+		uart.putc('\n');
+
+		const auto low_as_or = Rocinante::Memory::AddressSpace::Create(&pmm, paging_state->address_bits);
 		if (!low_as_or.has_value()) {
 			uart.puts("Paging bring-up: failed to allocate low-half address space root\n");
 			Rocinante::Platform::Halt();
 		}
-		const auto low_as = low_as_or.value();
+		auto low_as = low_as_or.value();
 
 		// If higher-half MMIO aliases were not created, we must keep low-half MMIO
 		// mappings alive (bring-up fallback).
@@ -411,13 +444,16 @@ std::uintptr_t g_post_paging_continuation_low = 0;
 			}
 		}
 
-		uart.puts("Paging bring-up: switching ASID+PGDL; asid=");
-		uart.write_dec_u64(low_as.AddressSpaceId());
-		uart.puts(" pgdl_root_pt_phys=");
+		uart.puts("Paging bring-up: switching ASID+PGDL; pgdl_root_pt_phys=");
 		uart.write_dec_u64(low_as.LowHalfRoot().root_physical_address);
 		uart.putc('\n');
-		Rocinante::Memory::PagingHw::ActivateLowHalfAddressSpace(low_as.LowHalfRoot(), low_as.AddressSpaceId());
-		uart.puts("Paging bring-up: minimal low-half address space active\n");
+		if (!low_as.Activate()) {
+			uart.puts("Paging bring-up: failed to activate low-half address space\n");
+			Rocinante::Platform::Halt();
+		}
+		uart.puts("Paging bring-up: minimal low-half address space active; asid=");
+		uart.write_dec_u64(low_as.AddressSpaceId());
+		uart.putc('\n');
 	}
 	#endif
 
@@ -599,10 +635,12 @@ void RunPagingBringup(
 	Rocinante::Memory::InitializePagingState(Rocinante::Memory::PagingState{
 		.root = root,
 		.address_bits = address_bits,
+		.walkers = Rocinante::Memory::Paging::SelectWalkers(address_bits),
 	});
 
 	// Identity-map the kernel image so enabling paging does not immediately
-	// fault while executing in the low physical mapping.
+	// fault while executing in the low physical mapping. MapRange() uses huge
+	// leaves for any whole 2 MiB blocks of the image (it is linked at 2 MiB).
 	const std::uintptr_t kernel_size_bytes = kernel_physical_end - kernel_physical_base;
 	const auto map_size_rounded =
 		static_cast<std::size_t>((kernel_size_bytes + Rocinante::Memory::Paging::kPageSizeBytes - 1) &
@@ -615,7 +653,7 @@ void RunPagingBringup(
 		.global = true,
 	};
 
-	if (!Rocinante::Memory::Paging::MapRange4KiB(
+	if (!Rocinante::Memory::Paging::MapRange(
 		pmm,
 		root,
 		kernel_physical_base,
@@ -640,7 +678,7 @@ void RunPagingBringup(
 	std::uintptr_t higher_half_stack_top = 0;
 	Rocinante::Memory::KernelVirtualAddressAllocator kernel_va;
 
-	if (!Rocinante::Memory::Paging::MapRange4KiB(
+	if (!Rocinante::Memory::Paging::MapRange(
 		pmm,
 		root,
 		kernel_higher_half_base,
@@ -846,50 +884,35 @@ void RunPagingBringup(
 		}
 	}
 
-	// Allocate and map a small VM-backed heap region.
+	// Reserve the VA window for the VM-backed heap.
 	//
 	// Plan alignment:
 	// - This is the handoff from the bootstrap .bss heap to a region backed
 	//   by real PMM frames and page-table mappings.
 	// - We keep the bootstrap heap alive; this is bring-up, not a teardown.
+	// - Nothing is mapped yet: the heap maps its first chunk after paging is
+	//   enabled and grows through the rest of the window on demand.
 	//
 	// Placement policy (bring-up only):
-	// Place heap pages immediately above the higher-half stack region.
+	// Place the heap window immediately above the higher-half stack region.
 	// This avoids overlapping the stack guard+stack pages we just mapped.
 	{
-		static constexpr std::size_t kHeapPageCount = 16;
-		static constexpr std::size_t kHeapSizeBytes = kHeapPageCount * Rocinante::Memory::Paging::kPageSizeBytes;
-
 		if (higher_half_stack_top == 0) {
-			uart.puts("Paging bring-up: higher-half stack not mapped; skipping heap mapping\n");
+			uart.puts("Paging bring-up: higher-half stack not mapped; skipping heap window reservation\n");
 		} else {
-			Rocinante::Memory::Paging::PagePermissions heap_permissions{
-				.access = Rocinante::Memory::Paging::AccessPermissions::ReadWrite,
-				.execute = Rocinante::Memory::Paging::ExecutePermissions::NoExecute,
-				.cache = Rocinante::Memory::Paging::CacheMode::CoherentCached,
-				.global = true,
-			};
-
-			const auto heap_or = Rocinante::Memory::KernelMappings::MapNewRange4KiB(
-				pmm,
-				root,
-				&kernel_va,
-				kHeapSizeBytes,
-				heap_permissions,
-				address_bits
+			const auto heap_window_or = kernel_va.Allocate(
+				kHeapWindowSizeBytes,
+				Rocinante::Memory::Paging::kPageSizeBytes
 			);
-			if (!heap_or.has_value()) {
-				uart.puts("Paging bring-up: failed to map heap range\n");
+			if (!heap_window_or.has_value()) {
+				uart.puts("Paging bring-up: failed to reserve heap VA window\n");
 			} else {
-				const std::uintptr_t heap_virtual_base = heap_or.value().virtual_base;
-				g_paging_bringup_heap_virtual_base = heap_virtual_base;
-				g_paging_bringup_heap_size_bytes = heap_or.value().size_bytes;
-				uart.puts("Paging bring-up: higher-half heap mapped; virt_base=");
-				uart.write_dec_u64(heap_virtual_base);
+				g_paging_bringup_heap_virtual_base = heap_window_or.value();
+				g_paging_bringup_heap_window_size_bytes = kHeapWindowSizeBytes;
+				uart.puts("Paging bring-up: higher-half heap window reserved (mapped on demand); virt_base=");
+				uart.write_dec_u64(g_paging_bringup_heap_virtual_base);
 				uart.puts(" size_bytes=");
-				uart.write_dec_u64(heap_or.value().size_bytes);
-				uart.puts(" pages=");
-				uart.write_dec_u64(kHeapPageCount);
+				uart.write_dec_u64(kHeapWindowSizeBytes);
 				uart.putc('\n');
 			}
 		}
@@ -931,7 +954,7 @@ void RunPagingBringup(
 	}
 
 	// Bootstrap physmap: map the previously computed physmap window into the
-	// higher half.
+	// higher half, with huge leaves wherever alignment allows.
 	if (physmap_size_bytes != 0) {
 		const std::uintptr_t physmap_virtual_base =
 			Rocinante::Memory::VirtualLayout::ToPhysMapVirtual(
@@ -946,7 +969,7 @@ void RunPagingBringup(
 			.global = true,
 		};
 
-		if (!Rocinante::Memory::Paging::MapRange4KiB(
+		if (!Rocinante::Memory::Paging::MapRange(
 			pmm,
 			root,
 			physmap_virtual_base,
@@ -1034,19 +1057,19 @@ void RunPagingBringup(
 			uart.puts("Paging bring-up: e3=");
 			uart.write_dec_u64(e3);
 			uart.putc('\n');
-			if (IsWalkable(e3)) {
+			if (IsWalkable(e3) && (e3 & Rocinante::Memory::Paging::PteBits::kHuge) == 0) {
 				auto* dir2 = reinterpret_cast<Rocinante::Memory::Paging::PageTablePage*>(EntryBase4K(e3));
 				const std::uint64_t e2 = dir2 ? dir2->entries[idx_dir2] : 0;
 				uart.puts("Paging bring-up: e2=");
 				uart.write_dec_u64(e2);
 				uart.putc('\n');
-				if (dir2 && IsWalkable(e2)) {
+				if (dir2 && IsWalkable(e2) && (e2 & Rocinante::Memory::Paging::PteBits::kHuge) == 0) {
 					auto* dirl = reinterpret_cast<Rocinante::Memory::Paging::PageTablePage*>(EntryBase4K(e2));
 					const std::uint64_t e1 = dirl ? dirl->entries[idx_dirl] : 0;
 					uart.puts("Paging bring-up: e1=");
 					uart.write_dec_u64(e1);
 					uart.putc('\n');
-					if (dirl && IsWalkable(e1)) {
+					if (dirl && IsWalkable(e1) && (e1 & Rocinante::Memory::Paging::PteBits::kHuge) == 0) {
 						auto* pt = reinterpret_cast<Rocinante::Memory::Paging::PageTablePage*>(EntryBase4K(e1));
 						const std::uint64_t ep = pt ? pt->entries[idx_pt] : 0;
 						uart.puts("Paging bring-up: ep=");
@@ -1119,11 +1142,15 @@ void RunPagingBringup(
 
 			const std::uint64_t e2 = dir2->entries[idx_dir2];
 			if (!EntryIsWalkable(e2)) return Rocinante::nullopt;
+			// Huge-page leaves (physmap, kernel image) end the walk early; their
+			// cache and NX fields sit where a PTE's do.
+			if ((e2 & Rocinante::Memory::Paging::PteBits::kHuge) != 0) return Rocinante::Optional<std::uint64_t>(e2);
 			auto* dirl = reinterpret_cast<Rocinante::Memory::Paging::PageTablePage*>(EntryBase4K(e2));
 			if (!dirl) return Rocinante::nullopt;
 
 			const std::uint64_t e1 = dirl->entries[idx_dirl];
 			if (!EntryIsWalkable(e1)) return Rocinante::nullopt;
+			if ((e1 & Rocinante::Memory::Paging::PteBits::kHuge) != 0) return Rocinante::Optional<std::uint64_t>(e1);
 			auto* pt = reinterpret_cast<Rocinante::Memory::Paging::PageTablePage*>(EntryBase4K(e1));
 			if (!pt) return Rocinante::nullopt;
 
@@ -1322,6 +1349,17 @@ void RunPagingBringup(
 	uart.puts(enable_ptw ? "on" : "off");
 	uart.puts(")\n");
 
+	// Prefer the LDDIR/LDPTE refill entry; Trap::Initialize() installed the
+	// software walk, which stays in place if the CPU lacks the instructions.
+	const std::uint8_t directory_levels = Rocinante::Memory::PagingHw::DirectoryLevelCount(config_or.value());
+	if (Rocinante::Trap::InstallLddirTlbRefillHandler(directory_levels)) {
+		uart.puts("Paging bring-up: TLB refill via LDDIR/LDPTE; directory_levels=");
+		uart.write_dec_u64(directory_levels);
+		uart.putc('\n');
+	} else {
+		uart.puts("Paging bring-up: TLB refill via software walk\n");
+	}
+
 	uart.puts("Paging bring-up: invalidating TLB (INVTLB op=0x2 + op=0x3)\n");
 	Rocinante::Memory::PagingHw::InvalidateGlobalTlbEntries();
 	Rocinante::Memory::PagingHw::InvalidateNonGlobalTlbEntries();
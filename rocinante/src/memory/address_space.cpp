@@ -5,6 +5,7 @@
 
 #include "address_space.h"
 
+#include <src/memory/page_table_pool.h>
 #include <src/memory/paging_hw.h>
 #include <src/memory/pmm.h>
 
@@ -12,13 +13,29 @@ namespace Rocinante::Memory {
 
 Rocinante::Optional<AddressSpace> AddressSpace::Create(
 	PhysicalMemoryManager* physical_memory_manager,
-	Paging::AddressSpaceBits address_bits,
-	std::uint16_t address_space_id
+	Paging::AddressSpaceBits address_bits
 ) {
 	if (!physical_memory_manager) return Rocinante::nullopt;
 	const auto root_or = Paging::AllocateRootPageTable(physical_memory_manager);
 	if (!root_or.has_value()) return Rocinante::nullopt;
-	return AddressSpace(root_or.value(), address_bits, address_space_id);
+	return AddressSpace(root_or.value(), address_bits);
+}
+
+bool AddressSpace::Activate() {
+	auto& allocator = GetAsidAllocator();
+	if (!allocator.IsInitialized()) return false;
+	if (low_half_root_.root_physical_address == 0) return false;
+
+	const AsidAllocator::Activation activation = allocator.Activate(&asid_assignment_);
+
+	// Spec anchor (LoongArch-Vol1-EN.html):
+	// - Section 4.2.4.7 (INVTLB), Table 13: op=0x3 clears all G=0 entries.
+	//
+	// After a rollover, ASID values from the previous generation may be
+	// cached for address spaces that no longer own them.
+	if (activation.flush_non_global) PagingHw::InvalidateNonGlobalTlbEntries();
+	PagingHw::ActivateLowHalfAddressSpace(low_half_root_, activation.asid);
+	return true;
 }
 
 bool AddressSpace::MapPage4KiB(
@@ -70,15 +87,23 @@ bool AddressSpace::DestroyPageTables(PhysicalMemoryManager* physical_memory_mana
 	//
 	// Bring-up policy:
 	// - Destroying an address space implies its translations must not be used.
-	// - Invalidate all non-global entries for this address space's ASID.
+	// - Invalidate all non-global entries for this address space's ASID (an
+	//   address space that was never activated has none), so the allocator
+	//   can hand the ASID out again.
 	// - Invalidate global entries only if this address space contained any global mappings.
 	//
 	// Explicit flaws:
 	// - Invalidating all global entries is still coarse; the kernel currently
 	//   uses G=1 for some mappings (including in tests), so we cannot avoid it
 	//   here without changing mapping policy.
-	Rocinante::Memory::PagingHw::InvalidateNonGlobalTlbEntriesForAsid(address_space_id_);
+	if (asid_assignment_.asid != AsidAllocator::kReservedAsid) {
+		Rocinante::Memory::PagingHw::InvalidateNonGlobalTlbEntriesForAsid(asid_assignment_.asid);
+	}
+	GetAsidAllocator().Release(&asid_assignment_);
 
+	// The freed tables belong to this batch only: the flushes here cover this
+	// address space, not whatever other unmaps left on the deferred list.
+	PageTablePagePool::DeferredBatch table_batch(Rocinante::Memory::GetPageTablePagePool());
 	bool had_global_leaf_mappings = false;
 	if (!Paging::FreeAllPageTables4KiB(physical_memory_manager, low_half_root_, address_bits_, &had_global_leaf_mappings)) {
 		return false;
@@ -87,6 +112,9 @@ bool AddressSpace::DestroyPageTables(PhysicalMemoryManager* physical_memory_mana
 		Rocinante::Memory::PagingHw::InvalidateGlobalTlbEntries();
 	}
 
+	// No TLB entry can reach the freed tables any more; let the pool reuse them.
+	(void)table_batch.Reclaim();
+
 	// Poison the root to make accidental reuse fail loudly.
 	low_half_root_.root_physical_address = 0;
 	return true;
@@ -10,6 +10,7 @@
 
 #include <src/helpers/optional.h>
 
+#include <src/memory/asid_allocator.h>
 #include <src/memory/paging.h>
 
 namespace Rocinante::Memory {
@@ -21,6 +22,8 @@ class PhysicalMemoryManager;
  *
  * Scope (bring-up):
  * - Own a low-half page-table root and an ASID (address-space identifier).
+ *   The ASID comes from the global AsidAllocator on first activation and is
+ *   kept across switches until a generation rollover takes it away.
  * - Provide mapping helpers for 4 KiB pages/ranges using existing Paging APIs.
  *
  * Non-goals (explicit for now):
@@ -33,12 +36,24 @@ class AddressSpace final {
 public:
 	static Rocinante::Optional<AddressSpace> Create(
 		PhysicalMemoryManager* physical_memory_manager,
-		Paging::AddressSpaceBits address_bits,
-		std::uint16_t address_space_id);
+		Paging::AddressSpaceBits address_bits);
 
 	const Paging::PageTableRoot& LowHalfRoot() const { return low_half_root_; }
 	Paging::AddressSpaceBits AddressBits() const { return address_bits_; }
-	std::uint16_t AddressSpaceId() const { return address_space_id_; }
+
+	// The ASID from the last activation; 0 before the first one.
+	std::uint16_t AddressSpaceId() const { return asid_assignment_.asid; }
+
+	/**
+	 * @brief Makes this the current CPU's low-half address space.
+	 *
+	 * Gets (or revalidates) the ASID from GetAsidAllocator(), flushes all
+	 * non-global TLB entries only if the allocator asks for it (generation
+	 * rollover), then programs CSR.ASID and CSR.PGDL.
+	 *
+	 * Returns false if the allocator is not initialized.
+	 */
+	bool Activate();
 
 	bool MapPage4KiB(
 		PhysicalMemoryManager* physical_memory_manager,
@@ -64,6 +79,7 @@ public:
 	 *
 	 * Safety requirements:
 	 * - The address space must be inactive; no CPU may continue to use its ASID/root.
+	 * - The ASID goes back to the allocator.
 	 * - This invalidates:
 	 *   - non-global (G=0) entries for this address space's ASID, and
 	 *   - global (G=1) entries system-wide.
@@ -74,13 +90,13 @@ public:
 	bool DestroyPageTables(PhysicalMemoryManager* physical_memory_manager);
 
 private:
-	AddressSpace(Paging::PageTableRoot low_half_root, Paging::AddressSpaceBits address_bits, std::uint16_t address_space_id)
-		: low_half_root_(low_half_root), address_bits_(address_bits), address_space_id_(address_space_id) {
+	AddressSpace(Paging::PageTableRoot low_half_root, Paging::AddressSpaceBits address_bits)
+		: low_half_root_(low_half_root), address_bits_(address_bits) {
 	}
 
 	Paging::PageTableRoot low_half_root_{};
 	Paging::AddressSpaceBits address_bits_{};
-	std::uint16_t address_space_id_ = 0;
+	AsidAllocator::Assignment asid_assignment_{};
 };
 
 } // namespace Rocinante::Memory
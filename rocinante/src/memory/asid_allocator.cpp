@@ -0,0 +1,177 @@
+/**
+ * Copyright (C) 2026 Andrew S. Rightenburg
+ * GPL-3.0-or-later
+ */
+
+#include "asid_allocator.h"
+
+#include <src/sp/cpuid.h>
+
+namespace Rocinante::Memory {
+
+namespace {
+
+constexpr std::uint64_t AllCpusMask(std::size_t cpu_count) {
+	return cpu_count >= 64 ? ~0ull : ((1ull << cpu_count) - 1);
+}
+
+} // namespace
+
+AsidAllocator& GetAsidAllocator() {
+	static AsidAllocator instance;
+	return instance;
+}
+
+void AsidAllocator::Initialize(std::uint8_t asid_bits) {
+	if (asid_bits > kMaxAsidBits) asid_bits = kMaxAsidBits;
+
+	Rocinante::SpinlockGuard guard(&m_lock);
+	m_asid_count = std::size_t{1} << asid_bits;
+	m_generation = 1;
+	for (std::size_t word = 0; word < kBitmapWords; word++) {
+		m_used[word] = 0;
+	}
+	_set(kReservedAsid);
+	m_next_search = 1;
+	m_flush_pending_cpus = AllCpusMask(kMaxCpuCount);
+	for (std::size_t core_id = 0; core_id < kMaxCpuCount; core_id++) {
+		m_active[core_id] = Assignment{};
+		m_reserved[core_id] = Assignment{};
+	}
+	m_statistics = Statistics{};
+}
+
+void AsidAllocator::_set(std::uint16_t asid) {
+	m_used[asid / 64] |= (1ull << (asid % 64));
+}
+
+void AsidAllocator::_clear(std::uint16_t asid) {
+	m_used[asid / 64] &= ~(1ull << (asid % 64));
+}
+
+// An address space that was running on some CPU at the last rollover keeps
+// its ASID: rollover already marked it used in the new generation.
+bool AsidAllocator::_claim_reserved(const Assignment& stale) {
+	bool claimed = false;
+	for (std::size_t core_id = 0; core_id < kMaxCpuCount; core_id++) {
+		Assignment& reserved = m_reserved[core_id];
+		if (reserved.generation != stale.generation || reserved.asid != stale.asid) continue;
+		reserved.generation = m_generation;
+		claimed = true;
+	}
+	return claimed;
+}
+
+bool AsidAllocator::_find_free(std::uint16_t* out_asid) {
+	// Round-robin from the last hand-out, so a released ASID is not reused
+	// (and its TLB entries evicted) before the others.
+	for (std::size_t i = 0; i < m_asid_count; i++) {
+		std::size_t asid = m_next_search + i;
+		if (asid >= m_asid_count) asid -= m_asid_count;
+		if (m_used[asid / 64] == ~0ull) {
+			// Skip to the next word (the loop's i++ adds the final step).
+			i += 63 - (asid % 64);
+			continue;
+		}
+		if ((m_used[asid / 64] & (1ull << (asid % 64))) != 0) continue;
+
+		*out_asid = static_cast<std::uint16_t>(asid);
+		m_next_search = (asid + 1 < m_asid_count) ? asid + 1 : 1;
+		return true;
+	}
+	return false;
+}
+
+void AsidAllocator::_rollover() {
+	m_generation++;
+	m_statistics.rollovers++;
+	for (std::size_t word = 0; word < kBitmapWords; word++) {
+		m_used[word] = 0;
+	}
+	_set(kReservedAsid);
+	m_next_search = 1;
+
+	// Keep every CPU's running ASID out of the new generation's free pool.
+	// A CPU that has not switched since an earlier rollover still runs the
+	// ASID it had reserved then.
+	for (std::size_t core_id = 0; core_id < kMaxCpuCount; core_id++) {
+		const Assignment running = m_active[core_id].generation != 0 ? m_active[core_id] : m_reserved[core_id];
+		m_active[core_id] = Assignment{};
+		m_reserved[core_id] = running;
+		if (running.generation != 0 && running.asid != kReservedAsid) _set(running.asid);
+	}
+	m_flush_pending_cpus = AllCpusMask(kMaxCpuCount);
+}
+
+AsidAllocator::Activation AsidAllocator::Activate(Assignment* assignment) {
+	if (!assignment || m_asid_count == 0) return Activation{.asid = kReservedAsid, .flush_non_global = true};
+	const std::size_t core_id = Rocinante::ReadCurrentProcessorCoreId();
+
+	Rocinante::SpinlockGuard guard(&m_lock);
+	if (assignment->generation != m_generation) {
+		if (assignment->generation != 0 && _claim_reserved(*assignment)) {
+			*assignment = Assignment{.generation = m_generation, .asid = assignment->asid};
+		} else {
+			std::uint16_t asid = kReservedAsid;
+			bool found = _find_free(&asid);
+			if (!found) {
+				_rollover();
+				found = _find_free(&asid);
+			}
+			if (found) {
+				_set(asid);
+				m_statistics.assignments++;
+				*assignment = Assignment{.generation = m_generation, .asid = asid};
+			} else {
+				*assignment = Assignment{};
+			}
+		}
+	}
+
+	Activation activation{.asid = assignment->asid, .flush_non_global = false};
+	if (core_id < kMaxCpuCount) {
+		const std::uint64_t cpu_bit = 1ull << core_id;
+		if ((m_flush_pending_cpus & cpu_bit) != 0) {
+			m_flush_pending_cpus &= ~cpu_bit;
+			activation.flush_non_global = true;
+		}
+		m_active[core_id] = *assignment;
+	} else {
+		// No pending-flush bit to track this CPU with.
+		activation.flush_non_global = true;
+	}
+
+	// Out of ASIDs altogether: ASID 0 is shared, so it is flushed every time.
+	if (assignment->generation == 0) activation.flush_non_global = true;
+	if (activation.flush_non_global) m_statistics.flushes++;
+	return activation;
+}
+
+void AsidAllocator::Release(Assignment* assignment) {
+	if (!assignment) return;
+	if (assignment->generation == 0) return;
+
+	Rocinante::SpinlockGuard guard(&m_lock);
+	bool holds_asid = assignment->generation == m_generation;
+	for (std::size_t core_id = 0; core_id < kMaxCpuCount; core_id++) {
+		Assignment& reserved = m_reserved[core_id];
+		if (reserved.generation == assignment->generation && reserved.asid == assignment->asid) {
+			// Reserved at rollover and never claimed: it still holds the ASID.
+			reserved = Assignment{};
+			holds_asid = true;
+		}
+		Assignment& active = m_active[core_id];
+		if (active.generation == assignment->generation && active.asid == assignment->asid) active = Assignment{};
+	}
+	if (holds_asid && assignment->asid != kReservedAsid) _clear(assignment->asid);
+	*assignment = Assignment{};
+}
+
+AsidAllocator::Statistics AsidAllocator::GetStatistics() const {
+	// Unlocked read: exact when the allocator is quiescent.
+	Statistics statistics = m_statistics;
+	statistics.generation = m_generation;
+	return statistics;
+}
+
+} // namespace Rocinante::Memory
@@ -0,0 +1,150 @@
+/**
+ * Copyright (C) 2026 Andrew S. Rightenburg
+ * GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <src/sp/per_cpu.h>
+#include <src/sp/spinlock.h>
+
+namespace Rocinante::Memory {
+
+/**
+ * @brief Global ASID allocator with generation rollover.
+ *
+ * An address space gets an ASID the first time it is activated and keeps it
+ * across later switches, so switching back to it hits whatever TLB entries
+ * it still has instead of flushing them.
+ *
+ * Generations:
+ * - Every assignment is tagged with the generation it was made in. An
+ *   assignment from an older generation is stale: its ASID value may have
+ *   been handed to another address space since.
+ * - When a generation runs out of ASIDs, the allocator starts a new one
+ *   (rollover). Non-global TLB entries may then belong to either generation,
+ *   so each CPU does one full non-global flush (INVTLB op=0x3) before its
+ *   next activation. This is the only time activation flushes.
+ * - The ASID each CPU is running at rollover stays reserved in the new
+ *   generation: the address space keeps it, and nothing else gets it.
+ *
+ * ASID 0 is never handed out. It is what the kernel runs with before the
+ * first activation, so nothing allocated ever matches stale bring-up entries.
+ *
+ * Current limitations (intentional for early bring-up):
+ * - Activate() takes the allocator lock on every switch; a lock-free fast
+ *   path on the generation check can come with SMP scheduling.
+ * - With too few ASIDs to leave one free after reserving every CPU's active
+ *   ASID, Activate() falls back to ASID 0 and a flush on every switch.
+ */
+class AsidAllocator final {
+	public:
+		// CSR.ASID.ASID is 10 bits wide (LoongArch-Vol1-EN.html, Section 7.5.4).
+		static constexpr std::uint8_t kMaxAsidBits = 10;
+		static constexpr std::uint16_t kReservedAsid = 0;
+
+		/**
+		 * @brief An address space's claim on an ASID.
+		 *
+		 * generation == 0 means "never assigned" (generations start at 1).
+		 */
+		struct Assignment final {
+			std::uint64_t generation = 0;
+			std::uint16_t asid = kReservedAsid;
+		};
+
+		/**
+		 * @brief What the caller must program before running the address space.
+		 *
+		 * - asid: the value for CSR.ASID.ASID.
+		 * - flush_non_global: invalidate all G=0 TLB entries first.
+		 */
+		struct Activation final {
+			std::uint16_t asid = kReservedAsid;
+			bool flush_non_global = false;
+		};
+
+		/**
+		 * @brief Allocator-wide counters.
+		 *
+		 * - assignments: ASIDs handed out (excluding reserved carry-overs).
+		 * - rollovers: generations started after the first.
+		 * - flushes: activations that had to flush all non-global entries.
+		 */
+		struct Statistics final {
+			std::uint64_t generation = 0;
+			std::uint64_t assignments = 0;
+			std::uint64_t rollovers = 0;
+			std::uint64_t flushes = 0;
+		};
+
+		AsidAllocator() = default;
+		~AsidAllocator() = default;
+		AsidAllocator(const AsidAllocator&) = delete;
+		AsidAllocator& operator=(const AsidAllocator&) = delete;
+		AsidAllocator(AsidAllocator&&) = delete;
+		AsidAllocator& operator=(AsidAllocator&&) = delete;
+
+		/**
+		 * @brief Sizes the allocator for 2^asid_bits ASIDs and starts generation 1.
+		 *
+		 * asid_bits comes from CSR.ASID.ASIDBITS and is clamped to
+		 * kMaxAsidBits. Every CPU's first activation afterwards flushes, since
+		 * the TLB may hold entries from before the allocator existed.
+		 * Assignments made before re-initializing must not be used again.
+		 */
+		void Initialize(std::uint8_t asid_bits);
+
+		bool IsInitialized() const { return m_asid_count != 0; }
+		std::size_t AsidCount() const { return m_asid_count; }
+
+		/**
+		 * @brief Gets the ASID to run `assignment`'s address space with on this CPU.
+		 *
+		 * Keeps the assignment if it belongs to the current generation;
+		 * otherwise gives it a new ASID (starting a new generation if none is
+		 * free) and updates it in place.
+		 */
+		Activation Activate(Assignment* assignment);
+
+		/**
+		 * @brief Returns an address space's ASID for reuse.
+		 *
+		 * The address space must be inactive on every CPU, and the caller must
+		 * already have invalidated the non-global entries tagged with
+		 * assignment->asid. Resets the assignment.
+		 */
+		void Release(Assignment* assignment);
+
+		Statistics GetStatistics() const;
+
+	private:
+		static constexpr std::size_t kBitmapWords = (std::size_t{1} << kMaxAsidBits) / 64;
+
+		std::size_t m_asid_count = 0;
+
+		Rocinante::Spinlock m_lock{};
+
+		// Guarded by m_lock.
+		std::uint64_t m_generation = 0;
+		std::uint64_t m_used[kBitmapWords] = {};
+		std::size_t m_next_search = 1;
+		std::uint64_t m_flush_pending_cpus = 0;
+		Assignment m_active[kMaxCpuCount] = {};
+		Assignment m_reserved[kMaxCpuCount] = {};
+		Statistics m_statistics{};
+
+		void _set(std::uint16_t asid);
+		void _clear(std::uint16_t asid);
+		bool _claim_reserved(const Assignment& stale);
+		bool _find_free(std::uint16_t* out_asid);
+		void _rollover();
+};
+
+// Returns the single canonical ASID allocator for the kernel.
+AsidAllocator& GetAsidAllocator();
+
+} // namespace Rocinante::Memory
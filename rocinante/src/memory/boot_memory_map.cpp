@@ -148,7 +148,8 @@ bool TryReadAddressSizePairs(
 	std::uint32_t address_cells,
 	std::uint32_t size_cells,
 	BootMemoryMap* out_map,
-	BootMemoryRegion::Type type
+	BootMemoryRegion::Type type,
+	std::uint32_t numa_node_id
 ) {
 	if (!reg_value || !out_map) return false;
 	if (address_cells == 0 || size_cells == 0) return false;
@@ -185,7 +186,7 @@ bool TryReadAddressSizePairs(
 		}
 
 		if (size == 0) continue;
-		if (!out_map->AddRegion(BootMemoryRegion{.physical_base = address, .size_bytes = size, .type = type})) {
+		if (!out_map->AddRegion(BootMemoryRegion{.physical_base = address, .size_bytes = size, .type = type, .numa_node_id = numa_node_id})) {
 			return false;
 		}
 	}
@@ -276,9 +277,9 @@ struct NodeContext final {
 	std::uint32_t size_cells;
 };
 
-// The structure parser above needs to know the current node name when it sees a
-// property. To keep the core parse loop readable, we do a second implementation
-// that tracks node names explicitly, and call that instead.
+// The structure parser needs to know which node a property belongs to. Node
+// names are classified once at BEGIN_NODE (memory, reserved-memory, cpus) and
+// the properties of interest are collected until the matching END_NODE.
 bool ParseStructureBlockWithNodeNames(const FdtView& view, BootMemoryMap* out_map) {
 	if (!out_map) return false;
 
@@ -288,16 +289,28 @@ bool ParseStructureBlockWithNodeNames(const FdtView& view, BootMemoryMap* out_ma
 	};
 
 	NodeContext ctx_stack[32]{};
-	const char* name_stack[32]{};
 	std::size_t depth = 0;
 
 	// Defaults per the devicetree specification when not provided.
 	ctx_stack[0] = NodeContext{.address_cells = 2, .size_cells = 1};
-	name_stack[0] = "";
 
 	NodeContext reserved_memory_ctx = ctx_stack[0];
 	bool in_reserved_memory_node = false;
 
+	// /memory nodes: "numa-node-id" may come before or after "reg" (QEMU emits
+	// it after), so the ranges are only recorded when the node ends.
+	bool in_memory_node = false;
+	const std::uint8_t* memory_reg_value = nullptr;
+	std::uint32_t memory_reg_size_bytes = 0;
+	NodeContext memory_ctx = ctx_stack[0];
+	std::uint32_t memory_numa_node_id = 0;
+
+	// /cpus children: same deferral for ("reg", "numa-node-id").
+	bool in_cpus_node = false;
+	bool cpu_has_core_id = false;
+	bool cpu_has_numa_node_id = false;
+	BootCpuNumaAffinity cpu_affinity{};
+
 	for (;;) {
 		std::uint32_t token = 0;
 		if (!CursorReadBe32(&c, &token)) return false;
@@ -311,7 +324,6 @@ bool ParseStructureBlockWithNodeNames(const FdtView& view, BootMemoryMap* out_ma
 
 				// Inherit parent context.
 				ctx_stack[depth + 1] = ctx_stack[depth];
-				name_stack[depth + 1] = node_name;
 				depth++;
 
 				if (depth == 1) {
@@ -323,11 +335,47 @@ bool ParseStructureBlockWithNodeNames(const FdtView& view, BootMemoryMap* out_ma
 					reserved_memory_ctx = ctx_stack[depth];
 				}
 
+				if (depth == 2 && (StartsWith(node_name, "memory@") || (node_name[0] == 'm' && StartsWith(node_name, "memory")))) {
+					in_memory_node = true;
+					memory_reg_value = nullptr;
+					memory_reg_size_bytes = 0;
+					memory_ctx = ctx_stack[depth];
+					memory_numa_node_id = 0;
+				}
+
+				if (depth == 2 && StartsWith(node_name, "cpus") && (node_name[4] == '\0' || node_name[4] == '@')) {
+					in_cpus_node = true;
+				}
+
+				if (depth == 3 && in_cpus_node) {
+					cpu_has_core_id = false;
+					cpu_has_numa_node_id = false;
+					cpu_affinity = BootCpuNumaAffinity{};
+				}
+
 				break;
 			}
 			case Fdt::kTokenEndNode: {
 				if (depth == 0) return false;
 				if (depth == 2 && in_reserved_memory_node) in_reserved_memory_node = false;
+
+				if (depth == 2 && in_memory_node) {
+					in_memory_node = false;
+					if (memory_reg_value) {
+						if (!TryReadAddressSizePairs(memory_reg_value, memory_reg_size_bytes, memory_ctx.address_cells, memory_ctx.size_cells, out_map, BootMemoryRegion::Type::UsableRAM, memory_numa_node_id)) {
+							return false;
+						}
+					}
+				}
+
+				if (depth == 2 && in_cpus_node) in_cpus_node = false;
+
+				if (depth == 3 && in_cpus_node && cpu_has_core_id && cpu_has_numa_node_id) {
+					// Bring-up policy: running out of affinity slots is not fatal;
+					// the remaining cores simply default to node 0.
+					(void)out_map->AddCpuNumaAffinity(cpu_affinity);
+				}
+
 				depth--;
 				break;
 			}
@@ -366,26 +414,42 @@ bool ParseStructureBlockWithNodeNames(const FdtView& view, BootMemoryMap* out_ma
 					if (TryReadU32Property(value, len_bytes, &v)) reserved_memory_ctx.size_cells = v;
 				}
 
-				// Usable RAM discovery: /memory node.
-				if (depth == 2 && StartsWith(prop_name, "reg")) {
-					const char* node_name = name_stack[depth];
-					const bool looks_like_memory_node =
-						(node_name && (StartsWith(node_name, "memory@") || (node_name[0] == 'm' && StartsWith(node_name, "memory"))));
-
-					if (looks_like_memory_node) {
-						if (!TryReadAddressSizePairs(value, len_bytes, ctx.address_cells, ctx.size_cells, out_map, BootMemoryRegion::Type::UsableRAM)) {
-							return false;
-						}
-					}
+				// Usable RAM discovery: /memory node (recorded at EndNode).
+				if (depth == 2 && in_memory_node && StartsWith(prop_name, "reg")) {
+					memory_reg_value = value;
+					memory_reg_size_bytes = len_bytes;
+					memory_ctx = ctx;
+				}
+				if (depth == 2 && in_memory_node && StartsWith(prop_name, "numa-node-id")) {
+					std::uint32_t v = 0;
+					if (TryReadU32Property(value, len_bytes, &v)) memory_numa_node_id = v;
 				}
 
 				// Reserved memory discovery: /reserved-memory children reg.
 				if (in_reserved_memory_node && depth >= 3 && StartsWith(prop_name, "reg")) {
-					if (!TryReadAddressSizePairs(value, len_bytes, reserved_memory_ctx.address_cells, reserved_memory_ctx.size_cells, out_map, BootMemoryRegion::Type::Reserved)) {
+					if (!TryReadAddressSizePairs(value, len_bytes, reserved_memory_ctx.address_cells, reserved_memory_ctx.size_cells, out_map, BootMemoryRegion::Type::Reserved, 0)) {
 						return false;
 					}
 				}
 
+				// Core-to-node affinity: /cpus/cpu@N "reg" and "numa-node-id".
+				//
+				// /cpus uses #address-cells = 1 (or 2 with a zero upper cell on
+				// some firmware); the core ID is the last cell either way.
+				if (depth == 3 && in_cpus_node && StartsWith(prop_name, "reg")) {
+					if (len_bytes == 4 || len_bytes == 8) {
+						cpu_affinity.core_id = ReadBe32(value + (len_bytes - 4));
+						cpu_has_core_id = true;
+					}
+				}
+				if (depth == 3 && in_cpus_node && StartsWith(prop_name, "numa-node-id")) {
+					std::uint32_t v = 0;
+					if (TryReadU32Property(value, len_bytes, &v)) {
+						cpu_affinity.numa_node_id = v;
+						cpu_has_numa_node_id = true;
+					}
+				}
+
 				break;
 			}
 			case Fdt::kTokenNop: {
@@ -410,10 +474,12 @@ bool BootMemoryMap::AddRegion(BootMemoryRegion region) {
 	//
 	// Policy: only merge if:
 	// - types match
+	// - NUMA nodes match (zones must not straddle nodes)
 	// - ranges are exactly adjacent
 	for (std::size_t i = 0; i < region_count; i++) {
 		BootMemoryRegion& existing = regions[i];
 		if (existing.type != region.type) continue;
+		if (existing.numa_node_id != region.numa_node_id) continue;
 
 		if ((existing.physical_base + existing.size_bytes) < existing.physical_base) continue;
 		const std::uint64_t existing_end = existing.physical_base + existing.size_bytes;
@@ -435,6 +501,19 @@ bool BootMemoryMap::AddRegion(BootMemoryRegion region) {
 	return true;
 }
 
+bool BootMemoryMap::AddCpuNumaAffinity(BootCpuNumaAffinity affinity) {
+	for (std::size_t i = 0; i < cpu_numa_affinity_count; i++) {
+		if (cpu_numa_affinities[i].core_id == affinity.core_id) {
+			cpu_numa_affinities[i] = affinity;
+			return true;
+		}
+	}
+
+	if (cpu_numa_affinity_count >= kMaxCpuNumaAffinities) return false;
+	cpu_numa_affinities[cpu_numa_affinity_count++] = affinity;
+	return true;
+}
+
 bool BootMemoryMap::LooksLikeDeviceTreeBlob(const void* device_tree_blob) {
 	FdtView view{};
 	return TryMakeFdtView(device_tree_blob, &view);
@@ -455,7 +534,7 @@ bool BootMemoryMap::TryParseFromDeviceTree(const void* device_tree_blob) {
 	// 1) Parse reserved ranges from the memreserve table.
 	if (!ParseMemReserveTable(view, this)) return false;
 
-	// 2) Parse the structure block for /memory and /reserved-memory.
+	// 2) Parse the structure block for /memory, /reserved-memory and /cpus.
 	if (!ParseStructureBlockWithNodeNames(view, this)) return false;
 
 	return true;
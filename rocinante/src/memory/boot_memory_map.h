@@ -31,6 +31,22 @@ struct BootMemoryRegion final {
 	std::uint64_t physical_base = 0;
 	std::uint64_t size_bytes = 0;
 	Type type = Type::Reserved;
+
+	// NUMA node the range belongs to (DTB "numa-node-id" on the /memory node).
+	// Single-node systems, and Reserved ranges, report node 0.
+	std::uint32_t numa_node_id = 0;
+};
+
+/**
+ * @brief Core-to-NUMA-node affinity reported by the boot environment.
+ *
+ * Parsed from /cpus/cpu@N nodes: core_id is the node's "reg" value (which is
+ * what CSR.CPUID.CoreID reports on the running core) and numa_node_id is its
+ * "numa-node-id" property.
+ */
+struct BootCpuNumaAffinity final {
+	std::uint32_t core_id = 0;
+	std::uint32_t numa_node_id = 0;
 };
 
 /**
@@ -55,14 +71,27 @@ struct BootMemoryMap final {
 	BootMemoryRegion regions[kMaxRegions];
 	std::size_t region_count = 0;
 
+	static constexpr std::size_t kMaxCpuNumaAffinities = 64;
+
+	// Same convention as `regions`: only [0, cpu_numa_affinity_count) is valid.
+	BootCpuNumaAffinity cpu_numa_affinities[kMaxCpuNumaAffinities];
+	std::size_t cpu_numa_affinity_count = 0;
+
 	// Resets the map to empty.
 	void Clear() {
 		region_count = 0;
+		cpu_numa_affinity_count = 0;
 	}
 
 	// Adds a region. Returns false if capacity is exceeded or input is invalid.
+	//
+	// Adjacent regions are merged only if both their type and NUMA node match.
 	bool AddRegion(BootMemoryRegion region);
 
+	// Records a core's NUMA node. A later entry for the same core replaces the
+	// earlier one. Returns false if capacity is exceeded.
+	bool AddCpuNumaAffinity(BootCpuNumaAffinity affinity);
+
 	// Quick structural check for a device tree blob.
 	//
 	// This does not prove that the DTB is semantically correct; it is only meant
@@ -78,10 +107,12 @@ struct BootMemoryMap final {
 	// Parses a DTB/FDT memory map into this BootMemoryMap.
 	//
 	// Extracts:
-	// - Usable RAM from the /memory node's "reg" property.
+	// - Usable RAM from the /memory node's "reg" property, tagged with the
+	//   node's "numa-node-id" (0 if absent).
 	// - Reserved ranges from:
 	//   - the DTB "memreserve" table
 	//   - /reserved-memory children "reg" properties
+	// - Core-to-node affinities from /cpus children carrying "numa-node-id".
 	//
 	// Returns true on success.
 	//
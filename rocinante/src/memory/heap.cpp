@@ -5,6 +5,10 @@
 
 #include "heap.h"
 
+#include <src/memory/kernel_mappings.h>
+#include <src/memory/kernel_va_allocator.h>
+#include <src/memory/slab.h>
+
 #include <cstdint>
 
 namespace Rocinante::Memory::Heap {
@@ -23,11 +27,31 @@ namespace Rocinante::Memory::Heap {
 // That gives us room for a small flag bitfield.
 //
 // When a block is FREE, we store a doubly-linked list node at the beginning of
-// the payload area so we can maintain an explicit free list.
+// the payload area and file the block in a two-level segregated-fit (TLSF)
+// index:
+// - First level: the power of two the size falls in.
+// - Second level: that power-of-two range split into kSecondLevelCount equal
+//   steps (blocks below kSmallBlockSize share first level 0, in kHeapAlign
+//   steps).
+// - One bitmap bit per non-empty list at each level, so finding the smallest
+//   non-empty list that is large enough takes two find-first-set operations
+//   instead of a list walk.
+//
+// Allocation rounds the request up to the start of the next second-level
+// step, so the head of whichever list the bitmaps pick always fits (with one
+// extra look at the request's own list when nothing larger is free). Alloc()
+// and Free() are O(1), including over-aligned requests, which search for
+// enough slack to split off an aligned prefix instead of probing a block at
+// successive alignments.
 //
 // This is a classic "boundary tag" allocator:
 // - Coalescing with the next block is easy (look at next header).
 // - Coalescing with the previous block is easy (look at previous footer).
+//
+// A growable heap keeps the same layout: growing maps a chunk at g_heap_end
+// and frees it into the heap as one block (coalescing with a free tail), and
+// trimming shortens a free tail block before unmapping what it gave up. Both
+// keep g_heap_end a whole number of chunks past g_heap_begin.
 
 namespace {
 
@@ -62,9 +86,63 @@ constexpr std::size_t MinFreeBlockSize =
 
 std::uint8_t* g_heap_begin = nullptr;
 std::uint8_t* g_heap_end = nullptr;
-FreeNode* g_free_list_head = nullptr;
 bool g_initialized = false;
 
+constexpr std::size_t kHeapAlignLog2 = 4;
+constexpr std::size_t kSecondLevelLog2 = 4;
+constexpr std::size_t kSecondLevelCount = 1u << kSecondLevelLog2;
+constexpr std::size_t kFirstLevelShift = kSecondLevelLog2 + kHeapAlignLog2;
+constexpr std::size_t kSmallBlockSize = 1u << kFirstLevelShift;
+// Blocks (and so Init() regions and growth windows) stay below 2^38 bytes.
+constexpr std::size_t kMaxBlockSizeLog2 = 38;
+constexpr std::size_t kMaxBlockSize = (std::size_t{1} << kMaxBlockSizeLog2) - kHeapAlign;
+constexpr std::size_t kFirstLevelCount = kMaxBlockSizeLog2 - kFirstLevelShift + 1;
+
+static_assert((std::size_t{1} << kHeapAlignLog2) == kHeapAlign);
+static_assert(kFirstLevelCount <= 32, "first-level bitmap is 32 bits");
+static_assert(kSecondLevelCount <= 32, "second-level bitmaps are 32 bits");
+
+struct BinIndex final {
+	std::size_t first;
+	std::size_t second;
+};
+
+#if defined(ROCINANTE_HEAP_DEBUG_HISTOGRAM)
+static_assert(kFirstLevelCount == kFreeBlockHistogramBucketCount, "one histogram bucket per first-level class");
+static_assert(FreeBlockHistogramBucketMinBytes(1) == kSmallBlockSize);
+#endif
+
+std::uint32_t g_first_level_bitmap = 0;
+std::uint32_t g_second_level_bitmaps[kFirstLevelCount] = {};
+FreeNode* g_free_lists[kFirstLevelCount][kSecondLevelCount] = {};
+
+// Running counters behind GetStatistics(); byte and block counts follow
+// BinInsert()/BinRemove().
+struct Counters final {
+	std::size_t free_bytes = 0;
+	std::size_t free_block_count = 0;
+	std::uint64_t allocation_count = 0;
+	std::uint64_t free_count = 0;
+	std::uint64_t failed_allocation_count = 0;
+#if defined(ROCINANTE_HEAP_DEBUG_HISTOGRAM)
+	std::size_t free_blocks_by_first_level[kFirstLevelCount] = {};
+#endif
+};
+
+Counters g_counters;
+
+struct GrowthState final {
+	bool enabled = false;
+	GrowthConfig config{};
+	// Hands out the window front-to-back: everything below g_heap_end is
+	// allocated, so first-fit always returns g_heap_end.
+	KernelVirtualAddressAllocator window_va;
+	// The mapped region never shrinks below this.
+	std::uint8_t* minimum_end = nullptr;
+};
+
+GrowthState g_growth;
+
 constexpr std::uintptr_t AlignUp(std::uintptr_t value, std::size_t alignment) {
 	return (value + (alignment - 1)) & ~(static_cast<std::uintptr_t>(alignment) - 1);
 }
@@ -113,11 +191,46 @@ BlockHeader* HeaderFor(FreeNode* node) {
 	return reinterpret_cast<BlockHeader*>(reinterpret_cast<std::uint8_t*>(node) - HeaderSize);
 }
 
-void FreeListRemove(FreeNode* node) {
+std::size_t FloorLog2(std::size_t x) {
+	return (sizeof(std::size_t) * 8 - 1) - static_cast<std::size_t>(__builtin_clzl(x));
+}
+
+// The list a free block of `size_bytes` lives in.
+BinIndex BinForSize(std::size_t size_bytes) {
+	if (size_bytes < kSmallBlockSize) {
+		return BinIndex{.first = 0, .second = size_bytes >> kHeapAlignLog2};
+	}
+	const std::size_t log2 = FloorLog2(size_bytes);
+	return BinIndex{
+		.first = log2 - kFirstLevelShift + 1,
+		.second = (size_bytes >> (log2 - kSecondLevelLog2)) - kSecondLevelCount,
+	};
+}
+
+// Rounds a request up to the smallest size of the next second-level step, so
+// every block in BinForSize(result) or above is large enough.
+std::size_t RoundUpToBinSize(std::size_t size_bytes) {
+	if (size_bytes < kSmallBlockSize) return size_bytes;
+	const std::size_t step_mask = (std::size_t{1} << (FloorLog2(size_bytes) - kSecondLevelLog2)) - 1;
+	return (size_bytes + step_mask) & ~step_mask;
+}
+
+void BinRemove(BlockHeader* header) {
+	const BinIndex bin = BinForSize(BlockSize(header));
+	g_counters.free_bytes -= BlockSize(header);
+	g_counters.free_block_count--;
+#if defined(ROCINANTE_HEAP_DEBUG_HISTOGRAM)
+	g_counters.free_blocks_by_first_level[bin.first]--;
+#endif
+	FreeNode* node = NodeFor(header);
 	if (node->Prev) {
 		node->Prev->Next = node->Next;
 	} else {
-		g_free_list_head = node->Next;
+		g_free_lists[bin.first][bin.second] = node->Next;
+		if (!node->Next) {
+			g_second_level_bitmaps[bin.first] &= ~(1u << bin.second);
+			if (g_second_level_bitmaps[bin.first] == 0) g_first_level_bitmap &= ~(1u << bin.first);
+		}
 	}
 	if (node->Next) {
 		node->Next->Prev = node->Prev;
@@ -126,11 +239,315 @@ void FreeListRemove(FreeNode* node) {
 	node->Prev = nullptr;
 }
 
-void FreeListInsertFront(FreeNode* node) {
+void BinInsert(BlockHeader* header) {
+	const BinIndex bin = BinForSize(BlockSize(header));
+	g_counters.free_bytes += BlockSize(header);
+	g_counters.free_block_count++;
+#if defined(ROCINANTE_HEAP_DEBUG_HISTOGRAM)
+	g_counters.free_blocks_by_first_level[bin.first]++;
+#endif
+	FreeNode* node = NodeFor(header);
+	FreeNode*& head = g_free_lists[bin.first][bin.second];
 	node->Prev = nullptr;
-	node->Next = g_free_list_head;
-	if (g_free_list_head) g_free_list_head->Prev = node;
-	g_free_list_head = node;
+	node->Next = head;
+	if (head) head->Prev = node;
+	head = node;
+	g_second_level_bitmaps[bin.first] |= (1u << bin.second);
+	g_first_level_bitmap |= (1u << bin.first);
+}
+
+// Head of the smallest non-empty list whose blocks are all at least
+// `search_size` bytes (already rounded by RoundUpToBinSize()).
+BlockHeader* FindFreeBlockAtLeast(std::size_t search_size) {
+	BinIndex bin = BinForSize(search_size);
+	if (bin.first >= kFirstLevelCount) return nullptr;
+
+	std::uint32_t second_map = g_second_level_bitmaps[bin.first] & (~0u << bin.second);
+	if (second_map == 0) {
+		const std::uint32_t first_map = g_first_level_bitmap & (~0u << (bin.first + 1));
+		if (first_map == 0) return nullptr;
+		bin.first = static_cast<std::size_t>(__builtin_ctz(first_map));
+		second_map = g_second_level_bitmaps[bin.first];
+	}
+	bin.second = static_cast<std::size_t>(__builtin_ctz(second_map));
+	return HeaderFor(g_free_lists[bin.first][bin.second]);
+}
+
+// A free block of at least `required_size` bytes, or nullptr.
+//
+// If no list guarantees a fit, the head of required_size's own list is
+// checked too, so a request close to the largest free block (e.g. most of
+// a fresh heap) does not fail just because of the rounding.
+BlockHeader* FindFreeBlock(std::size_t required_size) {
+	if (BlockHeader* block = FindFreeBlockAtLeast(RoundUpToBinSize(required_size))) return block;
+
+	const BinIndex bin = BinForSize(required_size);
+	if (bin.first >= kFirstLevelCount) return nullptr;
+	FreeNode* head = g_free_lists[bin.first][bin.second];
+	if (head && BlockSize(HeaderFor(head)) >= required_size) return HeaderFor(head);
+	return nullptr;
+}
+
+// Empties the index and restarts every counter.
+void ResetBins() {
+	g_counters = Counters{};
+	g_first_level_bitmap = 0;
+	for (std::size_t first = 0; first < kFirstLevelCount; first++) {
+		g_second_level_bitmaps[first] = 0;
+		for (std::size_t second = 0; second < kSecondLevelCount; second++) {
+			g_free_lists[first][second] = nullptr;
+		}
+	}
+}
+
+// Block size (header + payload + footer) for a `size`-byte request. The
+// payload is rounded up to the base heap alignment, and every block must be
+// able to hold a FreeNode once it is freed.
+std::size_t BlockSizeForRequest(std::size_t size) {
+	const std::size_t payload_size = RoundUp(size, kHeapAlign);
+	const std::size_t block_size = RoundUp(HeaderSize + payload_size + FooterSize, kHeapAlign);
+	return (block_size < MinFreeBlockSize) ? MinFreeBlockSize : block_size;
+}
+
+// Free block size that always fits a block of `block_needed` bytes at
+// `alignment`.
+//
+// Over-aligned requests ask for enough extra that the aligned block fits
+// after a prefix that is either empty or a valid free block.
+std::size_t RequiredFreeBlockSize(std::size_t block_needed, std::size_t alignment) {
+	if (alignment <= kHeapAlign) return block_needed;
+	return block_needed + alignment + MinFreeBlockSize;
+}
+
+// Takes a block from the bins and splits it into
+// [optional prefix free][allocated][optional suffix free].
+void* AllocateFromBins(std::size_t required_size, std::size_t block_needed, std::size_t alignment) {
+	BlockHeader* free_block = FindFreeBlock(required_size);
+	if (!free_block) return nullptr;
+	BinRemove(free_block);
+
+	auto* block_begin = reinterpret_cast<std::uint8_t*>(free_block);
+	std::uint8_t* block_end = block_begin + BlockSize(free_block);
+
+	// We want:
+	//   payload = alloc_header + HeaderSize
+	// to be aligned.
+	auto payload_begin = reinterpret_cast<std::uintptr_t>(block_begin + HeaderSize);
+	std::uintptr_t payload_aligned = AlignUp(payload_begin, alignment);
+	auto* alloc_header_begin = reinterpret_cast<std::uint8_t*>(payload_aligned - HeaderSize);
+
+	// If the prefix is too small to be its own free block, move to the first
+	// aligned position past a minimum-size prefix. RequiredFreeBlockSize()
+	// reserved room for this, so one step is always enough.
+	if (alloc_header_begin > block_begin &&
+		static_cast<std::size_t>(alloc_header_begin - block_begin) < MinFreeBlockSize) {
+		payload_aligned = AlignUp(payload_begin + MinFreeBlockSize, alignment);
+		alloc_header_begin = reinterpret_cast<std::uint8_t*>(payload_aligned - HeaderSize);
+	}
+
+	const auto prefix = static_cast<std::size_t>(alloc_header_begin - block_begin);
+
+	// Prefix free block
+	if (prefix >= MinFreeBlockSize) {
+		auto* prefix_header = reinterpret_cast<BlockHeader*>(block_begin);
+		SetHeaderAndFooter(prefix_header, prefix, /*used=*/false);
+		BinInsert(prefix_header);
+	}
+
+	// Allocated block
+	auto* alloc_header = reinterpret_cast<BlockHeader*>(alloc_header_begin);
+	SetHeaderAndFooter(alloc_header, block_needed, /*used=*/true);
+
+	// Suffix free block
+	std::uint8_t* suffix_begin = alloc_header_begin + block_needed;
+	const auto suffix = static_cast<std::size_t>(block_end - suffix_begin);
+	if (suffix >= MinFreeBlockSize) {
+		auto* suffix_header = reinterpret_cast<BlockHeader*>(suffix_begin);
+		SetHeaderAndFooter(suffix_header, suffix, /*used=*/false);
+		BinInsert(suffix_header);
+	} else if (suffix != 0) {
+		// Not enough space to form a valid free block; just give it to the
+		// allocation (prevents creating an unusable fragment).
+		SetHeaderAndFooter(alloc_header, block_needed + suffix, /*used=*/true);
+	}
+
+	return reinterpret_cast<void*>(alloc_header_begin + HeaderSize);
+}
+
+// Marks a block free, merges it with free neighbours and files the result in
+// the bins. Returns the (possibly merged) block.
+BlockHeader* ReleaseBlock(BlockHeader* header) {
+	// Mark the block free.
+	SetHeaderAndFooter(header, BlockSize(header), /*used=*/false);
+
+	// Coalesce with next block if it exists and is free.
+	BlockHeader* next = NextBlock(header);
+	if (reinterpret_cast<std::uint8_t*>(next) < g_heap_end && !IsUsed(next)) {
+		BinRemove(next);
+		const std::size_t merged = BlockSize(header) + BlockSize(next);
+		SetHeaderAndFooter(header, merged, /*used=*/false);
+	}
+
+	// Coalesce with previous block if it exists and is free.
+	if (reinterpret_cast<std::uint8_t*>(header) > g_heap_begin) {
+		BlockHeader* prev = PrevBlock(header);
+		if (reinterpret_cast<std::uint8_t*>(prev) >= g_heap_begin && !IsUsed(prev)) {
+			BinRemove(prev);
+			const std::size_t merged = BlockSize(prev) + BlockSize(header);
+			SetHeaderAndFooter(prev, merged, /*used=*/false);
+			header = prev;
+		}
+	}
+
+	// File the (possibly merged) free block.
+	BinInsert(header);
+	return header;
+}
+
+// Maps `size_bytes` (a whole number of chunks) at g_heap_end and frees it into
+// the heap.
+bool GrowBy(std::size_t size_bytes) {
+	if (!g_growth.enabled) return false;
+
+	const GrowthConfig& config = g_growth.config;
+	const auto mapped_or = KernelMappings::MapNewRange4KiB(
+		config.pmm,
+		config.root,
+		&g_growth.window_va,
+		size_bytes,
+		config.permissions,
+		config.address_bits
+	);
+	if (!mapped_or.has_value()) return false;
+
+	const std::uintptr_t mapped_base = mapped_or.value().virtual_base;
+	if (mapped_base != reinterpret_cast<std::uintptr_t>(g_heap_end)) {
+		// Not contiguous with the heap (an earlier trim could not hand its VA
+		// back); return the range and stop growing.
+		(void)KernelMappings::UnmapAndFreeBackingPages4KiB(
+			config.pmm, config.root, &g_growth.window_va, mapped_base, size_bytes, config.address_bits);
+		return false;
+	}
+
+	auto* chunk_header = reinterpret_cast<BlockHeader*>(g_heap_end);
+	g_heap_end += size_bytes;
+	SetHeaderAndFooter(chunk_header, size_bytes, /*used=*/true);
+	(void)ReleaseBlock(chunk_header);
+	return true;
+}
+
+// Returns whole chunks at the end of the heap to the PMM if `free_block` is
+// the tail block and more than one spare chunk would be left behind it.
+void TrimTail(BlockHeader* free_block) {
+	if (!g_growth.enabled) return;
+
+	auto* block_begin = reinterpret_cast<std::uint8_t*>(free_block);
+	if (block_begin + BlockSize(free_block) != g_heap_end) return;
+
+	// Keep the block itself (at least MinFreeBlockSize of it) plus one spare
+	// chunk, in whole chunks from g_heap_begin.
+	const auto kept_bytes = static_cast<std::size_t>(block_begin - g_heap_begin) + MinFreeBlockSize;
+	std::uint8_t* keep_end = g_heap_begin + RoundUp(kept_bytes, kGrowthChunkBytes) + kGrowthChunkBytes;
+	if (keep_end < g_growth.minimum_end) keep_end = g_growth.minimum_end;
+	if (keep_end >= g_heap_end) return;
+
+	const auto trim_bytes = static_cast<std::size_t>(g_heap_end - keep_end);
+	BinRemove(free_block);
+	SetHeaderAndFooter(free_block, static_cast<std::size_t>(keep_end - block_begin), /*used=*/false);
+	BinInsert(free_block);
+	g_heap_end = keep_end;
+
+	// If the VA cannot be handed back to window_va, the next GrowBy() sees a
+	// non-contiguous range and refuses: the heap just stops growing.
+	const GrowthConfig& config = g_growth.config;
+	const auto trim_base = reinterpret_cast<std::uintptr_t>(keep_end);
+	// Heap mappings are global; the helper invalidates each page before its
+	// frame or any emptied table is reused.
+	(void)KernelMappings::UnmapAndFreeBackingPages4KiB(
+		config.pmm, config.root, &g_growth.window_va, trim_base, trim_bytes, config.address_bits);
+}
+
+// Splits whatever a used block holds beyond `block_needed` off as a free
+// block, if that remainder can stand alone.
+void SplitUsedBlock(BlockHeader* header, std::size_t block_needed) {
+	const std::size_t remainder = BlockSize(header) - block_needed;
+	if (remainder < MinFreeBlockSize) return;
+
+	SetHeaderAndFooter(header, block_needed, /*used=*/true);
+	auto* tail = reinterpret_cast<BlockHeader*>(reinterpret_cast<std::uint8_t*>(header) + block_needed);
+	SetHeaderAndFooter(tail, remainder, /*used=*/true);
+	TrimTail(ReleaseBlock(tail));
+}
+
+// Resizes a used block without moving it: shrink by splitting, grow by
+// absorbing a free successor (mapping more heap first if the block, or its
+// free successor, ends the heap). Returns false if the block cannot grow.
+bool ResizeInPlace(BlockHeader* header, std::size_t block_needed) {
+	if (block_needed <= BlockSize(header)) {
+		SplitUsedBlock(header, block_needed);
+		return true;
+	}
+
+	BlockHeader* next = NextBlock(header);
+	std::size_t available = BlockSize(header);
+	if (reinterpret_cast<std::uint8_t*>(next) < g_heap_end && !IsUsed(next)) available += BlockSize(next);
+	if (available < block_needed) {
+		if (reinterpret_cast<std::uint8_t*>(header) + available != g_heap_end) return false;
+		// The new chunk merges into the free successor, or becomes it.
+		if (!GrowBy(RoundUp(block_needed - available, kGrowthChunkBytes))) return false;
+		next = NextBlock(header);
+	}
+
+	BinRemove(next);
+	SetHeaderAndFooter(header, BlockSize(header) + BlockSize(next), /*used=*/true);
+	SplitUsedBlock(header, block_needed);
+	return true;
+}
+
+// Copies between payloads, which are at least 8-byte aligned. The compiler
+// barrier keeps the loop from being turned back into a call to the
+// byte-at-a-time memcpy in cxxabi.cpp.
+void CopyPayload(void* destination, const void* source, std::size_t byte_count) {
+	auto* dst = static_cast<std::uint64_t*>(destination);
+	const auto* src = static_cast<const std::uint64_t*>(source);
+	const std::size_t word_count = byte_count / sizeof(std::uint64_t);
+	for (std::size_t i = 0; i < word_count; i++) {
+		dst[i] = src[i];
+		asm volatile("" ::: "memory");
+	}
+
+	auto* dst_tail = reinterpret_cast<std::uint8_t*>(dst + word_count);
+	const auto* src_tail = reinterpret_cast<const std::uint8_t*>(src + word_count);
+	for (std::size_t i = 0; i < (byte_count % sizeof(std::uint64_t)); i++) {
+		dst_tail[i] = src_tail[i];
+	}
+}
+
+// Alloc() without the call counters.
+void* AllocateUncounted(std::size_t size, std::size_t alignment) {
+	if (SlabAllocator::Handles(size, alignment)) {
+		auto& slabs = GetSlabAllocator();
+		if (slabs.IsInitialized()) {
+			if (void* ptr = slabs.Allocate(size)) return ptr;
+		}
+	}
+
+	if (!g_initialized) return nullptr;
+
+	// Normalize alignment. We guarantee at least 16-byte alignment.
+	if (alignment < kHeapAlign) alignment = kHeapAlign;
+	if (!IsPowerOfTwo(alignment)) return nullptr;
+	if (size > kMaxBlockSize || alignment > kMaxBlockSize) return nullptr;
+
+	const std::size_t block_needed = BlockSizeForRequest(size);
+
+	const std::size_t required_size = RequiredFreeBlockSize(block_needed, alignment);
+	if (void* ptr = AllocateFromBins(required_size, block_needed, alignment)) return ptr;
+
+	// Out of room: map enough whole chunks that the new space alone passes
+	// the rounded search, whether or not it merges with a free tail.
+	if (!GrowBy(RoundUp(RoundUpToBinSize(required_size), kGrowthChunkBytes))) return nullptr;
+	return AllocateFromBins(required_size, block_needed, alignment);
 }
 
 } // namespace
@@ -140,6 +557,9 @@ bool IsInitialized() {
 }
 
 void Init(void* heap_start, std::size_t heap_size_bytes) {
+	// A fixed region; InitGrowable() re-enables growth afterwards.
+	g_growth.enabled = false;
+
 	// Align the heap start up, and shrink the size accordingly.
 	auto begin = reinterpret_cast<std::uintptr_t>(heap_start);
 	std::uintptr_t aligned_begin = AlignUp(begin, kHeapAlign);
@@ -150,17 +570,18 @@ void Init(void* heap_start, std::size_t heap_size_bytes) {
 			// Not enough space.
 			g_initialized = false;
 			g_heap_begin = g_heap_end = nullptr;
-			g_free_list_head = nullptr;
+			ResetBins();
 			return;
 		}
 		heap_size_bytes -= delta;
 	}
 
 	heap_size_bytes &= ~kFlagMask; // round down
+	if (heap_size_bytes > kMaxBlockSize) heap_size_bytes = kMaxBlockSize;
 
 	g_heap_begin = reinterpret_cast<std::uint8_t*>(aligned_begin);
 	g_heap_end = g_heap_begin + heap_size_bytes;
-	g_free_list_head = nullptr;
+	ResetBins();
 
 	if (heap_size_bytes < MinFreeBlockSize) {
 		g_initialized = false;
@@ -171,117 +592,130 @@ void Init(void* heap_start, std::size_t heap_size_bytes) {
 	// Create a single large free block spanning the entire heap.
 	auto* first = reinterpret_cast<BlockHeader*>(g_heap_begin);
 	SetHeaderAndFooter(first, heap_size_bytes, /*used=*/false);
-
-	FreeNode* node = NodeFor(first);
-	node->Next = nullptr;
-	node->Prev = nullptr;
-	g_free_list_head = node;
+	BinInsert(first);
 
 	g_initialized = true;
 }
 
+bool InitGrowable(const GrowthConfig& config, std::size_t initial_size_bytes) {
+	g_initialized = false;
+	g_growth.enabled = false;
+
+	if (!config.pmm) return false;
+	if ((config.window_base % Paging::kPageSizeBytes) != 0) return false;
+	if (initial_size_bytes == 0) initial_size_bytes = kGrowthChunkBytes;
+	initial_size_bytes = RoundUp(initial_size_bytes, kGrowthChunkBytes);
+	if (initial_size_bytes > config.window_size_bytes) return false;
+	if (config.window_size_bytes > kMaxBlockSize) return false;
+	const std::uintptr_t window_limit = config.window_base + static_cast<std::uintptr_t>(config.window_size_bytes);
+	if (window_limit < config.window_base) return false;
+
+	g_growth.config = config;
+	g_growth.window_va.Init(config.window_base, window_limit);
+
+	const auto mapped_or = KernelMappings::MapNewRange4KiB(
+		config.pmm,
+		config.root,
+		&g_growth.window_va,
+		initial_size_bytes,
+		config.permissions,
+		config.address_bits
+	);
+	if (!mapped_or.has_value()) return false;
+
+	Init(reinterpret_cast<void*>(mapped_or.value().virtual_base), initial_size_bytes);
+	if (!g_initialized) return false;
+
+	g_growth.minimum_end = g_heap_end;
+	g_growth.enabled = true;
+	return true;
+}
+
 void* Alloc(std::size_t size, std::size_t alignment) {
-	if (!g_initialized) return nullptr;
+	void* ptr = AllocateUncounted(size, alignment);
+	if (ptr) {
+		g_counters.allocation_count++;
+	} else {
+		g_counters.failed_allocation_count++;
+	}
+	return ptr;
+}
 
-	// Normalize alignment. We guarantee at least 16-byte alignment.
-	if (alignment < kHeapAlign) alignment = kHeapAlign;
-	if (!IsPowerOfTwo(alignment)) return nullptr;
+void Free(void* ptr) {
+	if (!ptr) return;
 
-	// Payload size is rounded up to the base heap alignment.
-	const std::size_t payload_size = RoundUp(size, kHeapAlign);
-	const std::size_t block_needed = RoundUp(HeaderSize + payload_size + FooterSize, kHeapAlign);
-
-	for (FreeNode* node = g_free_list_head; node; node = node->Next) {
-		BlockHeader* free_block = HeaderFor(node);
-		const std::size_t free_size = BlockSize(free_block);
-
-		// Try to place an allocated block inside this free block so that the
-		// returned payload pointer meets `alignment`.
-		auto* block_begin = reinterpret_cast<std::uint8_t*>(free_block);
-		std::uint8_t* block_end = block_begin + free_size;
-
-		// We want:
-		//   payload = alloc_header + HeaderSize
-		// to be aligned.
-		auto payload_begin = reinterpret_cast<std::uintptr_t>(block_begin + HeaderSize);
-		std::uintptr_t payload_aligned = AlignUp(payload_begin, alignment);
-		auto* alloc_header_begin = reinterpret_cast<std::uint8_t*>(payload_aligned - HeaderSize);
-
-		// If the prefix is too small to be its own free block, bump by alignment
-		// until it is (or until it no longer fits).
-		while (alloc_header_begin > block_begin &&
-			static_cast<std::size_t>(alloc_header_begin - block_begin) < MinFreeBlockSize) {
-			payload_aligned += alignment;
-			alloc_header_begin = reinterpret_cast<std::uint8_t*>(payload_aligned - HeaderSize);
-			if (alloc_header_begin + block_needed > block_end) break;
-		}
+	// Anything outside the boundary-tag region came from a slab.
+	auto* byte_ptr = static_cast<std::uint8_t*>(ptr);
+	if (!g_initialized || byte_ptr < g_heap_begin || byte_ptr >= g_heap_end) {
+		if (GetSlabAllocator().Free(ptr)) g_counters.free_count++;
+		return;
+	}
 
-		const auto prefix = static_cast<std::size_t>(alloc_header_begin - block_begin);
-		if (alloc_header_begin + block_needed > block_end) continue;
+	g_counters.free_count++;
 
-		// Success: remove this free block from the free list and split it into:
-		// [optional prefix free][allocated][optional suffix free]
-		FreeListRemove(node);
+	auto* header = reinterpret_cast<BlockHeader*>(reinterpret_cast<std::uint8_t*>(ptr) - HeaderSize);
+	TrimTail(ReleaseBlock(header));
+}
 
-		// Prefix free block
-		if (prefix >= MinFreeBlockSize) {
-			auto* prefix_header = reinterpret_cast<BlockHeader*>(block_begin);
-			SetHeaderAndFooter(prefix_header, prefix, /*used=*/false);
-			FreeListInsertFront(NodeFor(prefix_header));
-		}
+void* Realloc(void* ptr, std::size_t size, std::size_t alignment) {
+	if (!ptr) return Alloc(size, alignment);
+	if (size == 0) {
+		Free(ptr);
+		return nullptr;
+	}
 
-		// Allocated block
-		auto* alloc_header = reinterpret_cast<BlockHeader*>(alloc_header_begin);
-		SetHeaderAndFooter(alloc_header, block_needed, /*used=*/true);
-
-		// Suffix free block
-		std::uint8_t* suffix_begin = alloc_header_begin + block_needed;
-		const auto suffix = static_cast<std::size_t>(block_end - suffix_begin);
-		if (suffix >= MinFreeBlockSize) {
-			auto* suffix_header = reinterpret_cast<BlockHeader*>(suffix_begin);
-			SetHeaderAndFooter(suffix_header, suffix, /*used=*/false);
-			FreeListInsertFront(NodeFor(suffix_header));
-		} else if (suffix != 0) {
-			// Not enough space to form a valid free block; just give it to the
-			// allocation (prevents creating an unusable fragment).
-			SetHeaderAndFooter(alloc_header, block_needed + suffix, /*used=*/true);
+	auto* byte_ptr = static_cast<std::uint8_t*>(ptr);
+	if (g_initialized && byte_ptr >= g_heap_begin && byte_ptr < g_heap_end) {
+		if (size <= kMaxBlockSize) {
+			auto* header = reinterpret_cast<BlockHeader*>(byte_ptr - HeaderSize);
+			if (ResizeInPlace(header, BlockSizeForRequest(size))) return ptr;
 		}
-
-		return reinterpret_cast<void*>(alloc_header_begin + HeaderSize);
+	} else {
+		const std::size_t object_size = GetSlabAllocator().ObjectSize(ptr);
+		if (object_size == 0) return nullptr;
+		if (size <= object_size) return ptr;
 	}
 
-	return nullptr;
+	const std::size_t old_size = UsableSize(ptr);
+	void* moved = Alloc(size, alignment);
+	if (!moved) return nullptr;
+	CopyPayload(moved, ptr, (old_size < size) ? old_size : size);
+	Free(ptr);
+	return moved;
 }
 
-void Free(void* ptr) {
-	if (!g_initialized || !ptr) return;
-
-	auto* header = reinterpret_cast<BlockHeader*>(reinterpret_cast<std::uint8_t*>(ptr) - HeaderSize);
+std::size_t UsableSize(const void* ptr) {
+	if (!ptr) return 0;
 
-	// Mark the block free.
-	SetHeaderAndFooter(header, BlockSize(header), /*used=*/false);
-
-	// Coalesce with next block if it exists and is free.
-	BlockHeader* next = NextBlock(header);
-	if (reinterpret_cast<std::uint8_t*>(next) < g_heap_end && !IsUsed(next)) {
-		FreeListRemove(NodeFor(next));
-		const std::size_t merged = BlockSize(header) + BlockSize(next);
-		SetHeaderAndFooter(header, merged, /*used=*/false);
+	const auto* byte_ptr = static_cast<const std::uint8_t*>(ptr);
+	if (!g_initialized || byte_ptr < g_heap_begin || byte_ptr >= g_heap_end) {
+		return GetSlabAllocator().ObjectSize(ptr);
 	}
+	const auto* header = reinterpret_cast<const BlockHeader*>(byte_ptr - HeaderSize);
+	return BlockSize(header) - HeaderSize - FooterSize;
+}
 
-	// Coalesce with previous block if it exists and is free.
-	if (reinterpret_cast<std::uint8_t*>(header) > g_heap_begin) {
-		BlockHeader* prev = PrevBlock(header);
-		if (reinterpret_cast<std::uint8_t*>(prev) >= g_heap_begin && !IsUsed(prev)) {
-			FreeListRemove(NodeFor(prev));
-			const std::size_t merged = BlockSize(prev) + BlockSize(header);
-			SetHeaderAndFooter(prev, merged, /*used=*/false);
-			header = prev;
-		}
+Statistics GetStatistics() {
+	Statistics statistics;
+	if (!g_initialized) return statistics;
+
+	statistics.total_bytes = static_cast<std::size_t>(g_heap_end - g_heap_begin);
+	statistics.free_bytes = g_counters.free_bytes;
+	statistics.used_bytes = statistics.total_bytes - statistics.free_bytes;
+	statistics.free_block_count = g_counters.free_block_count;
+	statistics.allocation_count = g_counters.allocation_count;
+	statistics.free_count = g_counters.free_count;
+	statistics.failed_allocation_count = g_counters.failed_allocation_count;
+
+	// The largest block is in the top non-empty list, and blocks in one list
+	// differ by less than one second-level step: report that list's head
+	// rather than walking it.
+	if (g_first_level_bitmap != 0) {
+		const std::size_t first = 31 - static_cast<std::size_t>(__builtin_clz(g_first_level_bitmap));
+		const std::size_t second = 31 - static_cast<std::size_t>(__builtin_clz(g_second_level_bitmaps[first]));
+		statistics.largest_free_block_bytes = BlockSize(HeaderFor(g_free_lists[first][second]));
 	}
-
-	// Insert the (possibly merged) free block back into the free list.
-	FreeListInsertFront(NodeFor(header));
+	return statistics;
 }
 
 std::size_t TotalBytes() {
@@ -291,12 +725,18 @@ std::size_t TotalBytes() {
 
 std::size_t FreeBytes() {
 	if (!g_initialized) return 0;
+	return g_counters.free_bytes;
+}
 
-	std::size_t total = 0;
-	for (FreeNode* node = g_free_list_head; node; node = node->Next) {
-		total += BlockSize(HeaderFor(node));
+#if defined(ROCINANTE_HEAP_DEBUG_HISTOGRAM)
+FreeBlockHistogram GetFreeBlockHistogram() {
+	FreeBlockHistogram histogram;
+	if (!g_initialized) return histogram;
+	for (std::size_t bucket = 0; bucket < kFreeBlockHistogramBucketCount; bucket++) {
+		histogram.block_count[bucket] = g_counters.free_blocks_by_first_level[bucket];
 	}
-	return total;
+	return histogram;
 }
+#endif
 
 } // namespace Rocinante::Memory::Heap
@@ -6,6 +6,13 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
+
+#include <src/memory/paging.h>
+
+namespace Rocinante::Memory {
+class PhysicalMemoryManager;
+} // namespace Rocinante::Memory
 
 namespace Rocinante::Memory::Heap {
 
@@ -21,8 +28,35 @@ namespace Rocinante::Memory::Heap {
 // Non-goals (for now)
 // -------------------
 // - SMP-safe allocation (no locks yet).
-// - Per-CPU caches, slabs, etc.
+// - Per-CPU caches.
 // - Returning memory to the host/firmware.
+//
+// Growth
+// ------
+// InitGrowable() hands the heap a reserved (unmapped) kernel VA window instead
+// of a fixed region. The heap maps the window front-to-back in
+// kGrowthChunkBytes chunks via KernelMappings::MapNewRange4KiB() whenever an
+// allocation does not fit, and once a free block covers whole chunks at the
+// end of the mapped region it unmaps them and returns their frames to the PMM
+// (keeping one spare chunk so an alloc/free pair at the boundary does not
+// remap every time). The mapped region never shrinks below its initial size.
+//
+// Allocation strategy
+// -------------------
+// Boundary-tag blocks filed in a two-level segregated-fit (TLSF) index with
+// bitmaps, so Alloc() and Free() take bounded time regardless of how many
+// free blocks exist or how large the requested alignment is (trap-context
+// callers rely on that). The index is good-fit rather than best-fit: it picks
+// the first non-empty size class that is guaranteed to fit, which can pass
+// over a block in the request's own class that would have fit.
+//
+// Small requests
+// --------------
+// Once GetSlabAllocator() is initialized (after the paging heap handoff),
+// requests that SlabAllocator::Handles() are served from PMM-backed size-class
+// slabs instead of the boundary-tag region below; Free() tells the two apart
+// by address. If the slab allocator cannot get a page, the request falls
+// through to the boundary-tag region.
 
 // Initializes the heap over the given (already-mapped) memory region.
 //
@@ -30,6 +64,36 @@ namespace Rocinante::Memory::Heap {
 // kernel.
 void Init(void* heap_start, std::size_t heap_size_bytes);
 
+// Granularity of heap growth and trimming.
+inline constexpr std::size_t kGrowthChunkBytes = 64u * 1024u;
+
+// Where a growable heap gets its backing from.
+//
+// - window_base / window_size_bytes: a page-aligned VA range reserved for the
+//   heap alone (e.g. from KernelVirtualAddressAllocator) with nothing mapped.
+// - pmm / root / address_bits / permissions: passed through to
+//   KernelMappings when mapping and unmapping chunks.
+struct GrowthConfig final {
+	PhysicalMemoryManager* pmm;
+	Paging::PageTableRoot root;
+	Paging::AddressSpaceBits address_bits;
+	Paging::PagePermissions permissions;
+	std::uintptr_t window_base;
+	std::size_t window_size_bytes;
+};
+
+// Initializes the heap over a growable VA window, mapping the first
+// `initial_size_bytes` (rounded up to kGrowthChunkBytes) up front.
+//
+// Returns false (and leaves the heap uninitialized) if the window is unusable
+// or the initial mapping fails.
+//
+// Current limitations (intentional for early bring-up):
+// - Trimming invalidates the unmapped pages on the local CPU only; there is no
+//   cross-CPU shootdown yet.
+// - Growth is contiguous: the heap stops growing at the end of the window.
+bool InitGrowable(const GrowthConfig& config, std::size_t initial_size_bytes);
+
 // Returns true once Init() has been called.
 bool IsInitialized();
 
@@ -41,8 +105,79 @@ void* Alloc(std::size_t size, std::size_t alignment = 16);
 // Frees a pointer returned by Alloc().
 void Free(void* ptr);
 
-// Debug helpers
+// Resizes an allocation, keeping its contents up to the smaller of the old
+// and new sizes.
+//
+// - In place when possible: a shrink splits the tail off as a free block; a
+//   grow absorbs a free successor block (growing the heap first if the block
+//   sits at the end of a growable heap). Slab objects stay put while the new
+//   size still fits their size class.
+// - Otherwise allocates a new block with `alignment`, copies, and frees the
+//   old one. Pass the alignment the block was allocated with.
+// - ptr == nullptr behaves like Alloc(); size == 0 frees ptr and returns
+//   nullptr.
+//
+// Returns nullptr on failure, leaving ptr allocated and unchanged.
+void* Realloc(void* ptr, std::size_t size, std::size_t alignment = 16);
+
+// Bytes usable through ptr (at least what was requested; often more, from
+// size rounding or an unsplittable remainder). Returns 0 for nullptr or a
+// pointer the heap does not own.
+std::size_t UsableSize(const void* ptr);
+
+// Running counters.
+//
+// Byte and block counts describe the boundary-tag region only (see
+// SlabAllocator for slab counters); for a growable heap total_bytes is the
+// currently mapped size. Bytes are whole blocks, headers and footers
+// included, so used_bytes + free_bytes == total_bytes.
+//
+// The call counts cover every Alloc()/Free(), whichever layer served them.
+// All counters restart at Init()/InitGrowable().
+//
+// largest_free_block_bytes is approximate: it is the size of one block from
+// the top non-empty size class, so the largest free block is at most one
+// second-level step (1/16 of its size) bigger. It is exact while that class
+// holds a single block, and a block of the reported size is always free.
+struct Statistics final {
+	std::size_t total_bytes = 0;
+	std::size_t used_bytes = 0;
+	std::size_t free_bytes = 0;
+	std::size_t free_block_count = 0;
+	std::size_t largest_free_block_bytes = 0;
+	std::uint64_t allocation_count = 0;
+	std::uint64_t free_count = 0;
+	std::uint64_t failed_allocation_count = 0;
+};
+
+// Snapshot of the running counters.
+//
+// Cost does not depend on heap size or fragmentation: the counters are kept
+// up to date by Alloc()/Free(), and the largest free block is the head of the
+// top non-empty size class (no list is walked).
+Statistics GetStatistics();
+
+// Shorthands for GetStatistics().total_bytes / .free_bytes.
 std::size_t TotalBytes();
 std::size_t FreeBytes();
 
+#if defined(ROCINANTE_HEAP_DEBUG_HISTOGRAM)
+// Free blocks by size, one bucket per power of two (debug builds only: the
+// counts cost an extra update on every free-list insert/remove).
+//
+// Bucket 0 holds blocks below 256 bytes; bucket i > 0 holds blocks in
+// [128 << i, 256 << i).
+inline constexpr std::size_t kFreeBlockHistogramBucketCount = 31;
+
+constexpr std::size_t FreeBlockHistogramBucketMinBytes(std::size_t bucket) {
+	return (bucket == 0) ? 0 : (std::size_t{128} << bucket);
+}
+
+struct FreeBlockHistogram final {
+	std::size_t block_count[kFreeBlockHistogramBucketCount] = {};
+};
+
+FreeBlockHistogram GetFreeBlockHistogram();
+#endif
+
 } // namespace Rocinante::Memory::Heap
@@ -6,8 +6,10 @@
 #include <src/memory/kernel_mappings.h>
 
 #include <src/memory/kernel_va_allocator.h>
-#include <src/memory/pmm.h>
+#include <src/memory/page_table_pool.h>
 #include <src/memory/paging.h>
+#include <src/memory/paging_hw.h>
+#include <src/memory/pmm.h>
 
 #include <limits>
 
@@ -34,6 +36,20 @@ Rocinante::Optional<std::size_t> RoundUpToPageSize(std::size_t bytes) {
 	return rounded;
 }
 
+// Drops the TLB entry for one just-unmapped kernel page.
+//
+// Spec anchor (LoongArch-Vol1-EN.html):
+// - Section 4.2.4.7 (INVTLB), Table 13: op=0x6 clears the entries for one VA
+//   that are global (G=1) or tagged with the supplied ASID.
+//
+// Kernel mappings are global or were filled under the running ASID, so op=0x6
+// with the current ASID covers both. Runs before the page's frame or any
+// emptied table is reused.
+void InvalidateUnmappedPage(std::uintptr_t virtual_page) {
+	Rocinante::Memory::PagingHw::InvalidateGlobalOrAsidTlbEntryForVa(
+		Rocinante::Memory::PagingHw::GetAddressSpaceId(), virtual_page);
+}
+
 } // namespace
 
 Rocinante::Optional<MappedRange> MapPhysicalRange4KiB(
@@ -73,12 +89,15 @@ Rocinante::Optional<MappedRange> MapPhysicalRange4KiB(
 	}
 
 	if (mapped_bytes != size_bytes) {
+		PageTablePagePool::DeferredBatch table_batch(GetPageTablePagePool());
 		std::size_t unmapped_bytes = 0;
 		while (unmapped_bytes < mapped_bytes) {
 			const std::uintptr_t virtual_page = virtual_base + unmapped_bytes;
 			(void)Paging::UnmapPage4KiB(pmm, root, virtual_page, address_bits);
+			InvalidateUnmappedPage(virtual_page);
 			unmapped_bytes += Rocinante::Memory::Paging::kPageSizeBytes;
 		}
+		(void)table_batch.Reclaim();
 		(void)va_allocator->Free(virtual_base, size_bytes);
 		return Rocinante::nullopt;
 	}
@@ -128,16 +147,19 @@ Rocinante::Optional<MappedRange> MapNewRange4KiB(
 	}
 
 	if (mapped_bytes != size_bytes) {
+		PageTablePagePool::DeferredBatch table_batch(GetPageTablePagePool());
 		std::size_t rolled_back_bytes = 0;
 		while (rolled_back_bytes < mapped_bytes) {
 			const std::uintptr_t virtual_page = virtual_base + rolled_back_bytes;
 			const auto physical_or = Paging::Translate(root, virtual_page, address_bits);
 			(void)Paging::UnmapPage4KiB(pmm, root, virtual_page, address_bits);
+			InvalidateUnmappedPage(virtual_page);
 			if (physical_or.has_value()) {
 				(void)pmm->FreePage(physical_or.value());
 			}
 			rolled_back_bytes += Rocinante::Memory::Paging::kPageSizeBytes;
 		}
+		(void)table_batch.Reclaim();
 		(void)va_allocator->Free(virtual_base, size_bytes);
 		return Rocinante::nullopt;
 	}
@@ -196,16 +218,19 @@ Rocinante::Optional<GuardedMappedRange4KiB> MapNewGuardedRange4KiB(
 	}
 
 	if (mapped_bytes != mapped_size_bytes) {
+		PageTablePagePool::DeferredBatch table_batch(GetPageTablePagePool());
 		std::size_t rolled_back_bytes = 0;
 		while (rolled_back_bytes < mapped_bytes) {
 			const std::uintptr_t virtual_page = mapped_virtual_base + rolled_back_bytes;
 			const auto physical_or = Paging::Translate(root, virtual_page, address_bits);
 			(void)Paging::UnmapPage4KiB(pmm, root, virtual_page, address_bits);
+			InvalidateUnmappedPage(virtual_page);
 			if (physical_or.has_value()) {
 				(void)pmm->FreePage(physical_or.value());
 			}
 			rolled_back_bytes += Rocinante::Memory::Paging::kPageSizeBytes;
 		}
+		(void)table_batch.Reclaim();
 		(void)va_allocator->Free(guard_virtual_base, total_size_bytes);
 		return Rocinante::nullopt;
 	}
@@ -231,15 +256,24 @@ bool UnmapAndFree4KiB(
 	if (!IsPageAligned(virtual_base)) return false;
 	if ((size_bytes % Rocinante::Memory::Paging::kPageSizeBytes) != 0) return false;
 
+	PageTablePagePool::DeferredBatch table_batch(GetPageTablePagePool());
+	Paging::Cursor cursor(pmm, root, address_bits);
+	if (!cursor.IsValid()) return false;
+
 	bool all_unmapped = true;
 	std::size_t unmapped_bytes = 0;
 	while (unmapped_bytes < size_bytes) {
 		const std::uintptr_t virtual_page = virtual_base + unmapped_bytes;
-		if (!Paging::UnmapPage4KiB(pmm, root, virtual_page, address_bits)) {
+		if (!cursor.Seek(virtual_page) || !cursor.Unmap()) {
 			all_unmapped = false;
+		} else {
+			InvalidateUnmappedPage(virtual_page);
 		}
 		unmapped_bytes += Rocinante::Memory::Paging::kPageSizeBytes;
 	}
+	if (!cursor.Flush()) all_unmapped = false;
+	// Every page the emptied tables covered was invalidated above.
+	(void)table_batch.Reclaim();
 
 	if (!all_unmapped) return false;
 	return va_allocator->Free(virtual_base, size_bytes);
@@ -258,15 +292,27 @@ bool UnmapAndFreeBackingPages4KiB(
 	if (!IsPageAligned(virtual_base)) return false;
 	if ((size_bytes % Rocinante::Memory::Paging::kPageSizeBytes) != 0) return false;
 
+	PageTablePagePool::DeferredBatch table_batch(GetPageTablePagePool());
+	Paging::Cursor cursor(pmm, root, address_bits);
+	if (!cursor.IsValid()) return false;
+
 	bool all_unmapped = true;
 	std::size_t unmapped_bytes = 0;
 	while (unmapped_bytes < size_bytes) {
 		const std::uintptr_t virtual_page = virtual_base + unmapped_bytes;
-		const auto physical_or = Paging::Translate(root, virtual_page, address_bits);
+		if (!cursor.Seek(virtual_page)) {
+			all_unmapped = false;
+			unmapped_bytes += Rocinante::Memory::Paging::kPageSizeBytes;
+			continue;
+		}
+		const auto physical_or = cursor.Query();
 
-		if (!Paging::UnmapPage4KiB(pmm, root, virtual_page, address_bits)) {
+		if (!cursor.Unmap()) {
 			all_unmapped = false;
 		} else {
+			// The stale TLB entry goes before the frame returns to the PMM.
+			InvalidateUnmappedPage(virtual_page);
+
 			// Only attempt to free the backing page if the unmap succeeded.
 			//
 			// NOTE: We translate before unmapping so that the physical address is
@@ -283,6 +329,9 @@ bool UnmapAndFreeBackingPages4KiB(
 		unmapped_bytes += Rocinante::Memory::Paging::kPageSizeBytes;
 	}
 
+	if (!cursor.Flush()) all_unmapped = false;
+	(void)table_batch.Reclaim();
+
 	if (!all_unmapped) return false;
 	return va_allocator->Free(virtual_base, size_bytes);
 }
@@ -135,6 +135,13 @@ Rocinante::Optional<GuardedMappedRange4KiB> MapNewGuardedRange4KiB(
 	Paging::AddressSpaceBits address_bits
 );
 
+// Unmaps a virtual range and frees the VA range; the physical pages stay with
+// their owner.
+//
+// TLB policy:
+// - Each unmapped page is invalidated (INVTLB op=0x6 with the current ASID)
+//   before this returns, and page tables emptied by the unmap are recycled
+//   only after that.
 bool UnmapAndFree4KiB(
 	PhysicalMemoryManager* pmm,
 	const Paging::PageTableRoot& root,
@@ -153,9 +160,8 @@ bool UnmapAndFree4KiB(
 // Important:
 // - This is NOT safe for ranges mapped with MapPhysicalRange4KiB() or MMIO
 //   mappings: those physical pages are caller-owned and must not be freed.
-// - `Paging::UnmapPage4KiB()` intentionally does not define a TLB invalidation
-//   policy; callers that require immediate hardware enforcement must invalidate
-//   stale translations (e.g., via PagingHw) before reusing the freed pages.
+// - Same TLB policy as UnmapAndFree4KiB(); each page is invalidated before its
+//   backing frame goes back to the PMM.
 // - This helper is intentionally dumb: it assumes that every mapped 4 KiB page
 //   in the virtual interval translates to a page-aligned physical address.
 bool UnmapAndFreeBackingPages4KiB(
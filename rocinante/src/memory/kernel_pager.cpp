@@ -131,8 +131,10 @@ Rocinante::Trap::PagingFaultResult KernelPagerPagingFaultObserver(
 		return Rocinante::Trap::PagingFaultResult::NotHandled;
 	}
 
+	// Lazy kernel pages read as zero on first touch. The PMM's pre-zeroed pool
+	// usually has a frame ready, keeping the 4 KiB clear off the fault path.
 	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
-	const auto physical_page_or = pmm.AllocatePage();
+	const auto physical_page_or = pmm.AllocateZeroedPage();
 	if (!physical_page_or.has_value()) {
 		g_handling = false;
 		return Rocinante::Trap::PagingFaultResult::NotHandled;
@@ -6,6 +6,8 @@
 #include "memory.h"
 
 #include "heap.h"
+#include "paging_state.h"
+#include "pmm.h"
 
 #include <src/sp/cpucfg.h>
 
@@ -83,4 +85,25 @@ void InitHeapAfterPaging(void* heap_base, std::size_t heap_size_bytes) {
 	Rocinante::Memory::Heap::Init(heap_base, heap_size_bytes);
 }
 
+bool InitGrowableHeapAfterPaging(std::uintptr_t window_base, std::size_t window_size_bytes, std::size_t initial_size_bytes) {
+	const PagingState* paging_state = TryGetPagingState();
+	if (!paging_state) return false;
+
+	// Kernel data: global (shared by every address space), never executable.
+	const Rocinante::Memory::Heap::GrowthConfig config{
+		.pmm = &GetPhysicalMemoryManager(),
+		.root = paging_state->root,
+		.address_bits = paging_state->address_bits,
+		.permissions = Paging::PagePermissions{
+			.access = Paging::AccessPermissions::ReadWrite,
+			.execute = Paging::ExecutePermissions::NoExecute,
+			.cache = Paging::CacheMode::CoherentCached,
+			.global = true,
+		},
+		.window_base = window_base,
+		.window_size_bytes = window_size_bytes,
+	};
+	return Rocinante::Memory::Heap::InitGrowable(config, initial_size_bytes);
+}
+
 } // namespace Rocinante::Memory
@@ -58,4 +58,12 @@ std::uintptr_t RecommendedHeapVirtualBase();
 // 2) a VMM/page tables that map those pages into [heap_base, heap_base+size)
 void InitHeapAfterPaging(void* heap_base, std::size_t heap_size_bytes);
 
+// Initializes the heap over a reserved, still-unmapped kernel VA window that
+// the heap maps (and trims) on demand; see Heap::InitGrowable().
+//
+// Uses the global PMM and paging state, so call it after paging is enabled and
+// the physmap is live. Returns false if either is missing or the initial
+// mapping fails.
+bool InitGrowableHeapAfterPaging(std::uintptr_t window_base, std::size_t window_size_bytes, std::size_t initial_size_bytes);
+
 } // namespace Rocinante::Memory
@@ -0,0 +1,161 @@
+/**
+ * Copyright (C) 2026 Andrew S. Rightenburg
+ * GPL-3.0-or-later
+ */
+
+#include "page_frame_cache.h"
+
+#include <src/sp/cpuid.h>
+
+namespace Rocinante::Memory {
+
+PageFrameCache& GetPageFrameCache() {
+	static PageFrameCache instance;
+	return instance;
+}
+
+void PageFrameCache::Initialize(PhysicalMemoryManager* pmm) {
+	m_pmm = pmm;
+	m_tuning = Tuning{};
+	for (std::size_t core_id = 0; core_id < kMaxCpuCount; core_id++) {
+		m_magazines[core_id].count = 0;
+		m_magazines[core_id].statistics = Statistics{};
+	}
+}
+
+bool PageFrameCache::SetTuning(const Tuning& tuning) {
+	if (tuning.refill_batch_frames == 0 || tuning.refill_batch_frames > kMagazineCapacityFrames) return false;
+	if (tuning.drain_batch_frames == 0 || tuning.drain_batch_frames > kMagazineCapacityFrames) return false;
+	m_tuning = tuning;
+	return true;
+}
+
+PageFrameCache::Magazine* PageFrameCache::_current_magazine() {
+	const std::size_t core_id = Rocinante::ReadCurrentProcessorCoreId();
+	if (core_id >= kMaxCpuCount) return nullptr;
+	return &m_magazines[core_id];
+}
+
+void PageFrameCache::_refill(Magazine* magazine) {
+	Rocinante::SpinlockGuard guard(&m_pmm_lock);
+	std::size_t frames_to_take = m_tuning.refill_batch_frames;
+	if (frames_to_take > (kMagazineCapacityFrames - magazine->count)) {
+		frames_to_take = kMagazineCapacityFrames - magazine->count;
+	}
+
+	for (std::size_t i = 0; i < frames_to_take; i++) {
+		const auto frame_or = m_pmm->AllocatePage();
+		if (!frame_or.has_value()) break;
+		magazine->frames[magazine->count++] = frame_or.value();
+	}
+	magazine->statistics.refill_batches++;
+}
+
+void PageFrameCache::_drain(Magazine* magazine, std::size_t frame_count) {
+	if (frame_count > magazine->count) frame_count = magazine->count;
+	if (frame_count == 0) return;
+
+	// Drain from the bottom of the stack: those frames were freed longest ago
+	// and are the least likely to still be cache-hot.
+	{
+		Rocinante::SpinlockGuard guard(&m_pmm_lock);
+		for (std::size_t i = 0; i < frame_count; i++) {
+			(void)m_pmm->FreePage(magazine->frames[i]);
+		}
+	}
+
+	const std::size_t remaining = magazine->count - frame_count;
+	for (std::size_t i = 0; i < remaining; i++) {
+		magazine->frames[i] = magazine->frames[frame_count + i];
+	}
+	magazine->count = remaining;
+	magazine->statistics.drain_batches++;
+}
+
+Rocinante::Optional<std::uintptr_t> PageFrameCache::AllocatePage() {
+	if (!m_pmm) return Rocinante::nullopt;
+
+	Magazine* magazine = _current_magazine();
+	if (!magazine) {
+		Rocinante::SpinlockGuard guard(&m_pmm_lock);
+		return m_pmm->AllocatePage();
+	}
+
+	if (magazine->count != 0) {
+		magazine->statistics.allocation_hits++;
+		return Rocinante::Optional<std::uintptr_t>(magazine->frames[--magazine->count]);
+	}
+
+	magazine->statistics.allocation_misses++;
+	_refill(magazine);
+	if (magazine->count == 0) return Rocinante::nullopt;
+	return Rocinante::Optional<std::uintptr_t>(magazine->frames[--magazine->count]);
+}
+
+bool PageFrameCache::FreePage(std::uintptr_t physical_page_base) {
+	if (!m_pmm) return false;
+
+	Magazine* magazine = _current_magazine();
+
+	// Only frames the caller exclusively owns may be cached. These reads are
+	// race-free for such frames: nobody else holds a reference to change them.
+	const auto ref_count = m_pmm->ReferenceCountForPhysical(physical_page_base);
+	const auto map_count = m_pmm->MapCountForPhysical(physical_page_base);
+	const bool exclusively_owned =
+		ref_count.has_value() && ref_count.value() == 1 &&
+		map_count.has_value() && map_count.value() == 0;
+
+	if (!magazine || !exclusively_owned) {
+		if (magazine) magazine->statistics.free_bypasses++;
+		Rocinante::SpinlockGuard guard(&m_pmm_lock);
+		return m_pmm->FreePage(physical_page_base);
+	}
+
+	if (magazine->count == kMagazineCapacityFrames) {
+		_drain(magazine, m_tuning.drain_batch_frames);
+	}
+
+	magazine->frames[magazine->count++] = physical_page_base;
+	magazine->statistics.free_hits++;
+	return true;
+}
+
+void PageFrameCache::DrainCurrentCpu() {
+	if (!m_pmm) return;
+	Magazine* magazine = _current_magazine();
+	if (!magazine) return;
+	_drain(magazine, magazine->count);
+}
+
+void PageFrameCache::DrainAll() {
+	if (!m_pmm) return;
+	for (std::size_t core_id = 0; core_id < kMaxCpuCount; core_id++) {
+		_drain(&m_magazines[core_id], m_magazines[core_id].count);
+	}
+}
+
+std::size_t PageFrameCache::CachedFrameCount() const {
+	std::size_t total = 0;
+	for (std::size_t core_id = 0; core_id < kMaxCpuCount; core_id++) {
+		total += m_magazines[core_id].count;
+	}
+	return total;
+}
+
+std::size_t PageFrameCache::CachedFrameCountForCpu(std::size_t core_id) const {
+	if (core_id >= kMaxCpuCount) return 0;
+	return m_magazines[core_id].count;
+}
+
+PageFrameCache::Statistics PageFrameCache::StatisticsForCpu(std::size_t core_id) const {
+	if (core_id >= kMaxCpuCount) return Statistics{};
+	return m_magazines[core_id].statistics;
+}
+
+void PageFrameCache::ResetStatistics() {
+	for (std::size_t core_id = 0; core_id < kMaxCpuCount; core_id++) {
+		m_magazines[core_id].statistics = Statistics{};
+	}
+}
+
+} // namespace Rocinante::Memory
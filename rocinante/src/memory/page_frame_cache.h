@@ -0,0 +1,151 @@
+/**
+ * Copyright (C) 2026 Andrew S. Rightenburg
+ * GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <src/helpers/optional.h>
+#include <src/memory/pmm.h>
+#include <src/sp/per_cpu.h>
+#include <src/sp/spinlock.h>
+
+namespace Rocinante::Memory {
+
+/**
+ * @brief Per-CPU page-frame caches ("magazines") in front of the PMM.
+ *
+ * Each CPU owns a small LIFO stack of free page frames. Single-page allocation
+ * and release hit the current CPU's stack without taking a lock or executing
+ * an atomic instruction. Only when the stack runs empty (refill) or full
+ * (drain) does the CPU take the global PMM lock and move a whole batch of
+ * frames at once.
+ *
+ * Frame state:
+ * - Frames sitting in a magazine are *allocated* from the PMM's point of view
+ *   (ref_count==1, map_count==0). They are therefore not counted by
+ *   PhysicalMemoryManager::FreePages(); use CachedFrameCount() for the total.
+ * - Frames handed out by AllocatePage() are ordinary PMM pages and may be
+ *   released either through this cache or directly through the PMM.
+ *
+ * Current limitations (intentional for early bring-up):
+ * - The fast path follows the per-CPU contract documented at
+ *   Rocinante::kMaxCpuCount (src/sp/per_cpu.h).
+ * - There is no cross-CPU stealing: if the PMM is empty but another CPU's
+ *   magazine holds frames, allocation fails. DrainAll() is the remedy.
+ * - Refills come from the calling core's NUMA node, but magazines do not sort
+ *   frames by node: a remote frame freed on this CPU is reused here.
+ */
+class PageFrameCache final {
+	public:
+		// Frames per magazine. 64 frames = 256 KiB of cached memory per CPU.
+		static constexpr std::size_t kMagazineCapacityFrames = 64;
+
+		static constexpr std::size_t kDefaultRefillBatchFrames = 16;
+		static constexpr std::size_t kDefaultDrainBatchFrames = 16;
+
+		/**
+		 * @brief Batch sizes used when a magazine runs empty or full.
+		 *
+		 * Both must be in [1, kMagazineCapacityFrames].
+		 */
+		struct Tuning final {
+			std::size_t refill_batch_frames = kDefaultRefillBatchFrames;
+			std::size_t drain_batch_frames = kDefaultDrainBatchFrames;
+		};
+
+		/**
+		 * @brief Per-CPU counters for tuning.
+		 *
+		 * - allocation_hits/misses: AllocatePage() served from / not from the magazine.
+		 * - free_hits: FreePage() absorbed by the magazine (possibly after a drain).
+		 * - free_bypasses: FreePage() forwarded to the PMM because the frame was
+		 *   still shared or mapped.
+		 * - refill_batches/drain_batches: number of global-lock round trips.
+		 */
+		struct Statistics final {
+			std::uint64_t allocation_hits = 0;
+			std::uint64_t allocation_misses = 0;
+			std::uint64_t free_hits = 0;
+			std::uint64_t free_bypasses = 0;
+			std::uint64_t refill_batches = 0;
+			std::uint64_t drain_batches = 0;
+		};
+
+		PageFrameCache() = default;
+		~PageFrameCache() = default;
+		PageFrameCache(const PageFrameCache&) = delete;
+		PageFrameCache& operator=(const PageFrameCache&) = delete;
+		PageFrameCache(PageFrameCache&&) = delete;
+		PageFrameCache& operator=(PageFrameCache&&) = delete;
+
+		/**
+		 * @brief Binds the cache to a PMM and empties every magazine.
+		 *
+		 * Frames cached for a previous binding are discarded without being
+		 * returned (the usual reason to re-initialize is that the PMM itself was
+		 * re-initialized). Tuning is reset to defaults; statistics are cleared.
+		 */
+		void Initialize(PhysicalMemoryManager* pmm);
+
+		bool IsInitialized() const { return m_pmm != nullptr; }
+
+		// Returns false (and changes nothing) if either batch size is out of range.
+		bool SetTuning(const Tuning& tuning);
+		Tuning GetTuning() const { return m_tuning; }
+
+		// Allocates one page frame for the current CPU.
+		Rocinante::Optional<std::uintptr_t> AllocatePage();
+
+		/**
+		 * @brief Releases one page frame from the current CPU.
+		 *
+		 * Frames whose final reference this is (ref_count==1, map_count==0) are
+		 * kept in the magazine. Anything else is forwarded to
+		 * PhysicalMemoryManager::FreePage() under the global lock, which applies
+		 * the usual ref/map-count policy.
+		 */
+		bool FreePage(std::uintptr_t physical_page_base);
+
+		// Returns every frame cached by the current CPU to the PMM.
+		void DrainCurrentCpu();
+
+		/**
+		 * @brief Returns every cached frame on every CPU to the PMM.
+		 *
+		 * Only safe while the other CPUs are not using the cache (bring-up,
+		 * tests, or a future stop-the-world low-memory path).
+		 */
+		void DrainAll();
+
+		std::size_t CachedFrameCount() const;
+		std::size_t CachedFrameCountForCpu(std::size_t core_id) const;
+
+		// Returns a zeroed Statistics for core IDs >= kMaxCpuCount.
+		Statistics StatisticsForCpu(std::size_t core_id) const;
+		void ResetStatistics();
+
+	private:
+		struct alignas(Rocinante::kCacheLineBytes) Magazine final {
+			std::uintptr_t frames[kMagazineCapacityFrames] = {};
+			std::size_t count = 0;
+			Statistics statistics{};
+		};
+
+		PhysicalMemoryManager* m_pmm = nullptr;
+		Tuning m_tuning{};
+		Rocinante::Spinlock m_pmm_lock{};
+		Magazine m_magazines[kMaxCpuCount] = {};
+
+		Magazine* _current_magazine();
+		void _refill(Magazine* magazine);
+		void _drain(Magazine* magazine, std::size_t frame_count);
+};
+
+// Returns the single canonical page-frame cache for the kernel.
+PageFrameCache& GetPageFrameCache();
+
+} // namespace Rocinante::Memory
@@ -0,0 +1,218 @@
+/**
+ * Copyright (C) 2026 Andrew S. Rightenburg
+ * GPL-3.0-or-later
+ */
+
+#include "page_table_pool.h"
+
+#include <src/memory/paging_hw.h>
+#include <src/sp/cpuid.h>
+
+namespace Rocinante::Memory {
+
+PageTablePagePool& GetPageTablePagePool() {
+	static PageTablePagePool instance;
+	return instance;
+}
+
+void PageTablePagePool::Initialize(PhysicalMemoryManager* pmm) {
+	m_pmm = pmm;
+	m_watermarks = Watermarks{};
+	m_deferred_count = 0;
+	for (std::size_t core_id = 0; core_id < kMaxCpuCount; core_id++) {
+		m_reserves[core_id].count = 0;
+		m_reserves[core_id].open_batch_id = 0;
+		m_reserves[core_id].statistics = Statistics{};
+	}
+}
+
+bool PageTablePagePool::SetWatermarks(const Watermarks& watermarks) {
+	if (watermarks.high_pages == 0 || watermarks.high_pages > kReserveCapacityPages) return false;
+	if (watermarks.low_pages > watermarks.high_pages) return false;
+	m_watermarks = watermarks;
+	return true;
+}
+
+PageTablePagePool::CpuReserve* PageTablePagePool::_current_reserve() {
+	const std::size_t core_id = Rocinante::ReadCurrentProcessorCoreId();
+	if (core_id >= kMaxCpuCount) return nullptr;
+	return &m_reserves[core_id];
+}
+
+void PageTablePagePool::_refill(CpuReserve* reserve, std::size_t target_count) {
+	if (target_count > kReserveCapacityPages) target_count = kReserveCapacityPages;
+	if (reserve->count >= target_count) return;
+
+	Rocinante::SpinlockGuard guard(&m_lock);
+	const std::size_t before = reserve->count;
+	while (reserve->count < target_count) {
+		const auto page_or = m_pmm->AllocateZeroedPage();
+		if (!page_or.has_value()) break;
+		reserve->pages[reserve->count++] = page_or.value();
+	}
+	if (reserve->count != before) reserve->statistics.refill_batches++;
+}
+
+bool PageTablePagePool::Reserve(std::size_t page_count) {
+	if (!m_pmm) return false;
+	if (page_count > kReserveCapacityPages) return false;
+
+	// Without a reserve, AllocatePage() goes straight to the PMM; nothing to
+	// set aside.
+	CpuReserve* reserve = _current_reserve();
+	if (!reserve) return true;
+
+	if (reserve->count >= page_count && reserve->count >= m_watermarks.low_pages) return true;
+
+	_refill(reserve, page_count > m_watermarks.high_pages ? page_count : m_watermarks.high_pages);
+	if (reserve->count >= page_count) return true;
+	reserve->statistics.reserve_failures++;
+	return false;
+}
+
+Rocinante::Optional<std::uintptr_t> PageTablePagePool::AllocatePage() {
+	if (!m_pmm) return Rocinante::nullopt;
+
+	CpuReserve* reserve = _current_reserve();
+	if (!reserve) {
+		Rocinante::SpinlockGuard guard(&m_lock);
+		return m_pmm->AllocateZeroedPage();
+	}
+
+	if (reserve->count != 0) {
+		reserve->statistics.allocation_hits++;
+		return Rocinante::Optional<std::uintptr_t>(reserve->pages[--reserve->count]);
+	}
+
+	reserve->statistics.allocation_misses++;
+	_refill(reserve, m_watermarks.high_pages);
+	if (reserve->count == 0) return Rocinante::nullopt;
+	return Rocinante::Optional<std::uintptr_t>(reserve->pages[--reserve->count]);
+}
+
+PageTablePagePool::DeferredBatch::DeferredBatch(PageTablePagePool& pool) : m_pool(pool) {
+	CpuReserve* reserve = m_pool._current_reserve();
+	if (!reserve) return;
+
+	Rocinante::SpinlockGuard guard(&m_pool.m_lock);
+	m_id = m_pool.m_next_batch_id++;
+	m_previous_id = reserve->open_batch_id;
+	reserve->open_batch_id = m_id;
+}
+
+PageTablePagePool::DeferredBatch::~DeferredBatch() {
+	if (m_id == 0) return;
+	CpuReserve* reserve = m_pool._current_reserve();
+	if (reserve) reserve->open_batch_id = m_previous_id;
+}
+
+std::size_t PageTablePagePool::DeferredBatch::Reclaim() {
+	// Without a reserve the pages were deferred untagged; only an overflow
+	// flush can prove them unreachable.
+	if (m_id == 0 || !m_pool.m_pmm) return 0;
+
+	CpuReserve* reserve = m_pool._current_reserve();
+	Rocinante::SpinlockGuard guard(&m_pool.m_lock);
+	const std::size_t reclaimed = m_pool._reclaim_batch(reserve, m_id);
+	if (reclaimed != 0 && reserve) reserve->statistics.reclaim_batches++;
+	return reclaimed;
+}
+
+void PageTablePagePool::_recycle(CpuReserve* reserve, std::uintptr_t physical_page_base) {
+	if (reserve && reserve->count < m_watermarks.high_pages) {
+		reserve->pages[reserve->count++] = physical_page_base;
+		return;
+	}
+	(void)m_pmm->FreePage(physical_page_base);
+}
+
+std::size_t PageTablePagePool::_reclaim_batch(CpuReserve* reserve, std::uint64_t batch_id) {
+	// Recycle from the most recently freed end so those (likely cache-hot)
+	// pages land in the reserve first, then compact the other batches' pages.
+	std::size_t reclaimed = 0;
+	for (std::size_t i = m_deferred_count; i-- != 0;) {
+		if (m_deferred[i].batch_id != batch_id) continue;
+		_recycle(reserve, m_deferred[i].physical_page_base);
+		reclaimed++;
+	}
+	if (reclaimed == 0) return 0;
+
+	std::size_t kept = 0;
+	for (std::size_t i = 0; i < m_deferred_count; i++) {
+		if (m_deferred[i].batch_id != batch_id) m_deferred[kept++] = m_deferred[i];
+	}
+	m_deferred_count = kept;
+	return reclaimed;
+}
+
+bool PageTablePagePool::DeferFreePage(std::uintptr_t physical_page_base) {
+	if (!m_pmm) return false;
+
+	CpuReserve* reserve = _current_reserve();
+	if (reserve) reserve->statistics.deferred_pages++;
+	const std::uint64_t batch_id = reserve ? reserve->open_batch_id : 0;
+
+	Rocinante::SpinlockGuard guard(&m_lock);
+	if (m_deferred_count < kDeferredCapacityPages) {
+		m_deferred[m_deferred_count++] = DeferredPage{.physical_page_base = physical_page_base, .batch_id = batch_id};
+		return true;
+	}
+
+	// Nobody has reclaimed in a while. One full local flush covers every
+	// deferred page whatever unmap released it, so all of them (and this
+	// one) can be recycled.
+	if (reserve) reserve->statistics.deferred_overflows++;
+	Rocinante::Memory::PagingHw::InvalidateAllTlbEntries();
+	while (m_deferred_count != 0) {
+		_recycle(reserve, m_deferred[--m_deferred_count].physical_page_base);
+	}
+	_recycle(reserve, physical_page_base);
+	return true;
+}
+
+std::size_t PageTablePagePool::TopUpCurrentCpu() {
+	if (!m_pmm) return 0;
+	CpuReserve* reserve = _current_reserve();
+	if (!reserve) return 0;
+
+	const std::size_t before = reserve->count;
+	_refill(reserve, m_watermarks.high_pages);
+	return reserve->count - before;
+}
+
+void PageTablePagePool::DrainAll() {
+	if (!m_pmm) return;
+	Rocinante::SpinlockGuard guard(&m_lock);
+	for (std::size_t core_id = 0; core_id < kMaxCpuCount; core_id++) {
+		CpuReserve& reserve = m_reserves[core_id];
+		while (reserve.count != 0) {
+			(void)m_pmm->FreePage(reserve.pages[--reserve.count]);
+		}
+	}
+}
+
+std::size_t PageTablePagePool::ReservedPageCount() const {
+	std::size_t total = 0;
+	for (std::size_t core_id = 0; core_id < kMaxCpuCount; core_id++) {
+		total += m_reserves[core_id].count;
+	}
+	return total;
+}
+
+std::size_t PageTablePagePool::ReservedPageCountForCpu(std::size_t core_id) const {
+	if (core_id >= kMaxCpuCount) return 0;
+	return m_reserves[core_id].count;
+}
+
+PageTablePagePool::Statistics PageTablePagePool::StatisticsForCpu(std::size_t core_id) const {
+	if (core_id >= kMaxCpuCount) return Statistics{};
+	return m_reserves[core_id].statistics;
+}
+
+void PageTablePagePool::ResetStatistics() {
+	for (std::size_t core_id = 0; core_id < kMaxCpuCount; core_id++) {
+		m_reserves[core_id].statistics = Statistics{};
+	}
+}
+
+} // namespace Rocinante::Memory
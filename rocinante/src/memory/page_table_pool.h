@@ -0,0 +1,244 @@
+/**
+ * Copyright (C) 2026 Andrew S. Rightenburg
+ * GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <src/helpers/optional.h>
+#include <src/memory/pmm.h>
+#include <src/sp/per_cpu.h>
+#include <src/sp/spinlock.h>
+
+namespace Rocinante::Memory {
+
+/**
+ * @brief Pool of zeroed page-table pages in front of the PMM.
+ *
+ * Paging allocates and releases every table page through this pool once it
+ * is bound to the PMM the walk uses (see Paging's AllocateTablePage()).
+ *
+ * Layers:
+ * - Per-CPU reserves: small stacks of all-zero table pages. A walk calls
+ *   Reserve() with the number of tables it could need before it changes
+ *   anything, so building the path to a leaf takes pages from the reserve
+ *   and cannot run out half-way. A reserve that falls below the low
+ *   watermark is topped back up to the high watermark in one batch.
+ * - Deferred list (under m_lock): tables unlinked by an unmap. The TLB (and
+ *   other CPUs' page walks) may still reference them, so they are only
+ *   reused once the TLB invalidation covering that unmap has completed.
+ *   Each page is tagged with the DeferredBatch open on the releasing CPU,
+ *   and DeferredBatch::Reclaim() recycles only its own pages: an unmap that
+ *   invalidated one address space cannot hand out tables another unmap
+ *   released and has not invalidated yet.
+ *
+ * Page state:
+ * - Pages in a reserve or on the deferred list are *allocated* from the
+ *   PMM's point of view and not counted by PhysicalMemoryManager::FreePages().
+ * - Every page the pool hands out or takes back is all-zero: refills come
+ *   from PhysicalMemoryManager::AllocateZeroedPage() (the idle loop keeps
+ *   that pool pre-zeroed), and Paging only releases tables whose entries are
+ *   all invalid. Neither path clears a page.
+ *
+ * Current limitations (intentional for early bring-up):
+ * - Reserves follow the per-CPU contract documented at
+ *   Rocinante::kMaxCpuCount (src/sp/per_cpu.h).
+ * - There is no IPI-based shootdown yet, so "completed" means the local
+ *   INVTLB sequence has run; callers invoke DeferredBatch::Reclaim()
+ *   themselves.
+ * - Pages released outside any batch (or by a batch that never reclaims)
+ *   wait until the list fills. A full list invalidates the whole local TLB
+ *   (INVTLB op 0x0) and then recycles every deferred page, so no page is
+ *   reused ahead of an invalidation; this is counted as a deferred overflow.
+ */
+class PageTablePagePool final {
+	public:
+		// Pages per CPU reserve. A single walk needs at most level_count - 1
+		// (<= 5) new tables, so this covers several walks between refills.
+		static constexpr std::size_t kReserveCapacityPages = 32;
+
+		static constexpr std::size_t kDefaultLowWatermarkPages = 8;
+		static constexpr std::size_t kDefaultHighWatermarkPages = 16;
+
+		// Tables waiting for their batch to reclaim them. 512 pages = 2 MiB.
+		static constexpr std::size_t kDeferredCapacityPages = 512;
+
+		/**
+		 * @brief Reserve sizing per CPU.
+		 *
+		 * Reserve() refills a reserve that holds fewer than low_pages up to
+		 * high_pages. Requires low_pages <= high_pages, and high_pages in
+		 * [1, kReserveCapacityPages].
+		 */
+		struct Watermarks final {
+			std::size_t low_pages = kDefaultLowWatermarkPages;
+			std::size_t high_pages = kDefaultHighWatermarkPages;
+		};
+
+		/**
+		 * @brief Per-CPU counters for tuning.
+		 *
+		 * - allocation_hits/misses: AllocatePage() served from / not from the
+		 *   reserve. A miss means a walk allocated without reserving first.
+		 * - refill_batches: lock round trips that added at least one page to
+		 *   the reserve (an empty PMM is not counted).
+		 * - reserve_failures: Reserve() calls the PMM could not satisfy.
+		 * - deferred_pages: pages handed to DeferFreePage().
+		 * - deferred_overflows: DeferFreePage() calls that found the deferred
+		 *   list full and flushed the local TLB to empty it.
+		 * - reclaim_batches: DeferredBatch::Reclaim() calls that found pages
+		 *   waiting.
+		 */
+		struct Statistics final {
+			std::uint64_t allocation_hits = 0;
+			std::uint64_t allocation_misses = 0;
+			std::uint64_t refill_batches = 0;
+			std::uint64_t reserve_failures = 0;
+			std::uint64_t deferred_pages = 0;
+			std::uint64_t deferred_overflows = 0;
+			std::uint64_t reclaim_batches = 0;
+		};
+
+		/**
+		 * @brief Scope whose released tables are reclaimed together.
+		 *
+		 * While a batch is open, DeferFreePage() calls on the CPU that opened
+		 * it tag their pages with the batch. The owner unmaps, runs the TLB
+		 * invalidation covering what it unmapped, then calls Reclaim().
+		 * Batches nest: the destructor reopens the batch that was open before.
+		 * Pages a batch never reclaims are left to the overflow flush.
+		 */
+		class DeferredBatch final {
+			public:
+				explicit DeferredBatch(PageTablePagePool& pool);
+				~DeferredBatch();
+				DeferredBatch(const DeferredBatch&) = delete;
+				DeferredBatch& operator=(const DeferredBatch&) = delete;
+				DeferredBatch(DeferredBatch&&) = delete;
+				DeferredBatch& operator=(DeferredBatch&&) = delete;
+
+				/**
+				 * @brief Recycles the pages this batch released so far.
+				 *
+				 * Call only after the TLB invalidation covering the unmaps has
+				 * completed. Pages top the current CPU's reserve up to the high
+				 * watermark; the rest go back to the PMM. Pages of other batches
+				 * stay deferred. Returns the number of pages recycled.
+				 */
+				std::size_t Reclaim();
+
+			private:
+				PageTablePagePool& m_pool;
+				std::uint64_t m_id = 0;
+				std::uint64_t m_previous_id = 0;
+		};
+
+		PageTablePagePool() = default;
+		~PageTablePagePool() = default;
+		PageTablePagePool(const PageTablePagePool&) = delete;
+		PageTablePagePool& operator=(const PageTablePagePool&) = delete;
+		PageTablePagePool(PageTablePagePool&&) = delete;
+		PageTablePagePool& operator=(PageTablePagePool&&) = delete;
+
+		/**
+		 * @brief Binds the pool to a PMM (nullptr unbinds it) and empties it.
+		 *
+		 * Pages held for a previous binding are discarded without being
+		 * returned; call DrainAll() first to give them back. Watermarks are
+		 * reset to defaults; statistics are cleared.
+		 */
+		void Initialize(PhysicalMemoryManager* pmm);
+
+		bool IsInitialized() const { return m_pmm != nullptr; }
+		bool IsBoundTo(const PhysicalMemoryManager* pmm) const { return pmm && m_pmm == pmm; }
+
+		// Returns false (and changes nothing) if the watermarks are out of range.
+		bool SetWatermarks(const Watermarks& watermarks);
+		Watermarks GetWatermarks() const { return m_watermarks; }
+
+		/**
+		 * @brief Guarantees the current CPU's reserve holds page_count pages.
+		 *
+		 * Also refills a reserve below the low watermark up to the high one.
+		 * Returns false if page_count exceeds kReserveCapacityPages or the PMM
+		 * runs out; pages already taken stay in the reserve.
+		 */
+		bool Reserve(std::size_t page_count);
+
+		// Takes one zeroed table page from the current CPU's reserve,
+		// refilling it first if it is empty.
+		Rocinante::Optional<std::uintptr_t> AllocatePage();
+
+		/**
+		 * @brief Queues an unlinked, all-zero table page for reuse.
+		 *
+		 * The page belongs to the DeferredBatch open on the current CPU (if
+		 * any) and is not handed out again before that batch reclaims it or
+		 * an overflow flush does.
+		 */
+		bool DeferFreePage(std::uintptr_t physical_page_base);
+
+		/**
+		 * @brief Refills the current CPU's reserve up to the high watermark.
+		 *
+		 * For the idle loop, so walks rarely refill on their own. Returns the
+		 * number of pages added.
+		 */
+		std::size_t TopUpCurrentCpu();
+
+		/**
+		 * @brief Returns every reserved page on every CPU to the PMM.
+		 *
+		 * Deferred pages are left alone (they still need their batch's
+		 * Reclaim()).
+		 * Only safe while the other CPUs are not using the pool.
+		 */
+		void DrainAll();
+
+		std::size_t ReservedPageCount() const;
+		std::size_t ReservedPageCountForCpu(std::size_t core_id) const;
+		std::size_t DeferredPageCount() const { return m_deferred_count; }
+
+		// Returns a zeroed Statistics for core IDs >= kMaxCpuCount.
+		Statistics StatisticsForCpu(std::size_t core_id) const;
+		void ResetStatistics();
+
+	private:
+		struct alignas(Rocinante::kCacheLineBytes) CpuReserve final {
+			std::uintptr_t pages[kReserveCapacityPages] = {};
+			std::size_t count = 0;
+			// DeferredBatch open on this CPU; 0 when none is.
+			std::uint64_t open_batch_id = 0;
+			Statistics statistics{};
+		};
+
+		struct DeferredPage final {
+			std::uintptr_t physical_page_base = 0;
+			std::uint64_t batch_id = 0;
+		};
+
+		PhysicalMemoryManager* m_pmm = nullptr;
+		Watermarks m_watermarks{};
+		Rocinante::Spinlock m_lock{};
+
+		// Guarded by m_lock.
+		DeferredPage m_deferred[kDeferredCapacityPages] = {};
+		std::size_t m_deferred_count = 0;
+		std::uint64_t m_next_batch_id = 1;
+
+		CpuReserve m_reserves[kMaxCpuCount] = {};
+
+		CpuReserve* _current_reserve();
+		void _refill(CpuReserve* reserve, std::size_t target_count);
+		// Both require m_lock.
+		void _recycle(CpuReserve* reserve, std::uintptr_t physical_page_base);
+		std::size_t _reclaim_batch(CpuReserve* reserve, std::uint64_t batch_id);
+};
+
+// Returns the single canonical page-table page pool for the kernel.
+PageTablePagePool& GetPageTablePagePool();
+
+} // namespace Rocinante::Memory
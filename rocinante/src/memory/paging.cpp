@@ -5,13 +5,13 @@
 
 #include "paging.h"
 
+#include <src/memory/page_table_pool.h>
 #include <src/memory/pmm.h>
 #include <src/memory/paging_state.h>
+#include <src/memory/physmap.h>
 #include <src/memory/virtual_layout.h>
 #include <src/sp/cpucfg.h>
 
-extern "C" void* memset(void* destination, int byte_value, std::size_t byte_count);
-
 namespace Rocinante::Memory::Paging {
 
 namespace {
@@ -26,34 +26,6 @@ bool IsPhysMapLeafMapping(
 	return (virtual_page_base - physmap_base) == physical_page_base;
 }
 
-// LoongArch privileged architecture: CSR.CRMD (Current Mode Information).
-//
-// Spec anchor:
-//   - LoongArch-Vol1-EN.html, Section 5.2 (Virtual Address Space and Address Translation Mode)
-//   - CRMD.DA=1, CRMD.PG=0 => direct address translation mode
-//   - CRMD.DA=0, CRMD.PG=1 => mapped address translation mode
-namespace Csr {
-	constexpr std::uint32_t kCurrentModeInformation = 0x0; // CSR.CRMD
-} // namespace Csr
-
-namespace CurrentModeInformation {
-	constexpr std::uint64_t kDirectAddressingEnable = (1ull << 3u); // CRMD.DA
-	constexpr std::uint64_t kPagingEnable = (1ull << 4u);           // CRMD.PG
-} // namespace CurrentModeInformation
-
-inline std::uint64_t ReadCurrentModeInformation() {
-	std::uint64_t value;
-	asm volatile("csrrd %0, %1" : "=r"(value) : "i"(Csr::kCurrentModeInformation));
-	return value;
-}
-
-inline bool IsMappedAddressTranslationMode() {
-	const std::uint64_t crmd = ReadCurrentModeInformation();
-	const bool direct_addressing = (crmd & CurrentModeInformation::kDirectAddressingEnable) != 0;
-	const bool paging = (crmd & CurrentModeInformation::kPagingEnable) != 0;
-	return (!direct_addressing) && paging;
-}
-
 // Software-walker masking policy:
 //
 // Our PTE encoding places flags in the high bits (e.g. No-Execute at bit 62).
@@ -88,13 +60,13 @@ Rocinante::Memory::Paging::AddressSpaceBits AddressSpaceBitsFromCPUCFG() {
 	};
 }
 
-std::uint64_t MaskFromBits(std::uint8_t bits) {
+constexpr std::uint64_t MaskFromBits(std::uint8_t bits) {
 	if (bits >= 64) return ~0ull;
 	if (bits == 0) return 0;
 	return (1ull << bits) - 1ull;
 }
 
-std::uint8_t LevelCountFromVirtualAddressBits(std::uint8_t virtual_address_bits) {
+constexpr std::uint8_t LevelCountFromVirtualAddressBits(std::uint8_t virtual_address_bits) {
 	const auto offset_bits = static_cast<std::uint32_t>(Rocinante::Memory::Paging::kPageShiftBits);
 	const auto index_bits_per_level = static_cast<std::uint32_t>(Rocinante::Memory::Paging::kIndexBitsPerLevel);
 
@@ -105,7 +77,7 @@ std::uint8_t LevelCountFromVirtualAddressBits(std::uint8_t virtual_address_bits)
 	return static_cast<std::uint8_t>(level_count);
 }
 
-std::uint64_t PhysicalPageBaseMaskFromBits(std::uint8_t physical_address_bits) {
+constexpr std::uint64_t PhysicalPageBaseMaskFromBits(std::uint8_t physical_address_bits) {
 	if (physical_address_bits > kMaxEncodablePhysicalAddressBits) return 0;
 	if (physical_address_bits < Rocinante::Memory::Paging::kPageShiftBits) {
 		return 0;
@@ -134,6 +106,16 @@ std::size_t IndexFromVirtualAddressAtLevel(std::uintptr_t virtual_address, std::
 	return IndexFromVirtualAddress(virtual_address, ShiftBitsForLevel(level));
 }
 
+// Bytes mapped by one leaf entry in a table at `level` (4 KiB at level 0).
+constexpr std::size_t LeafSizeBytesForLevel(std::size_t level) {
+	return std::size_t{1} << ShiftBitsForLevel(level);
+}
+
+// Highest directory level we put huge-page leaves in (1 GiB with 4 KiB pages).
+constexpr std::size_t kMaxHugeLeafLevel = 2;
+static_assert(LeafSizeBytesForLevel(1) == kHugePageSizeBytes2MiB);
+static_assert(LeafSizeBytesForLevel(kMaxHugeLeafLevel) == kHugePageSizeBytes1GiB);
+
 std::uint64_t CacheBitsForMode(CacheMode mode) {
 	return (static_cast<std::uint64_t>(mode) << PteBits::kCacheShift) & PteBits::kCacheMask;
 }
@@ -180,6 +162,17 @@ std::uint64_t EncodeLeafEntry(std::uintptr_t physical_page_base, std::uint64_t p
 	return (static_cast<std::uint64_t>(physical_page_base) & physical_page_base_mask) | LeafFlagsForPermissions(permissions);
 }
 
+// Directory-level leaf: H set, and the global bit moved from bit 6 (which
+// now means H) to HG.
+std::uint64_t EncodeHugeLeafEntry(std::uintptr_t physical_page_base, std::uint64_t physical_page_base_mask, PagePermissions permissions) {
+	std::uint64_t flags = LeafFlagsForPermissions(permissions);
+	if ((flags & PteBits::kGlobal) != 0) {
+		flags &= ~PteBits::kGlobal;
+		flags |= PteBits::kHugeGlobal;
+	}
+	return (static_cast<std::uint64_t>(physical_page_base) & physical_page_base_mask) | flags | PteBits::kHuge;
+}
+
 std::uint64_t EncodeTablePointer(std::uintptr_t physical_page_base, std::uint64_t physical_page_base_mask) {
 	// For non-leaf page-table entries that point to a next-level table, encode:
 	// - aligned physical base
@@ -205,8 +198,38 @@ std::uintptr_t EntryPhysicalPageBase(std::uint64_t entry, std::uint64_t physical
 	return static_cast<std::uintptr_t>(entry & physical_page_base_mask);
 }
 
+// Only meaningful for directory entries (level > 0): in leaf PTEs bit 6 is G.
+bool EntryIsHugeLeaf(std::uint64_t entry) {
+	return (entry & PteBits::kHuge) != 0;
+}
+
+// Strips HG (bit 12) along with the other sub-leaf-size bits.
+std::uintptr_t HugeLeafPhysicalBase(std::uint64_t entry, std::uint64_t physical_page_base_mask, std::size_t level) {
+	return EntryPhysicalPageBase(entry, physical_page_base_mask) & ~(LeafSizeBytesForLevel(level) - 1);
+}
+
+// map_count is tracked per 4 KiB frame, so a huge leaf counts once for every
+// frame it covers.
+bool IncrementMapCountsForLeaf(PhysicalMemoryManager* pmm, std::uintptr_t physical_base, std::size_t size_bytes) {
+	for (std::size_t offset = 0; offset < size_bytes; offset += kPageSizeBytes) {
+		if (pmm->IncrementMapCountForPhysical(physical_base + offset)) continue;
+		for (std::size_t undo = 0; undo < offset; undo += kPageSizeBytes) {
+			(void)pmm->DecrementMapCountForPhysical(physical_base + undo);
+		}
+		return false;
+	}
+	return true;
+}
+
+bool DecrementMapCountsForLeaf(PhysicalMemoryManager* pmm, std::uintptr_t physical_base, std::size_t size_bytes) {
+	for (std::size_t offset = 0; offset < size_bytes; offset += kPageSizeBytes) {
+		if (!pmm->DecrementMapCountForPhysical(physical_base + offset)) return false;
+	}
+	return true;
+}
+
 PageTablePage* PageTablePageFromPhysical(std::uintptr_t physical_page_base) {
-	if (!IsMappedAddressTranslationMode()) {
+	if (!Rocinante::Memory::Physmap::IsMappedAddressTranslationMode()) {
 		// Direct-address mode: physical address equals (low bits of) virtual address.
 		return reinterpret_cast<PageTablePage*>(physical_page_base);
 	}
@@ -223,7 +246,7 @@ PageTablePage* PageTablePageFromPhysical(std::uintptr_t physical_page_base) {
 }
 
 const PageTablePage* PageTablePageFromPhysicalConst(std::uintptr_t physical_page_base) {
-	if (!IsMappedAddressTranslationMode()) {
+	if (!Rocinante::Memory::Physmap::IsMappedAddressTranslationMode()) {
 		return reinterpret_cast<const PageTablePage*>(physical_page_base);
 	}
 
@@ -236,6 +259,73 @@ const PageTablePage* PageTablePageFromPhysicalConst(std::uintptr_t physical_page
 	return reinterpret_cast<const PageTablePage*>(physmap_virtual);
 }
 
+// New tables must start with every entry invalid (zero).
+//
+// Policy:
+// - If the kernel page-table page pool is bound to this PMM, take a table
+//   from the current CPU's reserve: pool pages are already all-zero.
+// - Otherwise use the PMM's pre-zeroed pool.
+Rocinante::Optional<std::uintptr_t> AllocateTablePage(PhysicalMemoryManager* pmm) {
+	auto& pool = Rocinante::Memory::GetPageTablePagePool();
+	if (pool.IsBoundTo(pmm)) return pool.AllocatePage();
+	return pmm->AllocateZeroedPage();
+}
+
+// Callers only release tables whose entries are all zero. With the pool
+// bound, the page waits on its deferred list until the caller's TLB
+// invalidation is done (PageTablePagePool::DeferredBatch::Reclaim()).
+bool ReleaseTablePage(PhysicalMemoryManager* pmm, std::uintptr_t table_physical_base) {
+	auto& pool = Rocinante::Memory::GetPageTablePagePool();
+	if (pool.IsBoundTo(pmm)) return pool.DeferFreePage(table_physical_base);
+	return pmm->FreePage(table_physical_base);
+}
+
+// Sets aside the `table_count` tables a walk may create before it changes
+// anything, so it cannot fail half-way for lack of a table page. Without the
+// pool there is nothing to set aside.
+bool ReserveTablePages(PhysicalMemoryManager* pmm, std::size_t table_count) {
+	auto& pool = Rocinante::Memory::GetPageTablePagePool();
+	if (table_count == 0 || !pool.IsBoundTo(pmm)) return true;
+	return pool.Reserve(table_count);
+}
+
+// Replaces the huge leaf at `table->entries[index]` (a level `level` entry)
+// with a new table of next-smaller leaves covering the same physical range
+// with the same attributes. Translations and map counts do not change, so no
+// TLB maintenance is needed.
+bool SplitHugeLeaf(
+	PhysicalMemoryManager* pmm,
+	PageTablePage* table,
+	std::size_t index,
+	std::size_t level,
+	std::uint64_t physical_page_base_mask
+) {
+	const std::uint64_t entry = table->entries[index];
+	const auto child_page = AllocateTablePage(pmm);
+	if (!child_page.has_value()) return false;
+	const std::uintptr_t child_physical_base = child_page.value();
+	if (!IsPageAligned(child_physical_base)) return false;
+	auto* child = PageTablePageFromPhysical(child_physical_base);
+
+	const std::uintptr_t physical_base = HugeLeafPhysicalBase(entry, physical_page_base_mask, level);
+	const bool global = (entry & PteBits::kHugeGlobal) != 0;
+	std::uint64_t flags = entry & ~physical_page_base_mask;
+	if (level == 1) {
+		// Children are ordinary PTEs: bit 6 goes back to meaning G.
+		flags &= ~PteBits::kHuge;
+		if (global) flags |= PteBits::kGlobal;
+	} else if (global) {
+		flags |= PteBits::kHugeGlobal;
+	}
+
+	const std::size_t child_size_bytes = LeafSizeBytesForLevel(level - 1);
+	for (std::size_t i = 0; i < kEntriesPerTable; i++) {
+		child->entries[i] = static_cast<std::uint64_t>(physical_base + (i * child_size_bytes)) | flags;
+	}
+	table->entries[index] = EncodeTablePointer(child_physical_base, physical_page_base_mask);
+	return true;
+}
+
 bool EnsureNextLevelTable(
 	PhysicalMemoryManager* pmm,
 	PageTablePage* current_table,
@@ -247,20 +337,19 @@ bool EnsureNextLevelTable(
 
 	std::uint64_t entry = current_table->entries[index];
 	if (EntryIsPresent(entry)) {
-		// This software builder/walker does not support huge pages yet.
-		// In the privileged spec, bit 6 set in a directory entry indicates a huge-page entry.
-		if ((entry & PteBits::kGlobal) != 0) return false;
+		// A huge-page leaf already maps this whole range.
+		if (EntryIsHugeLeaf(entry)) return false;
 		*out_next_table = PageTablePageFromPhysical(EntryPhysicalPageBase(entry, physical_page_base_mask));
 		return true;
 	}
 
-	const auto new_table_page = pmm->AllocatePage();
+	// Comes back zeroed, usually without a clear on this path.
+	const auto new_table_page = AllocateTablePage(pmm);
 	if (!new_table_page.has_value()) return false;
 	const std::uintptr_t new_table_physical_base = new_table_page.value();
 	if (!IsPageAligned(new_table_physical_base)) return false;
 
 	auto* new_table = PageTablePageFromPhysical(new_table_physical_base);
-	(void)memset(new_table, 0, sizeof(PageTablePage));
 
 	current_table->entries[index] = EncodeTablePointer(new_table_physical_base, physical_page_base_mask);
 	*out_next_table = new_table;
@@ -300,7 +389,32 @@ Rocinante::Optional<Layout> BuildLayout(AddressSpaceBits address_bits) {
 	};
 }
 
-bool ValidateVirtualAddress(std::uintptr_t virtual_address, const Layout& layout) {
+// Layout with the level count and physical masks fixed at compile time, for
+// the specialized walkers. VALEN stays a run-time value: it only feeds the
+// canonical-address check, and several widths share one level count.
+template <std::uint8_t kLevelCount, std::uint8_t kPhysicalAddressBits>
+struct FixedLayout final {
+	static_assert(kLevelCount > 0 && kLevelCount <= kMaxSupportedLevelCount);
+	static_assert(PhysicalPageBaseMaskFromBits(kPhysicalAddressBits) != 0);
+
+	static constexpr std::uint8_t level_count = kLevelCount;
+	static constexpr std::uint8_t physical_address_bits = kPhysicalAddressBits;
+	static constexpr std::uint64_t physical_address_mask = MaskFromBits(kPhysicalAddressBits);
+	static constexpr std::uint64_t physical_page_base_mask = PhysicalPageBaseMaskFromBits(kPhysicalAddressBits);
+
+	std::uint8_t virtual_address_bits;
+	std::uint64_t virtual_address_low_mask;
+
+	static FixedLayout FromAddressBits(AddressSpaceBits address_bits) {
+		return FixedLayout{
+			.virtual_address_bits = address_bits.virtual_address_bits,
+			.virtual_address_low_mask = MaskFromBits(address_bits.virtual_address_bits),
+		};
+	}
+};
+
+template <typename LayoutT>
+bool ValidateVirtualAddress(std::uintptr_t virtual_address, const LayoutT& layout) {
 	// LoongArch LA64 uses canonical virtual addresses in mapped address translation mode.
 	//
 	// Given N valid virtual address bits, the CPU expects bits [63:N] to be a sign
@@ -322,231 +436,347 @@ bool ValidateVirtualAddress(std::uintptr_t virtual_address, const Layout& layout
 	return sign ? (upper == upper_mask) : (upper == 0);
 }
 
-bool ValidatePhysicalAddress(std::uintptr_t physical_address, const Layout& layout) {
+template <typename LayoutT>
+bool ValidatePhysicalAddress(std::uintptr_t physical_address, const LayoutT& layout) {
 	return (static_cast<std::uint64_t>(physical_address) & ~layout.physical_address_mask) == 0;
 }
 
-bool FreeAllPageTablesRecursive(
+// Descends from the root to the table at `level`, allocating missing
+// intermediate tables on the way.
+template <typename LayoutT>
+bool EnsureTableAtLevel(
 	PhysicalMemoryManager* pmm,
-	std::uintptr_t table_physical_base,
-	const Layout& layout,
+	const PageTableRoot& root,
+	std::uintptr_t virtual_address,
 	std::size_t level,
-	bool* out_had_global_leaf_mappings
+	const LayoutT& layout,
+	PageTablePage** out_table
 ) {
-	if (!pmm) return false;
-	if (!IsPageAligned(table_physical_base)) return false;
-
-	auto* table = PageTablePageFromPhysical(table_physical_base);
+	auto* table = PageTablePageFromPhysical(root.root_physical_address);
 	if (!table) return false;
+	if (!ReserveTablePages(pmm, static_cast<std::size_t>(layout.level_count - 1) - level)) return false;
 
-	// For non-leaf levels, directory entries point at lower-level tables.
-	// This walker does not support huge-page directory entries.
-	if (level > 0) {
-		for (std::size_t i = 0; i < kEntriesPerTable; i++) {
-			const std::uint64_t entry = table->entries[i];
-			if (!EntryIsPresent(entry)) continue;
-
-			// In the LoongArch privileged spec, bit 6 set in a directory entry
-			// indicates a huge-page mapping. We do not support huge pages yet.
-			if ((entry & PteBits::kGlobal) != 0) return false;
-
-			const std::uintptr_t child_physical = EntryPhysicalPageBase(entry, layout.physical_page_base_mask);
-			if (!FreeAllPageTablesRecursive(pmm, child_physical, layout, level - 1, out_had_global_leaf_mappings)) return false;
-			table->entries[i] = 0;
-		}
-	} else {
-		// Leaf PTEs map physical frames. We intentionally do not free those frames
-		// here; we only decrement their map_count and free the page-table page.
-		for (std::size_t i = 0; i < kEntriesPerTable; i++) {
-			const std::uint64_t entry = table->entries[i];
-			if (!EntryIsPresent(entry)) continue;
-
-			if (out_had_global_leaf_mappings && ((entry & PteBits::kGlobal) != 0)) {
-				*out_had_global_leaf_mappings = true;
-			}
-
-			const std::uintptr_t mapped_physical = EntryPhysicalPageBase(entry, layout.physical_page_base_mask);
-			if (!pmm->DecrementMapCountForPhysical(mapped_physical)) return false;
-			table->entries[i] = 0;
-		}
+	for (auto current = static_cast<std::size_t>(layout.level_count - 1); current > level; current--) {
+		const std::size_t index = IndexFromVirtualAddressAtLevel(virtual_address, current);
+		PageTablePage* next_table = nullptr;
+		if (!EnsureNextLevelTable(pmm, table, index, &next_table, layout.physical_page_base_mask)) return false;
+		table = next_table;
+		if (!table) return false;
 	}
-	return pmm->FreePage(table_physical_base);
-}
-
-} // namespace
-
-Rocinante::Optional<PageTableRoot> AllocateRootPageTable(PhysicalMemoryManager* pmm) {
-	if (!pmm) return Rocinante::nullopt;
-	const auto page = pmm->AllocatePage();
-	if (!page.has_value()) return Rocinante::nullopt;
-
-	const std::uintptr_t root_physical_base = page.value();
-	if (!IsPageAligned(root_physical_base)) return Rocinante::nullopt;
-
-	auto* root = PageTablePageFromPhysical(root_physical_base);
-	(void)memset(root, 0, sizeof(PageTablePage));
-
-	return PageTableRoot{.root_physical_address = root_physical_base};
+	*out_table = table;
+	return true;
 }
 
-bool FreeAllPageTables4KiB(
+// Writes a leaf for `level` (a 4 KiB PTE at level 0, a huge-page leaf above)
+// into an empty slot and counts the mapping.
+template <typename LayoutT>
+bool InstallLeaf(
 	PhysicalMemoryManager* pmm,
-	const PageTableRoot& root,
+	PageTablePage* table,
+	std::size_t level,
+	std::uintptr_t virtual_address,
+	std::uintptr_t physical_address,
+	PagePermissions permissions,
+	const LayoutT& layout,
 	AddressSpaceBits address_bits
 ) {
-	return FreeAllPageTables4KiB(pmm, root, address_bits, nullptr);
+	const std::size_t index = IndexFromVirtualAddressAtLevel(virtual_address, level);
+	if (EntryIsPresent(table->entries[index])) return false;
+
+	table->entries[index] = (level == 0)
+		? EncodeLeafEntry(physical_address, layout.physical_page_base_mask, permissions)
+		: EncodeHugeLeafEntry(physical_address, layout.physical_page_base_mask, permissions);
+	if (!IsPhysMapLeafMapping(virtual_address, physical_address, address_bits)) {
+		if (!IncrementMapCountsForLeaf(pmm, physical_address, LeafSizeBytesForLevel(level))) {
+			table->entries[index] = 0;
+			return false;
+		}
+	}
+	return true;
 }
 
-bool FreeAllPageTables4KiB(
-	PhysicalMemoryManager* pmm,
-	const PageTableRoot& root,
-	AddressSpaceBits address_bits,
-	bool* out_had_global_leaf_mappings
-) {
-	if (!pmm) return false;
-	if (out_had_global_leaf_mappings) *out_had_global_leaf_mappings = false;
-	const auto layout_opt = BuildLayout(address_bits);
-	if (!layout_opt.has_value()) return false;
-	const Layout layout = layout_opt.value();
-	if (layout.level_count == 0) return false;
-	if (layout.level_count > kMaxSupportedLevelCount) return false;
+// Rejects ranges that wrap or leave the canonical half they start in; the
+// walkers below index tables from the address bits alone.
+bool ValidateVirtualRange(std::uintptr_t virtual_base, std::size_t size_bytes, const Layout& layout) {
+	if (!ValidateVirtualAddress(virtual_base, layout)) return false;
+	if (size_bytes == 0) return true;
+	const std::uintptr_t virtual_last = virtual_base + (size_bytes - 1);
+	if (virtual_last < virtual_base) return false;
+	if (!ValidateVirtualAddress(virtual_last, layout)) return false;
+	if (layout.virtual_address_bits >= 64) return true;
+	const std::uint64_t sign_bit = (1ull << (layout.virtual_address_bits - 1u));
+	return ((virtual_base ^ virtual_last) & sign_bit) == 0;
+}
 
-	if (root.root_physical_address == 0) return false;
-	if (!IsPageAligned(root.root_physical_address)) return false;
+// State shared by every level of one range walk.
+struct RangeWalk final {
+	PhysicalMemoryManager* pmm;
+	const Layout* layout;
+	AddressSpaceBits address_bits;
+	PagePermissions permissions;
+	bool huge_leaves;
+};
 
-	return FreeAllPageTablesRecursive(
-		pmm,
-		root.root_physical_address,
-		layout,
-		static_cast<std::size_t>(layout.level_count - 1),
-		out_had_global_leaf_mappings);
+// Bytes of [virtual_address, virtual_address + remaining_bytes) that fall
+// under the entry of `level` containing virtual_address.
+std::size_t ChunkBytesForEntry(std::uintptr_t virtual_address, std::size_t remaining_bytes, std::size_t level) {
+	const std::size_t entry_span_bytes = LeafSizeBytesForLevel(level);
+	const std::size_t chunk_bytes = entry_span_bytes - (virtual_address & (entry_span_bytes - 1));
+	return chunk_bytes < remaining_bytes ? chunk_bytes : remaining_bytes;
 }
 
-bool MapRange4KiB(
-	PhysicalMemoryManager* pmm,
-	const PageTableRoot& root,
-	std::uintptr_t virtual_base,
-	std::uintptr_t physical_base,
-	std::size_t size_bytes,
-	PagePermissions permissions
+// Maps the part of a range that lies under `table`, descending into (or
+// creating) each child table once and filling consecutive entries of the
+// leaf table in a single pass.
+bool MapRangeInTable(
+	const RangeWalk& walk,
+	PageTablePage* table,
+	std::size_t level,
+	std::uintptr_t virtual_address,
+	std::uintptr_t physical_address,
+	std::size_t size_bytes
 ) {
-	return MapRange4KiB(
-		pmm,
-		root,
-		virtual_base,
-		physical_base,
-		size_bytes,
-		permissions,
-		AddressSpaceBitsFromCPUCFG()
-	);
+	while (size_bytes > 0) {
+		const std::size_t chunk_bytes = ChunkBytesForEntry(virtual_address, size_bytes, level);
+
+		bool install_leaf = (level == 0);
+		if (!install_leaf && walk.huge_leaves && level <= kMaxHugeLeafLevel) {
+			// The whole entry is covered (so the VA is aligned); the PA must be
+			// too, and a directory that already points at a table keeps its
+			// smaller leaves.
+			const std::size_t index = IndexFromVirtualAddressAtLevel(virtual_address, level);
+			install_leaf = chunk_bytes == LeafSizeBytesForLevel(level)
+				&& (physical_address & (chunk_bytes - 1)) == 0
+				&& !EntryIsPresent(table->entries[index]);
+		}
+
+		if (install_leaf) {
+			if (!InstallLeaf(walk.pmm, table, level, virtual_address, physical_address, walk.permissions, *walk.layout, walk.address_bits)) return false;
+		} else {
+			PageTablePage* child = nullptr;
+			const std::size_t index = IndexFromVirtualAddressAtLevel(virtual_address, level);
+			// Enough for the whole path down to a leaf table.
+			if (!EntryIsPresent(table->entries[index]) && !ReserveTablePages(walk.pmm, level)) return false;
+			if (!EnsureNextLevelTable(walk.pmm, table, index, &child, walk.layout->physical_page_base_mask)) return false;
+			if (!child) return false;
+			if (!MapRangeInTable(walk, child, level - 1, virtual_address, physical_address, chunk_bytes)) return false;
+		}
+
+		virtual_address += chunk_bytes;
+		physical_address += chunk_bytes;
+		size_bytes -= chunk_bytes;
+	}
+	return true;
 }
 
-bool MapRange4KiB(
+bool MapRangeFromRoot(
 	PhysicalMemoryManager* pmm,
 	const PageTableRoot& root,
 	std::uintptr_t virtual_base,
 	std::uintptr_t physical_base,
 	std::size_t size_bytes,
 	PagePermissions permissions,
-	AddressSpaceBits address_bits
+	AddressSpaceBits address_bits,
+	bool huge_leaves
 ) {
 	if (!pmm) return false;
 	const auto layout_opt = BuildLayout(address_bits);
 	if (!layout_opt.has_value()) return false;
 	const Layout layout = layout_opt.value();
 
+	if (root.root_physical_address == 0) return false;
 	if (!IsPageAligned(virtual_base)) return false;
 	if (!IsPageAligned(physical_base)) return false;
 	if ((size_bytes % kPageSizeBytes) != 0) return false;
-	if (!ValidateVirtualAddress(virtual_base, layout)) return false;
+	if (!ValidateVirtualRange(virtual_base, size_bytes, layout)) return false;
 	if (!ValidatePhysicalAddress(physical_base, layout)) return false;
+	if (size_bytes != 0 && !ValidatePhysicalAddress(physical_base + (size_bytes - 1), layout)) return false;
 
-	for (std::size_t offset = 0; offset < size_bytes; offset += kPageSizeBytes) {
-		const std::uintptr_t virtual_address = virtual_base + offset;
-		const std::uintptr_t physical_address = physical_base + offset;
-		if (!MapPage4KiB(pmm, root, virtual_address, physical_address, permissions, address_bits)) {
-			return false;
-		}
+	auto* root_table = PageTablePageFromPhysical(root.root_physical_address);
+	if (!root_table) return false;
+
+	const RangeWalk walk{
+		.pmm = pmm,
+		.layout = &layout,
+		.address_bits = address_bits,
+		.permissions = permissions,
+		.huge_leaves = huge_leaves,
+	};
+	return MapRangeInTable(walk, root_table, static_cast<std::size_t>(layout.level_count - 1), virtual_base, physical_base, size_bytes);
+}
+
+// Clears the leaf at `index` (a 4 KiB PTE at level 0, a huge-page leaf
+// above) and drops its map counts.
+bool RemoveLeaf(const RangeWalk& walk, PageTablePage* table, std::size_t index, std::size_t level, std::uintptr_t virtual_address) {
+	const std::uint64_t entry = table->entries[index];
+	const std::uintptr_t mapped_physical = (level == 0)
+		? EntryPhysicalPageBase(entry, walk.layout->physical_page_base_mask)
+		: HugeLeafPhysicalBase(entry, walk.layout->physical_page_base_mask, level);
+	if (!IsPhysMapLeafMapping(virtual_address, mapped_physical, walk.address_bits)) {
+		if (!DecrementMapCountsForLeaf(walk.pmm, mapped_physical, LeafSizeBytesForLevel(level))) return false;
 	}
+	table->entries[index] = 0;
+	return true;
+}
+
+// Unmaps the part of a range that lies under `table`. Child tables left
+// empty are released on the way back up, so the range costs one walk.
+bool UnmapRangeInTable(
+	const RangeWalk& walk,
+	PageTablePage* table,
+	std::size_t level,
+	std::uintptr_t virtual_address,
+	std::size_t size_bytes
+) {
+	while (size_bytes > 0) {
+		const std::size_t chunk_bytes = ChunkBytesForEntry(virtual_address, size_bytes, level);
+		const std::size_t index = IndexFromVirtualAddressAtLevel(virtual_address, level);
+		const std::uint64_t entry = table->entries[index];
+
+		if (EntryIsPresent(entry)) {
+			const bool leaf = (level == 0) || EntryIsHugeLeaf(entry);
+			if (leaf && chunk_bytes == LeafSizeBytesForLevel(level)) {
+				if (!RemoveLeaf(walk, table, index, level, virtual_address)) return false;
+			} else {
+				// Only part of a huge leaf goes away: split it and unmap
+				// the covered part of the new table.
+				if (leaf) {
+					// Splits below this one may need a table per level.
+					if (!ReserveTablePages(walk.pmm, level)) return false;
+					if (!SplitHugeLeaf(walk.pmm, table, index, level, walk.layout->physical_page_base_mask)) return false;
+				}
+
+				const std::uintptr_t child_physical = EntryPhysicalPageBase(table->entries[index], walk.layout->physical_page_base_mask);
+				auto* child = PageTablePageFromPhysical(child_physical);
+				if (!child) return false;
+				if (!UnmapRangeInTable(walk, child, level - 1, virtual_address, chunk_bytes)) return false;
+
+				// A fully covered child is empty without looking.
+				if (chunk_bytes == LeafSizeBytesForLevel(level) || TableIsEmpty(child)) {
+					if (!ReleaseTablePage(walk.pmm, child_physical)) return false;
+					table->entries[index] = 0;
+				}
+			}
+		}
 
+		virtual_address += chunk_bytes;
+		size_bytes -= chunk_bytes;
+	}
 	return true;
 }
 
-bool MapPage4KiB(
+// Sign-extends a virtual address assembled from table indices, so entries in
+// the upper half of the root land in the canonical high half.
+std::uintptr_t CanonicalVirtualAddress(std::uintptr_t virtual_address, std::uint8_t virtual_address_bits) {
+	if (virtual_address_bits == 0 || virtual_address_bits >= 64) return virtual_address;
+	const std::uintptr_t sign_bit = std::uintptr_t{1} << (virtual_address_bits - 1);
+	if ((virtual_address & sign_bit) == 0) return virtual_address;
+	return virtual_address | ~((sign_bit << 1) - 1);
+}
+
+// `table_virtual_base` is the first virtual address `table` translates.
+bool FreeAllPageTablesRecursive(
 	PhysicalMemoryManager* pmm,
-	const PageTableRoot& root,
-	std::uintptr_t virtual_address,
-	std::uintptr_t physical_address,
-	PagePermissions permissions
+	std::uintptr_t table_physical_base,
+	std::uintptr_t table_virtual_base,
+	const Layout& layout,
+	AddressSpaceBits address_bits,
+	std::size_t level,
+	bool* out_had_global_leaf_mappings
 ) {
-	return MapPage4KiB(
-		pmm,
-		root,
-		virtual_address,
-		physical_address,
-		permissions,
-		AddressSpaceBitsFromCPUCFG()
-	);
+	if (!pmm) return false;
+	if (!IsPageAligned(table_physical_base)) return false;
+
+	auto* table = PageTablePageFromPhysical(table_physical_base);
+	if (!table) return false;
+
+	// For non-leaf levels, directory entries point at lower-level tables or
+	// are huge-page leaves.
+	if (level > 0) {
+		for (std::size_t i = 0; i < kEntriesPerTable; i++) {
+			const std::uint64_t entry = table->entries[i];
+			if (!EntryIsPresent(entry)) continue;
+
+			const std::uintptr_t entry_virtual_base = CanonicalVirtualAddress(
+				table_virtual_base + (i * LeafSizeBytesForLevel(level)), address_bits.virtual_address_bits);
+
+			if (EntryIsHugeLeaf(entry)) {
+				if (out_had_global_leaf_mappings && ((entry & PteBits::kHugeGlobal) != 0)) {
+					*out_had_global_leaf_mappings = true;
+				}
+				// Physmap leaves never counted their frames (see InstallLeaf()).
+				const std::uintptr_t mapped_physical = HugeLeafPhysicalBase(entry, layout.physical_page_base_mask, level);
+				if (!IsPhysMapLeafMapping(entry_virtual_base, mapped_physical, address_bits)) {
+					if (!DecrementMapCountsForLeaf(pmm, mapped_physical, LeafSizeBytesForLevel(level))) return false;
+				}
+				table->entries[i] = 0;
+				continue;
+			}
+
+			const std::uintptr_t child_physical = EntryPhysicalPageBase(entry, layout.physical_page_base_mask);
+			if (!FreeAllPageTablesRecursive(
+					pmm, child_physical, entry_virtual_base, layout, address_bits, level - 1, out_had_global_leaf_mappings)) {
+				return false;
+			}
+			table->entries[i] = 0;
+		}
+	} else {
+		// Leaf PTEs map physical frames. We intentionally do not free those frames
+		// here; we only decrement their map_count and free the page-table page.
+		for (std::size_t i = 0; i < kEntriesPerTable; i++) {
+			const std::uint64_t entry = table->entries[i];
+			if (!EntryIsPresent(entry)) continue;
+
+			if (out_had_global_leaf_mappings && ((entry & PteBits::kGlobal) != 0)) {
+				*out_had_global_leaf_mappings = true;
+			}
+
+			const std::uintptr_t mapped_physical = EntryPhysicalPageBase(entry, layout.physical_page_base_mask);
+			const std::uintptr_t entry_virtual_base = table_virtual_base + (i * kPageSizeBytes);
+			// As for huge leaves above: physmap PTEs hold no map count.
+			if (!IsPhysMapLeafMapping(entry_virtual_base, mapped_physical, address_bits)) {
+				if (!pmm->DecrementMapCountForPhysical(mapped_physical)) return false;
+			}
+			table->entries[i] = 0;
+		}
+	}
+	return ReleaseTablePage(pmm, table_physical_base);
 }
 
-bool MapPage4KiB(
+// Single-page walkers, written once over the layout type. With a FixedLayout
+// the level loops have a constant trip count and every mask is an immediate,
+// so the compiler unrolls the walk.
+template <typename LayoutT>
+bool MapPage4KiBWithLayout(
 	PhysicalMemoryManager* pmm,
 	const PageTableRoot& root,
 	std::uintptr_t virtual_address,
 	std::uintptr_t physical_address,
 	PagePermissions permissions,
+	const LayoutT& layout,
 	AddressSpaceBits address_bits
 ) {
 	if (!pmm) return false;
-	const auto layout_opt = BuildLayout(address_bits);
-	if (!layout_opt.has_value()) return false;
-	const Layout layout = layout_opt.value();
-
 	if (root.root_physical_address == 0) return false;
 	if (!ValidateVirtualAddress(virtual_address, layout)) return false;
 	if (!ValidatePhysicalAddress(physical_address, layout)) return false;
 	if (!IsPageAligned(virtual_address)) return false;
 	if (!IsPageAligned(physical_address)) return false;
 
-	auto* table = PageTablePageFromPhysical(root.root_physical_address);
-	if (!table) return false;
-
-	for (auto level = static_cast<std::size_t>(layout.level_count - 1); level > 0; level--) {
-		const std::size_t index = IndexFromVirtualAddressAtLevel(virtual_address, level);
-		PageTablePage* next_table = nullptr;
-		if (!EnsureNextLevelTable(pmm, table, index, &next_table, layout.physical_page_base_mask)) return false;
-		table = next_table;
-		if (!table) return false;
-	}
-
-	const std::size_t leaf_index = IndexFromVirtualAddressAtLevel(virtual_address, 0);
-	if (EntryIsPresent(table->entries[leaf_index])) return false;
-
-	table->entries[leaf_index] = EncodeLeafEntry(physical_address, layout.physical_page_base_mask, permissions);
-	if (!IsPhysMapLeafMapping(virtual_address, physical_address, address_bits)) {
-		if (!pmm->IncrementMapCountForPhysical(physical_address)) {
-			table->entries[leaf_index] = 0;
-			return false;
-		}
-	}
-	return true;
-}
-
-bool UnmapPage4KiB(PhysicalMemoryManager* pmm, const PageTableRoot& root, std::uintptr_t virtual_address) {
-	return UnmapPage4KiB(
-		pmm,
-		root,
-		virtual_address,
-		AddressSpaceBitsFromCPUCFG()
-	);
+	PageTablePage* table = nullptr;
+	if (!EnsureTableAtLevel(pmm, root, virtual_address, 0, layout, &table)) return false;
+	return InstallLeaf(pmm, table, 0, virtual_address, physical_address, permissions, layout, address_bits);
 }
 
-bool UnmapPage4KiB(PhysicalMemoryManager* pmm, const PageTableRoot& root, std::uintptr_t virtual_address, AddressSpaceBits address_bits) {
+template <typename LayoutT>
+bool UnmapPage4KiBWithLayout(
+	PhysicalMemoryManager* pmm,
+	const PageTableRoot& root,
+	std::uintptr_t virtual_address,
+	const LayoutT& layout,
+	AddressSpaceBits address_bits
+) {
 	if (!pmm) return false;
-	const auto layout_opt = BuildLayout(address_bits);
-	if (!layout_opt.has_value()) return false;
-	const Layout layout = layout_opt.value();
-
 	if (root.root_physical_address == 0) return false;
 	if (!ValidateVirtualAddress(virtual_address, layout)) return false;
 	if (!IsPageAligned(virtual_address)) return false;
@@ -566,11 +796,15 @@ bool UnmapPage4KiB(PhysicalMemoryManager* pmm, const PageTableRoot& root, std::u
 	for (auto level = static_cast<std::size_t>(layout.level_count - 1); level > 0; level--) {
 		const std::size_t index = IndexFromVirtualAddressAtLevel(virtual_address, level);
 		child_index_by_level[level] = index;
-		const std::uint64_t entry = table->entries[index];
-		// This software walker does not yet support huge pages. In the LoongArch
-		// privileged spec, bit 6 being set in a directory entry indicates a huge-page mapping.
-		if ((entry & PteBits::kGlobal) != 0) return false;
+		std::uint64_t entry = table->entries[index];
 		if (!EntryIsPresent(entry)) return false;
+		if (EntryIsHugeLeaf(entry)) {
+			// Carve the page out of the huge leaf, then keep walking down;
+			// every level from here to the leaf gets a new table.
+			if (!ReserveTablePages(pmm, level)) return false;
+			if (!SplitHugeLeaf(pmm, table, index, level, layout.physical_page_base_mask)) return false;
+			entry = table->entries[index];
+		}
 		const std::uintptr_t next_physical = EntryPhysicalPageBase(entry, layout.physical_page_base_mask);
 		table = PageTablePageFromPhysical(next_physical);
 		if (!table) return false;
@@ -600,7 +834,7 @@ bool UnmapPage4KiB(PhysicalMemoryManager* pmm, const PageTableRoot& root, std::u
 
 		const std::uintptr_t current_physical = physical_by_level[level];
 		if (current_physical == 0) return false;
-		if (!pmm->FreePage(current_physical)) return false;
+		if (!ReleaseTablePage(pmm, current_physical)) return false;
 
 		PageTablePage* parent = tables_by_level[level + 1];
 		if (!parent) return false;
@@ -609,19 +843,12 @@ bool UnmapPage4KiB(PhysicalMemoryManager* pmm, const PageTableRoot& root, std::u
 	return true;
 }
 
-Rocinante::Optional<std::uintptr_t> Translate(const PageTableRoot& root, std::uintptr_t virtual_address) {
-	return Translate(
-		root,
-		virtual_address,
-		AddressSpaceBitsFromCPUCFG()
-	);
-}
-
-Rocinante::Optional<std::uintptr_t> Translate(const PageTableRoot& root, std::uintptr_t virtual_address, AddressSpaceBits address_bits) {
-	const auto layout_opt = BuildLayout(address_bits);
-	if (!layout_opt.has_value()) return Rocinante::nullopt;
-	const Layout layout = layout_opt.value();
-
+template <typename LayoutT>
+Rocinante::Optional<std::uintptr_t> TranslateWithLayout(
+	const PageTableRoot& root,
+	std::uintptr_t virtual_address,
+	const LayoutT& layout
+) {
 	if (root.root_physical_address == 0) return Rocinante::nullopt;
 	if (!ValidateVirtualAddress(virtual_address, layout)) return Rocinante::nullopt;
 
@@ -631,10 +858,11 @@ Rocinante::Optional<std::uintptr_t> Translate(const PageTableRoot& root, std::ui
 	for (auto level = static_cast<std::size_t>(layout.level_count - 1); level > 0; level--) {
 		const std::size_t index = IndexFromVirtualAddressAtLevel(virtual_address, level);
 		const std::uint64_t entry = table->entries[index];
-		// This software walker does not yet support huge pages. In the LoongArch
-		// privileged spec, bit 6 being set in a directory entry indicates a huge-page mapping.
-		if ((entry & PteBits::kGlobal) != 0) return Rocinante::nullopt;
 		if (!EntryIsPresent(entry)) return Rocinante::nullopt;
+		if (EntryIsHugeLeaf(entry)) {
+			const std::uintptr_t offset = virtual_address & (LeafSizeBytesForLevel(level) - 1);
+			return HugeLeafPhysicalBase(entry, layout.physical_page_base_mask, level) + offset;
+		}
 		table = PageTablePageFromPhysicalConst(EntryPhysicalPageBase(entry, layout.physical_page_base_mask));
 		if (!table) return Rocinante::nullopt;
 	}
@@ -648,4 +876,500 @@ Rocinante::Optional<std::uintptr_t> Translate(const PageTableRoot& root, std::ui
 	return physical_page_base + static_cast<std::uintptr_t>(page_offset);
 }
 
+// Walkers entry points for a layout derived at run time (any supported width).
+bool MapPage4KiBGeneric(
+	PhysicalMemoryManager* pmm,
+	const PageTableRoot& root,
+	std::uintptr_t virtual_address,
+	std::uintptr_t physical_address,
+	PagePermissions permissions,
+	AddressSpaceBits address_bits
+) {
+	const auto layout_opt = BuildLayout(address_bits);
+	if (!layout_opt.has_value()) return false;
+	return MapPage4KiBWithLayout(pmm, root, virtual_address, physical_address, permissions, layout_opt.value(), address_bits);
+}
+
+bool UnmapPage4KiBGeneric(
+	PhysicalMemoryManager* pmm,
+	const PageTableRoot& root,
+	std::uintptr_t virtual_address,
+	AddressSpaceBits address_bits
+) {
+	const auto layout_opt = BuildLayout(address_bits);
+	if (!layout_opt.has_value()) return false;
+	return UnmapPage4KiBWithLayout(pmm, root, virtual_address, layout_opt.value(), address_bits);
+}
+
+Rocinante::Optional<std::uintptr_t> TranslateGeneric(
+	const PageTableRoot& root,
+	std::uintptr_t virtual_address,
+	AddressSpaceBits address_bits
+) {
+	const auto layout_opt = BuildLayout(address_bits);
+	if (!layout_opt.has_value()) return Rocinante::nullopt;
+	return TranslateWithLayout(root, virtual_address, layout_opt.value());
+}
+
+// Walkers entry points compiled for one level count and PALEN. Only called
+// with address widths that SelectWalkers() matched to them.
+template <std::uint8_t kLevelCount, std::uint8_t kPhysicalAddressBits>
+bool MapPage4KiBFixed(
+	PhysicalMemoryManager* pmm,
+	const PageTableRoot& root,
+	std::uintptr_t virtual_address,
+	std::uintptr_t physical_address,
+	PagePermissions permissions,
+	AddressSpaceBits address_bits
+) {
+	using LayoutT = FixedLayout<kLevelCount, kPhysicalAddressBits>;
+	return MapPage4KiBWithLayout(pmm, root, virtual_address, physical_address, permissions, LayoutT::FromAddressBits(address_bits), address_bits);
+}
+
+template <std::uint8_t kLevelCount, std::uint8_t kPhysicalAddressBits>
+bool UnmapPage4KiBFixed(
+	PhysicalMemoryManager* pmm,
+	const PageTableRoot& root,
+	std::uintptr_t virtual_address,
+	AddressSpaceBits address_bits
+) {
+	using LayoutT = FixedLayout<kLevelCount, kPhysicalAddressBits>;
+	return UnmapPage4KiBWithLayout(pmm, root, virtual_address, LayoutT::FromAddressBits(address_bits), address_bits);
+}
+
+template <std::uint8_t kLevelCount, std::uint8_t kPhysicalAddressBits>
+Rocinante::Optional<std::uintptr_t> TranslateFixed(
+	const PageTableRoot& root,
+	std::uintptr_t virtual_address,
+	AddressSpaceBits address_bits
+) {
+	using LayoutT = FixedLayout<kLevelCount, kPhysicalAddressBits>;
+	return TranslateWithLayout(root, virtual_address, LayoutT::FromAddressBits(address_bits));
+}
+
+template <std::uint8_t kLevelCount, std::uint8_t kPhysicalAddressBits>
+Walkers FixedWalkers(AddressSpaceBits address_bits) {
+	return Walkers{
+		.address_bits = address_bits,
+		.specialized = true,
+		.translate = &TranslateFixed<kLevelCount, kPhysicalAddressBits>,
+		.map_page_4kib = &MapPage4KiBFixed<kLevelCount, kPhysicalAddressBits>,
+		.unmap_page_4kib = &UnmapPage4KiBFixed<kLevelCount, kPhysicalAddressBits>,
+	};
+}
+
+constexpr Walkers kGenericWalkers{
+	.address_bits = {},
+	.specialized = false,
+	.translate = &TranslateGeneric,
+	.map_page_4kib = &MapPage4KiBGeneric,
+	.unmap_page_4kib = &UnmapPage4KiBGeneric,
+};
+
+// The walkers installed at paging init when `address_bits` is the kernel's
+// configuration (the common case), the run-time-layout ones otherwise.
+const Walkers& WalkersFor(AddressSpaceBits address_bits) {
+	const Rocinante::Memory::PagingState* paging_state = Rocinante::Memory::TryGetPagingState();
+	if (paging_state && paging_state->walkers.translate
+		&& paging_state->walkers.address_bits.virtual_address_bits == address_bits.virtual_address_bits
+		&& paging_state->walkers.address_bits.physical_address_bits == address_bits.physical_address_bits) {
+		return paging_state->walkers;
+	}
+	return kGenericWalkers;
+}
+
+} // namespace
+
+Walkers SelectWalkers(AddressSpaceBits address_bits) {
+	if (BuildLayout(address_bits).has_value() && address_bits.physical_address_bits == 48) {
+		// LA464/LA664 report VALEN = PALEN = 48: four levels. Three levels
+		// covers kernels that shrink VALEN to 39 bits or less.
+		switch (LevelCountFromVirtualAddressBits(address_bits.virtual_address_bits)) {
+			case 4: return FixedWalkers<4, 48>(address_bits);
+			case 3: return FixedWalkers<3, 48>(address_bits);
+			default: break;
+		}
+	}
+
+	Walkers walkers = kGenericWalkers;
+	walkers.address_bits = address_bits;
+	return walkers;
+}
+
+Rocinante::Optional<PageTableRoot> AllocateRootPageTable(PhysicalMemoryManager* pmm) {
+	if (!pmm) return Rocinante::nullopt;
+	if (!ReserveTablePages(pmm, 1)) return Rocinante::nullopt;
+	const auto page = AllocateTablePage(pmm);
+	if (!page.has_value()) return Rocinante::nullopt;
+
+	const std::uintptr_t root_physical_base = page.value();
+	if (!IsPageAligned(root_physical_base)) return Rocinante::nullopt;
+
+	return PageTableRoot{.root_physical_address = root_physical_base};
+}
+
+bool FreeAllPageTables4KiB(
+	PhysicalMemoryManager* pmm,
+	const PageTableRoot& root,
+	AddressSpaceBits address_bits
+) {
+	return FreeAllPageTables4KiB(pmm, root, address_bits, nullptr);
+}
+
+bool FreeAllPageTables4KiB(
+	PhysicalMemoryManager* pmm,
+	const PageTableRoot& root,
+	AddressSpaceBits address_bits,
+	bool* out_had_global_leaf_mappings
+) {
+	if (!pmm) return false;
+	if (out_had_global_leaf_mappings) *out_had_global_leaf_mappings = false;
+	const auto layout_opt = BuildLayout(address_bits);
+	if (!layout_opt.has_value()) return false;
+	const Layout layout = layout_opt.value();
+	if (layout.level_count == 0) return false;
+	if (layout.level_count > kMaxSupportedLevelCount) return false;
+
+	if (root.root_physical_address == 0) return false;
+	if (!IsPageAligned(root.root_physical_address)) return false;
+
+	return FreeAllPageTablesRecursive(
+		pmm,
+		root.root_physical_address,
+		0,
+		layout,
+		address_bits,
+		static_cast<std::size_t>(layout.level_count - 1),
+		out_had_global_leaf_mappings);
+}
+
+bool MapRange(
+	PhysicalMemoryManager* pmm,
+	const PageTableRoot& root,
+	std::uintptr_t virtual_base,
+	std::uintptr_t physical_base,
+	std::size_t size_bytes,
+	PagePermissions permissions
+) {
+	return MapRange(
+		pmm,
+		root,
+		virtual_base,
+		physical_base,
+		size_bytes,
+		permissions,
+		AddressSpaceBitsFromCPUCFG()
+	);
+}
+
+bool MapRange(
+	PhysicalMemoryManager* pmm,
+	const PageTableRoot& root,
+	std::uintptr_t virtual_base,
+	std::uintptr_t physical_base,
+	std::size_t size_bytes,
+	PagePermissions permissions,
+	AddressSpaceBits address_bits
+) {
+	// Spec anchor: LoongArch-Vol1-EN.html, CPUCFG word 1 bit 24 (HP): the MTLB
+	// accepts page sizes other than CSR.STLBPS.
+	const bool huge_pages_supported = Rocinante::GetCPUCFG().SupportsHugePage();
+	return MapRangeFromRoot(pmm, root, virtual_base, physical_base, size_bytes, permissions, address_bits, huge_pages_supported);
+}
+
+bool MapRange4KiB(
+	PhysicalMemoryManager* pmm,
+	const PageTableRoot& root,
+	std::uintptr_t virtual_base,
+	std::uintptr_t physical_base,
+	std::size_t size_bytes,
+	PagePermissions permissions
+) {
+	return MapRange4KiB(
+		pmm,
+		root,
+		virtual_base,
+		physical_base,
+		size_bytes,
+		permissions,
+		AddressSpaceBitsFromCPUCFG()
+	);
+}
+
+bool MapRange4KiB(
+	PhysicalMemoryManager* pmm,
+	const PageTableRoot& root,
+	std::uintptr_t virtual_base,
+	std::uintptr_t physical_base,
+	std::size_t size_bytes,
+	PagePermissions permissions,
+	AddressSpaceBits address_bits
+) {
+	return MapRangeFromRoot(pmm, root, virtual_base, physical_base, size_bytes, permissions, address_bits, /*huge_leaves=*/false);
+}
+
+bool MapPage4KiB(
+	PhysicalMemoryManager* pmm,
+	const PageTableRoot& root,
+	std::uintptr_t virtual_address,
+	std::uintptr_t physical_address,
+	PagePermissions permissions
+) {
+	return MapPage4KiB(
+		pmm,
+		root,
+		virtual_address,
+		physical_address,
+		permissions,
+		AddressSpaceBitsFromCPUCFG()
+	);
+}
+
+bool MapPage4KiB(
+	PhysicalMemoryManager* pmm,
+	const PageTableRoot& root,
+	std::uintptr_t virtual_address,
+	std::uintptr_t physical_address,
+	PagePermissions permissions,
+	AddressSpaceBits address_bits
+) {
+	return WalkersFor(address_bits).map_page_4kib(pmm, root, virtual_address, physical_address, permissions, address_bits);
+}
+
+bool UnmapPage4KiB(PhysicalMemoryManager* pmm, const PageTableRoot& root, std::uintptr_t virtual_address) {
+	return UnmapPage4KiB(
+		pmm,
+		root,
+		virtual_address,
+		AddressSpaceBitsFromCPUCFG()
+	);
+}
+
+bool UnmapPage4KiB(PhysicalMemoryManager* pmm, const PageTableRoot& root, std::uintptr_t virtual_address, AddressSpaceBits address_bits) {
+	return WalkersFor(address_bits).unmap_page_4kib(pmm, root, virtual_address, address_bits);
+}
+
+bool UnmapRange(
+	PhysicalMemoryManager* pmm,
+	const PageTableRoot& root,
+	std::uintptr_t virtual_base,
+	std::size_t size_bytes
+) {
+	return UnmapRange(
+		pmm,
+		root,
+		virtual_base,
+		size_bytes,
+		AddressSpaceBitsFromCPUCFG()
+	);
+}
+
+bool UnmapRange(
+	PhysicalMemoryManager* pmm,
+	const PageTableRoot& root,
+	std::uintptr_t virtual_base,
+	std::size_t size_bytes,
+	AddressSpaceBits address_bits
+) {
+	if (!pmm) return false;
+	const auto layout_opt = BuildLayout(address_bits);
+	if (!layout_opt.has_value()) return false;
+	const Layout layout = layout_opt.value();
+
+	if (root.root_physical_address == 0) return false;
+	if (!IsPageAligned(virtual_base)) return false;
+	if ((size_bytes % kPageSizeBytes) != 0) return false;
+	if (!ValidateVirtualRange(virtual_base, size_bytes, layout)) return false;
+
+	auto* root_table = PageTablePageFromPhysical(root.root_physical_address);
+	if (!root_table) return false;
+
+	// Spec anchor (LoongArch-Vol1-EN.html): INVTLB maintains consistency
+	// between page tables and the TLB; that is left to the caller, as for
+	// UnmapPage4KiB().
+	const RangeWalk walk{
+		.pmm = pmm,
+		.layout = &layout,
+		.address_bits = address_bits,
+		.permissions = {},
+		.huge_leaves = false,
+	};
+	return UnmapRangeInTable(walk, root_table, static_cast<std::size_t>(layout.level_count - 1), virtual_base, size_bytes);
+}
+
+Rocinante::Optional<std::uintptr_t> Translate(const PageTableRoot& root, std::uintptr_t virtual_address) {
+	return Translate(
+		root,
+		virtual_address,
+		AddressSpaceBitsFromCPUCFG()
+	);
+}
+
+Rocinante::Optional<std::uintptr_t> Translate(const PageTableRoot& root, std::uintptr_t virtual_address, AddressSpaceBits address_bits) {
+	return WalkersFor(address_bits).translate(root, virtual_address, address_bits);
+}
+
+static_assert(Cursor::kMaxLevelCount == kMaxSupportedLevelCount);
+
+Cursor::Cursor(PhysicalMemoryManager* pmm, const PageTableRoot& root, AddressSpaceBits address_bits) {
+	_initialize(pmm, root, address_bits);
+}
+
+Cursor::Cursor(PhysicalMemoryManager* pmm, const PageTableRoot& root) {
+	_initialize(pmm, root, AddressSpaceBitsFromCPUCFG());
+}
+
+Cursor::~Cursor() {
+	(void)Flush();
+}
+
+void Cursor::_initialize(PhysicalMemoryManager* pmm, const PageTableRoot& root, AddressSpaceBits address_bits) {
+	if (!pmm) return;
+	if (root.root_physical_address == 0 || !IsPageAligned(root.root_physical_address)) return;
+	const auto layout_opt = BuildLayout(address_bits);
+	if (!layout_opt.has_value()) return;
+	const Layout layout = layout_opt.value();
+
+	auto* root_table = PageTablePageFromPhysical(root.root_physical_address);
+	if (!root_table) return;
+
+	m_geometry = Geometry{
+		.virtual_address_bits = layout.virtual_address_bits,
+		.physical_address_bits = layout.physical_address_bits,
+		.level_count = layout.level_count,
+		.virtual_address_low_mask = layout.virtual_address_low_mask,
+		.physical_address_mask = layout.physical_address_mask,
+		.physical_page_base_mask = layout.physical_page_base_mask,
+	};
+	m_address_bits = address_bits;
+	m_lowest_cached_level = static_cast<std::size_t>(layout.level_count - 1);
+	m_tables[m_lowest_cached_level] = root_table;
+	m_table_physical[m_lowest_cached_level] = root.root_physical_address;
+	m_pmm = pmm;
+}
+
+bool Cursor::Seek(std::uintptr_t virtual_address) {
+	if (!IsValid()) return false;
+	if (!IsPageAligned(virtual_address)) return false;
+	if (!ValidateVirtualAddress(virtual_address, m_geometry)) return false;
+
+	_leave_tables_not_covering(virtual_address);
+	m_virtual_address = virtual_address;
+	return true;
+}
+
+// Drops cached tables whose span does not contain virtual_address, lowest
+// level first, reclaiming the ones Unmap() emptied.
+void Cursor::_leave_tables_not_covering(std::uintptr_t virtual_address) {
+	const auto root_level = static_cast<std::size_t>(m_geometry.level_count - 1);
+	while (m_lowest_cached_level < root_level) {
+		const std::size_t parent_shift_bits = ShiftBitsForLevel(m_lowest_cached_level + 1);
+		if (((virtual_address ^ m_cached_virtual_address) >> parent_shift_bits) == 0) break;
+		_leave_table(m_lowest_cached_level);
+		m_lowest_cached_level++;
+	}
+	m_cached_virtual_address = virtual_address;
+}
+
+void Cursor::_leave_table(std::size_t level) {
+	if (!m_table_lost_entries[level]) return;
+	m_table_lost_entries[level] = false;
+	if (!TableIsEmpty(m_tables[level])) return;
+
+	if (!ReleaseTablePage(m_pmm, m_table_physical[level])) {
+		m_reclaim_failed = true;
+		return;
+	}
+	m_tables[level + 1]->entries[IndexFromVirtualAddressAtLevel(m_cached_virtual_address, level + 1)] = 0;
+	m_table_lost_entries[level + 1] = true;
+}
+
+// Walks from the lowest cached table toward the leaf table for the current
+// position. *out_level is 0 once the leaf table is cached; otherwise it is
+// the level holding a huge leaf, or (without create_tables) a missing entry.
+bool Cursor::_descend(bool create_tables, std::size_t* out_level) {
+	std::size_t level = m_lowest_cached_level;
+	if (create_tables && !ReserveTablePages(m_pmm, level)) return false;
+	while (level > 0) {
+		PageTablePage* table = m_tables[level];
+		const std::size_t index = IndexFromVirtualAddressAtLevel(m_virtual_address, level);
+		const std::uint64_t entry = table->entries[index];
+		if (EntryIsPresent(entry) && EntryIsHugeLeaf(entry)) break;
+		if (!EntryIsPresent(entry) && !create_tables) break;
+
+		PageTablePage* child = nullptr;
+		if (!EnsureNextLevelTable(m_pmm, table, index, &child, m_geometry.physical_page_base_mask)) return false;
+		if (!child) return false;
+		level--;
+		m_tables[level] = child;
+		m_table_physical[level] = EntryPhysicalPageBase(table->entries[index], m_geometry.physical_page_base_mask);
+		m_lowest_cached_level = level;
+	}
+	*out_level = level;
+	return true;
+}
+
+Rocinante::Optional<std::uintptr_t> Cursor::Query() {
+	if (!IsValid()) return Rocinante::nullopt;
+	std::size_t level = 0;
+	if (!_descend(false, &level)) return Rocinante::nullopt;
+
+	const std::uint64_t entry = m_tables[level]->entries[IndexFromVirtualAddressAtLevel(m_virtual_address, level)];
+	if (!EntryIsPresent(entry)) return Rocinante::nullopt;
+	if (level == 0) return EntryPhysicalPageBase(entry, m_geometry.physical_page_base_mask);
+	const std::uintptr_t offset = m_virtual_address & (LeafSizeBytesForLevel(level) - 1);
+	return HugeLeafPhysicalBase(entry, m_geometry.physical_page_base_mask, level) + offset;
+}
+
+bool Cursor::Map(std::uintptr_t physical_address, PagePermissions permissions) {
+	if (!IsValid()) return false;
+	if (!IsPageAligned(physical_address)) return false;
+	if (!ValidatePhysicalAddress(physical_address, m_geometry)) return false;
+
+	std::size_t level = 0;
+	if (!_descend(true, &level)) return false;
+	// Already covered by a huge leaf.
+	if (level != 0) return false;
+	return InstallLeaf(m_pmm, m_tables[0], 0, m_virtual_address, physical_address, permissions, m_geometry, m_address_bits);
+}
+
+bool Cursor::Unmap() {
+	if (!IsValid()) return false;
+	std::size_t level = 0;
+	if (!_descend(false, &level)) return false;
+
+	// Carve the page out of a huge leaf, one level at a time.
+	if (!ReserveTablePages(m_pmm, level)) return false;
+	while (level > 0) {
+		PageTablePage* table = m_tables[level];
+		const std::size_t index = IndexFromVirtualAddressAtLevel(m_virtual_address, level);
+		if (!EntryIsPresent(table->entries[index])) return false;
+		if (!SplitHugeLeaf(m_pmm, table, index, level, m_geometry.physical_page_base_mask)) return false;
+		if (!_descend(false, &level)) return false;
+	}
+
+	PageTablePage* table = m_tables[0];
+	const std::size_t index = IndexFromVirtualAddressAtLevel(m_virtual_address, 0);
+	const std::uint64_t entry = table->entries[index];
+	if (!EntryIsPresent(entry)) return false;
+	const std::uintptr_t mapped_physical = EntryPhysicalPageBase(entry, m_geometry.physical_page_base_mask);
+	if (!IsPhysMapLeafMapping(m_virtual_address, mapped_physical, m_address_bits)) {
+		if (!m_pmm->DecrementMapCountForPhysical(mapped_physical)) return false;
+	}
+	table->entries[index] = 0;
+	m_table_lost_entries[0] = true;
+	return true;
+}
+
+bool Cursor::Flush() {
+	if (!IsValid()) return false;
+	const auto root_level = static_cast<std::size_t>(m_geometry.level_count - 1);
+	for (; m_lowest_cached_level < root_level; m_lowest_cached_level++) {
+		_leave_table(m_lowest_cached_level);
+	}
+	const bool ok = !m_reclaim_failed;
+	m_reclaim_failed = false;
+	return ok;
+}
+
 } // namespace Rocinante::Memory::Paging
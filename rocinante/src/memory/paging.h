@@ -41,6 +41,10 @@ static constexpr std::size_t kPageShiftBits = 12;
 static constexpr std::size_t kEntriesPerTable = 512;
 static constexpr std::size_t kIndexBitsPerLevel = 9;
 
+// Huge-page leaves: one level-1 (2 MiB) or level-2 (1 GiB) directory entry.
+static constexpr std::size_t kHugePageSizeBytes2MiB = kPageSizeBytes << kIndexBitsPerLevel;
+static constexpr std::size_t kHugePageSizeBytes1GiB = kHugePageSizeBytes2MiB << kIndexBitsPerLevel;
+
 static constexpr std::uint64_t kPageOffsetMask = (1ull << kPageShiftBits) - 1ull;
 static constexpr std::uint64_t kPageBaseMask = ~kPageOffsetMask;
 
@@ -61,7 +65,10 @@ namespace PteBits {
 	//   - "Definition of TLB entry low order bits in LA64" (TLBELO0/TLBELO1)
 	//     This matches the per-page attribute layout used for common 4 KiB mappings.
 	//
-	// For early bring-up we only build common (4 KiB) page mappings. We still
+	// Leaves are common (4 KiB) PTEs at level 0 and, from MapRange(), huge-page
+	// leaves in directory entries at levels 1 through kMaxHugeLeafLevel
+	// (paging.cpp): 2 MiB and 1 GiB with 4 KiB pages. Huge leaves reuse this
+	// layout except for bit 6 (H) and bit 12 (HG), see kHuge below. We still
 	// define the high-bit permission fields because they affect address masking.
 	//
 	// Used by TLB hardware.
@@ -74,6 +81,13 @@ namespace PteBits {
 	// Bit 6 is G (Global) for leaf entries (common pages). For intermediate
 	// directory entries, the privileged spec uses bit 6 as the huge-page indicator.
 	static constexpr std::uint64_t kGlobal = (1ull << 6u);
+	// Directory-level (huge page) leaves.
+	// See LoongArch-Vol1-EN.html, "Table entry format for huge pages":
+	// - bit 6 is H (this directory entry is a leaf, not a table pointer)
+	// - bit 12 is HG, the huge-page global bit (the huge-page-aligned physical
+	//   base leaves it free)
+	static constexpr std::uint64_t kHuge = (1ull << 6u);
+	static constexpr std::uint64_t kHugeGlobal = (1ull << 12u);
 	// The page-table entry format defined in the privileged spec includes fields
 	// used during page walking but not filled into TLB entries.
 	// - P: physical page exists
@@ -113,6 +127,13 @@ struct PagePermissions final {
 	bool global;
 };
 
+// The same permissions without write access: the leaf gets D=0, so the first
+// store raises PME (used for copy-on-write and shared zero page mappings).
+constexpr PagePermissions WithoutWriteAccess(PagePermissions permissions) {
+	permissions.access = AccessPermissions::ReadOnly;
+	return permissions;
+}
+
 /**
  * @brief A single page table page (4 KiB) containing 512 64-bit entries.
  */
@@ -140,6 +161,44 @@ struct AddressSpaceBits final {
 	std::uint8_t physical_address_bits;
 };
 
+/**
+ * @brief Single-page walkers chosen for one address-width configuration.
+ *
+ * SelectWalkers() returns variants compiled for a fixed level count and PALEN
+ * when one matches (unrolled level loop, constant masks), and walkers that
+ * derive the layout at run time otherwise. Paging init stores the choice in
+ * PagingState; Translate(), MapPage4KiB() and UnmapPage4KiB() go through it
+ * whenever they are called with the installed address widths.
+ *
+ * The function pointers are only valid with the address_bits they were
+ * selected for.
+ */
+struct Walkers final {
+	AddressSpaceBits address_bits;
+	bool specialized;
+	Rocinante::Optional<std::uintptr_t> (*translate)(
+		const PageTableRoot& root,
+		std::uintptr_t virtual_address,
+		AddressSpaceBits address_bits);
+	bool (*map_page_4kib)(
+		PhysicalMemoryManager* pmm,
+		const PageTableRoot& root,
+		std::uintptr_t virtual_address,
+		std::uintptr_t physical_address,
+		PagePermissions permissions,
+		AddressSpaceBits address_bits);
+	bool (*unmap_page_4kib)(
+		PhysicalMemoryManager* pmm,
+		const PageTableRoot& root,
+		std::uintptr_t virtual_address,
+		AddressSpaceBits address_bits);
+};
+
+/**
+ * @brief Picks the walkers for an address-width configuration (see Walkers).
+ */
+Walkers SelectWalkers(AddressSpaceBits address_bits);
+
 /**
  * @brief Maps one 4 KiB page.
  *
@@ -169,6 +228,10 @@ bool MapPage4KiB(
 
 /**
  * @brief Unmaps one 4 KiB page.
+ *
+ * A page inside a huge-page leaf is carved out by first splitting that leaf
+ * into a table of next-smaller leaves (allocating one table page per level
+ * split), so this can fail on PMM exhaustion.
  */
 bool UnmapPage4KiB(
 	PhysicalMemoryManager* pmm,
@@ -189,7 +252,8 @@ bool UnmapPage4KiB(
 /**
  * @brief Translates a virtual address via software page table walking.
  *
- * Returns the physical address on success, or empty if not mapped.
+ * Returns the physical address on success, or empty if not mapped. Stops at
+ * the first huge-page leaf on the way down.
  */
 Rocinante::Optional<std::uintptr_t> Translate(
 	const PageTableRoot& root,
@@ -216,6 +280,8 @@ Rocinante::Optional<PageTableRoot> AllocateRootPageTable(PhysicalMemoryManager*
  * Important semantics:
  * - This frees *page-table pages only* (root + intermediate + leaf tables).
  * - It does NOT free mapped physical frames referenced by leaf PTEs.
+ * - Huge-page leaves are dropped like 4 KiB leaves: the map_count of every
+ *   4 KiB frame they cover is decremented.
  *
  * Ordering / safety requirements:
  * - Callers must ensure the address space is inactive and that any stale TLB
@@ -240,12 +306,50 @@ bool FreeAllPageTables4KiB(
 	bool* out_had_global_leaf_mappings
 );
 
+/**
+ * @brief Maps a contiguous range using the largest leaves alignment allows.
+ *
+ * Where the virtual and physical addresses are both 1 GiB (2 MiB) aligned and
+ * at least 1 GiB (2 MiB) of the range remains, a single directory-level leaf
+ * is written instead of a full 4 KiB page table. Directories that already
+ * hold a table keep their smaller leaves. Falls back to 4 KiB leaves when
+ * CPUCFG does not report huge-page support.
+ *
+ * Requirements are the same as MapRange4KiB().
+ */
+bool MapRange(
+	PhysicalMemoryManager* pmm,
+	const PageTableRoot& root,
+	std::uintptr_t virtual_base,
+	std::uintptr_t physical_base,
+	std::size_t size_bytes,
+	PagePermissions permissions
+);
+
+/**
+ * @brief Maps a contiguous range with huge leaves using runtime-reported address widths.
+ */
+bool MapRange(
+	PhysicalMemoryManager* pmm,
+	const PageTableRoot& root,
+	std::uintptr_t virtual_base,
+	std::uintptr_t physical_base,
+	std::size_t size_bytes,
+	PagePermissions permissions,
+	AddressSpaceBits address_bits
+);
+
 /**
  * @brief Maps a contiguous range using 4 KiB pages.
  *
+ * Walks the tables once for the whole range: each intermediate table is
+ * visited (or created) once and consecutive PTEs of a leaf table are filled
+ * in one pass. On failure, pages mapped before the failing one stay mapped.
+ *
  * Requirements:
  * - virtual_base, physical_base must be page-aligned.
  * - size_bytes must be a multiple of the page size.
+ * - The range must not wrap or cross out of its canonical half.
  */
 bool MapRange4KiB(
 	PhysicalMemoryManager* pmm,
@@ -269,6 +373,132 @@ bool MapRange4KiB(
 	AddressSpaceBits address_bits
 );
 
+/**
+ * @brief Unmaps every leaf in a range in one walk of the tables.
+ *
+ * - Holes (unmapped pages) are skipped rather than treated as errors.
+ * - A huge-page leaf wholly inside the range is cleared; one only partly
+ *   inside is split first (which can fail on PMM exhaustion).
+ * - Intermediate tables left empty are released on the way back up; the
+ *   root is kept.
+ * - Mapped frames are not freed; only their map_count is dropped.
+ *
+ * Callers must invalidate stale TLB entries for the range afterwards.
+ *
+ * Requirements are the same as MapRange4KiB() (without a physical base).
+ */
+bool UnmapRange(
+	PhysicalMemoryManager* pmm,
+	const PageTableRoot& root,
+	std::uintptr_t virtual_base,
+	std::size_t size_bytes
+);
+
+/**
+ * @brief Unmaps a range using runtime-reported address widths.
+ */
+bool UnmapRange(
+	PhysicalMemoryManager* pmm,
+	const PageTableRoot& root,
+	std::uintptr_t virtual_base,
+	std::size_t size_bytes,
+	AddressSpaceBits address_bits
+);
+
+/**
+ * @brief A position in one set of page tables, for runs of adjacent pages.
+ *
+ * The cursor remembers the table it used at each level. Moving to another
+ * page re-walks only below the highest level whose index changed, so a
+ * sequential pass costs one full walk per leaf table instead of one per page.
+ *
+ * Semantics:
+ * - Starts at virtual address 0; Seek() and Next() move it.
+ * - Query()/Map()/Unmap() act on the 4 KiB page at the current position and
+ *   behave like Translate()/MapPage4KiB()/UnmapPage4KiB() (Unmap() splits a
+ *   huge leaf it lands in).
+ * - Tables emptied by Unmap() are reclaimed when the cursor moves out of
+ *   them, or by Flush(); the destructor flushes. The root is kept.
+ *
+ * Requirements:
+ * - Nothing else may change these tables while the cursor is alive (its
+ *   cached pointers would go stale).
+ * - As with UnmapPage4KiB(), TLB invalidation is left to the caller.
+ */
+class Cursor final {
+	public:
+		static constexpr std::size_t kMaxLevelCount = 6;
+
+		Cursor(PhysicalMemoryManager* pmm, const PageTableRoot& root, AddressSpaceBits address_bits);
+		// Uses runtime-reported address widths.
+		Cursor(PhysicalMemoryManager* pmm, const PageTableRoot& root);
+		~Cursor();
+
+		Cursor(const Cursor&) = delete;
+		Cursor& operator=(const Cursor&) = delete;
+		Cursor(Cursor&&) = delete;
+		Cursor& operator=(Cursor&&) = delete;
+
+		// False if the PMM, root or address widths were unusable.
+		bool IsValid() const { return m_pmm != nullptr; }
+
+		std::uintptr_t VirtualAddress() const { return m_virtual_address; }
+
+		// Moves to a page-aligned, canonical virtual address. Returns false
+		// (and does not move) otherwise.
+		bool Seek(std::uintptr_t virtual_address);
+
+		// Moves to the next 4 KiB page.
+		bool Next() { return Seek(m_virtual_address + kPageSizeBytes); }
+
+		// Physical address of the current page, or empty if not mapped.
+		Rocinante::Optional<std::uintptr_t> Query();
+
+		bool Map(std::uintptr_t physical_address, PagePermissions permissions);
+
+		// Returns false if the current page is not mapped.
+		bool Unmap();
+
+		/**
+		 * @brief Reclaims the emptied tables still cached by the cursor.
+		 *
+		 * Returns false if this or an earlier reclaim failed to give a table
+		 * back.
+		 */
+		bool Flush();
+
+	private:
+		// Same fields as the walkers' layout (see paging.cpp).
+		struct Geometry final {
+			std::uint8_t virtual_address_bits;
+			std::uint8_t physical_address_bits;
+			std::uint8_t level_count;
+			std::uint64_t virtual_address_low_mask;
+			std::uint64_t physical_address_mask;
+			std::uint64_t physical_page_base_mask;
+		};
+
+		PhysicalMemoryManager* m_pmm = nullptr;
+		AddressSpaceBits m_address_bits{};
+		Geometry m_geometry{};
+
+		std::uintptr_t m_virtual_address = 0;
+		// m_tables[level] is valid for m_cached_virtual_address for every
+		// level from m_lowest_cached_level up to the root.
+		std::uintptr_t m_cached_virtual_address = 0;
+		std::size_t m_lowest_cached_level = 0;
+		PageTablePage* m_tables[kMaxLevelCount] = {};
+		std::uintptr_t m_table_physical[kMaxLevelCount] = {};
+		// A leaf under this table was removed; check it for emptiness when leaving.
+		bool m_table_lost_entries[kMaxLevelCount] = {};
+		bool m_reclaim_failed = false;
+
+		void _initialize(PhysicalMemoryManager* pmm, const PageTableRoot& root, AddressSpaceBits address_bits);
+		void _leave_tables_not_covering(std::uintptr_t virtual_address);
+		void _leave_table(std::size_t level);
+		bool _descend(bool create_tables, std::size_t* out_level);
+};
+
 } // namespace Paging
 
 } // namespace Rocinante::Memory
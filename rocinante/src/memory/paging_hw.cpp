@@ -21,7 +21,10 @@ namespace AddressSpaceId {
 	// Spec anchor (LoongArch-Vol1-EN.html):
 	// - Vol.1 Section 7.5.4 (ASID), Table 38:
 	//   - CSR.ASID.ASID is bits [9:0]
+	//   - CSR.ASID.ASIDBITS is bits [23:16]
 	constexpr std::uint64_t kAsidMask = 0x3ff;
+	constexpr std::uint64_t kAsidBitsShift = 16;
+	constexpr std::uint64_t kAsidBitsMask = 0xff;
 } // namespace AddressSpaceId
 
 inline std::uint64_t InvtlbAsidOperand(std::uint16_t address_space_id) {
@@ -182,6 +185,18 @@ Rocinante::Optional<PageWalkerConfig> Make4KiBPageWalkerConfig(Paging::AddressSp
 	return PageWalkerConfig{.pwcl = pwcl, .pwch = pwch};
 }
 
+std::uint8_t DirectoryLevelCount(PageWalkerConfig config) {
+	// Width fields (see Make4KiBPageWalkerConfig()):
+	// - PWCL [19:15] Dirl_width, [29:25] Dir2_width
+	// - PWCH [11: 6] Dir3_width, [23:18] Dir4_width
+	std::uint8_t count = 0;
+	if (((config.pwcl >> 15u) & 0x1Fu) != 0) count++;
+	if (((config.pwcl >> 25u) & 0x1Fu) != 0) count++;
+	if (((config.pwch >> 6u) & 0x3Fu) != 0) count++;
+	if (((config.pwch >> 18u) & 0x3Fu) != 0) count++;
+	return count;
+}
+
 void ConfigurePageTableWalker(const Paging::PageTableRoot& root, PageWalkerConfig config) {
 	ConfigurePageTableWalkerRoots(root, root, config);
 }
@@ -214,18 +229,20 @@ std::uint16_t GetAddressSpaceId() {
 	return static_cast<std::uint16_t>(asid_csr & AddressSpaceId::kAsidMask);
 }
 
+std::uint8_t GetAddressSpaceIdBits() {
+	const std::uint64_t asid_csr = ReadCsr(Csr::kAddressSpaceId);
+	return static_cast<std::uint8_t>((asid_csr >> AddressSpaceId::kAsidBitsShift) & AddressSpaceId::kAsidBitsMask);
+}
+
 void SetLowHalfRootPageDirectoryBase(const Paging::PageTableRoot& low_half_root) {
 	WriteCsr(Csr::kPgdLow, static_cast<std::uint64_t>(low_half_root.root_physical_address));
 }
 
 void ActivateLowHalfAddressSpace(const Paging::PageTableRoot& low_half_root, std::uint16_t address_space_id) {
+	// No INVTLB here: entries tagged with this ASID belong to this address
+	// space as long as the AsidAllocator says so (see AddressSpace::Activate()).
 	SetAddressSpaceId(address_space_id);
 	SetLowHalfRootPageDirectoryBase(low_half_root);
-
-	// Per-ASID policy:
-	// - When reusing an ASID, clear any stale non-global translations for that ASID.
-	// - Global (G=1) entries remain unaffected.
-	InvalidateNonGlobalTlbEntriesForAsid(address_space_id);
 }
 
 void EnablePaging() {
@@ -19,7 +19,9 @@ namespace Rocinante::Memory::PagingHw {
  * - Optionally switch the CPU into paging mode (CRMD.DA/CRMD.PG).
  *
  * Explicit flaws / limitations:
- * - This code currently only supports 4 KiB pages.
+ * - The base page size is 4 KiB. Larger pages only exist as directory-level
+ *   huge-page leaves (Paging::MapRange), which the TLB refill handlers in
+ *   trap.S fill as two half-size pages.
  * - Page-walker configuration (PWCL/PWCH) is derived from CPUCFG-reported VALEN.
  *   The PWCL/PWCH field layout encodes up to 5 index levels (PT + 4 directories),
  *   i.e. VALEN up to (PAGE_SHIFT + 5*9) == 57 for 4 KiB pages.
@@ -41,6 +43,14 @@ struct PageWalkerConfig final {
  */
 Rocinante::Optional<PageWalkerConfig> Make4KiBPageWalkerConfig(Paging::AddressSpaceBits address_bits);
 
+/**
+ * @brief Counts the directory levels (Dirl..Dir4) a walker config enables.
+ *
+ * A level is enabled when its PWCL/PWCH width field is nonzero. This is the
+ * number of LDDIR steps a refill needs (Trap::InstallLddirTlbRefillHandler()).
+ */
+std::uint8_t DirectoryLevelCount(PageWalkerConfig config);
+
 /**
  * @brief Programs the hardware page-table walker CSRs for the supplied root.
  *
@@ -82,6 +92,15 @@ void SetAddressSpaceId(std::uint16_t address_space_id);
  */
 std::uint16_t GetAddressSpaceId();
 
+/**
+ * @brief Returns the implemented ASID width from CSR.ASID.ASIDBITS.
+ *
+ * Spec anchor (LoongArch-Vol1-EN.html):
+ * - Vol.1 Section 7.5.4 (ASID), Table 38:
+ *   - CSR.ASID.ASIDBITS is bits [23:16] (read-only)
+ */
+std::uint8_t GetAddressSpaceIdBits();
+
 /**
  * @brief Sets CSR.PGDL.Base (low-half root page directory base).
  *
@@ -93,12 +112,11 @@ void SetLowHalfRootPageDirectoryBase(const Paging::PageTableRoot& low_half_root)
 /**
  * @brief Activates a low-half address space.
  *
- * Policy (bring-up):
- * - Programs CSR.ASID.ASID and CSR.PGDL.Base.
- * - Invalidates non-global TLB entries for the supplied ASID to avoid stale translations.
- *
- * Explicit flaw:
- * - This does not invalidate global entries and does not provide a per-page invalidation policy yet.
+ * Policy:
+ * - Programs CSR.ASID.ASID and CSR.PGDL.Base; it does not touch the TLB.
+ * - The caller guarantees that non-global entries tagged with the ASID
+ *   belong to this root. AddressSpace::Activate() gets that guarantee from
+ *   the AsidAllocator, which flushes only on generation rollover.
  */
 void ActivateLowHalfAddressSpace(const Paging::PageTableRoot& low_half_root, std::uint16_t address_space_id);
 
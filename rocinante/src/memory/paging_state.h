@@ -27,6 +27,8 @@ namespace Rocinante::Memory {
 struct PagingState final {
 	Rocinante::Memory::Paging::PageTableRoot root;
 	Rocinante::Memory::Paging::AddressSpaceBits address_bits;
+	// Paging::SelectWalkers(address_bits), chosen once at init.
+	Rocinante::Memory::Paging::Walkers walkers;
 };
 
 /**
@@ -0,0 +1,64 @@
+/**
+ * Copyright (C) 2026 Andrew S. Rightenburg
+ * GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <src/helpers/optional.h>
+#include <src/memory/virtual_layout.h>
+#include <src/sp/cpucfg.h>
+
+namespace Rocinante::Memory::Physmap {
+
+/**
+ * @brief Returns true once the CPU runs in mapped address translation mode.
+ *
+ * Spec anchor (LoongArch-Vol1-EN.html):
+ * - Section 5.2 (Virtual Address Space and Address Translation Mode)
+ *   - CRMD.DA=1, CRMD.PG=0 => direct address translation mode
+ *   - CRMD.DA=0, CRMD.PG=1 => mapped address translation mode
+ */
+inline bool IsMappedAddressTranslationMode() {
+	// CSR.CRMD (Current Mode Information)
+	static constexpr std::uint32_t kCsrCurrentModeInformation = 0x0;
+	static constexpr std::uint64_t kDirectAddressingEnable = (1ull << 3u); // CRMD.DA
+	static constexpr std::uint64_t kPagingEnable = (1ull << 4u);           // CRMD.PG
+
+	std::uint64_t crmd;
+	asm volatile("csrrd %0, %1" : "=r"(crmd) : "i"(kCsrCurrentModeInformation));
+	const bool direct_addressing = (crmd & kDirectAddressingEnable) != 0;
+	const bool paging = (crmd & kPagingEnable) != 0;
+	return (!direct_addressing) && paging;
+}
+
+/**
+ * @brief Address through which the kernel reaches physical memory right now.
+ *
+ * Direct-address mode: the physical address itself. Mapped mode: its alias in
+ * the higher-half linear physmap (VirtualLayout::ToPhysMapVirtual()).
+ */
+inline std::uintptr_t KernelVirtualForPhysical(std::uintptr_t physical_address, std::uint8_t virtual_address_bits) {
+	if (!IsMappedAddressTranslationMode()) return physical_address;
+	return Rocinante::Memory::VirtualLayout::ToPhysMapVirtual(physical_address, virtual_address_bits);
+}
+
+// As above, with the VALEN the CPU reports.
+inline std::uintptr_t KernelVirtualForPhysical(std::uintptr_t physical_address) {
+	if (!IsMappedAddressTranslationMode()) return physical_address;
+	const auto virtual_address_bits = static_cast<std::uint8_t>(Rocinante::GetCPUCFG().VirtualAddressBits());
+	return Rocinante::Memory::VirtualLayout::ToPhysMapVirtual(physical_address, virtual_address_bits);
+}
+
+// Inverse of KernelVirtualForPhysical(); nullopt if a mapped-mode address is
+// below the physmap.
+inline Rocinante::Optional<std::uintptr_t> PhysicalForKernelVirtual(std::uintptr_t virtual_address) {
+	if (!IsMappedAddressTranslationMode()) return virtual_address;
+	const auto virtual_address_bits = static_cast<std::uint8_t>(Rocinante::GetCPUCFG().VirtualAddressBits());
+	if (virtual_address < Rocinante::Memory::VirtualLayout::PhysMapBase(virtual_address_bits)) return Rocinante::nullopt;
+	return Rocinante::Memory::VirtualLayout::FromPhysMapVirtual(virtual_address, virtual_address_bits);
+}
+
+} // namespace Rocinante::Memory::Physmap
@@ -7,6 +7,8 @@
 
 #include <src/memory/virtual_layout.h>
 #include <src/sp/cpucfg.h>
+#include <src/sp/cpuid.h>
+#include <src/sp/stable_counter.h>
 
 namespace Rocinante::Memory {
 
@@ -48,6 +50,34 @@ constexpr std::uintptr_t AlignUp(std::uintptr_t value, std::size_t alignment) {
 	return (value + (alignment - 1)) & ~(static_cast<std::uintptr_t>(alignment) - 1);
 }
 
+// Bits per page-state bitmap word (leaf and summary levels).
+constexpr std::size_t kBitsPerBitmapWord = 64;
+
+// Index of the lowest set bit. Precondition: value != 0.
+//
+// LoongArch64 has a native CTZ.D instruction, so this compiles to a single
+// instruction rather than a libgcc call.
+inline std::size_t CountTrailingZeros(std::uint64_t value) {
+	return static_cast<std::size_t>(__builtin_ctzll(value));
+}
+
+// Number of set bits.
+//
+// LoongArch64 has no population-count instruction outside LSX, so spell out
+// the SWAR reduction rather than risk a libgcc call from __builtin_popcountll.
+inline std::size_t PopulationCount(std::uint64_t value) {
+	value = value - ((value >> 1) & 0x5555555555555555ull);
+	value = (value & 0x3333333333333333ull) + ((value >> 2) & 0x3333333333333333ull);
+	value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+	return static_cast<std::size_t>((value * 0x0101010101010101ull) >> 56);
+}
+
+// Mask of bit_count bits starting at bit_begin. Precondition:
+// bit_begin + bit_count <= kBitsPerBitmapWord, bit_count != 0.
+inline std::uint64_t BitmapWordMask(std::size_t bit_begin, std::size_t bit_count) {
+	return (bit_count == kBitsPerBitmapWord) ? ~0ull : (((1ull << bit_count) - 1) << bit_begin);
+}
+
 constexpr bool AddOverflows(std::uintptr_t a, std::size_t b) {
 	const std::uintptr_t sum = a + static_cast<std::uintptr_t>(b);
 	return sum < a;
@@ -77,66 +107,151 @@ PhysicalMemoryManager& GetPhysicalMemoryManager() {
 void PhysicalMemoryManager::_reset_state() {
 	m_bitmap_physical_base = 0;
 	m_bitmap_size_bytes = 0;
+	m_bitmap_leaf_word_count = 0;
+	m_bitmap_summary_word_count = 0;
 	m_frame_metadata_physical_base = 0;
 	m_frame_metadata_size_bytes = 0;
 	m_tracked_physical_base = 0;
 	m_tracked_physical_limit = 0;
 	m_page_count = 0;
 	m_free_page_count = 0;
-	m_next_search_index = 0;
 	m_initialized = false;
+	for (std::size_t node = 0; node < kMaxNumaNodes; node++) {
+		for (std::size_t order = 0; order < kBuddyOrderCount; order++) {
+			m_free_list_head[node][order] = kInvalidPageIndex;
+			m_free_block_count[node][order] = 0;
+		}
+		m_free_page_count_by_node[node] = 0;
+	}
+	m_numa_zone_count = 0;
+	m_numa_node_count = 1;
+	for (std::size_t core_id = 0; core_id < kMaxNumaCores; core_id++) {
+		m_numa_node_by_core[core_id] = 0;
+	}
+	m_zeroed_pool_count = 0;
+	m_zeroed_pool_statistics = ZeroedPoolStatistics{};
+	for (std::size_t i = 0; i < kFrameMetadataSectionWordCount; i++) {
+		m_frame_metadata_section_ready[i] = 0;
+	}
+	m_frame_metadata_section_count = 0;
+	m_deferred_section_count = 0;
+	m_deferred_free_page_count = 0;
+	m_initialization_statistics = InitializationStatistics{};
+}
+
+void PhysicalMemoryManager::_assign_numa_zones(const BootMemoryMap& boot_map) {
+	for (std::size_t i = 0; i < boot_map.region_count; i++) {
+		const auto& r = boot_map.regions[i];
+		if (r.type != BootMemoryRegion::Type::UsableRAM) continue;
+
+		std::size_t index_begin = 0;
+		std::size_t index_end = 0;
+		if (!_physical_range_to_page_indices(static_cast<std::uintptr_t>(r.physical_base), static_cast<std::size_t>(r.size_bytes), &index_begin, &index_end)) continue;
+
+		const std::uint8_t numa_node_id = (r.numa_node_id < kMaxNumaNodes) ? static_cast<std::uint8_t>(r.numa_node_id) : 0;
+		m_numa_zones[m_numa_zone_count++] = NumaZone{
+			.page_index_begin = index_begin,
+			.page_index_end = index_end,
+			.numa_node_id = numa_node_id,
+		};
+		if (static_cast<std::size_t>(numa_node_id) + 1 > m_numa_node_count) {
+			m_numa_node_count = static_cast<std::size_t>(numa_node_id) + 1;
+		}
+	}
+
+	for (std::size_t i = 0; i < boot_map.cpu_numa_affinity_count; i++) {
+		const auto& affinity = boot_map.cpu_numa_affinities[i];
+		if (affinity.core_id >= kMaxNumaCores) continue;
+		m_numa_node_by_core[affinity.core_id] =
+			(affinity.numa_node_id < kMaxNumaNodes) ? static_cast<std::uint8_t>(affinity.numa_node_id) : 0;
+	}
+}
+
+std::size_t PhysicalMemoryManager::_numa_node_for_page_from_zones(std::size_t page_index) const {
+	for (std::size_t i = 0; i < m_numa_zone_count; i++) {
+		const NumaZone& zone = m_numa_zones[i];
+		if (zone.page_index_begin <= page_index && page_index < zone.page_index_end) return zone.numa_node_id;
+	}
+	return 0;
+}
+
+bool PhysicalMemoryManager::_page_range_is_on_numa_node(std::size_t index_begin, std::size_t index_end, std::size_t numa_node) const {
+	// Zones describe UsableRAM only. Pages outside every zone are never free, so
+	// a free range only needs checking against zones of other nodes.
+	for (std::size_t i = 0; i < m_numa_zone_count; i++) {
+		const NumaZone& zone = m_numa_zones[i];
+		if (zone.numa_node_id == numa_node) continue;
+		if (zone.page_index_begin < index_end && index_begin < zone.page_index_end) return false;
+	}
+	return true;
 }
 
-std::uint8_t* PhysicalMemoryManager::_bitmap_ptr() {
+std::uint64_t* PhysicalMemoryManager::_bitmap_ptr() {
 	if (m_bitmap_size_bytes == 0) return nullptr;
 
 	if (!IsMappedAddressTranslationMode()) {
-		return reinterpret_cast<std::uint8_t*>(m_bitmap_physical_base);
+		return reinterpret_cast<std::uint64_t*>(m_bitmap_physical_base);
 	}
 
 	const auto virtual_address_bits = static_cast<std::uint8_t>(Rocinante::GetCPUCFG().VirtualAddressBits());
 	const std::uintptr_t physmap_virtual =
 		Rocinante::Memory::VirtualLayout::ToPhysMapVirtual(m_bitmap_physical_base, virtual_address_bits);
-	return reinterpret_cast<std::uint8_t*>(physmap_virtual);
+	return reinterpret_cast<std::uint64_t*>(physmap_virtual);
 }
 
-const std::uint8_t* PhysicalMemoryManager::_bitmap_ptr() const {
+const std::uint64_t* PhysicalMemoryManager::_bitmap_ptr() const {
 	if (m_bitmap_size_bytes == 0) return nullptr;
 
 	if (!IsMappedAddressTranslationMode()) {
-		return reinterpret_cast<const std::uint8_t*>(m_bitmap_physical_base);
+		return reinterpret_cast<const std::uint64_t*>(m_bitmap_physical_base);
 	}
 
 	const auto virtual_address_bits = static_cast<std::uint8_t>(Rocinante::GetCPUCFG().VirtualAddressBits());
 	const std::uintptr_t physmap_virtual =
 		Rocinante::Memory::VirtualLayout::ToPhysMapVirtual(m_bitmap_physical_base, virtual_address_bits);
-	return reinterpret_cast<const std::uint8_t*>(physmap_virtual);
+	return reinterpret_cast<const std::uint64_t*>(physmap_virtual);
 }
 
-PhysicalMemoryManager::PageFrameMetadata* PhysicalMemoryManager::_frame_metadata_ptr() {
-	if (m_frame_metadata_size_bytes == 0) return nullptr;
+PhysicalMemoryManager::FrameMetadataTable PhysicalMemoryManager::_frame_metadata_table() const {
+	if (m_frame_metadata_size_bytes == 0) return FrameMetadataTable{};
 
 	if (!IsMappedAddressTranslationMode()) {
-		return reinterpret_cast<PageFrameMetadata*>(m_frame_metadata_physical_base);
+		return FrameMetadataTable::FromStorage(m_frame_metadata_physical_base, m_page_count);
 	}
 
 	const auto virtual_address_bits = static_cast<std::uint8_t>(Rocinante::GetCPUCFG().VirtualAddressBits());
 	const std::uintptr_t physmap_virtual =
 		Rocinante::Memory::VirtualLayout::ToPhysMapVirtual(m_frame_metadata_physical_base, virtual_address_bits);
-	return reinterpret_cast<PageFrameMetadata*>(physmap_virtual);
+	return FrameMetadataTable::FromStorage(physmap_virtual, m_page_count);
 }
 
-const PhysicalMemoryManager::PageFrameMetadata* PhysicalMemoryManager::_frame_metadata_ptr() const {
-	if (m_frame_metadata_size_bytes == 0) return nullptr;
-
-	if (!IsMappedAddressTranslationMode()) {
-		return reinterpret_cast<const PageFrameMetadata*>(m_frame_metadata_physical_base);
+void PhysicalMemoryManager::_zero_page(std::uintptr_t physical_page_base) {
+	std::uintptr_t page_address = physical_page_base;
+	if (IsMappedAddressTranslationMode()) {
+		const auto virtual_address_bits = static_cast<std::uint8_t>(Rocinante::GetCPUCFG().VirtualAddressBits());
+		page_address = Rocinante::Memory::VirtualLayout::ToPhysMapVirtual(physical_page_base, virtual_address_bits);
 	}
 
-	const auto virtual_address_bits = static_cast<std::uint8_t>(Rocinante::GetCPUCFG().VirtualAddressBits());
-	const std::uintptr_t physmap_virtual =
-		Rocinante::Memory::VirtualLayout::ToPhysMapVirtual(m_frame_metadata_physical_base, virtual_address_bits);
-	return reinterpret_cast<const PageFrameMetadata*>(physmap_virtual);
+	// One 64-byte line per iteration with doubleword stores of $zero.
+	//
+	// Written as inline asm so the compiler cannot turn the loop back into a
+	// call to the byte-at-a-time memset in cxxabi.cpp.
+	static constexpr std::size_t kBytesPerIteration = 64;
+	for (std::size_t offset = 0; offset < kPageSizeBytes; offset += kBytesPerIteration) {
+		asm volatile(
+			"st.d $zero, %0, 0\n\t"
+			"st.d $zero, %0, 8\n\t"
+			"st.d $zero, %0, 16\n\t"
+			"st.d $zero, %0, 24\n\t"
+			"st.d $zero, %0, 32\n\t"
+			"st.d $zero, %0, 40\n\t"
+			"st.d $zero, %0, 48\n\t"
+			"st.d $zero, %0, 56"
+			:
+			: "r"(page_address + offset)
+			: "memory"
+		);
+	}
 }
 
 bool PhysicalMemoryManager::_allocate_bitmap(
@@ -161,11 +276,14 @@ bool PhysicalMemoryManager::_allocate_bitmap(
 		palen_valid ? static_cast<std::uintptr_t>(1ull << palen_bits) : 0;
 
 	// Bitmap encoding:
-	// - 1 bit per tracked physical page.
-	// - bit = 1 means "used / not allocatable".
-	// - bit = 0 means "free / allocatable".
-	const std::size_t bit_count = page_count;
-	const std::size_t byte_count = (bit_count + 7) / 8;
+	// - Leaf level: 1 bit per tracked physical page, packed into 64-bit words.
+	//   - bit = 1 means "used / not allocatable".
+	//   - bit = 0 means "free / allocatable".
+	// - Summary level: 1 bit per leaf word.
+	//   - bit = 1 means "leaf word has at least one free page".
+	const std::size_t leaf_word_count = (page_count + (kBitsPerBitmapWord - 1)) / kBitsPerBitmapWord;
+	const std::size_t summary_word_count = (leaf_word_count + (kBitsPerBitmapWord - 1)) / kBitsPerBitmapWord;
+	const std::size_t byte_count = (leaf_word_count + summary_word_count) * sizeof(std::uint64_t);
 	if (byte_count == 0) return false;
 	const std::size_t bitmap_alloc_size_bytes = AlignUp(byte_count, kPageSizeBytes);
 	if (bitmap_alloc_size_bytes == 0) return false;
@@ -267,15 +385,22 @@ bool PhysicalMemoryManager::_allocate_bitmap(
 
 	m_bitmap_physical_base = chosen_base;
 	m_bitmap_size_bytes = bitmap_alloc_size_bytes;
-	std::uint8_t* bitmap = _bitmap_ptr();
+	m_bitmap_leaf_word_count = leaf_word_count;
+	m_bitmap_summary_word_count = summary_word_count;
+	std::uint64_t* bitmap = _bitmap_ptr();
 	if (!bitmap) return false;
 
-	// Default to "used" for everything.
+	// Default to "used" for everything (and therefore "no free page" in the
+	// summary).
 	//
 	// Policy note: pages not explicitly described as UsableRAM are treated as
-	// non-allocatable.
-	for (std::size_t i = 0; i < bitmap_alloc_size_bytes; i++) {
-		bitmap[i] = 0xFF;
+	// non-allocatable. Leaf bits past page_count stay set forever, so searches
+	// never report them.
+	for (std::size_t i = 0; i < leaf_word_count; i++) {
+		bitmap[i] = ~0ull;
+	}
+	for (std::size_t i = 0; i < summary_word_count; i++) {
+		bitmap[leaf_word_count + i] = 0;
 	}
 
 	return true;
@@ -395,41 +520,141 @@ bool PhysicalMemoryManager::_allocate_frame_metadata(
 
 	if (chosen_base == 0) return false;
 
+	// Entries are cleared section by section (see
+	// _initialize_frame_metadata_section), not here: on a large machine most of
+	// this storage is not touched until after boot.
 	m_frame_metadata_physical_base = chosen_base;
 	m_frame_metadata_size_bytes = metadata_alloc_size_bytes;
-	PageFrameMetadata* metadata = _frame_metadata_ptr();
-	if (!metadata) return false;
-
-	const std::size_t element_count = m_page_count;
-	for (std::size_t i = 0; i < element_count; i++) {
-		metadata[i] = PageFrameMetadata{};
-	}
-
 	return true;
 }
 
 bool PhysicalMemoryManager::_is_page_used(std::size_t page_index) const {
-	const std::size_t byte_index = page_index / 8;
-	const std::size_t bit_index = page_index % 8;
-	const std::uint8_t* bitmap = _bitmap_ptr();
+	const std::size_t word_index = page_index / kBitsPerBitmapWord;
+	const std::size_t bit_index = page_index % kBitsPerBitmapWord;
+	const std::uint64_t* bitmap = _bitmap_ptr();
 	if (!bitmap) return true;
-	return (bitmap[byte_index] & (1u << bit_index)) != 0;
+	return (bitmap[word_index] & (1ull << bit_index)) != 0;
 }
 
 void PhysicalMemoryManager::_set_page_used(std::size_t page_index) {
-	const std::size_t byte_index = page_index / 8;
-	const std::size_t bit_index = page_index % 8;
-	std::uint8_t* bitmap = _bitmap_ptr();
+	const std::size_t word_index = page_index / kBitsPerBitmapWord;
+	const std::size_t bit_index = page_index % kBitsPerBitmapWord;
+	std::uint64_t* bitmap = _bitmap_ptr();
 	if (!bitmap) return;
-	bitmap[byte_index] |= static_cast<std::uint8_t>(1u << bit_index);
+	bitmap[word_index] |= (1ull << bit_index);
+
+	if (bitmap[word_index] == ~0ull) {
+		std::uint64_t* summary = bitmap + m_bitmap_leaf_word_count;
+		summary[word_index / kBitsPerBitmapWord] &= ~(1ull << (word_index % kBitsPerBitmapWord));
+	}
 }
 
-void PhysicalMemoryManager::_set_page_free(std::size_t page_index) {
-	const std::size_t byte_index = page_index / 8;
-	const std::size_t bit_index = page_index % 8;
-	std::uint8_t* bitmap = _bitmap_ptr();
+void PhysicalMemoryManager::_set_page_range_used(std::size_t index_begin, std::size_t index_end) {
+	std::uint64_t* bitmap = _bitmap_ptr();
 	if (!bitmap) return;
-	bitmap[byte_index] &= static_cast<std::uint8_t>(~(1u << bit_index));
+	std::uint64_t* summary = bitmap + m_bitmap_leaf_word_count;
+
+	std::size_t page_index = index_begin;
+	while (page_index < index_end) {
+		const std::size_t word_index = page_index / kBitsPerBitmapWord;
+		const std::size_t bit_begin = page_index % kBitsPerBitmapWord;
+		const std::size_t bits_left_in_word = kBitsPerBitmapWord - bit_begin;
+		const std::size_t bit_count = ((index_end - page_index) < bits_left_in_word) ? (index_end - page_index) : bits_left_in_word;
+		bitmap[word_index] |= BitmapWordMask(bit_begin, bit_count);
+		if (bitmap[word_index] == ~0ull) {
+			summary[word_index / kBitsPerBitmapWord] &= ~(1ull << (word_index % kBitsPerBitmapWord));
+		}
+		page_index += bit_count;
+	}
+}
+
+void PhysicalMemoryManager::_set_page_range_free(std::size_t index_begin, std::size_t index_end) {
+	std::uint64_t* bitmap = _bitmap_ptr();
+	if (!bitmap) return;
+	std::uint64_t* summary = bitmap + m_bitmap_leaf_word_count;
+
+	std::size_t page_index = index_begin;
+	while (page_index < index_end) {
+		const std::size_t word_index = page_index / kBitsPerBitmapWord;
+		const std::size_t bit_begin = page_index % kBitsPerBitmapWord;
+		const std::size_t bits_left_in_word = kBitsPerBitmapWord - bit_begin;
+		const std::size_t bit_count = ((index_end - page_index) < bits_left_in_word) ? (index_end - page_index) : bits_left_in_word;
+		bitmap[word_index] &= ~BitmapWordMask(bit_begin, bit_count);
+		summary[word_index / kBitsPerBitmapWord] |= (1ull << (word_index % kBitsPerBitmapWord));
+		page_index += bit_count;
+	}
+}
+
+std::size_t PhysicalMemoryManager::_count_free_pages(std::size_t index_begin, std::size_t index_end) const {
+	const std::uint64_t* bitmap = _bitmap_ptr();
+	if (!bitmap) return 0;
+
+	std::size_t free_pages = 0;
+	std::size_t page_index = index_begin;
+	while (page_index < index_end) {
+		const std::size_t word_index = page_index / kBitsPerBitmapWord;
+		const std::size_t bit_begin = page_index % kBitsPerBitmapWord;
+		const std::size_t bits_left_in_word = kBitsPerBitmapWord - bit_begin;
+		const std::size_t bit_count = ((index_end - page_index) < bits_left_in_word) ? (index_end - page_index) : bits_left_in_word;
+		free_pages += PopulationCount(~bitmap[word_index] & BitmapWordMask(bit_begin, bit_count));
+		page_index += bit_count;
+	}
+	return free_pages;
+}
+
+bool PhysicalMemoryManager::_find_next_free_page(std::size_t page_index_begin, std::size_t* out_page_index) const {
+	if (!out_page_index) return false;
+	if (page_index_begin >= m_page_count) return false;
+
+	const std::uint64_t* bitmap = _bitmap_ptr();
+	if (!bitmap) return false;
+	const std::uint64_t* summary = bitmap + m_bitmap_leaf_word_count;
+
+	// 1) Remainder of the starting leaf word.
+	const std::size_t first_word_index = page_index_begin / kBitsPerBitmapWord;
+	const std::uint64_t first_word_free_bits =
+		~bitmap[first_word_index] & (~0ull << (page_index_begin % kBitsPerBitmapWord));
+	if (first_word_free_bits != 0) {
+		*out_page_index = (first_word_index * kBitsPerBitmapWord) + CountTrailingZeros(first_word_free_bits);
+		return true;
+	}
+
+	// 2) Summary level: skip leaf words with no free page.
+	const std::size_t next_word_index = first_word_index + 1;
+	if (next_word_index >= m_bitmap_leaf_word_count) return false;
+
+	std::size_t summary_index = next_word_index / kBitsPerBitmapWord;
+	std::uint64_t summary_bits = summary[summary_index] & (~0ull << (next_word_index % kBitsPerBitmapWord));
+	while (true) {
+		if (summary_bits != 0) {
+			const std::size_t word_index = (summary_index * kBitsPerBitmapWord) + CountTrailingZeros(summary_bits);
+			*out_page_index = (word_index * kBitsPerBitmapWord) + CountTrailingZeros(~bitmap[word_index]);
+			return true;
+		}
+		summary_index++;
+		if (summary_index >= m_bitmap_summary_word_count) return false;
+		summary_bits = summary[summary_index];
+	}
+}
+
+bool PhysicalMemoryManager::_page_range_is_free(std::size_t index_begin, std::size_t index_end) const {
+	if (index_begin >= index_end) return true;
+	if (index_end > m_page_count) return false;
+
+	const std::uint64_t* bitmap = _bitmap_ptr();
+	if (!bitmap) return false;
+
+	// Word-at-a-time: build the mask of the range's bits within each word.
+	std::size_t page_index = index_begin;
+	while (page_index < index_end) {
+		const std::size_t word_index = page_index / kBitsPerBitmapWord;
+		const std::size_t bit_begin = page_index % kBitsPerBitmapWord;
+		const std::size_t bits_left_in_word = kBitsPerBitmapWord - bit_begin;
+		const std::size_t bit_count = ((index_end - page_index) < bits_left_in_word) ? (index_end - page_index) : bits_left_in_word;
+		if ((bitmap[word_index] & BitmapWordMask(bit_begin, bit_count)) != 0) return false;
+		page_index += bit_count;
+	}
+	return true;
 }
 
 std::uintptr_t PhysicalMemoryManager::_page_index_to_physical(std::size_t page_index) const {
@@ -474,14 +699,175 @@ bool PhysicalMemoryManager::_physical_range_to_page_indices(
 	return true;
 }
 
+bool PhysicalMemoryManager::_page_index_is_block_aligned(std::size_t page_index, std::size_t order) const {
+	if (order > kMaxBuddyOrder) return false;
+	const std::size_t block_pages = static_cast<std::size_t>(1) << order;
+	if (page_index >= m_page_count) return false;
+	if (block_pages > (m_page_count - page_index)) return false;
+
+	// Buddy blocks are aligned on the absolute physical frame number, not on the
+	// tracked-span page index, so order-N blocks are usable as huge-page backing.
+	const std::size_t absolute_frame_number = (m_tracked_physical_base / kPageSizeBytes) + page_index;
+	return (absolute_frame_number & (block_pages - 1)) == 0;
+}
+
+bool PhysicalMemoryManager::_buddy_page_index(std::size_t page_index, std::size_t order, std::size_t* out_buddy_index) const {
+	if (!out_buddy_index) return false;
+	if (order > kMaxBuddyOrder) return false;
+
+	const std::size_t base_frame_number = m_tracked_physical_base / kPageSizeBytes;
+	const std::size_t absolute_frame_number = base_frame_number + page_index;
+	const std::size_t buddy_frame_number = absolute_frame_number ^ (static_cast<std::size_t>(1) << order);
+	if (buddy_frame_number < base_frame_number) return false;
+
+	const std::size_t buddy_index = buddy_frame_number - base_frame_number;
+	if (!_page_index_is_block_aligned(buddy_index, order)) return false;
+
+	*out_buddy_index = buddy_index;
+	return true;
+}
+
+void PhysicalMemoryManager::_free_list_push(FrameMetadataTable metadata, std::size_t page_index, std::size_t order) {
+	const std::size_t node = metadata.NumaNode(page_index);
+	const std::uint32_t head = m_free_list_head[node][order];
+
+	metadata.SetBuddyState(page_index, kFrameFlagFreeBlockHead, static_cast<std::uint8_t>(order));
+	metadata.SetFreeListPrev(page_index, kInvalidPageIndex);
+	metadata.SetFreeListNext(page_index, head);
+	if (head != kInvalidPageIndex) {
+		metadata.SetFreeListPrev(head, static_cast<std::uint32_t>(page_index));
+	}
+
+	m_free_list_head[node][order] = static_cast<std::uint32_t>(page_index);
+	m_free_block_count[node][order]++;
+	m_free_page_count_by_node[node] += static_cast<std::size_t>(1) << order;
+}
+
+void PhysicalMemoryManager::_free_list_remove(FrameMetadataTable metadata, std::size_t page_index, std::size_t order) {
+	const std::size_t node = metadata.NumaNode(page_index);
+	const std::uint32_t next = metadata.FreeListNext(page_index);
+	const std::uint32_t prev = metadata.FreeListPrev(page_index);
+
+	if (prev == kInvalidPageIndex) {
+		m_free_list_head[node][order] = next;
+	} else {
+		metadata.SetFreeListNext(prev, next);
+	}
+	if (next != kInvalidPageIndex) {
+		metadata.SetFreeListPrev(next, prev);
+	}
+
+	metadata.SetBuddyState(page_index, 0, 0);
+	metadata.SetFreeListNext(page_index, kInvalidPageIndex);
+	metadata.SetFreeListPrev(page_index, kInvalidPageIndex);
+	m_free_block_count[node][order]--;
+	m_free_page_count_by_node[node] -= static_cast<std::size_t>(1) << order;
+}
+
+void PhysicalMemoryManager::_release_block(FrameMetadataTable metadata, std::size_t page_index, std::size_t order) {
+	const std::size_t block_pages = static_cast<std::size_t>(1) << order;
+	for (std::size_t i = page_index; i < page_index + block_pages; i++) {
+		metadata.ClearKeepingNode(i);
+	}
+	_set_page_range_free(page_index, page_index + block_pages);
+	m_free_page_count += block_pages;
+
+	// Coalesce upward while the buddy is a free block of the same order on the
+	// same node.
+	std::size_t block_index = page_index;
+	std::size_t block_order = order;
+	while (block_order < kMaxBuddyOrder) {
+		std::size_t buddy_index = 0;
+		if (!_buddy_page_index(block_index, block_order, &buddy_index)) break;
+		if ((metadata.Flags(buddy_index) & kFrameFlagFreeBlockHead) == 0) break;
+		if (metadata.BuddyOrder(buddy_index) != block_order) break;
+		if (metadata.NumaNode(buddy_index) != metadata.NumaNode(block_index)) break;
+
+		_free_list_remove(metadata, buddy_index, block_order);
+		if (buddy_index < block_index) block_index = buddy_index;
+		block_order++;
+	}
+
+	_free_list_push(metadata, block_index, block_order);
+}
+
+bool PhysicalMemoryManager::_carve_free_page(FrameMetadataTable metadata, std::size_t page_index) {
+	// Find the free block containing page_index. A block of order N containing
+	// the page must start at the page's frame number aligned down to 2^N.
+	const std::size_t base_frame_number = m_tracked_physical_base / kPageSizeBytes;
+	const std::size_t absolute_frame_number = base_frame_number + page_index;
+
+	for (std::size_t order = 0; order < kBuddyOrderCount; order++) {
+		const std::size_t block_pages = static_cast<std::size_t>(1) << order;
+		const std::size_t head_frame_number = absolute_frame_number & ~(block_pages - 1);
+		if (head_frame_number < base_frame_number) break;
+
+		std::size_t head_index = head_frame_number - base_frame_number;
+		if ((metadata.Flags(head_index) & kFrameFlagFreeBlockHead) == 0) continue;
+		if (metadata.BuddyOrder(head_index) != order) continue;
+
+		// Split the block down to the single target page, returning the halves
+		// that do not contain it to the free lists.
+		_free_list_remove(metadata, head_index, order);
+		std::size_t split_order = order;
+		while (split_order > 0) {
+			split_order--;
+			const std::size_t half_pages = static_cast<std::size_t>(1) << split_order;
+			if (page_index >= head_index + half_pages) {
+				_free_list_push(metadata, head_index, split_order);
+				head_index += half_pages;
+			} else {
+				_free_list_push(metadata, head_index + half_pages, split_order);
+			}
+		}
+
+		_set_page_used(page_index);
+		m_free_page_count--;
+		return true;
+	}
+
+	return false;
+}
+
+void PhysicalMemoryManager::_build_free_lists(FrameMetadataTable metadata, std::size_t index_begin, std::size_t index_end) {
+	// Greedily cover each run of free pages with the largest naturally-aligned
+	// blocks that fit without crossing into another NUMA node.
+	//
+	// [index_begin, index_end) is a whole metadata section, so the blocks
+	// cannot run past index_end: a naturally-aligned block never straddles a
+	// section boundary.
+	const bool multiple_numa_nodes = m_numa_node_count > 1;
+	std::size_t page_index = index_begin;
+	while (page_index < index_end) {
+		if (!_find_next_free_page(page_index, &page_index)) break;
+		if (page_index >= index_end) break;
+
+		const std::size_t numa_node = metadata.NumaNode(page_index);
+		std::size_t order = 0;
+		while (order < kMaxBuddyOrder) {
+			const std::size_t next_order = order + 1;
+			if (!_page_index_is_block_aligned(page_index, next_order)) break;
+
+			// The lower half is already known free; check the upper half.
+			const std::size_t half_pages = static_cast<std::size_t>(1) << order;
+			if (!_page_range_is_free(page_index + half_pages, page_index + (2 * half_pages))) break;
+			if (multiple_numa_nodes && !_page_range_is_on_numa_node(page_index + half_pages, page_index + (2 * half_pages), numa_node)) break;
+			order = next_order;
+		}
+
+		_free_list_push(metadata, page_index, order);
+		const std::size_t block_pages = static_cast<std::size_t>(1) << order;
+		m_free_page_count += block_pages;
+		page_index += block_pages;
+	}
+}
+
 bool PhysicalMemoryManager::_mark_range_free(std::uintptr_t physical_base, std::size_t size_bytes) {
 	std::size_t index_begin = 0;
 	std::size_t index_end = 0;
 	if (!_physical_range_to_page_indices(physical_base, size_bytes, &index_begin, &index_end)) return true;
 
-	for (std::size_t i = index_begin; i < index_end; i++) {
-		_set_page_free(i);
-	}
+	_set_page_range_free(index_begin, index_end);
 	return true;
 }
 
@@ -490,10 +876,99 @@ bool PhysicalMemoryManager::_mark_range_used(std::uintptr_t physical_base, std::
 	std::size_t index_end = 0;
 	if (!_physical_range_to_page_indices(physical_base, size_bytes, &index_begin, &index_end)) return true;
 
+	_set_page_range_used(index_begin, index_end);
+	return true;
+}
+
+std::size_t PhysicalMemoryManager::_frame_metadata_section_for_page(std::size_t page_index) const {
+	const std::size_t base_frame_number = m_tracked_physical_base / kPageSizeBytes;
+	return ((base_frame_number + page_index) / kFrameMetadataSectionPages) - (base_frame_number / kFrameMetadataSectionPages);
+}
+
+void PhysicalMemoryManager::_frame_metadata_section_page_range(std::size_t section, std::size_t* out_index_begin, std::size_t* out_index_end) const {
+	const std::size_t base_frame_number = m_tracked_physical_base / kPageSizeBytes;
+	const std::size_t first_section_frame_number = (base_frame_number / kFrameMetadataSectionPages) * kFrameMetadataSectionPages;
+	const std::size_t section_frame_begin = first_section_frame_number + (section * kFrameMetadataSectionPages);
+	const std::size_t section_frame_end = section_frame_begin + kFrameMetadataSectionPages;
+
+	const std::size_t index_begin = (section_frame_begin > base_frame_number) ? (section_frame_begin - base_frame_number) : 0;
+	std::size_t index_end = section_frame_end - base_frame_number;
+	if (index_end > m_page_count) index_end = m_page_count;
+	*out_index_begin = index_begin;
+	*out_index_end = index_end;
+}
+
+bool PhysicalMemoryManager::_frame_metadata_section_is_ready(std::size_t section) const {
+	return (m_frame_metadata_section_ready[section / 64] & (1ull << (section % 64))) != 0;
+}
+
+std::size_t PhysicalMemoryManager::_initialize_frame_metadata_section(FrameMetadataTable metadata, std::size_t section) {
+	std::size_t index_begin = 0;
+	std::size_t index_end = 0;
+	_frame_metadata_section_page_range(section, &index_begin, &index_end);
+
 	for (std::size_t i = index_begin; i < index_end; i++) {
-		_set_page_used(i);
+		metadata.Clear(i);
 	}
-	return true;
+
+	// Node 0 is the metadata default, so only other nodes need a pass.
+	for (std::size_t z = 0; z < m_numa_zone_count; z++) {
+		const NumaZone& zone = m_numa_zones[z];
+		if (zone.numa_node_id == 0) continue;
+		const std::size_t begin = (zone.page_index_begin > index_begin) ? zone.page_index_begin : index_begin;
+		const std::size_t end = (zone.page_index_end < index_end) ? zone.page_index_end : index_end;
+		for (std::size_t i = begin; i < end; i++) {
+			metadata.SetNumaNode(i, zone.numa_node_id);
+		}
+	}
+
+	m_frame_metadata_section_ready[section / 64] |= (1ull << (section % 64));
+
+	const std::size_t free_pages_before = m_free_page_count;
+	_build_free_lists(metadata, index_begin, index_end);
+	return m_free_page_count - free_pages_before;
+}
+
+void PhysicalMemoryManager::_initialize_deferred_section(FrameMetadataTable metadata, std::size_t section) {
+	const std::uint64_t start_ticks = Rocinante::ReadStableCounterTicks();
+	m_deferred_free_page_count -= _initialize_frame_metadata_section(metadata, section);
+	m_deferred_section_count--;
+	m_initialization_statistics.deferred_metadata_ticks += Rocinante::ReadStableCounterTicks() - start_ticks;
+}
+
+bool PhysicalMemoryManager::_initialize_next_deferred_section(FrameMetadataTable metadata) {
+	if (m_deferred_section_count == 0) return false;
+
+	for (std::size_t word = 0; word < kFrameMetadataSectionWordCount; word++) {
+		const std::uint64_t not_ready = ~m_frame_metadata_section_ready[word];
+		if (not_ready == 0) continue;
+
+		const std::size_t section = (word * 64) + CountTrailingZeros(not_ready);
+		if (section >= m_frame_metadata_section_count) return false;
+
+		_initialize_deferred_section(metadata, section);
+		return true;
+	}
+	return false;
+}
+
+void PhysicalMemoryManager::_ensure_frame_metadata_for_page(FrameMetadataTable metadata, std::size_t page_index) {
+	const std::size_t section = _frame_metadata_section_for_page(page_index);
+	if (_frame_metadata_section_is_ready(section)) return;
+	_initialize_deferred_section(metadata, section);
+}
+
+std::size_t PhysicalMemoryManager::InitializeDeferredFrameMetadata(std::size_t max_sections) {
+	if (!m_initialized) return 0;
+
+	const FrameMetadataTable metadata = _frame_metadata_table();
+	if (!metadata) return 0;
+
+	std::size_t initialized = 0;
+	while (initialized < max_sections && _initialize_next_deferred_section(metadata)) {
+		initialized++;
+	}
+	return initialized;
 }
 
 bool PhysicalMemoryManager::InitializeFromBootMemoryMap(
@@ -553,6 +1028,14 @@ bool PhysicalMemoryManager::InitializeFromBootMemoryMap(
 	m_page_count = static_cast<std::size_t>((m_tracked_physical_limit - m_tracked_physical_base) / kPageSizeBytes);
 	if (m_page_count == 0) return false;
 
+	// Free-list links are 32-bit page indices (see FrameMetadataTable).
+	if (m_page_count >= kInvalidPageIndex) {
+		_reset_state();
+		return false;
+	}
+
+	std::uint64_t phase_start_ticks = Rocinante::ReadStableCounterTicks();
+
 	if (!_allocate_bitmap(
 		boot_map,
 		m_page_count,
@@ -577,6 +1060,10 @@ bool PhysicalMemoryManager::InitializeFromBootMemoryMap(
 		return false;
 	}
 
+	std::uint64_t now_ticks = Rocinante::ReadStableCounterTicks();
+	m_initialization_statistics.storage_placement_ticks = now_ticks - phase_start_ticks;
+	phase_start_ticks = now_ticks;
+
 	// 1) Mark all UsableRAM pages free.
 	for (std::size_t i = 0; i < boot_map.region_count; i++) {
 		const auto& r = boot_map.regions[i];
@@ -642,13 +1129,38 @@ bool PhysicalMemoryManager::InitializeFromBootMemoryMap(
 	// tracked range.
 	(void)_mark_range_used(0, kPageSizeBytes);
 
-	// Finalize free-page accounting.
-	std::size_t free_pages = 0;
-	for (std::size_t i = 0; i < m_page_count; i++) {
-		if (!_is_page_used(i)) free_pages++;
+	now_ticks = Rocinante::ReadStableCounterTicks();
+	m_initialization_statistics.range_marking_ticks = now_ticks - phase_start_ticks;
+	phase_start_ticks = now_ticks;
+
+	// 6) Initialize the eager metadata sections and build their buddy free
+	// lists from the final bitmap. Deferred sections only have their free
+	// pages counted.
+	FrameMetadataTable metadata = _frame_metadata_table();
+	if (!metadata) {
+		_reset_state();
+		return false;
+	}
+	_assign_numa_zones(boot_map);
+	m_free_page_count = 0;
+	m_frame_metadata_section_count = _frame_metadata_section_for_page(m_page_count - 1) + 1;
+	for (std::size_t section = 0; section < m_frame_metadata_section_count; section++) {
+		std::size_t index_begin = 0;
+		std::size_t index_end = 0;
+		_frame_metadata_section_page_range(section, &index_begin, &index_end);
+
+		const std::size_t offset_bytes = index_begin * kPageSizeBytes;
+		if (section == 0 || offset_bytes < m_eager_frame_metadata_limit_bytes) {
+			(void)_initialize_frame_metadata_section(metadata, section);
+			m_initialization_statistics.eager_sections++;
+		} else {
+			m_deferred_free_page_count += _count_free_pages(index_begin, index_end);
+			m_deferred_section_count++;
+		}
 	}
-	m_free_page_count = free_pages;
-	m_next_search_index = 0;
+	m_initialization_statistics.deferred_sections = m_deferred_section_count;
+	m_initialization_statistics.eager_metadata_ticks = Rocinante::ReadStableCounterTicks() - phase_start_ticks;
+
 	m_initialized = true;
 	return true;
 }
@@ -679,13 +1191,16 @@ bool PhysicalMemoryManager::RetainPhysicalPage(std::uintptr_t physical_page_base
 	const std::size_t pfn = _physical_to_page_index(physical_page_base);
 	if (pfn >= m_page_count) return false;
 
-	auto* metadata = _frame_metadata_ptr();
+	auto metadata = _frame_metadata_table();
 	if (!metadata) return false;
 
-	const std::uint32_t before = metadata[pfn].ref_count;
+	// Pages in a deferred section have never been allocated.
+	if (!_frame_metadata_section_is_ready(_frame_metadata_section_for_page(pfn))) return false;
+
+	const std::uint32_t before = metadata.RefCount(pfn);
 	if (before == 0) return false;
-	if (before == static_cast<std::uint32_t>(-1)) return false;
-	metadata[pfn].ref_count = before + 1;
+	if (before == FrameMetadataTable::kMaxCount) return false;
+	metadata.SetRefCount(pfn, before + 1);
 	return true;
 }
 
@@ -698,29 +1213,24 @@ bool PhysicalMemoryManager::ReleasePhysicalPage(std::uintptr_t physical_page_bas
 	const std::size_t pfn = _physical_to_page_index(physical_page_base);
 	if (pfn >= m_page_count) return false;
 
-	auto* metadata = _frame_metadata_ptr();
+	auto metadata = _frame_metadata_table();
 	if (!metadata) return false;
+	if (!_frame_metadata_section_is_ready(_frame_metadata_section_for_page(pfn))) return false;
 
-	const std::uint32_t before = metadata[pfn].ref_count;
+	const std::uint32_t before = metadata.RefCount(pfn);
 	if (before == 0) return false;
 
 	if (before == 1) {
 		// Safety policy: do not return a page to the allocator while it is still
 		// mapped via tracked leaf PTEs.
-		if (metadata[pfn].map_count != 0) return false;
+		if (metadata.MapCount(pfn) != 0) return false;
 		if (!_is_page_used(pfn)) return false;
 
-		metadata[pfn].ref_count = 0;
-		metadata[pfn].flags = 0;
-		metadata[pfn].reserved = 0;
-
-		_set_page_free(pfn);
-		m_free_page_count++;
-		if (pfn < m_next_search_index) m_next_search_index = pfn;
+		_release_block(metadata, pfn, 0);
 		return true;
 	}
 
-	metadata[pfn].ref_count = before - 1;
+	metadata.SetRefCount(pfn, before - 1);
 	return true;
 }
 
@@ -733,10 +1243,11 @@ Rocinante::Optional<std::uint32_t> PhysicalMemoryManager::ReferenceCountForPhysi
 	const std::size_t pfn = _physical_to_page_index(physical_page_base);
 	if (pfn >= m_page_count) return Rocinante::nullopt;
 
-	const auto* metadata = _frame_metadata_ptr();
+	const auto metadata = _frame_metadata_table();
 	if (!metadata) return Rocinante::nullopt;
+	if (!_frame_metadata_section_is_ready(_frame_metadata_section_for_page(pfn))) return Rocinante::Optional<std::uint32_t>(0);
 
-	return Rocinante::Optional<std::uint32_t>(metadata[pfn].ref_count);
+	return Rocinante::Optional<std::uint32_t>(metadata.RefCount(pfn));
 }
 
 bool PhysicalMemoryManager::IncrementMapCountForPhysical(std::uintptr_t physical_page_base) {
@@ -749,12 +1260,13 @@ bool PhysicalMemoryManager::IncrementMapCountForPhysical(std::uintptr_t physical
 	const std::size_t pfn = _physical_to_page_index(physical_page_base);
 	if (pfn >= m_page_count) return false;
 
-	auto* metadata = _frame_metadata_ptr();
+	auto metadata = _frame_metadata_table();
 	if (!metadata) return false;
+	_ensure_frame_metadata_for_page(metadata, pfn);
 
-	const std::uint32_t before = metadata[pfn].map_count;
-	if (before == static_cast<std::uint32_t>(-1)) return false;
-	metadata[pfn].map_count = before + 1;
+	const std::uint32_t before = metadata.MapCount(pfn);
+	if (before == FrameMetadataTable::kMaxCount) return false;
+	metadata.SetMapCount(pfn, before + 1);
 	return true;
 }
 
@@ -768,12 +1280,13 @@ bool PhysicalMemoryManager::DecrementMapCountForPhysical(std::uintptr_t physical
 	const std::size_t pfn = _physical_to_page_index(physical_page_base);
 	if (pfn >= m_page_count) return false;
 
-	auto* metadata = _frame_metadata_ptr();
+	auto metadata = _frame_metadata_table();
 	if (!metadata) return false;
+	_ensure_frame_metadata_for_page(metadata, pfn);
 
-	const std::uint32_t before = metadata[pfn].map_count;
+	const std::uint32_t before = metadata.MapCount(pfn);
 	if (before == 0) return false;
-	metadata[pfn].map_count = before - 1;
+	metadata.SetMapCount(pfn, before - 1);
 	return true;
 }
 
@@ -786,41 +1299,227 @@ Rocinante::Optional<std::uint32_t> PhysicalMemoryManager::MapCountForPhysical(st
 	const std::size_t pfn = _physical_to_page_index(physical_page_base);
 	if (pfn >= m_page_count) return Rocinante::nullopt;
 
-	const auto* metadata = _frame_metadata_ptr();
+	const auto metadata = _frame_metadata_table();
 	if (!metadata) return Rocinante::nullopt;
+	if (!_frame_metadata_section_is_ready(_frame_metadata_section_for_page(pfn))) return Rocinante::Optional<std::uint32_t>(0);
 
-	return Rocinante::Optional<std::uint32_t>(metadata[pfn].map_count);
+	return Rocinante::Optional<std::uint32_t>(metadata.MapCount(pfn));
 }
 
 Rocinante::Optional<std::uintptr_t> PhysicalMemoryManager::AllocatePage() {
+	const auto page = AllocatePages(0);
+	if (page.has_value() || m_zeroed_pool_count == 0) return page;
+
+	// Out of free pages: a pre-zeroed frame is still a frame.
+	return Rocinante::Optional<std::uintptr_t>(m_zeroed_pool[--m_zeroed_pool_count]);
+}
+
+Rocinante::Optional<std::uintptr_t> PhysicalMemoryManager::AllocateZeroedPage() {
 	if (!m_initialized) return Rocinante::nullopt;
-	if (m_free_page_count == 0) return Rocinante::nullopt;
 
-	auto* metadata = _frame_metadata_ptr();
-	if (!metadata) return Rocinante::nullopt;
+	if (m_zeroed_pool_count != 0) {
+		m_zeroed_pool_statistics.hits++;
+		return Rocinante::Optional<std::uintptr_t>(m_zeroed_pool[--m_zeroed_pool_count]);
+	}
+
+	m_zeroed_pool_statistics.misses++;
+	const auto page = AllocatePages(0);
+	if (!page.has_value()) return Rocinante::nullopt;
+	_zero_page(page.value());
+	return page;
+}
 
-	for (std::size_t scan = 0; scan < m_page_count; scan++) {
-		const std::size_t index = (m_next_search_index + scan) % m_page_count;
-		if (_is_page_used(index)) continue;
+Rocinante::Optional<std::uintptr_t> PhysicalMemoryManager::AllocateZeroedPages(std::size_t order) {
+	if (order == 0) return AllocateZeroedPage();
 
-		_set_page_used(index);
-		m_free_page_count--;
-		m_next_search_index = (index + 1) % m_page_count;
+	const auto block = AllocatePages(order);
+	if (!block.has_value()) return Rocinante::nullopt;
+	ZeroPages(block.value(), std::size_t{1} << order);
+	return block;
+}
 
-		metadata[index].ref_count = 1;
-		metadata[index].map_count = 0;
-		metadata[index].flags = 0;
-		metadata[index].reserved = 0;
-		return Rocinante::Optional<std::uintptr_t>(_page_index_to_physical(index));
+void PhysicalMemoryManager::ZeroPages(std::uintptr_t physical_base, std::size_t page_count) {
+	for (std::size_t i = 0; i < page_count; i++) {
+		_zero_page(physical_base + (i * kPageSizeBytes));
 	}
+}
 
-	return Rocinante::nullopt;
+std::size_t PhysicalMemoryManager::RefillZeroedPool(std::size_t max_frames) {
+	if (!m_initialized) return 0;
+
+	std::size_t added = 0;
+	while (added < max_frames && m_zeroed_pool_count < kZeroedPoolCapacityFrames) {
+		const auto page = AllocatePages(0);
+		if (!page.has_value()) break;
+		_zero_page(page.value());
+		m_zeroed_pool[m_zeroed_pool_count++] = page.value();
+		added++;
+	}
+	m_zeroed_pool_statistics.frames_prezeroed += added;
+	return added;
+}
+
+void PhysicalMemoryManager::DrainZeroedPool() {
+	while (m_zeroed_pool_count != 0) {
+		(void)ReleasePhysicalPage(m_zeroed_pool[--m_zeroed_pool_count]);
+	}
 }
 
 bool PhysicalMemoryManager::FreePage(std::uintptr_t physical_address) {
 	return ReleasePhysicalPage(physical_address);
 }
 
+Rocinante::Optional<std::uintptr_t> PhysicalMemoryManager::AllocatePages(std::size_t order) {
+	return AllocatePagesPreferringNode(order, CurrentNumaNode());
+}
+
+Rocinante::Optional<std::uintptr_t> PhysicalMemoryManager::AllocatePagesPreferringNode(std::size_t order, std::size_t preferred_node) {
+	if (!m_initialized) return Rocinante::nullopt;
+	if (order > kMaxBuddyOrder) return Rocinante::nullopt;
+
+	auto metadata = _frame_metadata_table();
+	if (!metadata) return Rocinante::nullopt;
+
+	// When every initialized free list comes up short, pull in one deferred
+	// section at a time until the request fits or none are left.
+	do {
+		if (preferred_node < kMaxNumaNodes) {
+			const auto local = _allocate_from_node(metadata, order, preferred_node);
+			if (local.has_value()) return local;
+		}
+
+		for (std::size_t node = 0; node < m_numa_node_count; node++) {
+			if (node == preferred_node) continue;
+			const auto remote = _allocate_from_node(metadata, order, node);
+			if (remote.has_value()) return remote;
+		}
+	} while (_initialize_next_deferred_section(metadata));
+	return Rocinante::nullopt;
+}
+
+Rocinante::Optional<std::uintptr_t> PhysicalMemoryManager::_allocate_from_node(FrameMetadataTable metadata, std::size_t order, std::size_t numa_node) {
+	// Smallest non-empty free list at or above the requested order.
+	std::size_t block_order = order;
+	while (block_order < kBuddyOrderCount && m_free_list_head[numa_node][block_order] == kInvalidPageIndex) {
+		block_order++;
+	}
+	if (block_order >= kBuddyOrderCount) return Rocinante::nullopt;
+
+	const std::size_t page_index = m_free_list_head[numa_node][block_order];
+	_free_list_remove(metadata, page_index, block_order);
+
+	// Split down, returning upper halves to their free lists.
+	while (block_order > order) {
+		block_order--;
+		_free_list_push(metadata, page_index + (static_cast<std::size_t>(1) << block_order), block_order);
+	}
+
+	const std::size_t block_pages = static_cast<std::size_t>(1) << order;
+	_set_page_range_used(page_index, page_index + block_pages);
+	for (std::size_t i = page_index; i < page_index + block_pages; i++) {
+		metadata.ClearKeepingNode(i);
+		metadata.SetRefCount(i, 1);
+	}
+	m_free_page_count -= block_pages;
+
+	return Rocinante::Optional<std::uintptr_t>(_page_index_to_physical(page_index));
+}
+
+bool PhysicalMemoryManager::FreePages(std::uintptr_t physical_address, std::size_t order) {
+	if (!m_initialized) return false;
+	if (order > kMaxBuddyOrder) return false;
+	if ((physical_address % kPageSizeBytes) != 0) return false;
+	if (physical_address < m_tracked_physical_base) return false;
+	if (physical_address >= m_tracked_physical_limit) return false;
+
+	const std::size_t page_index = _physical_to_page_index(physical_address);
+	if (!_page_index_is_block_aligned(page_index, order)) return false;
+
+	auto metadata = _frame_metadata_table();
+	if (!metadata) return false;
+
+	// A block never spans two sections; a deferred one holds no allocations.
+	if (!_frame_metadata_section_is_ready(_frame_metadata_section_for_page(page_index))) return false;
+
+	// Validate the whole block before changing anything.
+	const std::size_t block_pages = static_cast<std::size_t>(1) << order;
+	bool every_page_is_last_reference = true;
+	for (std::size_t i = page_index; i < page_index + block_pages; i++) {
+		if (!_is_page_used(i)) return false;
+		const std::uint32_t ref_count = metadata.RefCount(i);
+		if (ref_count == 0) return false;
+		if (ref_count == 1 && metadata.MapCount(i) != 0) return false;
+		if (ref_count != 1) every_page_is_last_reference = false;
+	}
+
+	if (every_page_is_last_reference) {
+		_release_block(metadata, page_index, order);
+		return true;
+	}
+
+	// Some pages are still shared: drop one reference per page and return only
+	// the pages that reached zero.
+	for (std::size_t i = page_index; i < page_index + block_pages; i++) {
+		const std::uint32_t ref_count = metadata.RefCount(i);
+		if (ref_count == 1) {
+			_release_block(metadata, i, 0);
+		} else {
+			metadata.SetRefCount(i, ref_count - 1);
+		}
+	}
+	return true;
+}
+
+std::size_t PhysicalMemoryManager::FreeBlockCountForOrder(std::size_t order) const {
+	if (order > kMaxBuddyOrder) return 0;
+	std::size_t total = 0;
+	for (std::size_t node = 0; node < kMaxNumaNodes; node++) {
+		total += m_free_block_count[node][order];
+	}
+	return total;
+}
+
+std::size_t PhysicalMemoryManager::FreePagesOnNode(std::size_t numa_node) const {
+	if (numa_node >= kMaxNumaNodes) return 0;
+	return m_free_page_count_by_node[numa_node];
+}
+
+Rocinante::Optional<std::uint32_t> PhysicalMemoryManager::NumaNodeForPhysical(std::uintptr_t physical_page_base) const {
+	if (!m_initialized) return Rocinante::nullopt;
+	if ((physical_page_base % kPageSizeBytes) != 0) return Rocinante::nullopt;
+	if (physical_page_base < m_tracked_physical_base) return Rocinante::nullopt;
+	if (physical_page_base >= m_tracked_physical_limit) return Rocinante::nullopt;
+
+	const std::size_t pfn = _physical_to_page_index(physical_page_base);
+	if (pfn >= m_page_count) return Rocinante::nullopt;
+
+	const auto metadata = _frame_metadata_table();
+	if (!metadata) return Rocinante::nullopt;
+	if (!_frame_metadata_section_is_ready(_frame_metadata_section_for_page(pfn))) {
+		return Rocinante::Optional<std::uint32_t>(static_cast<std::uint32_t>(_numa_node_for_page_from_zones(pfn)));
+	}
+
+	return Rocinante::Optional<std::uint32_t>(metadata.NumaNode(pfn));
+}
+
+std::size_t PhysicalMemoryManager::NumaNodeForCore(std::size_t core_id) const {
+	if (core_id >= kMaxNumaCores) return 0;
+	return m_numa_node_by_core[core_id];
+}
+
+std::size_t PhysicalMemoryManager::CurrentNumaNode() const {
+	// Single-node systems skip the CSR read on every allocation.
+	if (m_numa_node_count <= 1) return 0;
+	return NumaNodeForCore(Rocinante::ReadCurrentProcessorCoreId());
+}
+
+bool PhysicalMemoryManager::SetNumaNodeForCore(std::size_t core_id, std::size_t numa_node) {
+	if (core_id >= kMaxNumaCores) return false;
+	if (numa_node >= kMaxNumaNodes) return false;
+	m_numa_node_by_core[core_id] = static_cast<std::uint8_t>(numa_node);
+	return true;
+}
+
 bool PhysicalMemoryManager::ReserveRange(std::uintptr_t physical_base, std::size_t size_bytes) {
 	if (!m_initialized) return false;
 
@@ -828,10 +1527,13 @@ bool PhysicalMemoryManager::ReserveRange(std::uintptr_t physical_base, std::size
 	std::size_t index_end = 0;
 	if (!_physical_range_to_page_indices(physical_base, size_bytes, &index_begin, &index_end)) return true;
 
+	auto metadata = _frame_metadata_table();
+	if (!metadata) return false;
+
 	for (std::size_t i = index_begin; i < index_end; i++) {
 		if (_is_page_used(i)) continue;
-		_set_page_used(i);
-		m_free_page_count--;
+		_ensure_frame_metadata_for_page(metadata, i);
+		if (!_carve_free_page(metadata, i)) return false;
 	}
 
 	return true;
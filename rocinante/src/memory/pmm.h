@@ -25,10 +25,65 @@ namespace Rocinante::Memory {
  * - BootMemoryRegion::Type::Reserved always wins.
  * - The kernel image range and the DTB blob range are proactively reserved.
  *
+ * Allocation strategy (binary buddy system):
+ * - Free memory is kept as naturally-aligned blocks of 2^order pages on
+ *   per-order free lists (order 0 = one 4 KiB page).
+ * - "Naturally aligned" is with respect to the absolute physical frame number,
+ *   so an order-9 block is 2 MiB-aligned in physical address space.
+ * - Allocation pops the smallest sufficient block and splits it down;
+ *   freeing coalesces with the buddy block while the buddy is also free.
+ * - Both operations are O(kMaxBuddyOrder), independent of how full RAM is.
+ *
+ * NUMA zones:
+ * - Every UsableRAM region carries the NUMA node the boot map assigned it.
+ *   Each node has its own set of per-order free lists, and buddy blocks never
+ *   span two nodes (building and coalescing both stop at node boundaries).
+ * - AllocatePage()/AllocatePages() prefer the calling core's node (from the
+ *   boot map's /cpus affinities) and fall back to the other nodes in
+ *   ascending node-ID order when it is exhausted.
+ * - Systems without NUMA information are a single node 0.
+ *
+ * Pre-zeroed pool:
+ * - A small stack of frames that were zeroed ahead of time by
+ *   RefillZeroedPool() (called from the idle loop). AllocateZeroedPage() pops
+ *   one, so page-table and fault-path allocations skip the 4 KiB clear.
+ * - Pooled frames are allocated from the buddy allocator's point of view
+ *   (ref_count==1) and are not counted by FreePages().
+ *
+ * Page state bitmap (two levels):
+ * - Leaf level: one bit per tracked page in 64-bit words (1 = used).
+ * - Summary level: one bit per leaf word (1 = "leaf word has a free page").
+ * - Free-page searches (free-list construction, range checks) skip full words
+ *   via the summary and locate bits with count-trailing-zeros instead of
+ *   testing pages one at a time.
+ * - Range marking (initialization, block alloc/free) sets or clears whole
+ *   words at a time.
+ *
+ * Deferred frame metadata:
+ * - Frame metadata is initialized in sections of kFrameMetadataSectionPages
+ *   (one maximum-order buddy block, 1 GiB), aligned on the absolute frame
+ *   number so no buddy block or buddy pair ever spans two sections.
+ * - InitializeFromBootMemoryMap() initializes only the sections starting
+ *   within the eager limit (default kDefaultEagerFrameMetadataLimitBytes past
+ *   the tracked base). Pages in the other sections are marked in the bitmap
+ *   but are not on any free list yet.
+ * - Deferred sections are initialized by InitializeDeferredFrameMetadata()
+ *   (the idle loop calls it one section at a time), or on first touch: when
+ *   every free list is empty, or when a map-count update or ReserveRange()
+ *   lands in one.
+ *
  * Current limitations (intentional for early bring-up):
  * - Not SMP-safe (no locking).
- * - Linear scan allocation (no freelists / buddy allocator yet).
  * - Tracks only the span of UsableRAM it was initialized with.
+ * - Free-list links are 32-bit page indices; spans of 2^32 pages or more are
+ *   rejected at initialization.
+ * - Fallback order ignores the DTB distance-map: a remote node is a remote
+ *   node. Node IDs >= kMaxNumaNodes are folded into node 0.
+ * - The pre-zeroed pool is global, not per node or per CPU.
+ * - Until a deferred section is initialized, its pages do not count toward
+ *   node-local preference and are not visible to FreePagesOnNode() or
+ *   FreeBlockCountForOrder(). There are no secondary cores yet to split the
+ *   deferred work across.
  */
 class PhysicalMemoryManager final {
 	public:
@@ -42,7 +97,73 @@ class PhysicalMemoryManager final {
 		//   own metadata.
 		// - Tests should be able to compute expected metadata footprint without
 		//   reaching into private implementation details.
+		//
+		// With ROCINANTE_PMM_COMPACT_METADATA this is the sum of the hot-counter
+		// and cold-state entries for one frame (see FrameMetadataTable).
+#if defined(ROCINANTE_PMM_COMPACT_METADATA)
 		static constexpr std::size_t kPageFrameMetadataSizeBytes = 16;
+#else
+		static constexpr std::size_t kPageFrameMetadataSizeBytes = 24;
+#endif
+
+		// Largest buddy block order: 2^18 pages * 4 KiB = 1 GiB.
+		//
+		// This matches the largest LoongArch huge-page leaf we intend to back with
+		// a single contiguous allocation.
+		static constexpr std::size_t kMaxBuddyOrder = 18;
+		static constexpr std::size_t kBuddyOrderCount = kMaxBuddyOrder + 1;
+
+		// NUMA nodes with their own free lists. Loongson 3C5000 systems top out
+		// at four nodes per board; eight leaves headroom for dual-board systems.
+		static constexpr std::size_t kMaxNumaNodes = 8;
+
+		// Cores (CSR.CPUID.CoreID values) whose node affinity is tracked. Other
+		// cores are treated as node 0.
+		static constexpr std::size_t kMaxNumaCores = 64;
+
+		// Frames kept in the pre-zeroed pool. 64 frames = 256 KiB.
+		static constexpr std::size_t kZeroedPoolCapacityFrames = 64;
+
+		// Pages per frame-metadata section: one maximum-order buddy block.
+		static constexpr std::size_t kFrameMetadataSectionPages = static_cast<std::size_t>(1) << kMaxBuddyOrder;
+
+		// Sections needed to cover the largest tracked span (2^32 pages), plus
+		// one for a tracked base that is not section-aligned.
+		static constexpr std::size_t kMaxFrameMetadataSections = ((1ull << 32) / kFrameMetadataSectionPages) + 1;
+
+		// Sections starting this far past the tracked base are deferred.
+		static constexpr std::size_t kDefaultEagerFrameMetadataLimitBytes = 4ull * 1024 * 1024 * 1024;
+
+		/**
+		 * @brief InitializeFromBootMemoryMap() phase timing, in Stable Counter ticks.
+		 *
+		 * - storage_placement_ticks: choosing and filling bitmap/metadata storage.
+		 * - range_marking_ticks: applying UsableRAM/Reserved/kernel/DTB ranges.
+		 * - eager_metadata_ticks: initializing eager sections and their free lists.
+		 * - deferred_metadata_ticks: accumulated by every deferred section
+		 *   initialized since (idle loop or first touch).
+		 */
+		struct InitializationStatistics final {
+			std::uint64_t storage_placement_ticks = 0;
+			std::uint64_t range_marking_ticks = 0;
+			std::uint64_t eager_metadata_ticks = 0;
+			std::uint64_t deferred_metadata_ticks = 0;
+			std::size_t eager_sections = 0;
+			std::size_t deferred_sections = 0;
+		};
+
+		/**
+		 * @brief Pre-zeroed pool counters.
+		 *
+		 * - hits: AllocateZeroedPage() served from the pool.
+		 * - misses: AllocateZeroedPage() had to zero a frame synchronously.
+		 * - frames_prezeroed: frames zeroed by RefillZeroedPool().
+		 */
+		struct ZeroedPoolStatistics final {
+			std::uint64_t hits = 0;
+			std::uint64_t misses = 0;
+			std::uint64_t frames_prezeroed = 0;
+		};
 
 		PhysicalMemoryManager() = default;
 		~PhysicalMemoryManager() = default;
@@ -53,6 +174,30 @@ class PhysicalMemoryManager final {
 
 		bool IsInitialized() const { return m_initialized; }
 
+		/**
+		 * @brief Sets how much of the tracked span is initialized eagerly.
+		 *
+		 * Takes effect at the next InitializeFromBootMemoryMap(). 0 still
+		 * initializes the first section (the one holding the tracked base).
+		 */
+		void SetEagerFrameMetadataLimitBytes(std::size_t limit_bytes) { m_eager_frame_metadata_limit_bytes = limit_bytes; }
+
+		/**
+		 * @brief Initializes up to max_sections deferred metadata sections.
+		 *
+		 * Lowest section first. Their free pages join the free lists.
+		 *
+		 * Returns: number of sections initialized (0 once none are left).
+		 */
+		std::size_t InitializeDeferredFrameMetadata(std::size_t max_sections);
+
+		std::size_t DeferredFrameMetadataSectionCount() const { return m_deferred_section_count; }
+
+		// Free pages in sections that are not initialized yet (included in FreePages()).
+		std::size_t DeferredFreePages() const { return m_deferred_free_page_count; }
+
+		InitializationStatistics GetInitializationStatistics() const { return m_initialization_statistics; }
+
 		/**
 		 * @brief Initializes the PMM from a boot memory map.
 		 *
@@ -74,16 +219,129 @@ class PhysicalMemoryManager final {
 		);
 
 		// Allocates one physical page and returns its physical address.
+		//
+		// Prefers the calling core's NUMA node (see AllocatePagesPreferringNode).
 		Rocinante::Optional<std::uintptr_t> AllocatePage();
 
 		// Releases a page previously returned by AllocatePage().
 		bool FreePage(std::uintptr_t physical_address);
 
+		/**
+		 * @brief Allocates one page whose contents are all zero.
+		 *
+		 * Pops a frame from the pre-zeroed pool when one is available; otherwise
+		 * allocates a page and zeroes it before returning. Either way the result is
+		 * an ordinary page (ref_count==1) released via FreePage().
+		 */
+		Rocinante::Optional<std::uintptr_t> AllocateZeroedPage();
+
+		/**
+		 * @brief Allocates 2^order contiguous pages whose contents are all zero.
+		 *
+		 * Order 0 is AllocateZeroedPage(); larger blocks come from
+		 * AllocatePages(order) and are cleared before returning. Released like
+		 * any AllocatePages() block.
+		 */
+		Rocinante::Optional<std::uintptr_t> AllocateZeroedPages(std::size_t order);
+
+		// Clears page_count pages starting at the page-aligned physical_base
+		// (e.g. a frame taken from a PageFrameCache that must read as zeros).
+		void ZeroPages(std::uintptr_t physical_base, std::size_t page_count);
+
+		/**
+		 * @brief Zeroes up to max_frames free pages into the pre-zeroed pool.
+		 *
+		 * Intended for idle time: the caller bounds the work per call, so a
+		 * pending interrupt waits for at most one batch.
+		 *
+		 * Returns: number of frames added (0 if the pool is full or RAM is
+		 * exhausted).
+		 */
+		std::size_t RefillZeroedPool(std::size_t max_frames);
+
+		// Returns every pooled frame to the free lists.
+		void DrainZeroedPool();
+
+		std::size_t ZeroedPoolFrameCount() const { return m_zeroed_pool_count; }
+		ZeroedPoolStatistics GetZeroedPoolStatistics() const { return m_zeroed_pool_statistics; }
+		void ResetZeroedPoolStatistics() { m_zeroed_pool_statistics = ZeroedPoolStatistics{}; }
+
+		/**
+		 * @brief Allocates 2^order physically contiguous pages.
+		 *
+		 * The returned physical base is aligned to (2^order * kPageSizeBytes).
+		 * Every page in the block starts with ref_count==1 and map_count==0, so the
+		 * pages can also be released individually via FreePage().
+		 *
+		 * Returns nullopt if the PMM is not initialized, order > kMaxBuddyOrder, or
+		 * no free block of at least that order exists.
+		 *
+		 * Prefers the calling core's NUMA node (see AllocatePagesPreferringNode).
+		 */
+		Rocinante::Optional<std::uintptr_t> AllocatePages(std::size_t order);
+
+		/**
+		 * @brief Allocates 2^order contiguous pages, preferring one NUMA node.
+		 *
+		 * Search order:
+		 * 1) every order >= `order` on `preferred_node` (splitting a large local
+		 *    block is cheaper over the block's lifetime than a remote page);
+		 * 2) the same on every other node, in ascending node-ID order.
+		 *
+		 * An out-of-range preferred_node simply has nothing to offer, so the
+		 * search starts with the fallback.
+		 */
+		Rocinante::Optional<std::uintptr_t> AllocatePagesPreferringNode(std::size_t order, std::size_t preferred_node);
+
+		/**
+		 * @brief Releases a block previously returned by AllocatePages(order).
+		 *
+		 * Drops one reference from every page in the block. Pages whose ref_count
+		 * reaches zero are returned to the free pool (coalescing with their buddies).
+		 *
+		 * Returns false (and changes nothing) if:
+		 * - the PMM is not initialized or order > kMaxBuddyOrder,
+		 * - physical_address is not aligned to the block size,
+		 * - the block is not entirely within the tracked span, or
+		 * - any page in the block is free, or would be freed while still mapped.
+		 */
+		bool FreePages(std::uintptr_t physical_address, std::size_t order);
+
 		// Explicitly reserves a physical range (marks its pages non-allocatable).
 		bool ReserveRange(std::uintptr_t physical_base, std::size_t size_bytes);
 
 		std::size_t TotalPages() const { return m_page_count; }
-		std::size_t FreePages() const { return m_free_page_count; }
+		std::size_t FreePages() const { return m_free_page_count + m_deferred_free_page_count; }
+
+		// Number of free blocks currently on the order-N free lists of all nodes
+		// (0 if order is out of range). Intended for diagnostics and tests.
+		std::size_t FreeBlockCountForOrder(std::size_t order) const;
+
+		// One more than the highest NUMA node ID owning tracked RAM (1 when the
+		// boot map carried no NUMA information).
+		std::size_t NumaNodeCount() const { return m_numa_node_count; }
+
+		// Free pages on one node (0 if node >= kMaxNumaNodes).
+		std::size_t FreePagesOnNode(std::size_t numa_node) const;
+
+		// NUMA node of a tracked page-aligned physical address.
+		Rocinante::Optional<std::uint32_t> NumaNodeForPhysical(std::uintptr_t physical_page_base) const;
+
+		// NUMA node of a core (0 for cores without a recorded affinity).
+		std::size_t NumaNodeForCore(std::size_t core_id) const;
+
+		// NUMA node of the calling core (CSR.CPUID.CoreID).
+		std::size_t CurrentNumaNode() const;
+
+		/**
+		 * @brief Overrides a core's NUMA node.
+		 *
+		 * InitializeFromBootMemoryMap() loads the affinities from the boot map;
+		 * this is for tests and for firmware that does not describe them.
+		 *
+		 * Returns false if core_id >= kMaxNumaCores or numa_node >= kMaxNumaNodes.
+		 */
+		bool SetNumaNodeForCore(std::size_t core_id, std::size_t numa_node);
 
 		std::uintptr_t TrackedPhysicalBase() const { return m_tracked_physical_base; }
 		std::uintptr_t TrackedPhysicalLimit() const { return m_tracked_physical_limit; }
@@ -166,16 +424,159 @@ class PhysicalMemoryManager final {
 		Rocinante::Optional<std::uint32_t> MapCountForPhysical(std::uintptr_t physical_page_base) const;
 
 	private:
+		// Sentinel for "no page" in the 32-bit free-list links.
+		static constexpr std::uint32_t kInvalidPageIndex = static_cast<std::uint32_t>(-1);
+
+		// Per-frame flags bits.
+		//
+		// kFrameFlagFreeBlockHead: this page is the first page of a free buddy
+		// block that is currently linked on
+		// m_free_list_head[numa_node_id][buddy_order]. Only block heads carry this
+		// flag; the other pages of a free block have flags==0.
+		static constexpr std::uint8_t kFrameFlagFreeBlockHead = (1u << 0);
+
+#if defined(ROCINANTE_PMM_COMPACT_METADATA)
+		// Compact layout: two parallel arrays in one reservation.
+		//
+		// - Hot array: ref/map counters, 4 bytes per frame. This is all that
+		//   RetainPhysicalPage()/IncrementMapCountForPhysical() and friends
+		//   touch, so 16 frames share a 64-byte cache line instead of 2-3.
+		// - Cold array: buddy state, 12 bytes per frame, touched only by the
+		//   allocate/free paths.
+		//
+		// Explicit flaw: counters saturate at 65535. Retain/Increment fail past
+		// that, exactly as they do at 2^32-1 in the default layout.
+		struct PageFrameCounters final {
+			std::uint16_t ref_count = 0;
+			std::uint16_t map_count = 0;
+		};
+		struct PageFrameState final {
+			// Free-list links (page indices), valid only for free block heads.
+			std::uint32_t free_list_next = kInvalidPageIndex;
+			std::uint32_t free_list_prev = kInvalidPageIndex;
+			std::uint8_t flags = 0;
+			std::uint8_t buddy_order = 0;
+			// Fixed at initialization from the page's UsableRAM region; survives
+			// every allocate/free cycle.
+			std::uint8_t numa_node_id = 0;
+			std::uint8_t reserved = 0;
+		};
+		static_assert(sizeof(PageFrameCounters) + sizeof(PageFrameState) == kPageFrameMetadataSizeBytes);
+		static_assert(alignof(PageFrameState) <= sizeof(PageFrameCounters));
+
+		// Accessors over [PageFrameCounters x page_count][PageFrameState x page_count].
+		struct FrameMetadataTable final {
+			static constexpr std::uint32_t kMaxCount = static_cast<std::uint16_t>(-1);
+
+			PageFrameCounters* counters = nullptr;
+			PageFrameState* state = nullptr;
+
+			static FrameMetadataTable FromStorage(std::uintptr_t storage, std::size_t page_count) {
+				auto* counters = reinterpret_cast<PageFrameCounters*>(storage);
+				return FrameMetadataTable{
+					.counters = counters,
+					.state = reinterpret_cast<PageFrameState*>(counters + page_count),
+				};
+			}
+
+			explicit operator bool() const { return counters != nullptr; }
+
+			std::uint32_t RefCount(std::size_t i) const { return counters[i].ref_count; }
+			void SetRefCount(std::size_t i, std::uint32_t v) { counters[i].ref_count = static_cast<std::uint16_t>(v); }
+			std::uint32_t MapCount(std::size_t i) const { return counters[i].map_count; }
+			void SetMapCount(std::size_t i, std::uint32_t v) { counters[i].map_count = static_cast<std::uint16_t>(v); }
+
+			std::uint8_t Flags(std::size_t i) const { return state[i].flags; }
+			std::uint8_t BuddyOrder(std::size_t i) const { return state[i].buddy_order; }
+			std::uint8_t NumaNode(std::size_t i) const { return state[i].numa_node_id; }
+			void SetNumaNode(std::size_t i, std::uint8_t node) { state[i].numa_node_id = node; }
+			std::uint32_t FreeListNext(std::size_t i) const { return state[i].free_list_next; }
+			void SetFreeListNext(std::size_t i, std::uint32_t v) { state[i].free_list_next = v; }
+			std::uint32_t FreeListPrev(std::size_t i) const { return state[i].free_list_prev; }
+			void SetFreeListPrev(std::size_t i, std::uint32_t v) { state[i].free_list_prev = v; }
+
+			void SetBuddyState(std::size_t i, std::uint8_t flags, std::uint8_t order) {
+				state[i].flags = flags;
+				state[i].buddy_order = order;
+			}
+
+			void Clear(std::size_t i) {
+				counters[i] = PageFrameCounters{};
+				state[i] = PageFrameState{};
+			}
+
+			// Resets everything except the NUMA node.
+			void ClearKeepingNode(std::size_t i) {
+				const std::uint8_t numa_node_id = state[i].numa_node_id;
+				counters[i] = PageFrameCounters{};
+				state[i] = PageFrameState{};
+				state[i].numa_node_id = numa_node_id;
+			}
+		};
+#else
 		struct PageFrameMetadata final {
 			std::uint32_t ref_count = 0;
 			std::uint32_t map_count = 0;
 			std::uint32_t flags = 0;
-			std::uint32_t reserved = 0;
+			std::uint8_t buddy_order = 0;
+			// Fixed at initialization from the page's UsableRAM region; survives
+			// every allocate/free cycle.
+			std::uint8_t numa_node_id = 0;
+			std::uint16_t reserved = 0;
+			// Free-list links (page indices), valid only for free block heads.
+			std::uint32_t free_list_next = kInvalidPageIndex;
+			std::uint32_t free_list_prev = kInvalidPageIndex;
 		};
 		static_assert(sizeof(PageFrameMetadata) == kPageFrameMetadataSizeBytes);
 
+		// Accessors over a PageFrameMetadata array. The PMM only goes through
+		// this interface so the compact layout can be swapped in at build time.
+		struct FrameMetadataTable final {
+			static constexpr std::uint32_t kMaxCount = static_cast<std::uint32_t>(-1);
+
+			PageFrameMetadata* frames = nullptr;
+
+			static FrameMetadataTable FromStorage(std::uintptr_t storage, std::size_t) {
+				return FrameMetadataTable{.frames = reinterpret_cast<PageFrameMetadata*>(storage)};
+			}
+
+			explicit operator bool() const { return frames != nullptr; }
+
+			std::uint32_t RefCount(std::size_t i) const { return frames[i].ref_count; }
+			void SetRefCount(std::size_t i, std::uint32_t v) { frames[i].ref_count = v; }
+			std::uint32_t MapCount(std::size_t i) const { return frames[i].map_count; }
+			void SetMapCount(std::size_t i, std::uint32_t v) { frames[i].map_count = v; }
+
+			std::uint8_t Flags(std::size_t i) const { return static_cast<std::uint8_t>(frames[i].flags); }
+			std::uint8_t BuddyOrder(std::size_t i) const { return frames[i].buddy_order; }
+			std::uint8_t NumaNode(std::size_t i) const { return frames[i].numa_node_id; }
+			void SetNumaNode(std::size_t i, std::uint8_t node) { frames[i].numa_node_id = node; }
+			std::uint32_t FreeListNext(std::size_t i) const { return frames[i].free_list_next; }
+			void SetFreeListNext(std::size_t i, std::uint32_t v) { frames[i].free_list_next = v; }
+			std::uint32_t FreeListPrev(std::size_t i) const { return frames[i].free_list_prev; }
+			void SetFreeListPrev(std::size_t i, std::uint32_t v) { frames[i].free_list_prev = v; }
+
+			void SetBuddyState(std::size_t i, std::uint8_t flags, std::uint8_t order) {
+				frames[i].flags = flags;
+				frames[i].buddy_order = order;
+			}
+
+			void Clear(std::size_t i) { frames[i] = PageFrameMetadata{}; }
+
+			// Resets everything except the NUMA node.
+			void ClearKeepingNode(std::size_t i) {
+				const std::uint8_t numa_node_id = frames[i].numa_node_id;
+				frames[i] = PageFrameMetadata{};
+				frames[i].numa_node_id = numa_node_id;
+			}
+		};
+#endif
+
+		// Bitmap storage layout: [leaf words][summary words], all std::uint64_t.
 		std::uintptr_t m_bitmap_physical_base = 0;
 		std::size_t m_bitmap_size_bytes = 0;
+		std::size_t m_bitmap_leaf_word_count = 0;
+		std::size_t m_bitmap_summary_word_count = 0;
 
 		std::uintptr_t m_frame_metadata_physical_base = 0;
 		std::size_t m_frame_metadata_size_bytes = 0;
@@ -185,13 +586,46 @@ class PhysicalMemoryManager final {
 
 		std::size_t m_page_count = 0;
 		std::size_t m_free_page_count = 0;
-		std::size_t m_next_search_index = 0;
 		bool m_initialized = false;
 
-		std::uint8_t* _bitmap_ptr();
-		const std::uint8_t* _bitmap_ptr() const;
-		PageFrameMetadata* _frame_metadata_ptr();
-		const PageFrameMetadata* _frame_metadata_ptr() const;
+		// Per-node, per-order free lists of buddy block heads (page indices).
+		std::uint32_t m_free_list_head[kMaxNumaNodes][kBuddyOrderCount] = {};
+		std::size_t m_free_block_count[kMaxNumaNodes][kBuddyOrderCount] = {};
+		std::size_t m_free_page_count_by_node[kMaxNumaNodes] = {};
+
+		// Page-index ranges of the UsableRAM regions and their nodes. Used to keep
+		// buddy blocks from straddling a node boundary while building free lists.
+		struct NumaZone final {
+			std::size_t page_index_begin = 0;
+			std::size_t page_index_end = 0;
+			std::uint8_t numa_node_id = 0;
+		};
+		NumaZone m_numa_zones[BootMemoryMap::kMaxRegions] = {};
+		std::size_t m_numa_zone_count = 0;
+		std::size_t m_numa_node_count = 1;
+
+		std::uint8_t m_numa_node_by_core[kMaxNumaCores] = {};
+
+		// Pre-zeroed pool (LIFO stack of physical page bases).
+		std::uintptr_t m_zeroed_pool[kZeroedPoolCapacityFrames] = {};
+		std::size_t m_zeroed_pool_count = 0;
+		ZeroedPoolStatistics m_zeroed_pool_statistics{};
+
+		// Metadata sections, indexed from the section holding the tracked base.
+		static constexpr std::size_t kFrameMetadataSectionWordCount = (kMaxFrameMetadataSections + 63) / 64;
+		std::uint64_t m_frame_metadata_section_ready[kFrameMetadataSectionWordCount] = {};
+		std::size_t m_frame_metadata_section_count = 0;
+		std::size_t m_deferred_section_count = 0;
+		std::size_t m_deferred_free_page_count = 0;
+		InitializationStatistics m_initialization_statistics{};
+
+		// Policy knob, not state: survives _reset_state().
+		std::size_t m_eager_frame_metadata_limit_bytes = kDefaultEagerFrameMetadataLimitBytes;
+
+		std::uint64_t* _bitmap_ptr();
+		const std::uint64_t* _bitmap_ptr() const;
+		FrameMetadataTable _frame_metadata_table() const;
+		void _zero_page(std::uintptr_t physical_page_base);
 
 		bool _allocate_bitmap(
 			const BootMemoryMap& boot_map,
@@ -210,10 +644,22 @@ class PhysicalMemoryManager final {
 			std::size_t device_tree_size_bytes
 		);
 		void _reset_state();
+		void _assign_numa_zones(const BootMemoryMap& boot_map);
+		bool _page_range_is_on_numa_node(std::size_t index_begin, std::size_t index_end, std::size_t numa_node) const;
+		Rocinante::Optional<std::uintptr_t> _allocate_from_node(FrameMetadataTable metadata, std::size_t order, std::size_t numa_node);
 
 		bool _mark_range_free(std::uintptr_t physical_base, std::size_t size_bytes);
 		bool _mark_range_used(std::uintptr_t physical_base, std::size_t size_bytes);
 
+		std::size_t _frame_metadata_section_for_page(std::size_t page_index) const;
+		void _frame_metadata_section_page_range(std::size_t section, std::size_t* out_index_begin, std::size_t* out_index_end) const;
+		bool _frame_metadata_section_is_ready(std::size_t section) const;
+		std::size_t _initialize_frame_metadata_section(FrameMetadataTable metadata, std::size_t section);
+		void _initialize_deferred_section(FrameMetadataTable metadata, std::size_t section);
+		bool _initialize_next_deferred_section(FrameMetadataTable metadata);
+		void _ensure_frame_metadata_for_page(FrameMetadataTable metadata, std::size_t page_index);
+		std::size_t _numa_node_for_page_from_zones(std::size_t page_index) const;
+
 		bool _physical_range_to_page_indices(
 			std::uintptr_t physical_base,
 			std::size_t size_bytes,
@@ -223,10 +669,24 @@ class PhysicalMemoryManager final {
 
 		bool _is_page_used(std::size_t page_index) const;
 		void _set_page_used(std::size_t page_index);
-		void _set_page_free(std::size_t page_index);
+		void _set_page_range_used(std::size_t index_begin, std::size_t index_end);
+		void _set_page_range_free(std::size_t index_begin, std::size_t index_end);
+		std::size_t _count_free_pages(std::size_t index_begin, std::size_t index_end) const;
+		bool _find_next_free_page(std::size_t page_index_begin, std::size_t* out_page_index) const;
+		bool _page_range_is_free(std::size_t index_begin, std::size_t index_end) const;
 
 		std::uintptr_t _page_index_to_physical(std::size_t page_index) const;
 		std::size_t _physical_to_page_index(std::uintptr_t physical_address) const;
+
+		bool _page_index_is_block_aligned(std::size_t page_index, std::size_t order) const;
+		bool _buddy_page_index(std::size_t page_index, std::size_t order, std::size_t* out_buddy_index) const;
+
+		void _free_list_push(FrameMetadataTable metadata, std::size_t page_index, std::size_t order);
+		void _free_list_remove(FrameMetadataTable metadata, std::size_t page_index, std::size_t order);
+
+		void _release_block(FrameMetadataTable metadata, std::size_t page_index, std::size_t order);
+		bool _carve_free_page(FrameMetadataTable metadata, std::size_t page_index);
+		void _build_free_lists(FrameMetadataTable metadata, std::size_t index_begin, std::size_t index_end);
 };
 
 // Returns the single canonical PMM instance for the kernel.
@@ -0,0 +1,238 @@
+/**
+ * Copyright (C) 2026 Andrew S. Rightenburg
+ * GPL-3.0-or-later
+ */
+
+#include "slab.h"
+
+#include <src/memory/physmap.h>
+
+namespace Rocinante::Memory {
+
+namespace {
+
+// "SLAB" + "PAGE" in ASCII; distinguishes slab pages from arbitrary memory.
+constexpr std::uint64_t kSlabMagic = 0x534C414250414745ull;
+
+constexpr std::size_t kSizeClassObjectSizes[SlabAllocator::kSizeClassCount] = {
+	16, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024,
+};
+
+static_assert(kSizeClassObjectSizes[SlabAllocator::kSizeClassCount - 1] == SlabAllocator::kMaxObjectSizeBytes);
+
+// Size-to-class lookup in 16-byte granules, so picking a class is one load
+// rather than a search.
+constexpr std::size_t kSizeGranuleBytes = SlabAllocator::kObjectAlignmentBytes;
+constexpr std::size_t kSizeGranuleCount = (SlabAllocator::kMaxObjectSizeBytes / kSizeGranuleBytes) + 1;
+
+struct SizeClassLookup final {
+	std::uint8_t class_for_granule[kSizeGranuleCount] = {};
+};
+
+constexpr SizeClassLookup BuildSizeClassLookup() {
+	SizeClassLookup lookup;
+	std::size_t class_index = 0;
+	for (std::size_t granule = 0; granule < kSizeGranuleCount; granule++) {
+		while (kSizeClassObjectSizes[class_index] < granule * kSizeGranuleBytes) class_index++;
+		lookup.class_for_granule[granule] = static_cast<std::uint8_t>(class_index);
+	}
+	return lookup;
+}
+
+constexpr SizeClassLookup kSizeClassLookup = BuildSizeClassLookup();
+
+static_assert(kSizeClassLookup.class_for_granule[0] == 0);
+static_assert(kSizeClassLookup.class_for_granule[kSizeGranuleCount - 1] == SlabAllocator::kSizeClassCount - 1);
+
+inline std::size_t SizeClassForSize(std::size_t size_bytes) {
+	return kSizeClassLookup.class_for_granule[(size_bytes + (kSizeGranuleBytes - 1)) / kSizeGranuleBytes];
+}
+
+} // namespace
+
+SlabAllocator& GetSlabAllocator() {
+	static SlabAllocator instance;
+	return instance;
+}
+
+void SlabAllocator::Initialize(PhysicalMemoryManager* pmm) {
+	m_pmm = pmm;
+	for (std::size_t i = 0; i < kSizeClassCount; i++) {
+		m_size_classes[i] = SizeClass{};
+	}
+}
+
+std::size_t SlabAllocator::SizeClassObjectSize(std::size_t class_index) {
+	if (class_index >= kSizeClassCount) return 0;
+	return kSizeClassObjectSizes[class_index];
+}
+
+void SlabAllocator::_partial_push(SlabHeader* slab) {
+	SizeClass& size_class = m_size_classes[slab->size_class];
+	slab->prev_partial = nullptr;
+	slab->next_partial = size_class.partial_head;
+	if (size_class.partial_head) size_class.partial_head->prev_partial = slab;
+	size_class.partial_head = slab;
+}
+
+void SlabAllocator::_partial_remove(SlabHeader* slab) {
+	SizeClass& size_class = m_size_classes[slab->size_class];
+	if (slab->prev_partial) {
+		slab->prev_partial->next_partial = slab->next_partial;
+	} else {
+		size_class.partial_head = slab->next_partial;
+	}
+	if (slab->next_partial) slab->next_partial->prev_partial = slab->prev_partial;
+	slab->next_partial = nullptr;
+	slab->prev_partial = nullptr;
+}
+
+SlabAllocator::SlabHeader* SlabAllocator::_grow(std::size_t class_index) {
+	const auto page_or = m_pmm->AllocatePage();
+	if (!page_or.has_value()) return nullptr;
+
+	const std::uintptr_t physical_base = page_or.value();
+	const std::uintptr_t virtual_base = Physmap::KernelVirtualForPhysical(physical_base);
+	const std::size_t object_size = kSizeClassObjectSizes[class_index];
+	const std::size_t capacity = (kSlabSizeBytes - sizeof(SlabHeader)) / object_size;
+
+	auto* slab = reinterpret_cast<SlabHeader*>(virtual_base);
+	*slab = SlabHeader{};
+	slab->magic = kSlabMagic;
+	slab->owner = this;
+	slab->physical_base = physical_base;
+	slab->size_class = static_cast<std::uint16_t>(class_index);
+	slab->object_capacity = static_cast<std::uint16_t>(capacity);
+
+	// Thread the free list front-to-back so the first allocations walk the
+	// page in address order.
+	auto* first_object = reinterpret_cast<std::uint8_t*>(virtual_base) + sizeof(SlabHeader);
+	void* next = nullptr;
+	for (std::size_t i = capacity; i > 0; i--) {
+		void* object = first_object + ((i - 1) * object_size);
+		*static_cast<void**>(object) = next;
+		next = object;
+	}
+	slab->free_list = next;
+
+	SizeClass& size_class = m_size_classes[class_index];
+	size_class.slab_count++;
+	size_class.objects_free += capacity;
+	_partial_push(slab);
+	return slab;
+}
+
+void SlabAllocator::_release_slab(SlabHeader* slab) {
+	SizeClass& size_class = m_size_classes[slab->size_class];
+	_partial_remove(slab);
+	size_class.slab_count--;
+	size_class.objects_free -= slab->object_capacity;
+
+	const std::uintptr_t physical_base = slab->physical_base;
+	slab->magic = 0;
+	slab->owner = nullptr;
+	(void)m_pmm->FreePage(physical_base);
+}
+
+void* SlabAllocator::Allocate(std::size_t size_bytes) {
+	if (!m_pmm || size_bytes > kMaxObjectSizeBytes) return nullptr;
+
+	const std::size_t class_index = SizeClassForSize(size_bytes);
+	SizeClass& size_class = m_size_classes[class_index];
+
+	SlabHeader* slab = size_class.partial_head;
+	if (!slab) {
+		slab = _grow(class_index);
+		if (!slab) return nullptr;
+	}
+
+	void* object = slab->free_list;
+	slab->free_list = *static_cast<void**>(object);
+	slab->objects_in_use++;
+	size_class.objects_in_use++;
+	size_class.objects_free--;
+
+	// Full slabs leave the partial list; Free() puts them back.
+	if (!slab->free_list) _partial_remove(slab);
+	return object;
+}
+
+const SlabAllocator::SlabHeader* SlabAllocator::_header_for(const void* ptr) const {
+	if (!m_pmm || !ptr) return nullptr;
+	const auto address = reinterpret_cast<std::uintptr_t>(ptr);
+
+	// Only dereference the candidate header if it lies in PMM-tracked RAM:
+	// callers (Heap::Free) may hand us pointers that were never slab objects.
+	const auto physical_or = Physmap::PhysicalForKernelVirtual(address);
+	if (!physical_or.has_value()) return nullptr;
+	if (physical_or.value() < m_pmm->TrackedPhysicalBase() || physical_or.value() >= m_pmm->TrackedPhysicalLimit()) return nullptr;
+
+	const auto* slab = reinterpret_cast<const SlabHeader*>(address & ~(static_cast<std::uintptr_t>(kSlabSizeBytes) - 1));
+	if (slab->magic != kSlabMagic || slab->owner != this) return nullptr;
+
+	// Reject pointers into the header or not on a slot boundary.
+	const auto* first_object = reinterpret_cast<const std::uint8_t*>(slab) + sizeof(SlabHeader);
+	if (reinterpret_cast<const std::uint8_t*>(ptr) < first_object) return nullptr;
+	const auto offset = static_cast<std::size_t>(reinterpret_cast<const std::uint8_t*>(ptr) - first_object);
+	const std::size_t object_size = kSizeClassObjectSizes[slab->size_class];
+	if ((offset % object_size) != 0 || (offset / object_size) >= slab->object_capacity) return nullptr;
+	return slab;
+}
+
+bool SlabAllocator::Owns(const void* ptr) const {
+	return _header_for(ptr) != nullptr;
+}
+
+std::size_t SlabAllocator::ObjectSize(const void* ptr) const {
+	const SlabHeader* slab = _header_for(ptr);
+	if (!slab) return 0;
+	return kSizeClassObjectSizes[slab->size_class];
+}
+
+bool SlabAllocator::Free(void* ptr) {
+	if (!m_pmm) return false;
+	auto* slab = const_cast<SlabHeader*>(_header_for(ptr));
+	if (!slab) return false;
+
+	SizeClass& size_class = m_size_classes[slab->size_class];
+	const bool was_full = (slab->free_list == nullptr);
+	*static_cast<void**>(ptr) = slab->free_list;
+	slab->free_list = ptr;
+	slab->objects_in_use--;
+	size_class.objects_in_use--;
+	size_class.objects_free++;
+
+	if (was_full) _partial_push(slab);
+
+	// Keep the class's last partial slab even when empty: an alloc/free pair
+	// straddling a page boundary would otherwise round-trip the PMM each time.
+	if (slab->objects_in_use == 0 && (size_class.partial_head != slab || slab->next_partial != nullptr)) {
+		_release_slab(slab);
+	}
+	return true;
+}
+
+void SlabAllocator::ReleaseEmptySlabs() {
+	if (!m_pmm) return;
+	for (std::size_t class_index = 0; class_index < kSizeClassCount; class_index++) {
+		SlabHeader* slab = m_size_classes[class_index].partial_head;
+		while (slab) {
+			SlabHeader* next = slab->next_partial;
+			if (slab->objects_in_use == 0) _release_slab(slab);
+			slab = next;
+		}
+	}
+}
+
+SlabAllocator::SizeClassStatistics SlabAllocator::StatisticsForSizeClass(std::size_t class_index) const {
+	if (class_index >= kSizeClassCount) return SizeClassStatistics{};
+	const SizeClass& size_class = m_size_classes[class_index];
+	SizeClassStatistics statistics;
+	statistics.object_size_bytes = kSizeClassObjectSizes[class_index];
+	statistics.objects_in_use = size_class.objects_in_use;
+	statistics.objects_free = size_class.objects_free;
+	statistics.slab_count = size_class.slab_count;
+	return statistics;
+}
+
+} // namespace Rocinante::Memory
@@ -0,0 +1,158 @@
+/**
+ * Copyright (C) 2026 Andrew S. Rightenburg
+ * GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <src/memory/pmm.h>
+
+namespace Rocinante::Memory {
+
+/**
+ * @brief Size-class slab allocator for small kernel objects.
+ *
+ * Sits in front of the boundary-tag heap: Heap::Alloc() routes requests of at
+ * most kMaxObjectSizeBytes (with at most kObjectAlignmentBytes alignment) here
+ * once the allocator is initialized, and everything else falls through to the
+ * heap.
+ *
+ * Layout:
+ * - A slab is one 4 KiB PMM page: a SlabHeader followed by equal-size object
+ *   slots of one size class.
+ * - Free slots form an intrusive singly-linked list threaded through the
+ *   slots themselves, so Allocate() and Free() are a pointer pop and push.
+ * - Free() finds the header by rounding the object pointer down to the page
+ *   boundary; no lookup structure is needed.
+ * - Each size class keeps a list of slabs with at least one free slot. Full
+ *   slabs are on no list until one of their objects is freed.
+ *
+ * Size classes are the powers of two from 16 to 1024 plus the 1.5x steps in
+ * between (48, 96, 192, ...), which is where small kernel structs tend to land.
+ *
+ * Page access:
+ * - Slab pages are touched through the physmap once paging is on, and
+ *   directly (physical == virtual) in direct address translation mode.
+ *
+ * Current limitations (intentional for early bring-up):
+ * - Not SMP-safe (no locking), like the heap it fronts.
+ * - A slab whose last object is freed goes back to the PMM unless it is the
+ *   size class's only partially-used slab, which is kept to avoid thrashing
+ *   at a page boundary. ReleaseEmptySlabs() returns those too.
+ */
+class SlabAllocator final {
+	public:
+		static constexpr std::size_t kSlabSizeBytes = PhysicalMemoryManager::kPageSizeBytes;
+		static constexpr std::size_t kObjectAlignmentBytes = 16;
+		static constexpr std::size_t kMaxObjectSizeBytes = 1024;
+		static constexpr std::size_t kSizeClassCount = 12;
+
+		/**
+		 * @brief Per-size-class counters.
+		 *
+		 * - objects_in_use: allocated and not yet freed.
+		 * - objects_free: free slots across this class's slabs.
+		 * - slab_count: PMM pages currently owned by this class.
+		 */
+		struct SizeClassStatistics final {
+			std::size_t object_size_bytes = 0;
+			std::size_t objects_in_use = 0;
+			std::size_t objects_free = 0;
+			std::size_t slab_count = 0;
+		};
+
+		SlabAllocator() = default;
+		~SlabAllocator() = default;
+		SlabAllocator(const SlabAllocator&) = delete;
+		SlabAllocator& operator=(const SlabAllocator&) = delete;
+		SlabAllocator(SlabAllocator&&) = delete;
+		SlabAllocator& operator=(SlabAllocator&&) = delete;
+
+		/**
+		 * @brief Binds the allocator to a PMM and forgets every slab.
+		 *
+		 * Slabs from a previous binding are discarded without being returned
+		 * (the usual reason to re-initialize is that the PMM itself was
+		 * re-initialized).
+		 */
+		void Initialize(PhysicalMemoryManager* pmm);
+
+		bool IsInitialized() const { return m_pmm != nullptr; }
+
+		// True if a request of this size and alignment is served by a size class.
+		static constexpr bool Handles(std::size_t size_bytes, std::size_t alignment) {
+			return size_bytes <= kMaxObjectSizeBytes && alignment <= kObjectAlignmentBytes;
+		}
+
+		// Object size of a size class (0 if class_index is out of range).
+		static std::size_t SizeClassObjectSize(std::size_t class_index);
+
+		/**
+		 * @brief Allocates one object of at least size_bytes.
+		 *
+		 * Returns nullptr if the allocator is not initialized, size_bytes is
+		 * larger than kMaxObjectSizeBytes, or the PMM is out of pages.
+		 */
+		void* Allocate(std::size_t size_bytes);
+
+		/**
+		 * @brief Frees an object returned by Allocate().
+		 *
+		 * Returns false (and changes nothing) if ptr does not point into a slab
+		 * owned by this allocator.
+		 */
+		bool Free(void* ptr);
+
+		// True if ptr points into a slab owned by this allocator.
+		bool Owns(const void* ptr) const;
+
+		// Object size of ptr's size class, or 0 if ptr is not one of this
+		// allocator's objects.
+		std::size_t ObjectSize(const void* ptr) const;
+
+		// Returns every slab with no objects in use to the PMM.
+		void ReleaseEmptySlabs();
+
+		// Returns a zeroed SizeClassStatistics for class_index >= kSizeClassCount.
+		SizeClassStatistics StatisticsForSizeClass(std::size_t class_index) const;
+
+	private:
+		// Slab page header. Padded to 64 bytes so the first slot (and every
+		// slot, since sizes are multiples of 16) is 16-byte aligned.
+		struct alignas(64) SlabHeader final {
+			std::uint64_t magic = 0;
+			const SlabAllocator* owner = nullptr;
+			std::uintptr_t physical_base = 0;
+			SlabHeader* next_partial = nullptr;
+			SlabHeader* prev_partial = nullptr;
+			void* free_list = nullptr;
+			std::uint16_t size_class = 0;
+			std::uint16_t objects_in_use = 0;
+			std::uint16_t object_capacity = 0;
+		};
+		static_assert(sizeof(SlabHeader) == 64);
+
+		struct SizeClass final {
+			SlabHeader* partial_head = nullptr;
+			std::size_t objects_in_use = 0;
+			std::size_t objects_free = 0;
+			std::size_t slab_count = 0;
+		};
+
+		PhysicalMemoryManager* m_pmm = nullptr;
+		SizeClass m_size_classes[kSizeClassCount] = {};
+
+		SlabHeader* _grow(std::size_t class_index);
+		void _release_slab(SlabHeader* slab);
+		void _partial_push(SlabHeader* slab);
+		void _partial_remove(SlabHeader* slab);
+		const SlabHeader* _header_for(const void* ptr) const;
+};
+
+// Returns the single canonical slab allocator for the kernel heap.
+SlabAllocator& GetSlabAllocator();
+
+} // namespace Rocinante::Memory
@@ -9,9 +9,9 @@
 #include <cstdint>
 
 #include <src/helpers/optional.h>
+#include <src/memory/page_frame_cache.h>
+#include <src/memory/physmap.h>
 #include <src/memory/pmm.h>
-#include <src/memory/virtual_layout.h>
-#include <src/sp/cpucfg.h>
 
 namespace Rocinante::Memory {
 
@@ -20,12 +20,21 @@ namespace Rocinante::Memory {
  *
  * - This object owns physical frames for an anonymous mapping.
  * - Frames are indexed by page offset (0 == first 4 KiB page in the object).
- * - On first access to an offset, the object allocates one PMM page and keeps
- *   its `ref_count` until the object releases it.
+ * - On first access to an offset, the object allocates one zeroed PMM page and
+ *   keeps its `ref_count` until the object releases it. Anonymous memory reads
+ *   as zeros until it is written, whichever access touched it first.
+ *
+ * Copy-on-write:
+ * - CloneFrom() makes this object reference every frame of another object
+ *   (one more `ref_count` each) without copying data.
+ * - A frame is shared while its `ref_count` is above 1. Shared frames must be
+ *   mapped read-only (D=0); BreakCopyOnWriteForPageOffset() gives the object
+ *   its own copy before the first store.
  *
  * Non-goals / bring-up limitations:
- * - No copy-on-write, no sharing, no file backing.
- * - No sharing / fork semantics.
+ * - No file backing.
+ * - No shadow objects: sharing is tracked per frame, so a clone costs one
+ *   `ref_count` increment (and one directory entry) per resident page.
  *
  * Data structure:
  * - Multi-level paged radix directory.
@@ -55,71 +64,183 @@ class AnonymousVmObject final {
 		 * Args:
 		 * - pmm: the PMM used for frame allocation.
 		 * - page_offset: 0-based page index within the object (units: 4 KiB pages).
+		 * - frame_cache: optional per-CPU frame cache used for the payload frame
+		 *   (fault-path fast path) when the PMM's pre-zeroed pool is empty; the
+		 *   frame is cleared before use. Directory pages always come from `pmm`.
+		 *
+		 * A created frame is all zeros.
 		 */
 		Rocinante::Optional<GetOrCreateFrameResult> GetOrCreateFrameForPageOffset(
 			PhysicalMemoryManager* pmm,
-			std::size_t page_offset
+			std::size_t page_offset,
+			PageFrameCache* frame_cache = nullptr
+		) {
+			std::uintptr_t* const slot = FrameSlotForPageOffset(pmm, page_offset);
+			if (!slot) return Rocinante::nullopt;
+
+			const std::uintptr_t existing = *slot;
+			if (existing != 0) {
+				return Rocinante::Optional<GetOrCreateFrameResult>(
+					GetOrCreateFrameResult{.physical_page_base = existing, .created = false}
+				);
+			}
+
+			// A pre-zeroed frame beats a cached one that still has to be cleared.
+			const bool from_cache = frame_cache && pmm->ZeroedPoolFrameCount() == 0;
+			const auto allocated_frame = from_cache ? frame_cache->AllocatePage() : pmm->AllocateZeroedPage();
+			if (!allocated_frame.has_value()) return Rocinante::nullopt;
+			const std::uintptr_t physical_page_base = allocated_frame.value();
+			if (from_cache) pmm->ZeroPages(physical_page_base, 1);
+			*slot = physical_page_base;
+			m_payload_frame_count++;
+
+			return Rocinante::Optional<GetOrCreateFrameResult>(
+				GetOrCreateFrameResult{.physical_page_base = physical_page_base, .created = true}
+			);
+		}
+
+		/**
+		 * @brief Makes `physical_page_base` the frame backing `page_offset`.
+		 *
+		 * The object takes over the caller's reference (`ref_count`), as if it
+		 * had allocated the frame itself; this lets callers allocate many
+		 * frames at once (e.g. one buddy block) and hand them over page by page.
+		 *
+		 * Returns false, leaving the caller with its reference, if the offset
+		 * already has a frame or a directory page cannot be allocated.
+		 */
+		bool InsertFrameForPageOffset(PhysicalMemoryManager* pmm, std::size_t page_offset, std::uintptr_t physical_page_base) {
+			if (physical_page_base == 0) return false;
+			std::uintptr_t* const slot = FrameSlotForPageOffset(pmm, page_offset);
+			if (!slot) return false;
+			if (*slot != 0) return false;
+			*slot = physical_page_base;
+			m_payload_frame_count++;
+			return true;
+		}
+
+		/**
+		 * @brief Makes this (empty) object share every frame of `source`.
+		 *
+		 * Each frame gets one more `ref_count`; the directory structure is
+		 * copied, the frames are not. Both objects then treat the frames as
+		 * copy-on-write (see IsFrameShared()).
+		 *
+		 * Returns false if this object is not empty, or a directory page cannot
+		 * be allocated; in the latter case this object is left empty again.
+		 */
+		bool CloneFrom(PhysicalMemoryManager* pmm, const AnonymousVmObject& source) {
+			if (!pmm) return false;
+			if (this == &source) return false;
+			if (m_root_directory_physical != 0 || m_payload_frame_count != 0) return false;
+			if (source.m_root_directory_physical == 0) return true;
+
+			const auto root_allocated = AllocateAndZeroRadixPage(pmm);
+			if (!root_allocated.has_value()) return false;
+			m_root_directory_physical = root_allocated.value();
+			m_block_index_levels = source.m_block_index_levels;
+
+			if (!CloneDirectorySubtree(pmm, m_root_directory_physical, source.m_root_directory_physical, m_block_index_levels)) {
+				(void)ReleaseAllOwnedFrames(pmm);
+				return false;
+			}
+			return true;
+		}
+
+		/**
+		 * @brief Whether `physical_page_base` is also owned by another object.
+		 *
+		 * Only meaningful for frames this object owns.
+		 */
+		static bool IsFrameShared(const PhysicalMemoryManager* pmm, std::uintptr_t physical_page_base) {
+			if (!pmm) return false;
+			const auto ref_count = pmm->ReferenceCountForPhysical(physical_page_base);
+			return ref_count.has_value() && ref_count.value() > 1;
+		}
+
+		/**
+		 * @brief Makes the frame at `page_offset` private to this object.
+		 *
+		 * If the frame is shared, allocates a new frame, copies the page into
+		 * it, installs it and drops this object's reference to the old one.
+		 * Otherwise returns the frame as is.
+		 *
+		 * Mappings of the old frame are the caller's to replace. The old frame
+		 * stays alive (another object still owns it), so the caller may unmap
+		 * it afterwards.
+		 *
+		 * Returns empty if the offset has no frame or memory ran out.
+		 */
+		Rocinante::Optional<std::uintptr_t> BreakCopyOnWriteForPageOffset(
+			PhysicalMemoryManager* pmm,
+			std::size_t page_offset,
+			PageFrameCache* frame_cache = nullptr
 		) {
 			if (!pmm) return Rocinante::nullopt;
+			const auto frame_or = FindFrameForPageOffset(page_offset);
+			if (!frame_or.has_value()) return Rocinante::nullopt;
+			const std::uintptr_t shared_physical = frame_or.value();
+			if (!IsFrameShared(pmm, shared_physical)) return frame_or;
+
+			const auto allocated_frame = frame_cache ? frame_cache->AllocatePage() : pmm->AllocatePage();
+			if (!allocated_frame.has_value()) return Rocinante::nullopt;
+			const std::uintptr_t private_physical = allocated_frame.value();
+
+			RadixPage* destination = RadixPageFromPhysical(private_physical);
+			const RadixPage* source = RadixPageFromPhysical(shared_physical);
+			if (!destination || !source) {
+				(void)pmm->FreePage(private_physical);
+				return Rocinante::nullopt;
+			}
+			// The compiler barrier keeps the loop from being turned into a call
+			// to the byte-at-a-time memcpy in cxxabi.cpp.
+			for (std::size_t i = 0; i < 512; i++) {
+				destination->entries[i] = source->entries[i];
+				asm volatile("" ::: "memory");
+			}
+
+			// The directories for this offset exist, so this does not allocate.
+			std::uintptr_t* const slot = FrameSlotForPageOffset(pmm, page_offset);
+			if (!slot) {
+				(void)pmm->FreePage(private_physical);
+				return Rocinante::nullopt;
+			}
+			*slot = private_physical;
+			(void)pmm->ReleasePhysicalPage(shared_physical);
+			return Rocinante::Optional<std::uintptr_t>(private_physical);
+		}
+
+		/**
+		 * @brief Returns the frame backing `page_offset` if it is resident.
+		 *
+		 * Unlike GetOrCreateFrameForPageOffset(), this never allocates: an
+		 * offset without a frame (or beyond the directory's height) is empty.
+		 */
+		Rocinante::Optional<std::uintptr_t> FindFrameForPageOffset(std::size_t page_offset) const {
+			if (m_root_directory_physical == 0) return Rocinante::nullopt;
+			if (m_block_index_levels == 0) return Rocinante::nullopt;
+
 			static constexpr std::size_t kIndexBitsPerLevel = 9;
 			static constexpr std::size_t kEntriesPerRadixPage = 512;
 			static constexpr std::size_t kBlockMask = kEntriesPerRadixPage - 1;
-			static_assert((kEntriesPerRadixPage & (kEntriesPerRadixPage - 1)) == 0);
 
 			const std::size_t block_index = page_offset >> kIndexBitsPerLevel;
 			const std::size_t offset_in_block = page_offset & kBlockMask;
+			if ((block_index >> (m_block_index_levels * kIndexBitsPerLevel)) != 0) return Rocinante::nullopt;
 
-			if (!EnsureRootDirectoryExists(pmm)) return Rocinante::nullopt;
-			if (!EnsureDirectoryHeightForBlockIndex(pmm, block_index)) return Rocinante::nullopt;
-
-			RadixPage* directory = RootDirectoryPage();
+			const RadixPage* directory = RootDirectoryPage();
 			if (!directory) return Rocinante::nullopt;
-			if (m_block_index_levels == 0) return Rocinante::nullopt;
-
 			for (std::size_t level = m_block_index_levels; level > 1; level--) {
 				const std::size_t shift = (level - 1) * kIndexBitsPerLevel;
-				const std::size_t index = (block_index >> shift) & kBlockMask;
-
-				std::uintptr_t child_physical = directory->entries[index];
-				if (child_physical == 0) {
-					const auto allocated = AllocateAndZeroRadixPage(pmm);
-					if (!allocated.has_value()) return Rocinante::nullopt;
-					child_physical = allocated.value();
-					directory->entries[index] = child_physical;
-				}
-
-				directory = RadixPageFromPhysical(child_physical);
+				directory = RadixPageFromPhysical(directory->entries[(block_index >> shift) & kBlockMask]);
 				if (!directory) return Rocinante::nullopt;
 			}
 
-			const std::size_t leaf_index = block_index & kBlockMask;
-			std::uintptr_t block_physical = directory->entries[leaf_index];
-			if (block_physical == 0) {
-				const auto allocated = AllocateAndZeroRadixPage(pmm);
-				if (!allocated.has_value()) return Rocinante::nullopt;
-				block_physical = allocated.value();
-				directory->entries[leaf_index] = block_physical;
-			}
-
-			RadixPage* block = RadixPageFromPhysical(block_physical);
+			const RadixPage* block = RadixPageFromPhysical(directory->entries[block_index & kBlockMask]);
 			if (!block) return Rocinante::nullopt;
-
-			const std::uintptr_t existing = block->entries[offset_in_block];
-			if (existing != 0) {
-				return Rocinante::Optional<GetOrCreateFrameResult>(
-					GetOrCreateFrameResult{.physical_page_base = existing, .created = false}
-				);
-			}
-
-			const auto allocated_frame = pmm->AllocatePage();
-			if (!allocated_frame.has_value()) return Rocinante::nullopt;
-			const std::uintptr_t physical_page_base = allocated_frame.value();
-			block->entries[offset_in_block] = physical_page_base;
-			m_payload_frame_count++;
-
-			return Rocinante::Optional<GetOrCreateFrameResult>(
-				GetOrCreateFrameResult{.physical_page_base = physical_page_base, .created = true}
-			);
+			const std::uintptr_t frame_physical = block->entries[offset_in_block];
+			if (frame_physical == 0) return Rocinante::nullopt;
+			return Rocinante::Optional<std::uintptr_t>(frame_physical);
 		}
 
 		/**
@@ -253,43 +374,9 @@ class AnonymousVmObject final {
 		};
 		static_assert(sizeof(RadixPage) == PhysicalMemoryManager::kPageSizeBytes);
 
-		// LoongArch privileged architecture: CSR.CRMD (Current Mode Information).
-		//
-		// Spec anchor:
-		// - LoongArch-Vol1-EN.html, Section 5.2 (Virtual Address Space and Address Translation Mode)
-		//   - CRMD.DA=1, CRMD.PG=0 => direct address translation mode
-		//   - CRMD.DA=0, CRMD.PG=1 => mapped address translation mode
-		struct Csr final {
-			static constexpr std::uint32_t kCurrentModeInformation = 0x0; // CSR.CRMD
-		};
-
-		struct CurrentModeInformation final {
-			static constexpr std::uint64_t kDirectAddressingEnable = (1ull << 3u); // CRMD.DA
-			static constexpr std::uint64_t kPagingEnable = (1ull << 4u);           // CRMD.PG
-		};
-
-		static std::uint64_t ReadCurrentModeInformation() {
-			std::uint64_t value;
-			asm volatile("csrrd %0, %1" : "=r"(value) : "i"(Csr::kCurrentModeInformation));
-			return value;
-		}
-
-		static bool IsMappedAddressTranslationMode() {
-			const std::uint64_t crmd = ReadCurrentModeInformation();
-			const bool direct_addressing = (crmd & CurrentModeInformation::kDirectAddressingEnable) != 0;
-			const bool paging = (crmd & CurrentModeInformation::kPagingEnable) != 0;
-			return (!direct_addressing) && paging;
-		}
-
 		static RadixPage* RadixPageFromPhysical(std::uintptr_t physical_page_base) {
 			if (physical_page_base == 0) return nullptr;
-			if (!IsMappedAddressTranslationMode()) {
-				return reinterpret_cast<RadixPage*>(physical_page_base);
-			}
-			const auto virtual_address_bits = static_cast<std::uint8_t>(Rocinante::GetCPUCFG().VirtualAddressBits());
-			const std::uintptr_t physmap_virtual =
-				Rocinante::Memory::VirtualLayout::ToPhysMapVirtual(physical_page_base, virtual_address_bits);
-			return reinterpret_cast<RadixPage*>(physmap_virtual);
+			return reinterpret_cast<RadixPage*>(Physmap::KernelVirtualForPhysical(physical_page_base));
 		}
 
 		static bool RadixPageIsEmpty(const RadixPage* page) {
@@ -302,18 +389,9 @@ class AnonymousVmObject final {
 
 		static Rocinante::Optional<std::uintptr_t> AllocateAndZeroRadixPage(PhysicalMemoryManager* pmm) {
 			if (!pmm) return Rocinante::nullopt;
-			const auto allocated = pmm->AllocatePage();
-			if (!allocated.has_value()) return Rocinante::nullopt;
-			const std::uintptr_t physical_page_base = allocated.value();
-			RadixPage* page = RadixPageFromPhysical(physical_page_base);
-			if (!page) {
-				(void)pmm->ReleasePhysicalPage(physical_page_base);
-				return Rocinante::nullopt;
-			}
-			for (std::size_t i = 0; i < 512; i++) {
-				page->entries[i] = 0;
-			}
-			return Rocinante::Optional<std::uintptr_t>(physical_page_base);
+			// Served from the PMM's pre-zeroed pool when it has a frame, so the
+			// fault path usually skips the 4 KiB clear.
+			return pmm->AllocateZeroedPage();
 		}
 
 		bool EnsureRootDirectoryExists(PhysicalMemoryManager* pmm) {
@@ -357,6 +435,98 @@ class AnonymousVmObject final {
 			return RadixPageFromPhysical(m_root_directory_physical);
 		}
 
+		// Returns the block entry for `page_offset`, allocating the directory
+		// and block pages on the way down. nullptr on allocation failure.
+		std::uintptr_t* FrameSlotForPageOffset(PhysicalMemoryManager* pmm, std::size_t page_offset) {
+			if (!pmm) return nullptr;
+			static constexpr std::size_t kIndexBitsPerLevel = 9;
+			static constexpr std::size_t kEntriesPerRadixPage = 512;
+			static constexpr std::size_t kBlockMask = kEntriesPerRadixPage - 1;
+			static_assert((kEntriesPerRadixPage & (kEntriesPerRadixPage - 1)) == 0);
+
+			const std::size_t block_index = page_offset >> kIndexBitsPerLevel;
+			const std::size_t offset_in_block = page_offset & kBlockMask;
+
+			if (!EnsureRootDirectoryExists(pmm)) return nullptr;
+			if (!EnsureDirectoryHeightForBlockIndex(pmm, block_index)) return nullptr;
+
+			RadixPage* directory = RootDirectoryPage();
+			if (!directory) return nullptr;
+			if (m_block_index_levels == 0) return nullptr;
+
+			for (std::size_t level = m_block_index_levels; level > 1; level--) {
+				const std::size_t shift = (level - 1) * kIndexBitsPerLevel;
+				const std::size_t index = (block_index >> shift) & kBlockMask;
+
+				std::uintptr_t child_physical = directory->entries[index];
+				if (child_physical == 0) {
+					const auto allocated = AllocateAndZeroRadixPage(pmm);
+					if (!allocated.has_value()) return nullptr;
+					child_physical = allocated.value();
+					directory->entries[index] = child_physical;
+				}
+
+				directory = RadixPageFromPhysical(child_physical);
+				if (!directory) return nullptr;
+			}
+
+			const std::size_t leaf_index = block_index & kBlockMask;
+			std::uintptr_t block_physical = directory->entries[leaf_index];
+			if (block_physical == 0) {
+				const auto allocated = AllocateAndZeroRadixPage(pmm);
+				if (!allocated.has_value()) return nullptr;
+				block_physical = allocated.value();
+				directory->entries[leaf_index] = block_physical;
+			}
+
+			RadixPage* block = RadixPageFromPhysical(block_physical);
+			if (!block) return nullptr;
+			return &block->entries[offset_in_block];
+		}
+
+		// Fills `directory_physical` (zeroed) with a copy of the subtree at
+		// `source_physical`: new directory and block pages, same frames, each
+		// retained once. Entries are linked as they are filled, so on failure
+		// ReleaseAllOwnedFrames() undoes exactly what was done.
+		bool CloneDirectorySubtree(
+			PhysicalMemoryManager* pmm,
+			std::uintptr_t directory_physical,
+			std::uintptr_t source_physical,
+			std::size_t levels
+		) {
+			if (levels == 0) return false;
+			RadixPage* directory = RadixPageFromPhysical(directory_physical);
+			const RadixPage* source = RadixPageFromPhysical(source_physical);
+			if (!directory || !source) return false;
+
+			for (std::size_t i = 0; i < 512; i++) {
+				const std::uintptr_t source_child = source->entries[i];
+				if (source_child == 0) continue;
+
+				const auto allocated = AllocateAndZeroRadixPage(pmm);
+				if (!allocated.has_value()) return false;
+				directory->entries[i] = allocated.value();
+
+				if (levels > 1) {
+					if (!CloneDirectorySubtree(pmm, allocated.value(), source_child, levels - 1)) return false;
+					continue;
+				}
+
+				// Leaf directory: the children are block pages of frames.
+				RadixPage* block = RadixPageFromPhysical(allocated.value());
+				const RadixPage* source_block = RadixPageFromPhysical(source_child);
+				if (!block || !source_block) return false;
+				for (std::size_t j = 0; j < 512; j++) {
+					const std::uintptr_t frame_physical = source_block->entries[j];
+					if (frame_physical == 0) continue;
+					if (!pmm->RetainPhysicalPage(frame_physical)) return false;
+					block->entries[j] = frame_physical;
+					m_payload_frame_count++;
+				}
+			}
+			return true;
+		}
+
 		bool ReleaseDirectorySubtree(PhysicalMemoryManager* pmm, std::uintptr_t directory_physical, std::size_t levels) {
 			if (!pmm) return false;
 			if (directory_physical == 0) return true;
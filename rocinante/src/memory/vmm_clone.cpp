@@ -0,0 +1,133 @@
+/**
+ * Copyright (C) 2026 Andrew S. Rightenburg
+ * GPL-3.0-or-later
+ */
+
+#include <src/memory/vmm_clone.h>
+
+#include <src/memory/vm_object.h>
+#include <src/memory/vmm_pager.h>
+
+namespace Rocinante::Memory::VmmClone {
+
+namespace {
+
+constexpr std::size_t kPagesPerChunk = Paging::kEntriesPerTable;
+constexpr std::size_t kBitsPerWord = 64;
+
+bool IsAnonymousWithObject(const VirtualMemoryArea& vma) {
+	return vma.IsValid() &&
+		vma.backing_type == VirtualMemoryArea::BackingType::Anonymous &&
+		vma.anonymous_object != nullptr;
+}
+
+// Clones `page_count` pages starting at `first_page_offset`. The two passes
+// use one cursor each, one after the other, so the two VMAs may share a root.
+bool CloneChunk(
+	PhysicalMemoryManager* pmm,
+	const Paging::PageTableRoot& source_root,
+	const VirtualMemoryArea& source_vma,
+	const Paging::PageTableRoot& destination_root,
+	const VirtualMemoryArea& destination_vma,
+	std::size_t first_page_offset,
+	std::size_t page_count
+) {
+	const bool writable = source_vma.permissions.access == Paging::AccessPermissions::ReadWrite;
+	const auto zero_page_or = VmmPager::SharedZeroPage();
+	const auto source_page = [&](std::size_t index) {
+		return source_vma.virtual_base + ((first_page_offset + index) * Paging::kPageSizeBytes);
+	};
+	const auto destination_page = [&](std::size_t index) {
+		return destination_vma.virtual_base + ((first_page_offset + index) * Paging::kPageSizeBytes);
+	};
+
+	// Pass 1 (source tables): write-protect the mapped pages the object owns,
+	// and note which destination pages to map.
+	std::uint64_t map_frame[kPagesPerChunk / kBitsPerWord] = {};
+	std::uint64_t map_zero_page[kPagesPerChunk / kBitsPerWord] = {};
+	{
+		Paging::Cursor cursor(pmm, source_root);
+		if (!cursor.IsValid()) return false;
+		for (std::size_t i = 0; i < page_count; i++) {
+			if (!cursor.Seek(source_page(i))) return false;
+			const auto mapped_or = cursor.Query();
+			if (!mapped_or.has_value()) continue;
+
+			if (zero_page_or.has_value() && mapped_or.value() == zero_page_or.value()) {
+				map_zero_page[i / kBitsPerWord] |= (1ull << (i % kBitsPerWord));
+				continue;
+			}
+
+			// Mappings of frames the object does not own are not cloned.
+			const auto frame_or = source_vma.anonymous_object->FindFrameForPageOffset(first_page_offset + i);
+			if (!frame_or.has_value() || frame_or.value() != mapped_or.value()) continue;
+
+			if (writable) {
+				if (!cursor.Unmap()) return false;
+				if (!cursor.Map(frame_or.value(), Paging::WithoutWriteAccess(source_vma.permissions))) return false;
+			}
+			map_frame[i / kBitsPerWord] |= (1ull << (i % kBitsPerWord));
+		}
+	}
+
+	// Pass 2 (destination tables): map the same frames read-only.
+	const auto destination_permissions = Paging::WithoutWriteAccess(destination_vma.permissions);
+	Paging::Cursor cursor(pmm, destination_root);
+	if (!cursor.IsValid()) return false;
+	for (std::size_t i = 0; i < page_count; i++) {
+		const std::uint64_t bit = 1ull << (i % kBitsPerWord);
+		const bool frame = (map_frame[i / kBitsPerWord] & bit) != 0;
+		const bool zero_page = (map_zero_page[i / kBitsPerWord] & bit) != 0;
+		if (!frame && !zero_page) continue;
+
+		if (!cursor.Seek(destination_page(i))) return false;
+		if (cursor.Query().has_value()) return false;
+
+		std::uintptr_t physical_page_base = 0;
+		if (zero_page) {
+			physical_page_base = zero_page_or.value();
+		} else {
+			const auto shared_or = destination_vma.anonymous_object->FindFrameForPageOffset(first_page_offset + i);
+			if (!shared_or.has_value()) return false;
+			physical_page_base = shared_or.value();
+		}
+		if (!cursor.Map(physical_page_base, destination_permissions)) return false;
+	}
+	return cursor.Flush();
+}
+
+} // namespace
+
+bool CloneVma4KiB(
+	PhysicalMemoryManager* pmm,
+	const Paging::PageTableRoot& source_root,
+	const VirtualMemoryArea& source_vma,
+	const Paging::PageTableRoot& destination_root,
+	const VirtualMemoryArea& destination_vma
+) {
+	if (!pmm) return false;
+	if (!IsAnonymousWithObject(source_vma) || !IsAnonymousWithObject(destination_vma)) return false;
+	if (source_vma.anonymous_object == destination_vma.anonymous_object) return false;
+
+	const std::uintptr_t size_bytes = source_vma.virtual_limit - source_vma.virtual_base;
+	if ((size_bytes % Paging::kPageSizeBytes) != 0) return false;
+	if (destination_vma.virtual_limit - destination_vma.virtual_base != size_bytes) return false;
+	if (source_root.root_physical_address == destination_root.root_physical_address &&
+		source_vma.virtual_base < destination_vma.virtual_limit &&
+		destination_vma.virtual_base < source_vma.virtual_limit) {
+		return false;
+	}
+
+	if (!destination_vma.anonymous_object->CloneFrom(pmm, *source_vma.anonymous_object)) return false;
+
+	const std::size_t page_count = size_bytes / Paging::kPageSizeBytes;
+	for (std::size_t first = 0; first < page_count; first += kPagesPerChunk) {
+		const std::size_t chunk_pages = (page_count - first) < kPagesPerChunk ? (page_count - first) : kPagesPerChunk;
+		if (!CloneChunk(pmm, source_root, source_vma, destination_root, destination_vma, first, chunk_pages)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+} // namespace Rocinante::Memory::VmmClone
@@ -0,0 +1,47 @@
+/**
+ * Copyright (C) 2026 Andrew S. Rightenburg
+ * GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <src/memory/paging.h>
+#include <src/memory/pmm.h>
+#include <src/memory/vma.h>
+
+namespace Rocinante::Memory::VmmClone {
+
+// Clones an anonymous VMA into another one of the same size, copy-on-write.
+//
+// Semantics (bring-up):
+// - The destination's VM object (which must be empty) shares every frame of
+//   the source's (AnonymousVmObject::CloneFrom()); no page data is copied.
+// - Pages mapped in the source are write-protected there (if the VMA is
+//   writable) and mapped read-only in the destination, so the cost is
+//   page-table work only. The first store on either side copies the frame
+//   (or reuses it once the other side is gone); see VmmPager.
+// - Pages resident but not mapped in the source are left to fault in; the
+//   pager maps shared frames read-only.
+// - Shared zero page mappings are mapped in the destination too.
+//
+// Returns false if the arguments are unusable (either VMA is not anonymous
+// with a VM object, the sizes differ, the destination object is not empty,
+// the ranges overlap in the same page table, or a destination page is
+// already mapped), or if memory runs out. After a failure
+// VmmUnmap::UnmapVma4KiB() on the destination undoes the clone; the source
+// stays usable either way.
+//
+// Notes:
+// - As with VmmUnmap, TLB maintenance is left to the caller: the source's
+//   write-protected pages need an invalidation (its ASID's non-global
+//   entries, or global entries for a global VMA) before the source stores
+//   to them again.
+bool CloneVma4KiB(
+	PhysicalMemoryManager* pmm,
+	const Paging::PageTableRoot& source_root,
+	const VirtualMemoryArea& source_vma,
+	const Paging::PageTableRoot& destination_root,
+	const VirtualMemoryArea& destination_vma
+);
+
+} // namespace Rocinante::Memory::VmmClone
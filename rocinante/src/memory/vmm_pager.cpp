@@ -5,6 +5,7 @@
 
 #include <src/memory/vmm_pager.h>
 
+#include <src/memory/page_frame_cache.h>
 #include <src/memory/paging.h>
 #include <src/memory/paging_hw.h>
 #include <src/memory/paging_state.h>
@@ -34,6 +35,12 @@ bool IsPageInvalidLoadOrStore(std::uint64_t exception_code) {
 	return exception_code == kExceptionCodePil || exception_code == kExceptionCodePis;
 }
 
+bool IsPageModify(std::uint64_t exception_code) {
+	// LoongArch-Vol1-EN.html, Table 21: PME=0x4 (store to a valid page with D=0).
+	static constexpr std::uint64_t kExceptionCodePme = 0x4;
+	return exception_code == kExceptionCodePme;
+}
+
 std::uintptr_t VirtualPageBase(std::uintptr_t virtual_address) {
 	return virtual_address & ~static_cast<std::uintptr_t>(Rocinante::Memory::Paging::kPageOffsetMask);
 }
@@ -55,6 +62,131 @@ bool AccessIsPermittedByVma(const Rocinante::Memory::VirtualMemoryArea& vma, Roc
 	return false;
 }
 
+Rocinante::Memory::VmmPager::FaultAroundConfig g_fault_around_config{};
+Rocinante::Memory::VmmPager::Statistics g_statistics{};
+
+// 0 while the shared zero page is disabled.
+std::uintptr_t g_shared_zero_page_physical = 0;
+
+enum class PageModifyOutcome : std::uint8_t {
+	NotHandled,
+	ReplacedSharedZeroPage,
+	CopiedSharedFrame,
+	ReusedFrame,
+};
+
+struct PageModifyResult final {
+	PageModifyOutcome outcome;
+	std::uintptr_t physical_page_base;
+};
+
+// Resolves a store to a write-protected (D=0) page of an anonymous VMA:
+// - the shared zero page is replaced with a private zeroed frame owned by the
+//   VM object;
+// - a copy-on-write frame of the VM object is copied if another object still
+//   shares it, or reused if this object is the last owner;
+// and the page is remapped with the VMA's permissions. Anything else (a
+// mapping the object does not own) is NotHandled, as is running out of memory.
+PageModifyResult ResolveWriteProtectedStore(
+	Rocinante::Memory::PhysicalMemoryManager* pmm,
+	Rocinante::Memory::PageFrameCache* cache,
+	const Rocinante::Memory::Paging::PageTableRoot& root,
+	Rocinante::Memory::Paging::AddressSpaceBits address_bits,
+	const Rocinante::Memory::VirtualMemoryArea& vma,
+	std::uintptr_t virtual_page_base,
+	std::size_t page_offset
+) {
+	using Rocinante::Memory::AnonymousVmObject;
+	static constexpr PageModifyResult kNotHandled{.outcome = PageModifyOutcome::NotHandled, .physical_page_base = 0};
+
+	Rocinante::Memory::Paging::Cursor cursor(pmm, root, address_bits);
+	if (!cursor.Seek(virtual_page_base)) return kNotHandled;
+	const auto mapped_or = cursor.Query();
+	if (!mapped_or.has_value()) return kNotHandled;
+
+	// Usually the object has no frame for a zero page mapping. It has one if
+	// an earlier replacement took the frame but failed to map it.
+	auto frame_or = vma.anonymous_object->FindFrameForPageOffset(page_offset);
+	PageModifyOutcome outcome = PageModifyOutcome::NotHandled;
+	if (g_shared_zero_page_physical != 0 && mapped_or.value() == g_shared_zero_page_physical) {
+		outcome = PageModifyOutcome::ReplacedSharedZeroPage;
+		if (!frame_or.has_value()) {
+			// The page read as zeros so far, so its own frame must start zeroed.
+			frame_or = pmm->AllocateZeroedPage();
+			if (!frame_or.has_value()) return kNotHandled;
+			if (!vma.anonymous_object->InsertFrameForPageOffset(pmm, page_offset, frame_or.value())) {
+				(void)pmm->FreePage(frame_or.value());
+				return kNotHandled;
+			}
+		}
+	} else {
+		if (!frame_or.has_value() || frame_or.value() != mapped_or.value()) return kNotHandled;
+		outcome = AnonymousVmObject::IsFrameShared(pmm, frame_or.value())
+			? PageModifyOutcome::CopiedSharedFrame
+			: PageModifyOutcome::ReusedFrame;
+		// The old frame stays owned by the other object(s), so it is still
+		// valid to unmap below.
+		frame_or = vma.anonymous_object->BreakCopyOnWriteForPageOffset(pmm, page_offset, cache);
+		if (!frame_or.has_value()) return kNotHandled;
+	}
+
+	// If Map() fails the page is left unmapped; its next fault maps the
+	// object's (now private) frame.
+	if (!cursor.Unmap()) return kNotHandled;
+	if (!cursor.Map(frame_or.value(), vma.permissions)) return kNotHandled;
+	return PageModifyResult{.outcome = outcome, .physical_page_base = frame_or.value()};
+}
+
+// A fault-around window never leaves the faulting page's leaf table.
+constexpr std::size_t kMaxFaultAroundPages = Rocinante::Memory::Paging::kEntriesPerTable;
+
+// Inclusive page range [first, last] handled for one fault.
+struct FaultAroundRange final {
+	std::uintptr_t first;
+	std::uintptr_t last;
+	// Pages in (fault, prefault_last] may be allocated, not just mapped.
+	std::uintptr_t prefault_last;
+};
+
+FaultAroundRange FaultAroundRangeFor(
+	const Rocinante::Memory::VirtualMemoryArea& vma,
+	std::uintptr_t fault_virtual_page_base,
+	bool is_store
+) {
+	using Rocinante::Memory::Paging::kHugePageSizeBytes2MiB;
+	using Rocinante::Memory::Paging::kPageSizeBytes;
+
+	// Inclusive bounds throughout: the last leaf table below 2^64 has no
+	// exclusive end.
+	const std::uintptr_t table_first = fault_virtual_page_base & ~static_cast<std::uintptr_t>(kHugePageSizeBytes2MiB - 1);
+	const std::uintptr_t table_last = table_first + (kHugePageSizeBytes2MiB - kPageSizeBytes);
+	std::uintptr_t first = vma.virtual_base > table_first ? vma.virtual_base : table_first;
+	std::uintptr_t last = (vma.virtual_limit - kPageSizeBytes) < table_last ? (vma.virtual_limit - kPageSizeBytes) : table_last;
+
+	FaultAroundRange range{
+		.first = fault_virtual_page_base,
+		.last = fault_virtual_page_base,
+		.prefault_last = fault_virtual_page_base,
+	};
+	const std::size_t window_pages = g_fault_around_config.window_pages;
+	if (window_pages > 1) {
+		const std::uintptr_t window_bytes = window_pages * kPageSizeBytes;
+		range.first = fault_virtual_page_base & ~(window_bytes - 1);
+		range.last = range.first + (window_bytes - kPageSizeBytes);
+	}
+	if (is_store && g_fault_around_config.store_prefault_pages != 0) {
+		const std::size_t pages_left = (last - fault_virtual_page_base) / kPageSizeBytes;
+		const std::size_t prefault_pages =
+			g_fault_around_config.store_prefault_pages < pages_left ? g_fault_around_config.store_prefault_pages : pages_left;
+		range.prefault_last = fault_virtual_page_base + (prefault_pages * kPageSizeBytes);
+		if (range.prefault_last > range.last) range.last = range.prefault_last;
+	}
+
+	if (range.first < first) range.first = first;
+	if (range.last > last) range.last = last;
+	return range;
+}
+
 } // namespace
 
 namespace Rocinante::Memory::VmmPager {
@@ -63,6 +195,50 @@ void ConfigureKernelVirtualMemoryAreas(const VirtualMemoryAreaSet* areas) {
 	g_kernel_vmas = areas;
 }
 
+bool ConfigureFaultAround(const FaultAroundConfig& config) {
+	if (config.window_pages > kMaxFaultAroundPages) return false;
+	if ((config.window_pages & (config.window_pages - 1)) != 0) return false;
+	if (config.store_prefault_pages >= kMaxFaultAroundPages) return false;
+	g_fault_around_config = config;
+	return true;
+}
+
+FaultAroundConfig GetFaultAroundConfig() {
+	return g_fault_around_config;
+}
+
+Statistics GetStatistics() {
+	return g_statistics;
+}
+
+void ResetStatistics() {
+	g_statistics = Statistics{};
+}
+
+bool EnableSharedZeroPage(PhysicalMemoryManager* pmm) {
+	if (!pmm) return false;
+	if (g_shared_zero_page_physical != 0) return true;
+	const auto frame_or = pmm->AllocateZeroedPage();
+	if (!frame_or.has_value()) return false;
+	g_shared_zero_page_physical = frame_or.value();
+	return true;
+}
+
+bool DisableSharedZeroPage(PhysicalMemoryManager* pmm) {
+	if (!pmm) return false;
+	if (g_shared_zero_page_physical == 0) return true;
+	const auto map_count = pmm->MapCountForPhysical(g_shared_zero_page_physical);
+	if (map_count.has_value() && map_count.value() != 0) return false;
+	if (!pmm->ReleasePhysicalPage(g_shared_zero_page_physical)) return false;
+	g_shared_zero_page_physical = 0;
+	return true;
+}
+
+Rocinante::Optional<std::uintptr_t> SharedZeroPage() {
+	if (g_shared_zero_page_physical == 0) return Rocinante::nullopt;
+	return Rocinante::Optional<std::uintptr_t>(g_shared_zero_page_physical);
+}
+
 Rocinante::Trap::PagingFaultResult PagingFaultObserver(
 	Rocinante::TrapFrame* tf,
 	const Rocinante::Trap::PagingFaultEvent& event
@@ -80,7 +256,12 @@ Rocinante::Trap::PagingFaultResult PagingFaultObserver(
 	// - Section 5.4.3.1 (TLB-related Exceptions): PIL/PIS are raised when the access
 	//   finds a matching TLB entry with V=0.
 	// - Table 21 (Table of exception encoding): PIL=0x1, PIS=0x2.
-	if (!IsPageInvalidLoadOrStore(event.exception_code)) {
+	//
+	// PME (a store hit a valid page with D=0) is handled only for pages the
+	// pager write-protected itself: shared zero page and copy-on-write
+	// mappings; see below.
+	const bool is_page_modify = IsPageModify(event.exception_code);
+	if (!IsPageInvalidLoadOrStore(event.exception_code) && !is_page_modify) {
 		return Rocinante::Trap::PagingFaultResult::NotHandled;
 	}
 
@@ -144,12 +325,6 @@ Rocinante::Trap::PagingFaultResult PagingFaultObserver(
 		.root_physical_address = static_cast<std::uintptr_t>(event.pgd_base),
 	};
 
-	// If the page is already mapped, this observer does not attempt to "repair" it.
-	if (Rocinante::Memory::Paging::Translate(root, fault_virtual_page_base, address_bits).has_value()) {
-		g_handling = false;
-		return Rocinante::Trap::PagingFaultResult::NotHandled;
-	}
-
 	if (fault_virtual_page_base < vma->virtual_base) {
 		g_handling = false;
 		return Rocinante::Trap::PagingFaultResult::NotHandled;
@@ -163,23 +338,120 @@ Rocinante::Trap::PagingFaultResult PagingFaultObserver(
 		offset_bytes / Rocinante::Memory::Paging::kPageSizeBytes);
 
 	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
-	const auto frame_or = vma->anonymous_object->GetOrCreateFrameForPageOffset(&pmm, page_offset);
-	if (!frame_or.has_value()) {
+	const std::uint16_t current_asid = Rocinante::Memory::PagingHw::GetAddressSpaceId();
+
+	// Prefer the per-CPU frame cache once it has been bound to the PMM (after
+	// boot-time PMM initialization); early tests run before that point.
+	auto& frame_cache = Rocinante::Memory::GetPageFrameCache();
+	PageFrameCache* const cache = frame_cache.IsInitialized() ? &frame_cache : nullptr;
+
+	// A store to a write-protected page: give the page its own frame.
+	if (is_page_modify) {
+		const PageModifyResult resolved = ResolveWriteProtectedStore(
+			&pmm, cache, root, address_bits, *vma, fault_virtual_page_base, page_offset);
+		if (resolved.outcome == PageModifyOutcome::NotHandled) {
+			g_handling = false;
+			return Rocinante::Trap::PagingFaultResult::NotHandled;
+		}
+
+		// The cached entry has D=0 (and G=1 if the VMA is global).
+		Rocinante::Memory::PagingHw::InvalidateNonGlobalTlbEntryForAsidAndVa(current_asid, fault_virtual_page_base);
+		if (vma->permissions.global) {
+			Rocinante::Memory::PagingHw::InvalidateGlobalTlbEntries();
+		}
+
+		g_statistics.faults_handled++;
+		const char* action = nullptr;
+		switch (resolved.outcome) {
+			case PageModifyOutcome::ReplacedSharedZeroPage:
+				g_statistics.zero_page_replacements++;
+				action = "replaced shared zero page";
+				break;
+			case PageModifyOutcome::CopiedSharedFrame:
+				g_statistics.copy_on_write_copies++;
+				action = "copied shared frame";
+				break;
+			case PageModifyOutcome::ReusedFrame:
+				g_statistics.copy_on_write_reuses++;
+				action = "reused last copy-on-write owner's frame";
+				break;
+			case PageModifyOutcome::NotHandled:
+				break;
+		}
+
+		auto& uart = Rocinante::Platform::GetEarlyUart();
+		uart.puts("VMM pager: ");
+		uart.puts(action);
+		uart.puts("; badv=");
+		uart.write_hex_u64(event.bad_virtual_address);
+		uart.puts(" va_page=");
+		uart.write_hex_u64(fault_virtual_page_base);
+		uart.puts(" pa_page=");
+		uart.write_hex_u64(resolved.physical_page_base);
+		uart.puts(" page_offset=");
+		uart.write_dec_u64(page_offset);
+		uart.putc('\n');
+
+		g_handling = false;
+		return Rocinante::Trap::PagingFaultResult::Handled;
+	}
+
+	// If the page is already mapped, this observer does not attempt to "repair" it.
+	if (Rocinante::Memory::Paging::Translate(root, fault_virtual_page_base, address_bits).has_value()) {
 		g_handling = false;
 		return Rocinante::Trap::PagingFaultResult::NotHandled;
 	}
 
-	const std::uintptr_t physical_page_base = frame_or.value().physical_page_base;
+	// One cursor for the faulting page and its neighbours: they share a leaf
+	// table, so only the first Map() walks from the root.
+	Rocinante::Memory::Paging::Cursor cursor(&pmm, root, address_bits);
+	if (!cursor.Seek(fault_virtual_page_base)) {
+		g_handling = false;
+		return Rocinante::Trap::PagingFaultResult::NotHandled;
+	}
+
+	// A load from a page that was never written reads the shared zero page.
+	// Once the zero frame's map_count saturates (65535 with compact PMM
+	// metadata) Map() fails and the page gets its own frame, which
+	// GetOrCreateFrameForPageOffset() hands out zeroed, so the load still
+	// reads zeros.
+	std::uintptr_t physical_page_base = 0;
+	bool mapped_shared_zero_page = false;
+	if (g_shared_zero_page_physical != 0 &&
+		event.access_type == Rocinante::Trap::PagingAccessType::Load &&
+		!vma->anonymous_object->FindFrameForPageOffset(page_offset).has_value()) {
+		mapped_shared_zero_page =
+			cursor.Map(g_shared_zero_page_physical, Rocinante::Memory::Paging::WithoutWriteAccess(vma->permissions));
+		if (mapped_shared_zero_page) physical_page_base = g_shared_zero_page_physical;
+	}
 
-	const bool mapped = Rocinante::Memory::Paging::MapPage4KiB(
-		&pmm,
-		root,
-		fault_virtual_page_base,
-		physical_page_base,
-		vma->permissions,
-		address_bits
-	);
-	if (!mapped) {
+	// A copy-on-write frame is copied before a store, and mapped read-only
+	// for a load (the first store then raises PME).
+	Rocinante::Memory::Paging::PagePermissions permissions = vma->permissions;
+	if (!mapped_shared_zero_page) {
+		const auto frame_or = vma->anonymous_object->GetOrCreateFrameForPageOffset(&pmm, page_offset, cache);
+		if (!frame_or.has_value()) {
+			g_handling = false;
+			return Rocinante::Trap::PagingFaultResult::NotHandled;
+		}
+		physical_page_base = frame_or.value().physical_page_base;
+
+		if (!frame_or.value().created && AnonymousVmObject::IsFrameShared(&pmm, physical_page_base)) {
+			if (event.access_type == Rocinante::Trap::PagingAccessType::Store) {
+				const auto private_or = vma->anonymous_object->BreakCopyOnWriteForPageOffset(&pmm, page_offset, cache);
+				if (!private_or.has_value()) {
+					g_handling = false;
+					return Rocinante::Trap::PagingFaultResult::NotHandled;
+				}
+				physical_page_base = private_or.value();
+				g_statistics.copy_on_write_copies++;
+			} else {
+				permissions = Rocinante::Memory::Paging::WithoutWriteAccess(vma->permissions);
+			}
+		}
+	}
+
+	if (!mapped_shared_zero_page && !cursor.Map(physical_page_base, permissions)) {
 		// Explicit flaw:
 		// The anonymous VM object currently commits newly allocated frames into its
 		// internal directory as part of GetOrCreateFrameForPageOffset(). If we fail
@@ -189,24 +461,71 @@ Rocinante::Trap::PagingFaultResult PagingFaultObserver(
 		return Rocinante::Trap::PagingFaultResult::NotHandled;
 	}
 
+	// Fault-around: map the neighbours that already have frames; after a
+	// store fault, also allocate the next few pages. Neighbours are best
+	// effort: any that cannot be mapped are left to fault on their own.
+	const FaultAroundRange range = FaultAroundRangeFor(
+		*vma, fault_virtual_page_base, event.access_type == Rocinante::Trap::PagingAccessType::Store);
+	std::size_t pages_mapped_around = 0;
+	std::size_t pages_prefaulted = 0;
+	for (std::uintptr_t va = range.first; va <= range.last; va += Rocinante::Memory::Paging::kPageSizeBytes) {
+		if (va != fault_virtual_page_base && cursor.Seek(va) && !cursor.Query().has_value()) {
+			const auto neighbour_offset = static_cast<std::size_t>(
+				(va - vma->virtual_base) / Rocinante::Memory::Paging::kPageSizeBytes);
+			auto neighbour_or = vma->anonymous_object->FindFrameForPageOffset(neighbour_offset);
+			bool prefaulted = false;
+			if (!neighbour_or.has_value() && va > fault_virtual_page_base && va <= range.prefault_last) {
+				const auto created_or = vma->anonymous_object->GetOrCreateFrameForPageOffset(&pmm, neighbour_offset, cache);
+				if (created_or.has_value()) {
+					neighbour_or = Rocinante::Optional<std::uintptr_t>(created_or.value().physical_page_base);
+					prefaulted = true;
+				}
+			}
+			const bool shared =
+				!prefaulted && neighbour_or.has_value() && AnonymousVmObject::IsFrameShared(&pmm, neighbour_or.value());
+			const auto neighbour_permissions =
+				shared ? Rocinante::Memory::Paging::WithoutWriteAccess(vma->permissions) : vma->permissions;
+			if (neighbour_or.has_value() && cursor.Map(neighbour_or.value(), neighbour_permissions)) {
+				if (prefaulted) {
+					pages_prefaulted++;
+				} else {
+					pages_mapped_around++;
+				}
+			}
+		}
+		// range.last may be the last page below 2^64.
+		if (va == range.last) break;
+	}
+
 	// Ensure the retried instruction observes the updated page tables.
 	//
 	// Spec anchor (LoongArch-Vol1-EN.html):
 	// - Section 4.2.4.7 (INVTLB) + Table 13:
 	//   - op=0x5 clears G=0 entries matching {ASID, VA}.
+	//   - op=0x4 clears all G=0 entries matching ASID.
 	//   - op=0x2 clears all G=1 (global) entries.
 	//
 	// Policy (bring-up):
-	// - Invalidate the faulting VA for the current ASID.
+	// - Invalidate the faulting VA for the current ASID, or all of the ASID's
+	//   non-global entries once neighbours were mapped too (one INVTLB either
+	//   way, instead of one per page).
 	// - If we installed a global mapping (G=1), also invalidate global entries
 	//   system-wide, since global translations do not participate in ASID matching.
-	const std::uint16_t current_asid = Rocinante::Memory::PagingHw::GetAddressSpaceId();
-	Rocinante::Memory::PagingHw::InvalidateNonGlobalTlbEntryForAsidAndVa(current_asid, fault_virtual_page_base);
+	if (pages_mapped_around + pages_prefaulted == 0) {
+		Rocinante::Memory::PagingHw::InvalidateNonGlobalTlbEntryForAsidAndVa(current_asid, fault_virtual_page_base);
+	} else {
+		Rocinante::Memory::PagingHw::InvalidateNonGlobalTlbEntriesForAsid(current_asid);
+	}
 	if (vma->permissions.global) {
 		Rocinante::Memory::PagingHw::InvalidateGlobalTlbEntries();
 	}
 
-	// Logging policy (bring-up): emit one concise line per mapped page.
+	g_statistics.faults_handled++;
+	g_statistics.pages_mapped_around += pages_mapped_around;
+	g_statistics.pages_prefaulted += pages_prefaulted;
+	if (mapped_shared_zero_page) g_statistics.zero_page_maps++;
+
+	// Logging policy (bring-up): emit one concise line per handled fault.
 	auto& uart = Rocinante::Platform::GetEarlyUart();
 	uart.puts("VMM pager: mapped anonymous page; badv=");
 	uart.write_hex_u64(event.bad_virtual_address);
@@ -216,6 +535,15 @@ Rocinante::Trap::PagingFaultResult PagingFaultObserver(
 	uart.write_hex_u64(physical_page_base);
 	uart.puts(" page_offset=");
 	uart.write_dec_u64(page_offset);
+	if (mapped_shared_zero_page) {
+		uart.puts(" shared_zero_page=1");
+	}
+	if (pages_mapped_around + pages_prefaulted != 0) {
+		uart.puts(" around=");
+		uart.write_dec_u64(pages_mapped_around);
+		uart.puts(" prefaulted=");
+		uart.write_dec_u64(pages_prefaulted);
+	}
 	uart.putc('\n');
 
 	g_handling = false;
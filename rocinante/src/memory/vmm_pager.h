@@ -5,6 +5,11 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
+#include <src/helpers/optional.h>
+#include <src/memory/pmm.h>
 #include <src/memory/vma.h>
 #include <src/trap/trap.h>
 
@@ -17,12 +22,90 @@ namespace Rocinante::Memory::VmmPager {
 // - This only affects behavior if the VMM pager observer is installed.
 void ConfigureKernelVirtualMemoryAreas(const VirtualMemoryAreaSet* areas);
 
+/**
+ * @brief How many pages around a fault the observer maps in one go.
+ *
+ * - window_pages: size of the fault-around window, a power of two up to
+ *   512 (one leaf table); 0 or 1 maps only the faulting page. The window is
+ *   aligned to its size, contains the fault, and is clipped to the VMA and
+ *   to the faulting page's leaf table. Pages in it that already have a frame
+ *   in the VM object are mapped too; the others are left for their own
+ *   faults.
+ * - store_prefault_pages: on a store fault, also allocate frames for (and
+ *   map) up to this many pages after the faulting one, within the same
+ *   bounds. 0 disables it.
+ */
+struct FaultAroundConfig final {
+	std::size_t window_pages = 0;
+	std::size_t store_prefault_pages = 0;
+};
+
+// Returns false (keeping the current configuration) if the window is not a
+// power of two up to 512 pages, or the prefault count exceeds 511.
+bool ConfigureFaultAround(const FaultAroundConfig& config);
+FaultAroundConfig GetFaultAroundConfig();
+
+// Shared zero page (opt-in).
+//
+// While enabled, a load fault on an anonymous page that has no frame yet maps
+// one global, pre-zeroed frame read-only (D=0) instead of allocating a private
+// frame. A later store raises PME; the observer then gives the page a private
+// zeroed frame in the VM object and remaps it with the VMA's permissions.
+//
+// The pager holds the zero frame's ref_count; every mapping of it counts in
+// its map_count like any other leaf.
+//
+// Returns false if the frame cannot be allocated. Enabling twice is a no-op.
+bool EnableSharedZeroPage(PhysicalMemoryManager* pmm);
+
+// Returns false (staying enabled) while the zero frame is still mapped.
+bool DisableSharedZeroPage(PhysicalMemoryManager* pmm);
+
+// Physical address of the shared zero frame, or empty while disabled.
+Rocinante::Optional<std::uintptr_t> SharedZeroPage();
+
+/**
+ * @brief Observer counters (bring-up, single CPU).
+ *
+ * - faults_handled: faults the observer returned Handled for.
+ * - pages_mapped_around: resident neighbours mapped by fault-around.
+ * - pages_prefaulted: neighbours allocated and mapped after a store fault.
+ * - zero_page_maps: load faults served with the shared zero page.
+ * - zero_page_replacements: PME faults that gave a zero-page mapping its
+ *   own frame.
+ * - copy_on_write_copies: shared frames copied before a store.
+ * - copy_on_write_reuses: PME faults on a copy-on-write page whose frame had
+ *   no other owner left, so it was only remapped writable.
+ */
+struct Statistics final {
+	std::uint64_t faults_handled = 0;
+	std::uint64_t pages_mapped_around = 0;
+	std::uint64_t pages_prefaulted = 0;
+	std::uint64_t zero_page_maps = 0;
+	std::uint64_t zero_page_replacements = 0;
+	std::uint64_t copy_on_write_copies = 0;
+	std::uint64_t copy_on_write_reuses = 0;
+};
+
+Statistics GetStatistics();
+void ResetStatistics();
+
 // Paging-fault observer that wires faults through VMAs and anonymous VM objects.
 //
 // Policy (bring-up):
 // - Only handles kernel-mode (PLV0) faults.
-// - Only handles page-invalid load/store (PIL/PIS) faults.
-// - Uses per-page TLB invalidation for the active ASID after successful mapping.
+// - Only handles page-invalid load/store (PIL/PIS) faults, and page-modify
+//   (PME) faults on shared zero page and copy-on-write mappings.
+// - Maps the faulting page plus its fault-around neighbours (see
+//   FaultAroundConfig) in one pass over the leaf table. A load fault on a
+//   page without a frame maps the shared zero page if it is enabled.
+// - Frames shared with another VM object (AnonymousVmObject::CloneFrom())
+//   are mapped read-only; a store copies the frame first, or just remaps it
+//   writable once no other object owns it.
+// - TLB maintenance after mapping: one per-page invalidation for the active
+//   ASID if only the faulting page was mapped, else one invalidation of the
+//   ASID's non-global entries (the neighbours' dual-page TLB entries may be
+//   cached with V=0).
 // - If the mapping is global (G=1), it also invalidates global TLB entries.
 Rocinante::Trap::PagingFaultResult PagingFaultObserver(
 	Rocinante::TrapFrame* tf,
@@ -0,0 +1,196 @@
+/**
+ * Copyright (C) 2026 Andrew S. Rightenburg
+ * GPL-3.0-or-later
+ */
+
+#include <src/memory/vmm_populate.h>
+
+#include <src/memory/paging.h>
+#include <src/memory/vm_object.h>
+#include <src/memory/vmm_pager.h>
+
+namespace Rocinante::Memory::VmmPopulate {
+
+namespace {
+
+constexpr std::size_t kPagesPerLeafTable = Paging::kEntriesPerTable;
+constexpr std::size_t kBitsPerWord = 64;
+
+// Largest buddy order whose block fits in `page_count` pages.
+std::size_t LargestOrderFitting(std::size_t page_count) {
+	std::size_t order = 0;
+	while (order < PhysicalMemoryManager::kMaxBuddyOrder && (std::size_t{2} << order) <= page_count) {
+		order++;
+	}
+	return order;
+}
+
+// Populates `page_count` pages starting at `virtual_base`, all under one leaf
+// table. Returns false if memory ran out.
+bool PopulateLeafTableChunk(
+	PhysicalMemoryManager* pmm,
+	const Paging::PageTableRoot& root,
+	const VirtualMemoryArea& vma,
+	std::uintptr_t virtual_base,
+	std::size_t page_count,
+	PopulateResult* result
+) {
+	AnonymousVmObject* const object = vma.anonymous_object;
+	const auto page_offset_of = [&](std::size_t index) {
+		return static_cast<std::size_t>((virtual_base - vma.virtual_base) / Paging::kPageSizeBytes) + index;
+	};
+
+	// In a writable VMA, write-protected mappings (the shared zero page or a
+	// copy-on-write frame) would still fault on the first store, so they are
+	// replaced like unmapped pages.
+	const bool writable = vma.permissions.access == Paging::AccessPermissions::ReadWrite;
+	const auto zero_page_or = VmmPager::SharedZeroPage();
+
+	// Pass 1, with a cursor (one table walk for the chunk): map resident
+	// pages, and note the ones that still need a frame.
+	std::uint64_t needs_frame[kPagesPerLeafTable / kBitsPerWord] = {};
+	{
+		Paging::Cursor cursor(pmm, root);
+		if (!cursor.IsValid()) return false;
+		for (std::size_t i = 0; i < page_count; i++) {
+			if (!cursor.Seek(virtual_base + (i * Paging::kPageSizeBytes))) return false;
+			auto frame_or = object->FindFrameForPageOffset(page_offset_of(i));
+			const auto mapped_or = cursor.Query();
+			if (mapped_or.has_value()) {
+				const bool zero_page = zero_page_or.has_value() && mapped_or.value() == zero_page_or.value();
+				const bool copy_on_write = frame_or.has_value() && mapped_or.value() == frame_or.value() &&
+					AnonymousVmObject::IsFrameShared(pmm, frame_or.value());
+				if (!writable || (!zero_page && !copy_on_write)) {
+					result->pages_already_mapped++;
+					continue;
+				}
+				if (!cursor.Unmap()) return false;
+			}
+
+			if (!frame_or.has_value()) {
+				needs_frame[i / kBitsPerWord] |= (1ull << (i % kBitsPerWord));
+				continue;
+			}
+
+			// Copy-on-write frames are copied now rather than on the first store.
+			if (writable && AnonymousVmObject::IsFrameShared(pmm, frame_or.value())) {
+				frame_or = object->BreakCopyOnWriteForPageOffset(pmm, page_offset_of(i));
+				if (!frame_or.has_value()) return false;
+				if (!cursor.Map(frame_or.value(), vma.permissions)) return false;
+				result->pages_populated++;
+				continue;
+			}
+			if (!cursor.Map(frame_or.value(), vma.permissions)) return false;
+			result->pages_mapped_resident++;
+		}
+	}
+
+	// Pass 2: back each run of frameless pages with contiguous blocks and map
+	// each block in one MapRange4KiB() call. The cursor is gone, so nothing
+	// caches these tables any more.
+	const auto needs_frame_at = [&](std::size_t index) {
+		return (needs_frame[index / kBitsPerWord] & (1ull << (index % kBitsPerWord))) != 0;
+	};
+	std::size_t i = 0;
+	while (i < page_count) {
+		if (!needs_frame_at(i)) {
+			i++;
+			continue;
+		}
+		std::size_t run_pages = 1;
+		while (i + run_pages < page_count && needs_frame_at(i + run_pages)) run_pages++;
+
+		while (run_pages != 0) {
+			// Zeroed like the pager's frames: a page that was mapped to the
+			// shared zero page (or never touched) must keep reading as zeros.
+			std::size_t order = LargestOrderFitting(run_pages);
+			auto block_or = pmm->AllocateZeroedPages(order);
+			while (!block_or.has_value() && order != 0) {
+				order--;
+				block_or = pmm->AllocateZeroedPages(order);
+			}
+			if (!block_or.has_value()) return false;
+
+			const std::uintptr_t block_physical = block_or.value();
+			const std::size_t block_pages = std::size_t{1} << order;
+
+			// Hand the frames to the VM object before mapping, so that the unmap
+			// path (which releases through the object) owns them either way.
+			for (std::size_t j = 0; j < block_pages; j++) {
+				const std::uintptr_t frame_physical = block_physical + (j * Paging::kPageSizeBytes);
+				if (object->InsertFrameForPageOffset(pmm, page_offset_of(i + j), frame_physical)) continue;
+
+				// Give back the frames the object did not take.
+				for (std::size_t k = j; k < block_pages; k++) {
+					(void)pmm->FreePage(block_physical + (k * Paging::kPageSizeBytes));
+				}
+				return false;
+			}
+
+			if (!Paging::MapRange4KiB(
+					pmm,
+					root,
+					virtual_base + (i * Paging::kPageSizeBytes),
+					block_physical,
+					block_pages * Paging::kPageSizeBytes,
+					vma.permissions)) {
+				return false;
+			}
+			result->pages_populated += block_pages;
+			i += block_pages;
+			run_pages -= block_pages;
+		}
+	}
+	return true;
+}
+
+} // namespace
+
+Rocinante::Optional<PopulateResult> PopulateRange4KiB(
+	PhysicalMemoryManager* pmm,
+	const Paging::PageTableRoot& root,
+	const VirtualMemoryArea& vma,
+	std::uintptr_t virtual_base,
+	std::size_t size_bytes
+) {
+	if (!pmm) return Rocinante::nullopt;
+	if (!vma.IsValid()) return Rocinante::nullopt;
+	if (vma.backing_type != VirtualMemoryArea::BackingType::Anonymous || !vma.anonymous_object) {
+		return Rocinante::nullopt;
+	}
+	if (size_bytes == 0) return Rocinante::nullopt;
+	if ((virtual_base % Paging::kPageSizeBytes) != 0) return Rocinante::nullopt;
+	if ((size_bytes % Paging::kPageSizeBytes) != 0) return Rocinante::nullopt;
+	if (virtual_base < vma.virtual_base || virtual_base >= vma.virtual_limit) return Rocinante::nullopt;
+	if (size_bytes > vma.virtual_limit - virtual_base) return Rocinante::nullopt;
+
+	PopulateResult result{};
+	result.pages_requested = size_bytes / Paging::kPageSizeBytes;
+
+	std::uintptr_t chunk_base = virtual_base;
+	std::size_t pages_left = result.pages_requested;
+	while (pages_left != 0) {
+		const std::size_t index_in_table = (chunk_base / Paging::kPageSizeBytes) % kPagesPerLeafTable;
+		const std::size_t chunk_pages =
+			(kPagesPerLeafTable - index_in_table) < pages_left ? (kPagesPerLeafTable - index_in_table) : pages_left;
+		if (!PopulateLeafTableChunk(pmm, root, vma, chunk_base, chunk_pages, &result)) {
+			return Rocinante::Optional<PopulateResult>(result);
+		}
+		chunk_base += chunk_pages * Paging::kPageSizeBytes;
+		pages_left -= chunk_pages;
+	}
+
+	result.complete = true;
+	return Rocinante::Optional<PopulateResult>(result);
+}
+
+Rocinante::Optional<PopulateResult> PopulateVma4KiB(
+	PhysicalMemoryManager* pmm,
+	const Paging::PageTableRoot& root,
+	const VirtualMemoryArea& vma
+) {
+	if (!vma.IsValid()) return Rocinante::nullopt;
+	return PopulateRange4KiB(pmm, root, vma, vma.virtual_base, vma.virtual_limit - vma.virtual_base);
+}
+
+} // namespace Rocinante::Memory::VmmPopulate
@@ -0,0 +1,79 @@
+/**
+ * Copyright (C) 2026 Andrew S. Rightenburg
+ * GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <src/helpers/optional.h>
+#include <src/memory/paging.h>
+#include <src/memory/pmm.h>
+#include <src/memory/vma.h>
+
+namespace Rocinante::Memory::VmmPopulate {
+
+/**
+ * @brief Outcome of populating a range.
+ *
+ * - pages_requested: pages in the range.
+ * - pages_populated: pages this call gave a frame (new, or a private copy
+ *   of a copy-on-write frame) and mapped.
+ * - pages_mapped_resident: pages that already had a frame in the VM object
+ *   and were only mapped.
+ * - pages_already_mapped: pages left as they were.
+ * - complete: every page in the range is now mapped. False means memory (for
+ *   frames, VM object directories or page tables) ran out part way; the
+ *   pages counted above stay populated.
+ */
+struct PopulateResult final {
+	std::size_t pages_requested = 0;
+	std::size_t pages_populated = 0;
+	std::size_t pages_mapped_resident = 0;
+	std::size_t pages_already_mapped = 0;
+	bool complete = false;
+};
+
+// Eagerly backs and maps [virtual_base, virtual_base + size_bytes) of an
+// anonymous VMA, so that the range never takes a page fault (MAP_POPULATE).
+//
+// Semantics (bring-up):
+// - Pages without a frame get one from a physically contiguous, zeroed PMM
+//   block (the largest buddy order that fits the run, falling back to smaller
+//   orders), handed to the VM object page by page. Each block is mapped with
+//   one MapRange4KiB() call.
+// - Pages that already have a frame but no mapping are mapped to it (after
+//   copying it if it is a copy-on-write frame and the VMA is writable); mapped
+//   pages are left alone, except, in a writable VMA, shared zero page (see
+//   VmmPager::EnableSharedZeroPage()) and copy-on-write mappings, which are
+//   treated like unmapped pages.
+// - Works one leaf table (2 MiB of virtual space) at a time.
+// - New frames are zeroed (same as the fault path), so a page that was mapped
+//   to the shared zero page still reads as zeros.
+//
+// Returns nullopt if the arguments are unusable: the range is not page
+// aligned, is empty, is not inside the VMA, or the VMA is not anonymous with
+// a VM object.
+//
+// Notes:
+// - As with VmmUnmap, TLB maintenance is left to the caller. Populating a
+//   range before its first access needs none; replacing write-protected
+//   mappings does.
+Rocinante::Optional<PopulateResult> PopulateRange4KiB(
+	PhysicalMemoryManager* pmm,
+	const Paging::PageTableRoot& root,
+	const VirtualMemoryArea& vma,
+	std::uintptr_t virtual_base,
+	std::size_t size_bytes
+);
+
+// Populates the entire VMA.
+Rocinante::Optional<PopulateResult> PopulateVma4KiB(
+	PhysicalMemoryManager* pmm,
+	const Paging::PageTableRoot& root,
+	const VirtualMemoryArea& vma
+);
+
+} // namespace Rocinante::Memory::VmmPopulate
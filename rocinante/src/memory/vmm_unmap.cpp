@@ -5,7 +5,9 @@
 
 #include <src/memory/vmm_unmap.h>
 
+#include <src/memory/page_table_pool.h>
 #include <src/memory/paging.h>
+#include <src/memory/paging_hw.h>
 #include <src/memory/vm_object.h>
 
 namespace Rocinante::Memory::VmmUnmap {
@@ -24,36 +26,53 @@ bool UnmapVma4KiB(
 	const std::uintptr_t size_bytes = virtual_limit - virtual_base;
 	if ((size_bytes % Paging::kPageSizeBytes) != 0) return false;
 
+	// One cursor for the whole VMA: adjacent pages share their upper tables.
+	// Tables it empties belong to this batch and wait for the flush below.
+	PageTablePagePool::DeferredBatch table_batch(GetPageTablePagePool());
+	Paging::Cursor cursor(pmm, root);
+	if (!cursor.IsValid()) return false;
+
 	bool ok = true;
-	std::uintptr_t unmapped_bytes = 0;
-	while (unmapped_bytes < size_bytes) {
-		const std::uintptr_t virtual_page = virtual_base + unmapped_bytes;
-		const auto page_offset = static_cast<std::size_t>(unmapped_bytes / Paging::kPageSizeBytes);
-
-		const auto translated = Paging::Translate(root, virtual_page);
-		if (translated.has_value()) {
-			if (!Paging::UnmapPage4KiB(pmm, root, virtual_page)) {
+	for (std::uintptr_t unmapped_bytes = 0; unmapped_bytes < size_bytes; unmapped_bytes += Paging::kPageSizeBytes) {
+		if (!cursor.Seek(virtual_base + unmapped_bytes)) {
+			ok = false;
+		} else if (cursor.Query().has_value()) {
+			if (!cursor.Unmap()) {
 				ok = false;
 			}
 		}
+	}
+	if (!cursor.Flush()) ok = false;
+
+	// Spec anchor (LoongArch-Vol1-EN.html):
+	// - Section 4.2.4.7 (INVTLB), Table 13: op=0x3 clears all G=0 entries,
+	//   op=0x2 all G=1 entries.
+	//
+	// The root's ASID is not known here, so clear every entry of the VMA's
+	// kind rather than per page under an ASID that may not be the root's.
+	if (vma.permissions.global) {
+		PagingHw::InvalidateGlobalTlbEntries();
+	} else {
+		PagingHw::InvalidateNonGlobalTlbEntries();
+	}
+	(void)table_batch.Reclaim();
 
-		if (vma.owns_frames) {
-			if (vma.backing_type != VirtualMemoryArea::BackingType::Anonymous || !vma.anonymous_object) {
+	if (vma.owns_frames) {
+		if (vma.backing_type != VirtualMemoryArea::BackingType::Anonymous || !vma.anonymous_object) {
+			return false;
+		}
+		// Policy note:
+		// Drop object ownership only after unmapping (and after the flush, so a
+		// frame that goes back to the PMM here is unreachable). If we release
+		// first, the PMM may observe ref_count==0 while map_count>0, and the
+		// subsequent unmap will not revisit the ref_count to reclaim the frame.
+		const auto page_count = static_cast<std::size_t>(size_bytes / Paging::kPageSizeBytes);
+		for (std::size_t page_offset = 0; page_offset < page_count; page_offset++) {
+			if (!vma.anonymous_object->ReleaseFrameForPageOffset(pmm, page_offset)) {
 				ok = false;
-			} else {
-				// Policy note:
-				// Drop object ownership only after unmapping. If we release first, the
-				// PMM may observe ref_count==0 while map_count>0, and the subsequent
-				// unmap will not revisit the ref_count to reclaim the frame.
-				if (!vma.anonymous_object->ReleaseFrameForPageOffset(pmm, page_offset)) {
-					ok = false;
-				}
 			}
 		}
-
-		unmapped_bytes += Paging::kPageSizeBytes;
 	}
-
 	return ok;
 }
 
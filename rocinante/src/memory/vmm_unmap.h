@@ -14,16 +14,16 @@ namespace Rocinante::Memory::VmmUnmap {
 // Unmaps the entire VMA range (4 KiB granularity).
 //
 // Semantics (bring-up):
-// - For each page in the VMA range:
-//   - If mapped, remove the leaf PTE (updates map_count via Paging).
-//   - If the VMA owns frames and has an anonymous object, drop object ownership
-//     for the page offset.
+// - For each page in the VMA range, if mapped, remove the leaf PTE (updates
+//   map_count via Paging).
+// - Invalidate the TLB, then recycle the page tables the unmap emptied.
+// - If the VMA owns frames and has an anonymous object, drop object ownership
+//   for every page offset.
 //
-// Notes:
-// - This helper intentionally does not define a TLB invalidation policy.
-//   Note: page-table updates require INVTLB for immediate hardware
-//   enforcement, but the correct scope (per-page/per-ASID/flush-all) is a
-//   separate iteration.
+// TLB policy:
+// - The root's ASID is not passed in, so the flush is coarse: all non-global
+//   entries (INVTLB op=0x3), or all global ones (op=0x2) for a global VMA.
+//   Per-page invalidation needs the ASID and is a separate iteration.
 bool UnmapVma4KiB(
 	PhysicalMemoryManager* pmm,
 	const Paging::PageTableRoot& root,
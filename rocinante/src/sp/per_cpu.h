@@ -0,0 +1,40 @@
+/**
+ * Copyright (C) 2026 Andrew S. Rightenburg
+ * GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace Rocinante {
+
+/**
+ * @brief Number of per-CPU slots every per-CPU table is sized for.
+ *
+ * One 64-bit CPU mask word (see TlbShootdown::CpuMask). Tables are indexed by
+ * ReadCurrentProcessorCoreId(); a CPU whose core ID is kMaxCpuCount or above
+ * has no slot and takes the owning structure's documented slow path.
+ *
+ * Per-CPU fast-path contract (PageFrameCache magazines, PageTablePagePool
+ * reserves, the paging statistics):
+ * - A CPU only touches its own slot, without a lock or an atomic instruction.
+ *   This holds because there is no preemption yet; once there is, a fast path
+ *   must run with preemption disabled.
+ * - An exception handler must not re-enter a structure on a CPU it
+ *   interrupted inside that structure. Today only synchronous paging faults
+ *   allocate, and they cannot fault inside these structures.
+ * - Each slot is aligned to kCacheLineBytes, so CPUs never write the same
+ *   cache line.
+ * - Slow paths (refilling from or draining to the PMM) take the owning
+ *   structure's lock. That lock only serializes that structure's own PMM
+ *   calls; callers that use PhysicalMemoryManager directly are not covered.
+ * - Reading another CPU's slot (statistics, drains) is exact only while that
+ *   CPU is quiescent.
+ */
+inline constexpr std::size_t kMaxCpuCount = 64;
+
+// Alignment of one per-CPU slot (see kMaxCpuCount).
+inline constexpr std::size_t kCacheLineBytes = 64;
+
+} // namespace Rocinante
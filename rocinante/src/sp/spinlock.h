@@ -0,0 +1,74 @@
+/**
+ * Copyright (C) 2026 Andrew S. Rightenburg
+ * GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <src/sp/atomic.h>
+
+namespace Rocinante {
+
+/**
+ * @brief Minimal test-and-test-and-set spinlock.
+ *
+ * Semantics:
+ * - Lock() spins until the lock word transitions 0 -> 1.
+ * - Unlock() publishes prior writes and releases the lock.
+ * - Both directions use the full-barrier (DBAR 0 / AM*_DB) atomic helpers, so
+ *   the critical section is ordered against surrounding memory accesses.
+ *
+ * Explicit flaws:
+ * - Not fair (no ticketing); a contended lock can starve a CPU.
+ * - Does not mask interrupts. Callers must not take the same lock from an
+ *   interrupt/exception path that may have interrupted a holder on the same CPU.
+ */
+class Spinlock final {
+	public:
+		Spinlock() = default;
+		Spinlock(const Spinlock&) = delete;
+		Spinlock& operator=(const Spinlock&) = delete;
+
+		void Lock() {
+			while (Rocinante::AtomicExchangeU64Db(&m_locked, 1) != 0) {
+				// Spin on plain loads so waiting CPUs do not keep the line in
+				// exclusive state.
+				while (m_locked != 0) {
+					asm volatile("nop" ::: "memory");
+				}
+			}
+		}
+
+		bool TryLock() {
+			return Rocinante::AtomicExchangeU64Db(&m_locked, 1) == 0;
+		}
+
+		void Unlock() {
+			Rocinante::AtomicStoreU64Db(&m_locked, 0);
+		}
+
+	private:
+		volatile std::uint64_t m_locked = 0;
+};
+
+/**
+ * @brief RAII guard for Spinlock (scope-bound critical section).
+ */
+class SpinlockGuard final {
+	public:
+		explicit SpinlockGuard(Spinlock* lock) : m_lock(lock) {
+			m_lock->Lock();
+		}
+		~SpinlockGuard() {
+			m_lock->Unlock();
+		}
+		SpinlockGuard(const SpinlockGuard&) = delete;
+		SpinlockGuard& operator=(const SpinlockGuard&) = delete;
+
+	private:
+		Spinlock* m_lock;
+};
+
+} // namespace Rocinante
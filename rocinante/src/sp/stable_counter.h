@@ -0,0 +1,28 @@
+/**
+ * Copyright (C) 2026 Andrew S. Rightenburg
+ * GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace Rocinante {
+
+/**
+ * @brief Read the 64-bit Stable Counter.
+ *
+ * The Stable Counter increments at a constant frequency independent of the
+ * core clock, so differences between two reads measure elapsed wall time.
+ *
+ * Spec anchor (LoongArch-Vol1-EN.html):
+ * - RDTIME.D reads the full 64-bit Stable Counter value into rd.
+ * - CPUCFG word 0x4 reports the counter's base crystal frequency.
+ */
+static inline std::uint64_t ReadStableCounterTicks() {
+	std::uint64_t value;
+	asm volatile("rdtime.d %0, $zero" : "=r"(value));
+	return value;
+}
+
+} // namespace Rocinante
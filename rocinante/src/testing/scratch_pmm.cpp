@@ -0,0 +1,35 @@
+/**
+ * Copyright (C) 2026 Andrew S. Rightenburg
+ * GPL-3.0-or-later
+ */
+
+#include <src/testing/scratch_pmm.h>
+
+#include <src/testing/test.h>
+
+#include <src/memory/boot_memory_map.h>
+#include <src/memory/pmm.h>
+
+extern "C" char _start;
+extern "C" char _end;
+
+namespace Rocinante::Testing {
+
+bool InitializeScratchPmm(TestContext* ctx, std::size_t size_bytes) {
+	using Rocinante::Memory::BootMemoryRegion;
+	using Rocinante::Memory::BootMemoryMap;
+
+	const std::uintptr_t kernel_physical_base = reinterpret_cast<std::uintptr_t>(&_start);
+	const std::uintptr_t kernel_physical_end = reinterpret_cast<std::uintptr_t>(&_end);
+
+	BootMemoryMap map;
+	map.Clear();
+	ROCINANTE_EXPECT_TRUE(ctx, map.AddRegion(BootMemoryRegion{.physical_base = kScratchPmmBase, .size_bytes = size_bytes, .type = BootMemoryRegion::Type::UsableRAM}));
+
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+	const bool ok = pmm.InitializeFromBootMemoryMap(map, kernel_physical_base, kernel_physical_end, 0, 0);
+	ROCINANTE_EXPECT_TRUE(ctx, ok);
+	return ok;
+}
+
+} // namespace Rocinante::Testing
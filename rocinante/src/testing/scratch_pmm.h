@@ -0,0 +1,25 @@
+/**
+ * Copyright (C) 2026 Andrew S. Rightenburg
+ * GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Rocinante::Testing {
+
+struct TestContext;
+
+// Physical base of the scratch RAM region the memory tests hand to the PMM
+// (the same one the KernelMappings tests use).
+inline constexpr std::uintptr_t kScratchPmmBase = 0x01000000; // 16 MiB
+
+// Re-initializes the global PMM with [kScratchPmmBase, kScratchPmmBase +
+// size_bytes) as its only usable RAM, excluding the kernel image.
+//
+// Reports a test failure and returns false if the PMM rejects the map.
+bool InitializeScratchPmm(TestContext* ctx, std::size_t size_bytes);
+
+} // namespace Rocinante::Testing
@@ -45,6 +45,43 @@ static void PrintU64(TestContext* ctx, std::uint64_t v) {
 	ctx->uart->write_dec_u64(v);
 }
 
+static void PrintPagingStatisticsLine(Uart16550* uart, const Rocinante::Trap::PagingStatistics& statistics) {
+	// Indexed by ESTAT.Ecode (LoongArch-Vol1-EN.html, Table 21).
+	static constexpr const char* kExceptionCodeLabels[Rocinante::Trap::PagingStatistics::kExceptionCodeCount] = {
+		nullptr, " pil=", " pis=", " pif=", " pme=", " pnr=", " pnx=", " ppi=",
+	};
+
+	uart->puts("tlb_refills=");
+	uart->write_dec_u64(statistics.tlb_refills);
+	for (std::size_t code = 1; code < Rocinante::Trap::PagingStatistics::kExceptionCodeCount; code++) {
+		uart->puts(kExceptionCodeLabels[code]);
+		uart->write_dec_u64(statistics.faults_by_exception_code[code]);
+	}
+	uart->puts(" handled=");
+	uart->write_dec_u64(statistics.handled);
+	uart->puts(" not_handled=");
+	uart->write_dec_u64(statistics.not_handled);
+	uart->puts(" handler_ticks=");
+	uart->write_dec_u64(statistics.handler_ticks);
+	uart->putc('\n');
+}
+
+// Counters accumulated over the whole run; CPUs that never refilled or
+// faulted are left out.
+static void PrintPagingStatistics(Uart16550* uart) {
+	uart->puts("\n=== Paging Statistics ===\n");
+	for (std::size_t core_id = 0; core_id < Rocinante::kMaxCpuCount; core_id++) {
+		const auto statistics = Rocinante::Trap::PagingStatisticsForCpu(core_id);
+		if (statistics.tlb_refills == 0 && statistics.handled == 0 && statistics.not_handled == 0) continue;
+		uart->puts("cpu ");
+		uart->write_dec_u64(core_id);
+		uart->puts(": ");
+		PrintPagingStatisticsLine(uart, statistics);
+	}
+	uart->puts("total: ");
+	PrintPagingStatisticsLine(uart, Rocinante::Trap::PagingStatisticsTotal());
+}
+
 } // namespace
 
 void ResetTrapObservations() {
@@ -190,6 +227,20 @@ void Note(TestContext* ctx, const char* file, int line, const char* message) {
 	Print(ctx, ")\n");
 }
 
+void NoteU64(TestContext* ctx, const char* file, int line, const char* label, std::uint64_t value) {
+	Print(ctx, "NOTE [");
+	Print(ctx, ctx->current_test_name ? ctx->current_test_name : "<unknown>");
+	Print(ctx, "] ");
+	Print(ctx, label);
+	Print(ctx, "=");
+	PrintU64(ctx, value);
+	Print(ctx, " (at ");
+	Print(ctx, file);
+	Print(ctx, ":");
+	PrintU64(ctx, static_cast<std::uint64_t>(line));
+	Print(ctx, ")\n");
+}
+
 void ExpectTrue(TestContext* ctx, bool value, const char* expr_text, const char* file, int line) {
 	if (value) return;
 	Fail(ctx, file, line, expr_text);
@@ -265,6 +316,8 @@ int RunAll(Uart16550* uart) {
 	uart->write_dec_u64(ctx.total_failures);
 	uart->putc('\n');
 
+	PrintPagingStatistics(uart);
+
 	return static_cast<int>(failed_tests);
 }
 
@@ -97,6 +97,12 @@ void Warn(TestContext* ctx, const char* file, int line, const char* message);
 // Output a note (not a failure or warning)
 void Note(TestContext* ctx, const char* file, int line, const char* message);
 
+// Output a note carrying one labeled measurement, e.g. "alloc_ticks=123".
+//
+// Intended for benchmark-style tests that report numbers without asserting on
+// them (timings are host/QEMU dependent).
+void NoteU64(TestContext* ctx, const char* file, int line, const char* label, std::uint64_t value);
+
 void ExpectTrue(TestContext* ctx, bool value, const char* expr_text, const char* file, int line);
 
 void ExpectEqU64(
@@ -22,6 +22,13 @@ void TestEntry_Interrupts_TimerIRQ_DeliversAndClears(TestContext* ctx);
 void TestEntry_Paging_MapTranslateUnmap(TestContext* ctx);
 void TestEntry_Paging_RespectsVALENAndPALEN(TestContext* ctx);
 void TestEntry_Paging_Physmap_MapsRootPageTableAndAttributes(TestContext* ctx);
+void TestEntry_Paging_HugeLeaves_MapTranslateSplitAndFree(TestContext* ctx);
+void TestEntry_Paging_UnmapRange_SkipsHolesAndReclaimsTables(TestContext* ctx);
+void TestEntry_Paging_Benchmark_RangeMapVersusPerPage(TestContext* ctx);
+void TestEntry_Paging_Walkers_SpecializedMatchesGeneric(TestContext* ctx);
+void TestEntry_Paging_Benchmark_SpecializedTranslate(TestContext* ctx);
+void TestEntry_Paging_Cursor_SequentialMapQueryUnmap(TestContext* ctx);
+void TestEntry_Paging_Benchmark_CursorVersusPerPageWalk(TestContext* ctx);
 void TestEntry_Paging_UnmapReclaimsIntermediateTables(TestContext* ctx);
 void TestEntry_Paging_MapCount_TracksLeafMappings(TestContext* ctx);
 void TestEntry_AddressSpace_DestroyPageTables_FreesRootAndSubtables(TestContext* ctx);
@@ -44,6 +51,9 @@ void TestEntry_TlbShootdown_State_MaskSampling_BasicSemantics(TestContext* ctx);
 void TestEntry_VMM_VMA_InsertLookup(TestContext* ctx);
 void TestEntry_VMM_AnonymousVmObject_Ownership(TestContext* ctx);
 void TestEntry_VMM_UnmapVma4KiB_ReleasesAnonymousFrames(TestContext* ctx);
+void TestEntry_VMM_PopulateVma4KiB_MapsEveryPageAndReportsPartial(TestContext* ctx);
+void TestEntry_VMM_PopulateRange4KiB_ZeroPageMappingsStillReadZero(TestContext* ctx);
+void TestEntry_VMM_CloneVma4KiB_SharesFramesCopyOnWrite(TestContext* ctx);
 
 void TestEntry_PMM_RespectsReservedKernelAndDTB(TestContext* ctx);
 void TestEntry_PMM_DoesNotClobberReservedDuringBitmapPlacement(TestContext* ctx);
@@ -52,6 +62,39 @@ void TestEntry_PMM_BitmapPlacement_RespectsPALEN(TestContext* ctx);
 void TestEntry_PMM_Initialize_SingleUsableRegionContainingKernelAndDTB(TestContext* ctx);
 void TestEntry_PMM_PageFrameNumberConversions(TestContext* ctx);
 void TestEntry_PMM_ReferenceCount_RetainRelease(TestContext* ctx);
+void TestEntry_PMM_Buddy_AllocatePagesReturnsAlignedContiguousBlock(TestContext* ctx);
+void TestEntry_PMM_Buddy_FreeCoalescesIntoLargerBlocks(TestContext* ctx);
+void TestEntry_PMM_Buddy_FreePagesRejectsInvalidBlocks(TestContext* ctx);
+void TestEntry_PMM_Numa_PrefersCoreNodeAndFallsBack(TestContext* ctx);
+void TestEntry_PMM_ZeroedPool_ServesZeroedFrames(TestContext* ctx);
+void TestEntry_PMM_DeferredMetadata_InitializesOnDemand(TestContext* ctx);
+void TestEntry_PMM_Benchmark_InitializationPhases(TestContext* ctx);
+void TestEntry_PMM_Benchmark_AllocationLatencyByOccupancy(TestContext* ctx);
+void TestEntry_PMM_Benchmark_ZeroedPageLatency(TestContext* ctx);
+void TestEntry_PMM_Benchmark_FrameMetadataFootprintAndRefCountThroughput(TestContext* ctx);
+void TestEntry_BootMemoryMap_DeviceTree_ParsesNumaNodeIds(TestContext* ctx);
+
+void TestEntry_PageFrameCache_RefillsAndServesHitsFromMagazine(TestContext* ctx);
+void TestEntry_PageFrameCache_DrainsBatchWhenFull(TestContext* ctx);
+void TestEntry_PageFrameCache_SharedOrMappedFramesBypassMagazine(TestContext* ctx);
+
+void TestEntry_PageTablePool_ReserveTracksWatermarks(TestContext* ctx);
+void TestEntry_PageTablePool_DeferredPagesWaitForReclaim(TestContext* ctx);
+void TestEntry_PageTablePool_FullDeferredListFlushesAndRecycles(TestContext* ctx);
+void TestEntry_PageTablePool_PagingWalkFailsBeforeBuildingTables(TestContext* ctx);
+void TestEntry_PageTablePool_Benchmark_MapUnmapFreshPath(TestContext* ctx);
+void TestEntry_AsidAllocator_KeepsAsidAcrossActivations(TestContext* ctx);
+void TestEntry_AsidAllocator_RolloverFlushesOnceAndKeepsRunningAsid(TestContext* ctx);
+
+void TestEntry_Slab_AllocateFreeReusesSlots(TestContext* ctx);
+void TestEntry_Slab_GrowsReleasesAndRejectsForeignPointers(TestContext* ctx);
+void TestEntry_Slab_Benchmark_SmallObjectLatencyVersusHeap(TestContext* ctx);
+
+void TestEntry_Heap_GrowsOnDemandAndTrimsFreeTail(TestContext* ctx);
+void TestEntry_Heap_AlignedAllocationsSplitAndCoalesce(TestContext* ctx);
+void TestEntry_Heap_StatisticsTrackAllocationsAndFragmentation(TestContext* ctx);
+void TestEntry_Heap_ReallocResizesInPlaceAndUsableSize(TestContext* ctx);
+void TestEntry_Heap_Benchmark_FragmentedAllocLatency(TestContext* ctx);
 
 void TestEntry_PagingHw_EnablePaging_TlbRefillSmoke(TestContext* ctx);
 void TestEntry_PagingHw_UnmappedAccess_FaultsAndReportsBadV(TestContext* ctx);
@@ -59,10 +102,16 @@ void TestEntry_PagingHw_PagingFaultObserver_DispatchesAndCanHandle(TestContext*
 void TestEntry_PagingHw_PagingFaultObserver_MapsAndRetries(TestContext* ctx);
 void TestEntry_PagingHw_KernelPager_MapsAndRetries(TestContext* ctx);
 void TestEntry_PagingHw_VmmPager_MapsViaVmaAndVmObject(TestContext* ctx);
+void TestEntry_PagingHw_VmmPager_FaultAroundMapsResidentNeighbours(TestContext* ctx);
+void TestEntry_PagingHw_VmmPager_SharedZeroPageUntilFirstStore(TestContext* ctx);
+void TestEntry_PagingHw_VmmPager_CopyOnWriteAfterClone(TestContext* ctx);
 void TestEntry_PagingHw_ReadOnlyStore_RaisesPme(TestContext* ctx);
 void TestEntry_PagingHw_NonExecutableFetch_RaisesPnx(TestContext* ctx);
 void TestEntry_PagingHw_PostPaging_MapUnmap_Faults(TestContext* ctx);
 void TestEntry_PagingHw_HigherHalfStack_GuardPageFaults(TestContext* ctx);
+void TestEntry_PagingHw_TlbRefill_LddirMatchesSoftwareWalk(TestContext* ctx);
+void TestEntry_PagingHw_Benchmark_TlbRefillLddirVersusSoftwareWalk(TestContext* ctx);
+void TestEntry_PagingHw_PagingStatistics_CountsRefillsAndFaults(TestContext* ctx);
 void TestEntry_PagingHw_AddressSpaces_SwitchPgdlChangesTranslation(TestContext* ctx);
 
 extern const TestCase g_test_cases[] = {
@@ -82,6 +131,13 @@ extern const TestCase g_test_cases[] = {
 	{"Memory.Paging.RespectsVALENAndPALEN", &TestEntry_Paging_RespectsVALENAndPALEN},
 	{"Memory.Paging.Physmap.MapsRootAndAttributes", &TestEntry_Paging_Physmap_MapsRootPageTableAndAttributes},
 	{"Memory.Paging.UnmapReclaimsIntermediateTables", &TestEntry_Paging_UnmapReclaimsIntermediateTables},
+	{"Memory.Paging.HugeLeaves.MapTranslateSplitAndFree", &TestEntry_Paging_HugeLeaves_MapTranslateSplitAndFree},
+	{"Memory.Paging.UnmapRange.SkipsHolesAndReclaimsTables", &TestEntry_Paging_UnmapRange_SkipsHolesAndReclaimsTables},
+	{"Memory.Paging.Benchmark.RangeMapVersusPerPage", &TestEntry_Paging_Benchmark_RangeMapVersusPerPage},
+	{"Memory.Paging.Walkers.SpecializedMatchesGeneric", &TestEntry_Paging_Walkers_SpecializedMatchesGeneric},
+	{"Memory.Paging.Benchmark.SpecializedTranslate", &TestEntry_Paging_Benchmark_SpecializedTranslate},
+	{"Memory.Paging.Cursor.SequentialMapQueryUnmap", &TestEntry_Paging_Cursor_SequentialMapQueryUnmap},
+	{"Memory.Paging.Benchmark.CursorVersusPerPageWalk", &TestEntry_Paging_Benchmark_CursorVersusPerPageWalk},
 	{"Memory.AddressSpace.DestroyPageTables.FreesRootAndSubtables", &TestEntry_AddressSpace_DestroyPageTables_FreesRootAndSubtables},
 	{"Memory.KernelVirtualAddressAllocator.AllocateFreeCoalesce", &TestEntry_KernelVirtualAddressAllocator_AllocateFreeCoalesce},
 	{"Memory.KernelVirtualAddressAllocator.ReserveCarvesFixedRange", &TestEntry_KernelVirtualAddressAllocator_ReserveCarvesFixedRange},
@@ -99,6 +155,9 @@ extern const TestCase g_test_cases[] = {
 	{"Memory.VMM.VMA.InsertLookup", &TestEntry_VMM_VMA_InsertLookup},
 	{"Memory.VMM.AnonymousVmObject.Ownership", &TestEntry_VMM_AnonymousVmObject_Ownership},
 	{"Memory.VMM.UnmapVma4KiB.ReleasesAnonymousFrames", &TestEntry_VMM_UnmapVma4KiB_ReleasesAnonymousFrames},
+	{"Memory.VMM.PopulateVma4KiB.MapsEveryPageAndReportsPartial", &TestEntry_VMM_PopulateVma4KiB_MapsEveryPageAndReportsPartial},
+	{"Memory.VMM.PopulateRange4KiB.ZeroPageMappingsStillReadZero", &TestEntry_VMM_PopulateRange4KiB_ZeroPageMappingsStillReadZero},
+	{"Memory.VMM.CloneVma4KiB.SharesFramesCopyOnWrite", &TestEntry_VMM_CloneVma4KiB_SharesFramesCopyOnWrite},
 	{"Memory.PMM.RespectsReservedKernelAndDTB", &TestEntry_PMM_RespectsReservedKernelAndDTB},
 	{"Memory.PMM.BitmapPlacement.DoesNotClobberReserved", &TestEntry_PMM_DoesNotClobberReservedDuringBitmapPlacement},
 	{"Memory.PMM.ClampsTrackedRangeToPALEN", &TestEntry_PMM_ClampsTrackedRangeToPALEN},
@@ -106,16 +165,51 @@ extern const TestCase g_test_cases[] = {
 	{"Memory.PMM.Initialize.SingleUsableRegionContainingKernelAndDTB", &TestEntry_PMM_Initialize_SingleUsableRegionContainingKernelAndDTB},
 	{"Memory.PMM.PageFrameNumber.Conversions", &TestEntry_PMM_PageFrameNumberConversions},
 	{"Memory.PMM.ReferenceCount.RetainRelease", &TestEntry_PMM_ReferenceCount_RetainRelease},
+	{"Memory.PMM.Buddy.AllocatePagesReturnsAlignedContiguousBlock", &TestEntry_PMM_Buddy_AllocatePagesReturnsAlignedContiguousBlock},
+	{"Memory.PMM.Buddy.FreeCoalescesIntoLargerBlocks", &TestEntry_PMM_Buddy_FreeCoalescesIntoLargerBlocks},
+	{"Memory.PMM.Buddy.FreePagesRejectsInvalidBlocks", &TestEntry_PMM_Buddy_FreePagesRejectsInvalidBlocks},
+	{"Memory.PMM.Numa.PrefersCoreNodeAndFallsBack", &TestEntry_PMM_Numa_PrefersCoreNodeAndFallsBack},
+	{"Memory.PMM.ZeroedPool.ServesZeroedFrames", &TestEntry_PMM_ZeroedPool_ServesZeroedFrames},
+	{"Memory.PMM.DeferredMetadata.InitializesOnDemand", &TestEntry_PMM_DeferredMetadata_InitializesOnDemand},
+	{"Memory.PMM.Benchmark.AllocationLatencyByOccupancy", &TestEntry_PMM_Benchmark_AllocationLatencyByOccupancy},
+	{"Memory.PMM.Benchmark.ZeroedPageLatency", &TestEntry_PMM_Benchmark_ZeroedPageLatency},
+	{"Memory.PMM.Benchmark.InitializationPhases", &TestEntry_PMM_Benchmark_InitializationPhases},
+	{"Memory.PMM.Benchmark.FrameMetadataFootprintAndRefCountThroughput", &TestEntry_PMM_Benchmark_FrameMetadataFootprintAndRefCountThroughput},
+	{"Memory.BootMemoryMap.DeviceTree.ParsesNumaNodeIds", &TestEntry_BootMemoryMap_DeviceTree_ParsesNumaNodeIds},
+	{"Memory.PageFrameCache.RefillsAndServesHitsFromMagazine", &TestEntry_PageFrameCache_RefillsAndServesHitsFromMagazine},
+	{"Memory.PageFrameCache.DrainsBatchWhenFull", &TestEntry_PageFrameCache_DrainsBatchWhenFull},
+	{"Memory.PageFrameCache.SharedOrMappedFramesBypassMagazine", &TestEntry_PageFrameCache_SharedOrMappedFramesBypassMagazine},
+	{"Memory.PageTablePool.ReserveTracksWatermarks", &TestEntry_PageTablePool_ReserveTracksWatermarks},
+	{"Memory.PageTablePool.DeferredPagesWaitForReclaim", &TestEntry_PageTablePool_DeferredPagesWaitForReclaim},
+	{"Memory.PageTablePool.FullDeferredListFlushesAndRecycles", &TestEntry_PageTablePool_FullDeferredListFlushesAndRecycles},
+	{"Memory.PageTablePool.PagingWalkFailsBeforeBuildingTables", &TestEntry_PageTablePool_PagingWalkFailsBeforeBuildingTables},
+	{"Memory.PageTablePool.Benchmark.MapUnmapFreshPath", &TestEntry_PageTablePool_Benchmark_MapUnmapFreshPath},
+	{"Memory.AsidAllocator.KeepsAsidAcrossActivations", &TestEntry_AsidAllocator_KeepsAsidAcrossActivations},
+	{"Memory.AsidAllocator.RolloverFlushesOnceAndKeepsRunningAsid", &TestEntry_AsidAllocator_RolloverFlushesOnceAndKeepsRunningAsid},
+	{"Memory.Slab.AllocateFreeReusesSlots", &TestEntry_Slab_AllocateFreeReusesSlots},
+	{"Memory.Slab.GrowsReleasesAndRejectsForeignPointers", &TestEntry_Slab_GrowsReleasesAndRejectsForeignPointers},
+	{"Memory.Slab.Benchmark.SmallObjectLatencyVersusHeap", &TestEntry_Slab_Benchmark_SmallObjectLatencyVersusHeap},
+	{"Memory.Heap.GrowsOnDemandAndTrimsFreeTail", &TestEntry_Heap_GrowsOnDemandAndTrimsFreeTail},
+	{"Memory.Heap.AlignedAllocationsSplitAndCoalesce", &TestEntry_Heap_AlignedAllocationsSplitAndCoalesce},
+	{"Memory.Heap.StatisticsTrackAllocationsAndFragmentation", &TestEntry_Heap_StatisticsTrackAllocationsAndFragmentation},
+	{"Memory.Heap.ReallocResizesInPlaceAndUsableSize", &TestEntry_Heap_ReallocResizesInPlaceAndUsableSize},
+	{"Memory.Heap.Benchmark.FragmentedAllocLatency", &TestEntry_Heap_Benchmark_FragmentedAllocLatency},
 	{"Memory.PagingHw.EnablePaging.TlbRefillSmoke", &TestEntry_PagingHw_EnablePaging_TlbRefillSmoke},
 	{"Memory.PagingHw.UnmappedAccess.FaultsAndReportsBadV", &TestEntry_PagingHw_UnmappedAccess_FaultsAndReportsBadV},
 	{"Memory.PagingHw.PagingFaultObserver.DispatchesAndCanHandle", &TestEntry_PagingHw_PagingFaultObserver_DispatchesAndCanHandle},
 	{"Memory.PagingHw.PagingFaultObserver.MapsAndRetries", &TestEntry_PagingHw_PagingFaultObserver_MapsAndRetries},
 	{"Memory.PagingHw.KernelPager.MapsAndRetries", &TestEntry_PagingHw_KernelPager_MapsAndRetries},
 	{"Memory.PagingHw.VmmPager.MapsViaVmaAndVmObject", &TestEntry_PagingHw_VmmPager_MapsViaVmaAndVmObject},
+	{"Memory.PagingHw.VmmPager.FaultAroundMapsResidentNeighbours", &TestEntry_PagingHw_VmmPager_FaultAroundMapsResidentNeighbours},
+	{"Memory.PagingHw.VmmPager.SharedZeroPageUntilFirstStore", &TestEntry_PagingHw_VmmPager_SharedZeroPageUntilFirstStore},
+	{"Memory.PagingHw.VmmPager.CopyOnWriteAfterClone", &TestEntry_PagingHw_VmmPager_CopyOnWriteAfterClone},
 	{"Memory.PagingHw.ReadOnlyStore.RaisesPME", &TestEntry_PagingHw_ReadOnlyStore_RaisesPme},
 	{"Memory.PagingHw.NonExecutableFetch.RaisesPNX", &TestEntry_PagingHw_NonExecutableFetch_RaisesPnx},
 	{"Memory.PagingHw.PostPaging.MapUnmap.Faults", &TestEntry_PagingHw_PostPaging_MapUnmap_Faults},
 	{"Memory.PagingHw.HigherHalfStack.GuardPageFaults", &TestEntry_PagingHw_HigherHalfStack_GuardPageFaults},
+	{"Memory.PagingHw.TlbRefill.LddirMatchesSoftwareWalk", &TestEntry_PagingHw_TlbRefill_LddirMatchesSoftwareWalk},
+	{"Memory.PagingHw.Benchmark.TlbRefillLddirVersusSoftwareWalk", &TestEntry_PagingHw_Benchmark_TlbRefillLddirVersusSoftwareWalk},
+	{"Memory.PagingHw.PagingStatistics.CountsRefillsAndFaults", &TestEntry_PagingHw_PagingStatistics_CountsRefillsAndFaults},
 	{"Memory.PagingHw.AddressSpaces.SwitchPgdlChangesTranslation", &TestEntry_PagingHw_AddressSpaces_SwitchPgdlChangesTranslation},
 };
 
@@ -0,0 +1,135 @@
+/**
+ * Copyright (C) 2026 Andrew S. Rightenburg
+ * GPL-3.0-or-later
+ */
+
+#include <src/testing/test.h>
+
+#include <src/memory/asid_allocator.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Rocinante::Testing {
+
+namespace {
+
+// A test-private allocator: the kernel one is initialized by paging bring-up
+// from CSR.ASID.ASIDBITS. These tests only exercise the bookkeeping; the
+// PagingHw tests cover what the hardware does with the result.
+static Rocinante::Memory::AsidAllocator g_test_allocator;
+
+static void Test_AsidAllocator_KeepsAsidAcrossActivations(TestContext* ctx) {
+	using Rocinante::Memory::AsidAllocator;
+
+	g_test_allocator.Initialize(4);
+	ROCINANTE_EXPECT_EQ_U64(ctx, g_test_allocator.AsidCount(), 16);
+
+	AsidAllocator::Assignment a{};
+	AsidAllocator::Assignment b{};
+
+	// The first activation after Initialize() flushes: the TLB may hold
+	// entries from before the allocator existed.
+	const auto first_a = g_test_allocator.Activate(&a);
+	ROCINANTE_EXPECT_TRUE(ctx, first_a.flush_non_global);
+	ROCINANTE_EXPECT_TRUE(ctx, first_a.asid != AsidAllocator::kReservedAsid);
+	ROCINANTE_EXPECT_EQ_U64(ctx, first_a.asid, a.asid);
+
+	const auto first_b = g_test_allocator.Activate(&b);
+	ROCINANTE_EXPECT_TRUE(ctx, !first_b.flush_non_global);
+	ROCINANTE_EXPECT_TRUE(ctx, first_b.asid != AsidAllocator::kReservedAsid);
+	ROCINANTE_EXPECT_TRUE(ctx, first_b.asid != first_a.asid);
+
+	// Switching back and forth reuses the ASIDs and never flushes.
+	for (std::size_t i = 0; i < 8; i++) {
+		const auto again_a = g_test_allocator.Activate(&a);
+		const auto again_b = g_test_allocator.Activate(&b);
+		ROCINANTE_EXPECT_EQ_U64(ctx, again_a.asid, first_a.asid);
+		ROCINANTE_EXPECT_EQ_U64(ctx, again_b.asid, first_b.asid);
+		ROCINANTE_EXPECT_TRUE(ctx, !again_a.flush_non_global && !again_b.flush_non_global);
+	}
+
+	const auto statistics = g_test_allocator.GetStatistics();
+	ROCINANTE_EXPECT_EQ_U64(ctx, statistics.generation, 1);
+	ROCINANTE_EXPECT_EQ_U64(ctx, statistics.assignments, 2);
+	ROCINANTE_EXPECT_EQ_U64(ctx, statistics.rollovers, 0);
+	ROCINANTE_EXPECT_EQ_U64(ctx, statistics.flushes, 1);
+
+	// A released ASID goes back to the pool without a new generation. The
+	// search is round-robin, so it comes back once the 13 never-used ASIDs
+	// are gone.
+	const std::uint16_t released_asid = b.asid;
+	g_test_allocator.Release(&b);
+	ROCINANTE_EXPECT_EQ_U64(ctx, b.generation, 0);
+	AsidAllocator::Assignment spaces[14] = {};
+	bool reused = false;
+	for (auto& space : spaces) {
+		(void)g_test_allocator.Activate(&space);
+		if (space.asid == released_asid) reused = true;
+	}
+	ROCINANTE_EXPECT_TRUE(ctx, reused);
+	ROCINANTE_EXPECT_EQ_U64(ctx, g_test_allocator.GetStatistics().rollovers, 0);
+}
+
+static void Test_AsidAllocator_RolloverFlushesOnceAndKeepsRunningAsid(TestContext* ctx) {
+	using Rocinante::Memory::AsidAllocator;
+
+	// 8 ASIDs: ASID 0 is reserved, so generation 1 holds 7 address spaces.
+	g_test_allocator.Initialize(3);
+	AsidAllocator::Assignment spaces[8] = {};
+	for (std::size_t i = 0; i < 7; i++) {
+		(void)g_test_allocator.Activate(&spaces[i]);
+		ROCINANTE_EXPECT_EQ_U64(ctx, spaces[i].generation, 1);
+	}
+	const AsidAllocator::Assignment running = spaces[6];
+
+	// The eighth address space starts generation 2 and flushes once.
+	const auto overflow = g_test_allocator.Activate(&spaces[7]);
+	ROCINANTE_EXPECT_TRUE(ctx, overflow.flush_non_global);
+	ROCINANTE_EXPECT_EQ_U64(ctx, spaces[7].generation, 2);
+	ROCINANTE_EXPECT_EQ_U64(ctx, g_test_allocator.GetStatistics().rollovers, 1);
+
+	// The address space that was running at rollover keeps its ASID, and
+	// the new generation never hands that ASID to anyone else.
+	ROCINANTE_EXPECT_TRUE(ctx, spaces[7].asid != running.asid);
+	const auto resumed = g_test_allocator.Activate(&spaces[6]);
+	ROCINANTE_EXPECT_TRUE(ctx, !resumed.flush_non_global);
+	ROCINANTE_EXPECT_EQ_U64(ctx, resumed.asid, running.asid);
+	ROCINANTE_EXPECT_EQ_U64(ctx, spaces[6].generation, 2);
+
+	// Stale address spaces get new ASIDs in generation 2 without flushing
+	// again. Two of its seven ASIDs are taken, so five more fit.
+	for (std::size_t i = 0; i < 5; i++) {
+		const auto activation = g_test_allocator.Activate(&spaces[i]);
+		ROCINANTE_EXPECT_TRUE(ctx, !activation.flush_non_global);
+		ROCINANTE_EXPECT_EQ_U64(ctx, spaces[i].generation, 2);
+	}
+	ROCINANTE_EXPECT_EQ_U64(ctx, g_test_allocator.GetStatistics().rollovers, 1);
+	ROCINANTE_EXPECT_EQ_U64(ctx, g_test_allocator.GetStatistics().flushes, 2);
+
+	const std::size_t current[] = {0, 1, 2, 3, 4, 6, 7};
+	std::size_t duplicates = 0;
+	for (std::size_t i = 0; i < 7; i++) {
+		for (std::size_t j = i + 1; j < 7; j++) {
+			if (spaces[current[i]].asid == spaces[current[j]].asid) duplicates++;
+		}
+	}
+	ROCINANTE_EXPECT_EQ_U64(ctx, duplicates, 0);
+
+	// The generation is full again: the next stale address space rolls over.
+	(void)g_test_allocator.Activate(&spaces[5]);
+	ROCINANTE_EXPECT_EQ_U64(ctx, spaces[5].generation, 3);
+	ROCINANTE_EXPECT_EQ_U64(ctx, g_test_allocator.GetStatistics().rollovers, 2);
+}
+
+} // namespace
+
+void TestEntry_AsidAllocator_KeepsAsidAcrossActivations(TestContext* ctx) {
+	Test_AsidAllocator_KeepsAsidAcrossActivations(ctx);
+}
+
+void TestEntry_AsidAllocator_RolloverFlushesOnceAndKeepsRunningAsid(TestContext* ctx) {
+	Test_AsidAllocator_RolloverFlushesOnceAndKeepsRunningAsid(ctx);
+}
+
+} // namespace Rocinante::Testing
@@ -0,0 +1,212 @@
+/**
+ * Copyright (C) 2026 Andrew S. Rightenburg
+ * GPL-3.0-or-later
+ */
+
+#include <src/testing/test.h>
+
+#include <src/memory/boot_memory_map.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Rocinante::Testing {
+
+namespace {
+
+// Minimal flattened-device-tree writer for parser tests.
+//
+// Layout: [header (40 bytes)][empty memreserve table][structure][strings].
+// The structure block is written first into `structure`; Finish() copies the
+// pieces into `blob` and fills in the header.
+struct FdtWriter final {
+	static constexpr std::size_t kHeaderSizeBytes = 40;
+	static constexpr std::size_t kMemReserveSizeBytes = 16;
+	static constexpr std::size_t kCapacityBytes = 1024;
+
+	alignas(8) std::uint8_t blob[kCapacityBytes] = {};
+	std::uint8_t structure[kCapacityBytes] = {};
+	std::size_t structure_size_bytes = 0;
+	char strings[256] = {};
+	std::size_t strings_size_bytes = 0;
+	bool overflowed = false;
+
+	void Reset() {
+		structure_size_bytes = 0;
+		strings_size_bytes = 0;
+		overflowed = false;
+	}
+
+	static void PutBe32(std::uint8_t* p, std::uint32_t value) {
+		p[0] = static_cast<std::uint8_t>(value >> 24u);
+		p[1] = static_cast<std::uint8_t>(value >> 16u);
+		p[2] = static_cast<std::uint8_t>(value >> 8u);
+		p[3] = static_cast<std::uint8_t>(value >> 0u);
+	}
+
+	void Token(std::uint32_t value) {
+		if (structure_size_bytes + 4 > kCapacityBytes) {
+			overflowed = true;
+			return;
+		}
+		PutBe32(structure + structure_size_bytes, value);
+		structure_size_bytes += 4;
+	}
+
+	void PaddedBytes(const void* data, std::size_t size_bytes) {
+		const std::size_t padded = (size_bytes + 3u) & ~static_cast<std::size_t>(3u);
+		if (structure_size_bytes + padded > kCapacityBytes) {
+			overflowed = true;
+			return;
+		}
+		const auto* bytes = static_cast<const std::uint8_t*>(data);
+		for (std::size_t i = 0; i < padded; i++) {
+			structure[structure_size_bytes + i] = (i < size_bytes) ? bytes[i] : 0;
+		}
+		structure_size_bytes += padded;
+	}
+
+	std::uint32_t StringOffset(const char* name) {
+		// Reuse an existing entry if present.
+		std::size_t offset = 0;
+		while (offset < strings_size_bytes) {
+			std::size_t i = 0;
+			while (name[i] != '\0' && strings[offset + i] == name[i]) i++;
+			if (name[i] == '\0' && strings[offset + i] == '\0') return static_cast<std::uint32_t>(offset);
+			while (strings[offset] != '\0') offset++;
+			offset++;
+		}
+
+		std::size_t len = 0;
+		while (name[len] != '\0') len++;
+		if (strings_size_bytes + len + 1 > sizeof(strings)) {
+			overflowed = true;
+			return 0;
+		}
+		const std::size_t new_offset = strings_size_bytes;
+		for (std::size_t i = 0; i <= len; i++) strings[new_offset + i] = name[i];
+		strings_size_bytes += len + 1;
+		return static_cast<std::uint32_t>(new_offset);
+	}
+
+	void BeginNode(const char* name) {
+		Token(1); // FDT_BEGIN_NODE
+		std::size_t len = 0;
+		while (name[len] != '\0') len++;
+		PaddedBytes(name, len + 1);
+	}
+
+	void EndNode() {
+		Token(2); // FDT_END_NODE
+	}
+
+	void PropertyCells(const char* name, const std::uint32_t* cells, std::size_t cell_count) {
+		Token(3); // FDT_PROP
+		Token(static_cast<std::uint32_t>(cell_count * 4));
+		Token(StringOffset(name));
+		for (std::size_t i = 0; i < cell_count; i++) Token(cells[i]);
+	}
+
+	void PropertyU32(const char* name, std::uint32_t value) {
+		PropertyCells(name, &value, 1);
+	}
+
+	// Returns nullptr if the blob did not fit.
+	const void* Finish() {
+		Token(9); // FDT_END
+		const std::size_t off_struct = kHeaderSizeBytes + kMemReserveSizeBytes;
+		const std::size_t off_strings = off_struct + structure_size_bytes;
+		const std::size_t total = off_strings + strings_size_bytes;
+		if (overflowed || total > kCapacityBytes) return nullptr;
+
+		for (std::size_t i = 0; i < structure_size_bytes; i++) blob[off_struct + i] = structure[i];
+		for (std::size_t i = 0; i < strings_size_bytes; i++) blob[off_strings + i] = static_cast<std::uint8_t>(strings[i]);
+
+		PutBe32(blob + 0, 0xd00dfeedu);                           // magic
+		PutBe32(blob + 4, static_cast<std::uint32_t>(total));       // totalsize
+		PutBe32(blob + 8, static_cast<std::uint32_t>(off_struct));  // off_dt_struct
+		PutBe32(blob + 12, static_cast<std::uint32_t>(off_strings)); // off_dt_strings
+		PutBe32(blob + 16, kHeaderSizeBytes);                       // off_mem_rsvmap
+		PutBe32(blob + 20, 17);                                     // version
+		PutBe32(blob + 24, 16);                                     // last_comp_version
+		PutBe32(blob + 28, 0);                                      // boot_cpuid_phys
+		PutBe32(blob + 32, static_cast<std::uint32_t>(strings_size_bytes));
+		PutBe32(blob + 36, static_cast<std::uint32_t>(structure_size_bytes));
+		return blob;
+	}
+};
+
+static FdtWriter g_fdt_writer;
+
+static void Test_BootMemoryMap_DeviceTree_ParsesNumaNodeIds(TestContext* ctx) {
+	using Rocinante::Memory::BootMemoryRegion;
+	using Rocinante::Memory::BootMemoryMap;
+
+	// Shaped like QEMU's `-machine virt -numa ...` output: one /memory node per
+	// NUMA node, and a numa-node-id on every CPU. Node 0 lists numa-node-id
+	// after reg (QEMU's order); node 1 lists it first.
+	static constexpr std::uint32_t kNodeSizeBytes = 0x08000000; // 128 MiB
+	static constexpr std::uint32_t kNode0Reg[] = {0, 0, 0, kNodeSizeBytes};
+	static constexpr std::uint32_t kNode1Reg[] = {0, kNodeSizeBytes, 0, kNodeSizeBytes};
+
+	FdtWriter& w = g_fdt_writer;
+	w.Reset();
+	w.BeginNode("");
+	w.PropertyU32("#address-cells", 2);
+	w.PropertyU32("#size-cells", 2);
+
+	w.BeginNode("memory@0");
+	w.PropertyCells("reg", kNode0Reg, 4);
+	w.PropertyU32("numa-node-id", 0);
+	w.EndNode();
+
+	w.BeginNode("memory@8000000");
+	w.PropertyU32("numa-node-id", 1);
+	w.PropertyCells("reg", kNode1Reg, 4);
+	w.EndNode();
+
+	w.BeginNode("cpus");
+	w.PropertyU32("#address-cells", 1);
+	w.PropertyU32("#size-cells", 0);
+	for (std::uint32_t core = 0; core < 4; core++) {
+		char cpu_node_name[] = "cpu@0";
+		cpu_node_name[4] = static_cast<char>('0' + core);
+		w.BeginNode(cpu_node_name);
+		w.PropertyU32("reg", core);
+		w.PropertyU32("numa-node-id", core / 2);
+		w.EndNode();
+	}
+	w.EndNode();
+
+	w.EndNode();
+	const void* blob = w.Finish();
+	ROCINANTE_EXPECT_TRUE(ctx, blob != nullptr);
+	if (!blob) return;
+
+	BootMemoryMap map;
+	ROCINANTE_EXPECT_TRUE(ctx, map.TryParseFromDeviceTree(blob));
+
+	// The two ranges are adjacent but on different nodes: they must not merge.
+	ROCINANTE_EXPECT_EQ_U64(ctx, map.region_count, 2);
+	if (map.region_count != 2) return;
+	for (std::size_t i = 0; i < map.region_count; i++) {
+		const BootMemoryRegion& r = map.regions[i];
+		ROCINANTE_EXPECT_TRUE(ctx, r.type == BootMemoryRegion::Type::UsableRAM);
+		ROCINANTE_EXPECT_EQ_U64(ctx, r.size_bytes, kNodeSizeBytes);
+		ROCINANTE_EXPECT_EQ_U64(ctx, r.numa_node_id, (r.physical_base == 0) ? 0 : 1);
+	}
+
+	ROCINANTE_EXPECT_EQ_U64(ctx, map.cpu_numa_affinity_count, 4);
+	for (std::size_t i = 0; i < map.cpu_numa_affinity_count; i++) {
+		const auto& a = map.cpu_numa_affinities[i];
+		ROCINANTE_EXPECT_EQ_U64(ctx, a.numa_node_id, a.core_id / 2);
+	}
+}
+
+} // namespace
+
+void TestEntry_BootMemoryMap_DeviceTree_ParsesNumaNodeIds(TestContext* ctx) {
+	Test_BootMemoryMap_DeviceTree_ParsesNumaNodeIds(ctx);
+}
+
+} // namespace Rocinante::Testing
@@ -0,0 +1,368 @@
+/**
+ * Copyright (C) 2026 Andrew S. Rightenburg
+ * GPL-3.0-or-later
+ */
+
+#include <src/testing/test.h>
+
+#include <src/sp/cpucfg.h>
+
+#include <src/memory/boot_memory_map.h>
+#include <src/memory/heap.h>
+#include <src/memory/paging.h>
+#include <src/memory/pmm.h>
+#include <src/sp/stable_counter.h>
+
+#include <cstddef>
+#include <cstdint>
+
+extern "C" char _start;
+extern "C" char _end;
+
+namespace Rocinante::Testing {
+
+namespace {
+
+// Tests run in direct-address mode, so the heap's "virtual" window is used as
+// a physical address. Split the usual 8 MiB scratch region: the PMM owns the
+// lower half (backing frames + page tables), the heap window sits in the
+// upper half where nothing else will hand out the same memory.
+static constexpr std::uintptr_t kPmmBase = 0x01000000; // 16 MiB
+static constexpr std::size_t kPmmSizeBytes = 4u * 1024u * 1024u;
+static constexpr std::uintptr_t kHeapWindowBase = kPmmBase + kPmmSizeBytes; // 20 MiB
+static constexpr std::size_t kHeapWindowSizeBytes = 2u * 1024u * 1024u;
+
+static bool InitializeGrowableHeapForTest(TestContext* ctx, std::size_t initial_size_bytes, Rocinante::Memory::Heap::GrowthConfig* out_config) {
+	using Rocinante::Memory::BootMemoryRegion;
+	using Rocinante::Memory::BootMemoryMap;
+	using namespace Rocinante::Memory::Paging;
+
+	auto& cpucfg = Rocinante::GetCPUCFG();
+	const AddressSpaceBits address_bits{
+		.virtual_address_bits = static_cast<std::uint8_t>(cpucfg.VirtualAddressBits()),
+		.physical_address_bits = static_cast<std::uint8_t>(cpucfg.PhysicalAddressBits()),
+	};
+
+	const std::uintptr_t kernel_physical_base = reinterpret_cast<std::uintptr_t>(&_start);
+	const std::uintptr_t kernel_physical_end = reinterpret_cast<std::uintptr_t>(&_end);
+
+	BootMemoryMap map;
+	map.Clear();
+	ROCINANTE_EXPECT_TRUE(ctx, map.AddRegion(BootMemoryRegion{.physical_base = kPmmBase, .size_bytes = kPmmSizeBytes, .type = BootMemoryRegion::Type::UsableRAM}));
+
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+	const bool pmm_ok = pmm.InitializeFromBootMemoryMap(map, kernel_physical_base, kernel_physical_end, 0, 0);
+	ROCINANTE_EXPECT_TRUE(ctx, pmm_ok);
+	if (!pmm_ok) return false;
+
+	const auto root_or = AllocateRootPageTable(&pmm);
+	ROCINANTE_EXPECT_TRUE(ctx, root_or.has_value());
+	if (!root_or.has_value()) return false;
+
+	*out_config = Rocinante::Memory::Heap::GrowthConfig{
+		.pmm = &pmm,
+		.root = root_or.value(),
+		.address_bits = address_bits,
+		.permissions = PagePermissions{
+			.access = AccessPermissions::ReadWrite,
+			.execute = ExecutePermissions::NoExecute,
+			.cache = CacheMode::CoherentCached,
+			.global = true,
+		},
+		.window_base = kHeapWindowBase,
+		.window_size_bytes = kHeapWindowSizeBytes,
+	};
+
+	const bool heap_ok = Rocinante::Memory::Heap::InitGrowable(*out_config, initial_size_bytes);
+	ROCINANTE_EXPECT_TRUE(ctx, heap_ok);
+	return heap_ok;
+}
+
+static void Test_Heap_GrowsOnDemandAndTrimsFreeTail(TestContext* ctx) {
+	namespace Heap = Rocinante::Memory::Heap;
+	using Rocinante::Memory::Paging::Translate;
+	using Rocinante::Memory::Paging::kPageSizeBytes;
+
+	Heap::GrowthConfig config{};
+	if (!InitializeGrowableHeapForTest(ctx, Heap::kGrowthChunkBytes, &config)) return;
+	auto& pmm = *config.pmm;
+
+	const std::size_t initial_total = Heap::TotalBytes();
+	ROCINANTE_EXPECT_EQ_U64(ctx, initial_total, Heap::kGrowthChunkBytes);
+	const std::size_t pmm_free_after_init = pmm.FreePages();
+
+	// Three blocks that cannot all fit in the initial chunk.
+	static constexpr std::size_t kBlockCount = 3;
+	static constexpr std::size_t kBlockSizeBytes = 48u * 1024u;
+	std::uint8_t* blocks[kBlockCount] = {};
+	for (std::size_t i = 0; i < kBlockCount; i++) {
+		blocks[i] = static_cast<std::uint8_t*>(Heap::Alloc(kBlockSizeBytes, 64));
+		ROCINANTE_EXPECT_TRUE(ctx, blocks[i] != nullptr);
+		if (!blocks[i]) return;
+		ROCINANTE_EXPECT_EQ_U64(ctx, reinterpret_cast<std::uintptr_t>(blocks[i]) % 64, 0);
+		for (std::size_t b = 0; b < kBlockSizeBytes; b += 512) blocks[i][b] = static_cast<std::uint8_t>(i + 1);
+	}
+
+	const std::size_t grown_total = Heap::TotalBytes();
+	ROCINANTE_EXPECT_TRUE(ctx, grown_total > initial_total);
+	ROCINANTE_EXPECT_EQ_U64(ctx, grown_total % Heap::kGrowthChunkBytes, 0);
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.FreePages() < pmm_free_after_init);
+
+	// Every page of the grown region is mapped in the heap's page tables.
+	for (std::size_t offset = 0; offset < grown_total; offset += kPageSizeBytes) {
+		ROCINANTE_EXPECT_TRUE(ctx, Translate(config.root, kHeapWindowBase + offset, config.address_bits).has_value());
+	}
+	ROCINANTE_EXPECT_TRUE(ctx, !Translate(config.root, kHeapWindowBase + grown_total, config.address_bits).has_value());
+
+	for (std::size_t i = 0; i < kBlockCount; i++) {
+		bool intact = true;
+		for (std::size_t b = 0; b < kBlockSizeBytes; b += 512) intact = intact && (blocks[i][b] == static_cast<std::uint8_t>(i + 1));
+		ROCINANTE_EXPECT_TRUE(ctx, intact);
+	}
+
+	// A request bigger than the window fails without disturbing the heap.
+	ROCINANTE_EXPECT_TRUE(ctx, Heap::Alloc(kHeapWindowSizeBytes, 16) == nullptr);
+	ROCINANTE_EXPECT_EQ_U64(ctx, Heap::TotalBytes(), grown_total);
+
+	// Freeing everything trims back to the initial size plus one spare chunk,
+	// and those frames go back to the PMM (the leaf table stays: the initial
+	// chunk still lives in it).
+	for (std::size_t i = kBlockCount; i > 0; i--) Heap::Free(blocks[i - 1]);
+	const std::size_t trimmed_total = initial_total + Heap::kGrowthChunkBytes;
+	ROCINANTE_EXPECT_EQ_U64(ctx, Heap::TotalBytes(), trimmed_total);
+	ROCINANTE_EXPECT_EQ_U64(ctx, Heap::FreeBytes(), trimmed_total);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), pmm_free_after_init - (Heap::kGrowthChunkBytes / kPageSizeBytes));
+	ROCINANTE_EXPECT_TRUE(ctx, !Translate(config.root, kHeapWindowBase + trimmed_total, config.address_bits).has_value());
+
+	// Growing again reuses the same window addresses.
+	void* regrown = Heap::Alloc(3 * Heap::kGrowthChunkBytes, 16);
+	ROCINANTE_EXPECT_TRUE(ctx, regrown != nullptr);
+	ROCINANTE_EXPECT_TRUE(ctx, Heap::TotalBytes() > trimmed_total);
+	Heap::Free(regrown);
+	ROCINANTE_EXPECT_EQ_U64(ctx, Heap::TotalBytes(), trimmed_total);
+
+	// Leave the heap uninitialized for later tests; its PMM and page tables
+	// are about to be re-initialized under it.
+	Heap::Init(nullptr, 0);
+	ROCINANTE_EXPECT_TRUE(ctx, !Heap::IsInitialized());
+}
+
+// Fixed-region heap for the tests that do not need growth; the global slab
+// allocator is unbound during tests, so every request takes the TLSF path.
+static constexpr std::size_t kFixedHeapBytes = 256u * 1024u;
+alignas(16) static std::uint8_t g_fixed_heap[kFixedHeapBytes];
+
+static void Test_Heap_AlignedAllocationsSplitAndCoalesce(TestContext* ctx) {
+	namespace Heap = Rocinante::Memory::Heap;
+
+	Heap::Init(g_fixed_heap, sizeof(g_fixed_heap));
+	ROCINANTE_EXPECT_TRUE(ctx, Heap::IsInitialized());
+	const std::size_t total = Heap::TotalBytes();
+	ROCINANTE_EXPECT_EQ_U64(ctx, Heap::FreeBytes(), total);
+
+	// One allocation per alignment from 16 bytes to 64 KiB, mixed with small
+	// unaligned ones so the aligned blocks have to split prefixes off.
+	static constexpr std::size_t kAlignmentCount = 13;
+	void* aligned[kAlignmentCount] = {};
+	void* small[kAlignmentCount] = {};
+	for (std::size_t i = 0; i < kAlignmentCount; i++) {
+		const std::size_t alignment = std::size_t{16} << i;
+		small[i] = Heap::Alloc(24 + i);
+		aligned[i] = Heap::Alloc(100 + (i * 8), alignment);
+		ROCINANTE_EXPECT_TRUE(ctx, small[i] != nullptr && aligned[i] != nullptr);
+		if (!small[i] || !aligned[i]) return;
+		ROCINANTE_EXPECT_EQ_U64(ctx, reinterpret_cast<std::uintptr_t>(aligned[i]) % alignment, 0);
+		ROCINANTE_EXPECT_EQ_U64(ctx, reinterpret_cast<std::uintptr_t>(small[i]) % 16, 0);
+	}
+	ROCINANTE_EXPECT_TRUE(ctx, Heap::FreeBytes() < total);
+
+	// Freeing in an interleaved order must coalesce back to one block that
+	// can serve (almost) the whole heap again.
+	for (std::size_t i = 0; i < kAlignmentCount; i += 2) Heap::Free(aligned[i]);
+	for (std::size_t i = 0; i < kAlignmentCount; i++) Heap::Free(small[i]);
+	for (std::size_t i = 1; i < kAlignmentCount; i += 2) Heap::Free(aligned[i]);
+	ROCINANTE_EXPECT_EQ_U64(ctx, Heap::FreeBytes(), total);
+
+	void* whole = Heap::Alloc(total - 64);
+	ROCINANTE_EXPECT_TRUE(ctx, whole != nullptr);
+	Heap::Free(whole);
+	ROCINANTE_EXPECT_TRUE(ctx, Heap::Alloc(total) == nullptr);
+	ROCINANTE_EXPECT_TRUE(ctx, Heap::Alloc(64, 24) == nullptr);
+	ROCINANTE_EXPECT_EQ_U64(ctx, Heap::FreeBytes(), total);
+
+	Heap::Init(nullptr, 0);
+}
+
+static void Test_Heap_StatisticsTrackAllocationsAndFragmentation(TestContext* ctx) {
+	namespace Heap = Rocinante::Memory::Heap;
+
+	Heap::Init(g_fixed_heap, sizeof(g_fixed_heap));
+	auto stats = Heap::GetStatistics();
+	ROCINANTE_EXPECT_EQ_U64(ctx, stats.total_bytes, kFixedHeapBytes);
+	ROCINANTE_EXPECT_EQ_U64(ctx, stats.used_bytes, 0);
+	ROCINANTE_EXPECT_EQ_U64(ctx, stats.free_bytes, kFixedHeapBytes);
+	ROCINANTE_EXPECT_EQ_U64(ctx, stats.free_block_count, 1);
+	ROCINANTE_EXPECT_EQ_U64(ctx, stats.largest_free_block_bytes, kFixedHeapBytes);
+	ROCINANTE_EXPECT_EQ_U64(ctx, stats.allocation_count, 0);
+
+	// Eight 1 KiB blocks; freeing every other one leaves four isolated holes
+	// plus the untouched tail.
+	static constexpr std::size_t kBlockCount = 8;
+	void* blocks[kBlockCount] = {};
+	for (std::size_t i = 0; i < kBlockCount; i++) {
+		blocks[i] = Heap::Alloc(1000);
+		ROCINANTE_EXPECT_TRUE(ctx, blocks[i] != nullptr);
+		if (!blocks[i]) return;
+	}
+	stats = Heap::GetStatistics();
+	ROCINANTE_EXPECT_EQ_U64(ctx, stats.allocation_count, kBlockCount);
+	ROCINANTE_EXPECT_EQ_U64(ctx, stats.free_block_count, 1);
+	ROCINANTE_EXPECT_EQ_U64(ctx, stats.used_bytes + stats.free_bytes, stats.total_bytes);
+	const std::size_t block_bytes = stats.used_bytes / kBlockCount;
+	ROCINANTE_EXPECT_TRUE(ctx, block_bytes >= 1000);
+	ROCINANTE_EXPECT_EQ_U64(ctx, stats.largest_free_block_bytes, stats.free_bytes);
+
+	for (std::size_t i = 0; i < kBlockCount; i += 2) Heap::Free(blocks[i]);
+	ROCINANTE_EXPECT_TRUE(ctx, Heap::Alloc(kFixedHeapBytes) == nullptr);
+	stats = Heap::GetStatistics();
+	ROCINANTE_EXPECT_EQ_U64(ctx, stats.free_count, kBlockCount / 2);
+	ROCINANTE_EXPECT_EQ_U64(ctx, stats.failed_allocation_count, 1);
+	ROCINANTE_EXPECT_EQ_U64(ctx, stats.free_block_count, (kBlockCount / 2) + 1);
+	ROCINANTE_EXPECT_EQ_U64(ctx, stats.used_bytes, (kBlockCount / 2) * block_bytes);
+	ROCINANTE_EXPECT_EQ_U64(ctx, stats.largest_free_block_bytes, kFixedHeapBytes - (kBlockCount * block_bytes));
+	ROCINANTE_EXPECT_EQ_U64(ctx, Heap::FreeBytes(), stats.free_bytes);
+
+#if defined(ROCINANTE_HEAP_DEBUG_HISTOGRAM)
+	const auto histogram = Heap::GetFreeBlockHistogram();
+	std::size_t histogram_blocks = 0;
+	for (std::size_t bucket = 0; bucket < Heap::kFreeBlockHistogramBucketCount; bucket++) {
+		histogram_blocks += histogram.block_count[bucket];
+	}
+	ROCINANTE_EXPECT_EQ_U64(ctx, histogram_blocks, stats.free_block_count);
+	// The four holes share the bucket holding block_bytes.
+	std::size_t hole_bucket = 0;
+	while ((hole_bucket + 1) < Heap::kFreeBlockHistogramBucketCount &&
+		Heap::FreeBlockHistogramBucketMinBytes(hole_bucket + 1) <= block_bytes) {
+		hole_bucket++;
+	}
+	ROCINANTE_EXPECT_EQ_U64(ctx, histogram.block_count[hole_bucket], kBlockCount / 2);
+#endif
+
+	for (std::size_t i = 1; i < kBlockCount; i += 2) Heap::Free(blocks[i]);
+	stats = Heap::GetStatistics();
+	ROCINANTE_EXPECT_EQ_U64(ctx, stats.free_count, kBlockCount);
+	ROCINANTE_EXPECT_EQ_U64(ctx, stats.free_block_count, 1);
+	ROCINANTE_EXPECT_EQ_U64(ctx, stats.free_bytes, kFixedHeapBytes);
+
+	Heap::Init(nullptr, 0);
+}
+
+static void Test_Heap_ReallocResizesInPlaceAndUsableSize(TestContext* ctx) {
+	namespace Heap = Rocinante::Memory::Heap;
+
+	Heap::Init(g_fixed_heap, sizeof(g_fixed_heap));
+	ROCINANTE_EXPECT_EQ_U64(ctx, Heap::UsableSize(nullptr), 0);
+
+	// a | b | c | tail. Fill a with a pattern that every resize must keep.
+	auto* a = static_cast<std::uint8_t*>(Heap::Realloc(nullptr, 1000));
+	void* b = Heap::Alloc(1000);
+	void* c = Heap::Alloc(1000);
+	ROCINANTE_EXPECT_TRUE(ctx, a != nullptr && b != nullptr && c != nullptr);
+	if (!a || !b || !c) return;
+	ROCINANTE_EXPECT_TRUE(ctx, Heap::UsableSize(a) >= 1000);
+	for (std::size_t i = 0; i < 1000; i++) a[i] = static_cast<std::uint8_t>(i * 7);
+
+	// Shrinking keeps the pointer and hands the spare bytes back.
+	const std::size_t free_before_shrink = Heap::FreeBytes();
+	ROCINANTE_EXPECT_TRUE(ctx, Heap::Realloc(a, 200) == a);
+	ROCINANTE_EXPECT_TRUE(ctx, Heap::UsableSize(a) >= 200 && Heap::UsableSize(a) < 1000);
+	ROCINANTE_EXPECT_TRUE(ctx, Heap::FreeBytes() > free_before_shrink);
+
+	// Growing into the freed successor keeps the pointer too.
+	Heap::Free(b);
+	ROCINANTE_EXPECT_TRUE(ctx, Heap::Realloc(a, 1800) == a);
+	ROCINANTE_EXPECT_TRUE(ctx, Heap::UsableSize(a) >= 1800);
+
+	// c is still in the way, so this one has to move and copy.
+	auto* moved = static_cast<std::uint8_t*>(Heap::Realloc(a, 8000));
+	ROCINANTE_EXPECT_TRUE(ctx, moved != nullptr && moved != a);
+	if (!moved) return;
+	bool intact = true;
+	for (std::size_t i = 0; i < 200; i++) {
+		if (moved[i] != static_cast<std::uint8_t>(i * 7)) intact = false;
+	}
+	ROCINANTE_EXPECT_TRUE(ctx, intact);
+
+	// A failed resize leaves the block alone.
+	ROCINANTE_EXPECT_TRUE(ctx, Heap::Realloc(moved, kFixedHeapBytes) == nullptr);
+	ROCINANTE_EXPECT_TRUE(ctx, Heap::UsableSize(moved) >= 8000);
+
+	// Size 0 frees.
+	ROCINANTE_EXPECT_TRUE(ctx, Heap::Realloc(moved, 0) == nullptr);
+	Heap::Free(c);
+	ROCINANTE_EXPECT_EQ_U64(ctx, Heap::FreeBytes(), kFixedHeapBytes);
+
+	Heap::Init(nullptr, 0);
+}
+
+static void Test_Heap_Benchmark_FragmentedAllocLatency(TestContext* ctx) {
+	// Benchmark (reported, not asserted):
+	// Worst and average cost of a 4 KiB-aligned 2 KiB allocation (+free) with
+	// the heap split into hundreds of small free holes that cannot serve it.
+	// The segregated-fit index goes straight to a large enough class, so the
+	// worst case should stay close to the average.
+	static constexpr std::size_t kFragmentCount = 512;
+	static constexpr std::size_t kIterations = 256;
+
+	namespace Heap = Rocinante::Memory::Heap;
+	Heap::Init(g_fixed_heap, sizeof(g_fixed_heap));
+
+	static void* fragments[kFragmentCount * 2] = {};
+	for (std::size_t i = 0; i < kFragmentCount * 2; i++) {
+		fragments[i] = Heap::Alloc(48);
+		ROCINANTE_EXPECT_TRUE(ctx, fragments[i] != nullptr);
+		if (!fragments[i]) return;
+	}
+	for (std::size_t i = 0; i < kFragmentCount * 2; i += 2) Heap::Free(fragments[i]);
+
+	std::uint64_t worst_ticks = 0;
+	std::uint64_t total_ticks = 0;
+	for (std::size_t i = 0; i < kIterations; i++) {
+		const std::uint64_t start_ticks = Rocinante::ReadStableCounterTicks();
+		void* ptr = Heap::Alloc(2048, 4096);
+		Heap::Free(ptr);
+		const std::uint64_t ticks = Rocinante::ReadStableCounterTicks() - start_ticks;
+		ROCINANTE_EXPECT_TRUE(ctx, ptr != nullptr);
+		total_ticks += ticks;
+		if (ticks > worst_ticks) worst_ticks = ticks;
+	}
+
+	Rocinante::Testing::NoteU64(ctx, __FILE__, __LINE__, "fragmented_aligned_alloc_free_avg_ticks", total_ticks / kIterations);
+	Rocinante::Testing::NoteU64(ctx, __FILE__, __LINE__, "fragmented_aligned_alloc_free_worst_ticks", worst_ticks);
+
+	Heap::Init(nullptr, 0);
+}
+
+} // namespace
+
+void TestEntry_Heap_GrowsOnDemandAndTrimsFreeTail(TestContext* ctx) {
+	Test_Heap_GrowsOnDemandAndTrimsFreeTail(ctx);
+}
+
+void TestEntry_Heap_AlignedAllocationsSplitAndCoalesce(TestContext* ctx) {
+	Test_Heap_AlignedAllocationsSplitAndCoalesce(ctx);
+}
+
+void TestEntry_Heap_StatisticsTrackAllocationsAndFragmentation(TestContext* ctx) {
+	Test_Heap_StatisticsTrackAllocationsAndFragmentation(ctx);
+}
+
+void TestEntry_Heap_ReallocResizesInPlaceAndUsableSize(TestContext* ctx) {
+	Test_Heap_ReallocResizesInPlaceAndUsableSize(ctx);
+}
+
+void TestEntry_Heap_Benchmark_FragmentedAllocLatency(TestContext* ctx) {
+	Test_Heap_Benchmark_FragmentedAllocLatency(ctx);
+}
+
+} // namespace Rocinante::Testing
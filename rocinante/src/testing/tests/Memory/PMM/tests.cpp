@@ -6,10 +6,15 @@
 #include <src/testing/test.h>
 
 #include <src/sp/cpucfg.h>
+#include <src/sp/cpuid.h>
+#include <src/sp/stable_counter.h>
 
 #include <src/memory/boot_memory_map.h>
 #include <src/memory/pmm.h>
 
+extern "C" char _start;
+extern "C" char _end;
+
 #include <cstddef>
 #include <cstdint>
 
@@ -22,8 +27,12 @@ static constexpr std::size_t AlignUpSizeBytes(std::size_t value, std::size_t ali
 }
 
 static constexpr std::size_t BitmapReservedPagesForTrackedPages(std::size_t tracked_page_count) {
-	const std::size_t bit_count = tracked_page_count;
-	const std::size_t byte_count = (bit_count + 7) / 8;
+	// Two-level bitmap of 64-bit words: one leaf bit per page, one summary bit
+	// per leaf word.
+	constexpr std::size_t kBitsPerWord = 64;
+	const std::size_t leaf_word_count = (tracked_page_count + (kBitsPerWord - 1)) / kBitsPerWord;
+	const std::size_t summary_word_count = (leaf_word_count + (kBitsPerWord - 1)) / kBitsPerWord;
+	const std::size_t byte_count = (leaf_word_count + summary_word_count) * sizeof(std::uint64_t);
 	return AlignUpSizeBytes(byte_count, Rocinante::Memory::PhysicalMemoryManager::kPageSizeBytes) /
 		Rocinante::Memory::PhysicalMemoryManager::kPageSizeBytes;
 }
@@ -303,7 +312,7 @@ static void Test_PMM_Initialize_SingleUsableRegionContainingKernelAndDTB(TestCon
 	// Reserved pages:
 	// - DTB: 1 MiB = 256 pages
 	// - Kernel: 256 KiB = 64 pages
-	// - PMM bitmap storage: for 1024 tracked pages => 128 bytes, which occupies 1 page once page-granular reserved
+	// - PMM bitmap storage: for 1024 tracked pages => 16 leaf words + 1 summary word, which occupies 1 page once page-granular reserved
 	// - PMM per-frame metadata: for 1024 tracked pages => 16 KiB, which occupies 4 pages once page-granular reserved
 	// - Zero page: explicitly reserved by PMM policy (since kernel is not at physical 0)
 	static constexpr std::size_t kExpectedTotalPages = 1024;
@@ -419,6 +428,620 @@ static void Test_PMM_ReferenceCount_RetainRelease(TestContext* ctx) {
 	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), free_before);
 }
 
+static void Test_PMM_Buddy_AllocatePagesReturnsAlignedContiguousBlock(TestContext* ctx) {
+	using Rocinante::Memory::BootMemoryRegion;
+	using Rocinante::Memory::BootMemoryMap;
+	using Rocinante::Memory::PhysicalMemoryManager;
+
+	// 64 usable pages starting at a 1 MiB-aligned base. Buddy blocks are
+	// aligned on absolute physical frame numbers, so an order-N block must be
+	// aligned to 2^N pages in physical address space.
+	static constexpr std::uintptr_t kUsableBase = 0x00100000;
+	static constexpr std::size_t kUsablePages = 64;
+	static constexpr std::size_t kUsableSizeBytes = kUsablePages * PhysicalMemoryManager::kPageSizeBytes;
+
+	static constexpr std::uintptr_t kKernelBase = 0x00400000;
+	static constexpr std::uintptr_t kKernelEnd = 0x00401000;
+	static constexpr std::uintptr_t kDeviceTreeBase = 0x00500000;
+	static constexpr std::size_t kDeviceTreeSizeBytes = PhysicalMemoryManager::kPageSizeBytes;
+
+	BootMemoryMap map;
+	map.Clear();
+	ROCINANTE_EXPECT_TRUE(ctx, map.AddRegion(BootMemoryRegion{.physical_base = kUsableBase, .size_bytes = kUsableSizeBytes, .type = BootMemoryRegion::Type::UsableRAM}));
+
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.InitializeFromBootMemoryMap(map, kKernelBase, kKernelEnd, kDeviceTreeBase, kDeviceTreeSizeBytes));
+
+	static constexpr std::size_t kOrder = 3;
+	static constexpr std::size_t kBlockPages = static_cast<std::size_t>(1) << kOrder;
+	static constexpr std::size_t kBlockSizeBytes = kBlockPages * PhysicalMemoryManager::kPageSizeBytes;
+
+	const std::size_t free_before = pmm.FreePages();
+	const auto block_or = pmm.AllocatePages(kOrder);
+	ROCINANTE_EXPECT_TRUE(ctx, block_or.has_value());
+	if (!block_or.has_value()) return;
+	const std::uintptr_t block_base = block_or.value();
+
+	ROCINANTE_EXPECT_EQ_U64(ctx, block_base % kBlockSizeBytes, 0);
+	ROCINANTE_EXPECT_TRUE(ctx, block_base >= kUsableBase);
+	ROCINANTE_EXPECT_TRUE(ctx, (block_base + kBlockSizeBytes) <= (kUsableBase + kUsableSizeBytes));
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), free_before - kBlockPages);
+
+	// Every page of the block is individually reference counted.
+	for (std::size_t i = 0; i < kBlockPages; i++) {
+		const auto ref = pmm.ReferenceCountForPhysical(block_base + (i * PhysicalMemoryManager::kPageSizeBytes));
+		ROCINANTE_EXPECT_TRUE(ctx, ref.has_value());
+		ROCINANTE_EXPECT_EQ_U64(ctx, ref.value(), 1);
+	}
+
+	// Single-page allocations must never land inside the live block.
+	const auto page_or = pmm.AllocatePage();
+	ROCINANTE_EXPECT_TRUE(ctx, page_or.has_value());
+	if (page_or.has_value()) {
+		const bool inside_block = (page_or.value() >= block_base) && (page_or.value() < (block_base + kBlockSizeBytes));
+		ROCINANTE_EXPECT_TRUE(ctx, !inside_block);
+		ROCINANTE_EXPECT_TRUE(ctx, pmm.FreePage(page_or.value()));
+	}
+
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.FreePages(block_base, kOrder));
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), free_before);
+	const auto ref_after_free = pmm.ReferenceCountForPhysical(block_base);
+	ROCINANTE_EXPECT_TRUE(ctx, ref_after_free.has_value());
+	ROCINANTE_EXPECT_EQ_U64(ctx, ref_after_free.value(), 0);
+
+	// Requests beyond the largest supported order always fail.
+	ROCINANTE_EXPECT_TRUE(ctx, !pmm.AllocatePages(PhysicalMemoryManager::kMaxBuddyOrder + 1).has_value());
+}
+
+static void Test_PMM_Buddy_FreeCoalescesIntoLargerBlocks(TestContext* ctx) {
+	using Rocinante::Memory::BootMemoryRegion;
+	using Rocinante::Memory::BootMemoryMap;
+	using Rocinante::Memory::PhysicalMemoryManager;
+
+	static constexpr std::uintptr_t kUsableBase = 0x00100000;
+	static constexpr std::size_t kUsablePages = 64;
+	static constexpr std::size_t kUsableSizeBytes = kUsablePages * PhysicalMemoryManager::kPageSizeBytes;
+
+	static constexpr std::uintptr_t kKernelBase = 0x00400000;
+	static constexpr std::uintptr_t kKernelEnd = 0x00401000;
+	static constexpr std::uintptr_t kDeviceTreeBase = 0x00500000;
+	static constexpr std::size_t kDeviceTreeSizeBytes = PhysicalMemoryManager::kPageSizeBytes;
+
+	BootMemoryMap map;
+	map.Clear();
+	ROCINANTE_EXPECT_TRUE(ctx, map.AddRegion(BootMemoryRegion{.physical_base = kUsableBase, .size_bytes = kUsableSizeBytes, .type = BootMemoryRegion::Type::UsableRAM}));
+
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.InitializeFromBootMemoryMap(map, kKernelBase, kKernelEnd, kDeviceTreeBase, kDeviceTreeSizeBytes));
+
+	// The PMM's own bitmap and metadata occupy the first pages of the region, so
+	// the upper half (pages 32..63) is a single free order-5 block.
+	static constexpr std::size_t kLargestFreeOrder = 5;
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreeBlockCountForOrder(kLargestFreeOrder), 1);
+
+	// Drain everything one page at a time; this splits every block down to
+	// order 0.
+	static constexpr std::size_t kMaxPages = kUsablePages;
+	std::uintptr_t pages[kMaxPages] = {};
+	std::size_t page_count = 0;
+	const std::size_t free_before = pmm.FreePages();
+	while (page_count < kMaxPages) {
+		const auto page_or = pmm.AllocatePage();
+		if (!page_or.has_value()) break;
+		pages[page_count++] = page_or.value();
+	}
+	ROCINANTE_EXPECT_EQ_U64(ctx, page_count, free_before);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), 0);
+	ROCINANTE_EXPECT_TRUE(ctx, !pmm.AllocatePages(0).has_value());
+
+	// Freeing every page must coalesce back to the original block structure.
+	for (std::size_t i = 0; i < page_count; i++) {
+		ROCINANTE_EXPECT_TRUE(ctx, pmm.FreePage(pages[i]));
+	}
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), free_before);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreeBlockCountForOrder(kLargestFreeOrder), 1);
+
+	const auto large_or = pmm.AllocatePages(kLargestFreeOrder);
+	ROCINANTE_EXPECT_TRUE(ctx, large_or.has_value());
+	if (!large_or.has_value()) return;
+	ROCINANTE_EXPECT_EQ_U64(ctx, large_or.value(), kUsableBase + (32 * PhysicalMemoryManager::kPageSizeBytes));
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.FreePages(large_or.value(), kLargestFreeOrder));
+}
+
+static void Test_PMM_Buddy_FreePagesRejectsInvalidBlocks(TestContext* ctx) {
+	using Rocinante::Memory::BootMemoryRegion;
+	using Rocinante::Memory::BootMemoryMap;
+	using Rocinante::Memory::PhysicalMemoryManager;
+
+	static constexpr std::uintptr_t kUsableBase = 0x00100000;
+	static constexpr std::size_t kUsablePages = 64;
+	static constexpr std::size_t kUsableSizeBytes = kUsablePages * PhysicalMemoryManager::kPageSizeBytes;
+
+	static constexpr std::uintptr_t kKernelBase = 0x00400000;
+	static constexpr std::uintptr_t kKernelEnd = 0x00401000;
+	static constexpr std::uintptr_t kDeviceTreeBase = 0x00500000;
+	static constexpr std::size_t kDeviceTreeSizeBytes = PhysicalMemoryManager::kPageSizeBytes;
+
+	BootMemoryMap map;
+	map.Clear();
+	ROCINANTE_EXPECT_TRUE(ctx, map.AddRegion(BootMemoryRegion{.physical_base = kUsableBase, .size_bytes = kUsableSizeBytes, .type = BootMemoryRegion::Type::UsableRAM}));
+
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.InitializeFromBootMemoryMap(map, kKernelBase, kKernelEnd, kDeviceTreeBase, kDeviceTreeSizeBytes));
+
+	static constexpr std::size_t kOrder = 2;
+	const std::size_t free_before = pmm.FreePages();
+	const auto block_or = pmm.AllocatePages(kOrder);
+	ROCINANTE_EXPECT_TRUE(ctx, block_or.has_value());
+	if (!block_or.has_value()) return;
+	const std::uintptr_t block_base = block_or.value();
+	const std::uintptr_t second_page = block_base + PhysicalMemoryManager::kPageSizeBytes;
+
+	// Misaligned for the order.
+	ROCINANTE_EXPECT_TRUE(ctx, !pmm.FreePages(second_page, kOrder));
+	// Out-of-range order.
+	ROCINANTE_EXPECT_TRUE(ctx, !pmm.FreePages(block_base, PhysicalMemoryManager::kMaxBuddyOrder + 1));
+
+	// A still-mapped page blocks the whole release, with no partial effect.
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.IncrementMapCountForPhysical(second_page));
+	ROCINANTE_EXPECT_TRUE(ctx, !pmm.FreePages(block_base, kOrder));
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), free_before - (static_cast<std::size_t>(1) << kOrder));
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.DecrementMapCountForPhysical(second_page));
+
+	// A shared page survives the block release; the others return to the pool.
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.RetainPhysicalPage(second_page));
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.FreePages(block_base, kOrder));
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), free_before - 1);
+	const auto shared_ref = pmm.ReferenceCountForPhysical(second_page);
+	ROCINANTE_EXPECT_TRUE(ctx, shared_ref.has_value());
+	ROCINANTE_EXPECT_EQ_U64(ctx, shared_ref.value(), 1);
+
+	// Double free of an already-released block is rejected.
+	ROCINANTE_EXPECT_TRUE(ctx, !pmm.FreePages(block_base, kOrder));
+
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.FreePage(second_page));
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), free_before);
+}
+
+static void Test_PMM_Numa_PrefersCoreNodeAndFallsBack(TestContext* ctx) {
+	using Rocinante::Memory::BootMemoryRegion;
+	using Rocinante::Memory::BootMemoryMap;
+	using Rocinante::Memory::PhysicalMemoryManager;
+
+	// Two adjacent 64-page nodes. Together they form one 128-page,
+	// 128-page-aligned span, which would be a single order-7 block if the
+	// node boundary were ignored.
+	static constexpr std::size_t kNodePages = 64;
+	static constexpr std::size_t kNodeSizeBytes = kNodePages * PhysicalMemoryManager::kPageSizeBytes;
+	static constexpr std::uintptr_t kNode0Base = 0x00100000;
+	static constexpr std::uintptr_t kNode1Base = kNode0Base + kNodeSizeBytes;
+	static constexpr std::size_t kNodeOrder = 6;
+
+	static constexpr std::uintptr_t kKernelBase = 0x00400000;
+	static constexpr std::uintptr_t kKernelEnd = 0x00401000;
+	static constexpr std::uintptr_t kDeviceTreeBase = 0x00500000;
+	static constexpr std::size_t kDeviceTreeSizeBytes = PhysicalMemoryManager::kPageSizeBytes;
+
+	BootMemoryMap map;
+	map.Clear();
+	ROCINANTE_EXPECT_TRUE(ctx, map.AddRegion(BootMemoryRegion{.physical_base = kNode0Base, .size_bytes = kNodeSizeBytes, .type = BootMemoryRegion::Type::UsableRAM, .numa_node_id = 0}));
+	ROCINANTE_EXPECT_TRUE(ctx, map.AddRegion(BootMemoryRegion{.physical_base = kNode1Base, .size_bytes = kNodeSizeBytes, .type = BootMemoryRegion::Type::UsableRAM, .numa_node_id = 1}));
+	// Adjacent regions on different nodes must stay separate.
+	ROCINANTE_EXPECT_EQ_U64(ctx, map.region_count, 2);
+
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.InitializeFromBootMemoryMap(map, kKernelBase, kKernelEnd, kDeviceTreeBase, kDeviceTreeSizeBytes));
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.NumaNodeCount(), 2);
+
+	// Node 1 holds no PMM metadata, so it is one whole order-6 block; no block
+	// spans both nodes.
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePagesOnNode(1), kNodePages);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreeBlockCountForOrder(kNodeOrder + 1), 0);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePagesOnNode(0) + pmm.FreePagesOnNode(1), pmm.FreePages());
+
+	const auto node_of_node1_page = pmm.NumaNodeForPhysical(kNode1Base);
+	ROCINANTE_EXPECT_TRUE(ctx, node_of_node1_page.has_value());
+	ROCINANTE_EXPECT_EQ_U64(ctx, node_of_node1_page.value(), 1);
+
+	// AllocatePage() follows the calling core's node.
+	const std::size_t core_id = Rocinante::ReadCurrentProcessorCoreId();
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.SetNumaNodeForCore(core_id, 1));
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.CurrentNumaNode(), 1);
+	const auto local_or = pmm.AllocatePage();
+	ROCINANTE_EXPECT_TRUE(ctx, local_or.has_value());
+	if (!local_or.has_value()) return;
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.NumaNodeForPhysical(local_or.value()).value(), 1);
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.FreePage(local_or.value()));
+
+	// Exhaust node 1; the next request falls back to node 0.
+	const auto node1_block_or = pmm.AllocatePagesPreferringNode(kNodeOrder, 1);
+	ROCINANTE_EXPECT_TRUE(ctx, node1_block_or.has_value());
+	if (!node1_block_or.has_value()) return;
+	ROCINANTE_EXPECT_EQ_U64(ctx, node1_block_or.value(), kNode1Base);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePagesOnNode(1), 0);
+
+	const std::size_t node0_free_before = pmm.FreePagesOnNode(0);
+	const auto fallback_or = pmm.AllocatePage();
+	ROCINANTE_EXPECT_TRUE(ctx, fallback_or.has_value());
+	if (!fallback_or.has_value()) return;
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.NumaNodeForPhysical(fallback_or.value()).value(), 0);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePagesOnNode(0), node0_free_before - 1);
+
+	// Frees return to the owning node and coalesce only within it.
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.FreePage(fallback_or.value()));
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.FreePages(node1_block_or.value(), kNodeOrder));
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePagesOnNode(0), node0_free_before);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePagesOnNode(1), kNodePages);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreeBlockCountForOrder(kNodeOrder + 1), 0);
+
+	// Out-of-range overrides are rejected.
+	ROCINANTE_EXPECT_TRUE(ctx, !pmm.SetNumaNodeForCore(core_id, PhysicalMemoryManager::kMaxNumaNodes));
+	ROCINANTE_EXPECT_TRUE(ctx, !pmm.SetNumaNodeForCore(PhysicalMemoryManager::kMaxNumaCores, 0));
+}
+
+// Fills a page with a non-zero pattern (tests run with CRMD.DA=1, so the
+// physical address is directly dereferenceable).
+static void DirtyPhysicalPage(std::uintptr_t physical_page_base) {
+	auto* words = reinterpret_cast<volatile std::uint64_t*>(physical_page_base);
+	for (std::size_t i = 0; i < (Rocinante::Memory::PhysicalMemoryManager::kPageSizeBytes / sizeof(std::uint64_t)); i++) {
+		words[i] = 0xA5A5A5A5A5A5A5A5ull ^ i;
+	}
+}
+
+static bool PhysicalPageIsZero(std::uintptr_t physical_page_base) {
+	const auto* words = reinterpret_cast<const volatile std::uint64_t*>(physical_page_base);
+	for (std::size_t i = 0; i < (Rocinante::Memory::PhysicalMemoryManager::kPageSizeBytes / sizeof(std::uint64_t)); i++) {
+		if (words[i] != 0) return false;
+	}
+	return true;
+}
+
+static void Test_PMM_ZeroedPool_ServesZeroedFrames(TestContext* ctx) {
+	using Rocinante::Memory::BootMemoryRegion;
+	using Rocinante::Memory::BootMemoryMap;
+	using Rocinante::Memory::PhysicalMemoryManager;
+
+	// Real RAM: this test writes page contents.
+	static constexpr std::uintptr_t kUsableBase = 0x01000000; // 16 MiB
+	static constexpr std::size_t kUsableSizeBytes = 1u * 1024u * 1024u; // 1 MiB
+
+	const std::uintptr_t kernel_physical_base = reinterpret_cast<std::uintptr_t>(&_start);
+	const std::uintptr_t kernel_physical_end = reinterpret_cast<std::uintptr_t>(&_end);
+
+	BootMemoryMap map;
+	map.Clear();
+	ROCINANTE_EXPECT_TRUE(ctx, map.AddRegion(BootMemoryRegion{.physical_base = kUsableBase, .size_bytes = kUsableSizeBytes, .type = BootMemoryRegion::Type::UsableRAM}));
+
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.InitializeFromBootMemoryMap(map, kernel_physical_base, kernel_physical_end, 0, 0));
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.ZeroedPoolFrameCount(), 0);
+
+	// Miss: an empty pool still yields a zeroed page, even if the frame was
+	// dirty when it was freed.
+	const auto dirty_or = pmm.AllocatePage();
+	ROCINANTE_EXPECT_TRUE(ctx, dirty_or.has_value());
+	if (!dirty_or.has_value()) return;
+	DirtyPhysicalPage(dirty_or.value());
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.FreePage(dirty_or.value()));
+
+	const auto miss_or = pmm.AllocateZeroedPage();
+	ROCINANTE_EXPECT_TRUE(ctx, miss_or.has_value());
+	if (!miss_or.has_value()) return;
+	ROCINANTE_EXPECT_TRUE(ctx, PhysicalPageIsZero(miss_or.value()));
+	DirtyPhysicalPage(miss_or.value());
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.FreePage(miss_or.value()));
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.GetZeroedPoolStatistics().misses, 1);
+
+	// Refill moves frames from the free lists into the pool.
+	static constexpr std::size_t kRefillFrames = 8;
+	const std::size_t free_before = pmm.FreePages();
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.RefillZeroedPool(kRefillFrames), kRefillFrames);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.ZeroedPoolFrameCount(), kRefillFrames);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), free_before - kRefillFrames);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.GetZeroedPoolStatistics().frames_prezeroed, kRefillFrames);
+
+	// Hit: pooled frames come back zeroed and count as ordinary allocations.
+	const auto hit_or = pmm.AllocateZeroedPage();
+	ROCINANTE_EXPECT_TRUE(ctx, hit_or.has_value());
+	if (!hit_or.has_value()) return;
+	ROCINANTE_EXPECT_TRUE(ctx, PhysicalPageIsZero(hit_or.value()));
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.ZeroedPoolFrameCount(), kRefillFrames - 1);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.GetZeroedPoolStatistics().hits, 1);
+	const auto ref_count = pmm.ReferenceCountForPhysical(hit_or.value());
+	ROCINANTE_EXPECT_TRUE(ctx, ref_count.has_value());
+	ROCINANTE_EXPECT_EQ_U64(ctx, ref_count.value(), 1);
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.FreePage(hit_or.value()));
+
+	// The pool never grows past its capacity.
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.RefillZeroedPool(PhysicalMemoryManager::kZeroedPoolCapacityFrames * 2), PhysicalMemoryManager::kZeroedPoolCapacityFrames - (kRefillFrames - 1));
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.ZeroedPoolFrameCount(), PhysicalMemoryManager::kZeroedPoolCapacityFrames);
+
+	// Draining returns every pooled frame.
+	pmm.DrainZeroedPool();
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.ZeroedPoolFrameCount(), 0);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), free_before);
+}
+
+// Sparse map for the deferred-metadata tests: real scratch RAM in metadata
+// section 0, plus 1 MiB at 1 GiB (section 1). The high range is never
+// dereferenced, only tracked, so it need not exist in the QEMU machine.
+static constexpr std::uintptr_t kSparseLowUsableBase = 0x01000000; // 16 MiB
+static constexpr std::size_t kSparseLowUsableSizeBytes = 8u * 1024u * 1024u; // 8 MiB
+static constexpr std::uintptr_t kSparseHighUsableBase = 0x40000000; // 1 GiB
+static constexpr std::size_t kSparseHighUsableSizeBytes = 1u * 1024u * 1024u; // 1 MiB
+
+static bool BuildSparseMapForDeferredMetadata(TestContext* ctx, Rocinante::Memory::BootMemoryMap* map) {
+	using Rocinante::Memory::BootMemoryRegion;
+	map->Clear();
+	const bool low_ok = map->AddRegion(BootMemoryRegion{.physical_base = kSparseLowUsableBase, .size_bytes = kSparseLowUsableSizeBytes, .type = BootMemoryRegion::Type::UsableRAM});
+	const bool high_ok = map->AddRegion(BootMemoryRegion{.physical_base = kSparseHighUsableBase, .size_bytes = kSparseHighUsableSizeBytes, .type = BootMemoryRegion::Type::UsableRAM});
+	ROCINANTE_EXPECT_TRUE(ctx, low_ok);
+	ROCINANTE_EXPECT_TRUE(ctx, high_ok);
+	return low_ok && high_ok;
+}
+
+static void Test_PMM_DeferredMetadata_InitializesOnDemand(TestContext* ctx) {
+	using Rocinante::Memory::BootMemoryMap;
+	using Rocinante::Memory::PhysicalMemoryManager;
+
+	static constexpr std::size_t kHighPages = kSparseHighUsableSizeBytes / PhysicalMemoryManager::kPageSizeBytes;
+	// 1 MiB at 1 GiB is exactly one naturally-aligned order-8 block.
+	static constexpr std::size_t kHighBlockOrder = 8;
+
+	const std::uintptr_t kernel_physical_base = reinterpret_cast<std::uintptr_t>(&_start);
+	const std::uintptr_t kernel_physical_end = reinterpret_cast<std::uintptr_t>(&_end);
+
+	BootMemoryMap map;
+	if (!BuildSparseMapForDeferredMetadata(ctx, &map)) return;
+
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+	pmm.SetEagerFrameMetadataLimitBytes(0);
+
+	// 1) Explicit initialization (the idle-loop path).
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.InitializeFromBootMemoryMap(map, kernel_physical_base, kernel_physical_end, 0, 0));
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.GetInitializationStatistics().eager_sections, 1);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.DeferredFrameMetadataSectionCount(), 1);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.DeferredFreePages(), kHighPages);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreeBlockCountForOrder(kHighBlockOrder), 0);
+
+	// Deferred pages read as unallocated, on the node their region names.
+	const auto high_ref_count = pmm.ReferenceCountForPhysical(kSparseHighUsableBase);
+	ROCINANTE_EXPECT_TRUE(ctx, high_ref_count.has_value());
+	if (high_ref_count.has_value()) ROCINANTE_EXPECT_EQ_U64(ctx, high_ref_count.value(), 0);
+	const auto high_node = pmm.NumaNodeForPhysical(kSparseHighUsableBase);
+	ROCINANTE_EXPECT_TRUE(ctx, high_node.has_value());
+	if (high_node.has_value()) ROCINANTE_EXPECT_EQ_U64(ctx, high_node.value(), 0);
+	ROCINANTE_EXPECT_TRUE(ctx, !pmm.RetainPhysicalPage(kSparseHighUsableBase));
+
+	const std::size_t free_before = pmm.FreePages();
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.InitializeDeferredFrameMetadata(4), 1);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.InitializeDeferredFrameMetadata(4), 0);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.DeferredFrameMetadataSectionCount(), 0);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.DeferredFreePages(), 0);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), free_before);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreeBlockCountForOrder(kHighBlockOrder), 1);
+
+	// 2) First touch by allocation: once section 0 runs dry, the next
+	// allocation pulls in section 1 instead of failing.
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.InitializeFromBootMemoryMap(map, kernel_physical_base, kernel_physical_end, 0, 0));
+	const std::size_t low_free_pages = pmm.FreePages() - pmm.DeferredFreePages();
+	for (std::size_t i = 0; i < low_free_pages; i++) {
+		const auto page_or = pmm.AllocatePage();
+		ROCINANTE_EXPECT_TRUE(ctx, page_or.has_value());
+		if (!page_or.has_value()) break;
+		ROCINANTE_EXPECT_TRUE(ctx, page_or.value() < kSparseHighUsableBase);
+	}
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.DeferredFrameMetadataSectionCount(), 1);
+	const auto high_page = pmm.AllocatePage();
+	ROCINANTE_EXPECT_TRUE(ctx, high_page.has_value());
+	if (high_page.has_value()) ROCINANTE_EXPECT_TRUE(ctx, high_page.value() >= kSparseHighUsableBase);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.DeferredFrameMetadataSectionCount(), 0);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), kHighPages - 1);
+
+	// 3) First touch by ReserveRange().
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.InitializeFromBootMemoryMap(map, kernel_physical_base, kernel_physical_end, 0, 0));
+	const std::size_t free_before_reserve = pmm.FreePages();
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.ReserveRange(kSparseHighUsableBase, PhysicalMemoryManager::kPageSizeBytes));
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.DeferredFrameMetadataSectionCount(), 0);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), free_before_reserve - 1);
+
+	pmm.SetEagerFrameMetadataLimitBytes(PhysicalMemoryManager::kDefaultEagerFrameMetadataLimitBytes);
+}
+
+static void Test_PMM_Benchmark_InitializationPhases(TestContext* ctx) {
+	using Rocinante::Memory::BootMemoryMap;
+	using Rocinante::Memory::PhysicalMemoryManager;
+
+	// Benchmark (reported, not asserted):
+	// InitializeFromBootMemoryMap() phase timing over a ~1 GiB tracked span,
+	// with every section eager and then with section 1 deferred.
+	const std::uintptr_t kernel_physical_base = reinterpret_cast<std::uintptr_t>(&_start);
+	const std::uintptr_t kernel_physical_end = reinterpret_cast<std::uintptr_t>(&_end);
+
+	BootMemoryMap map;
+	if (!BuildSparseMapForDeferredMetadata(ctx, &map)) return;
+
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.InitializeFromBootMemoryMap(map, kernel_physical_base, kernel_physical_end, 0, 0));
+	auto stats = pmm.GetInitializationStatistics();
+	Rocinante::Testing::NoteU64(ctx, __FILE__, __LINE__, "pmm_init_placement_ticks", stats.storage_placement_ticks);
+	Rocinante::Testing::NoteU64(ctx, __FILE__, __LINE__, "pmm_init_marking_ticks", stats.range_marking_ticks);
+	Rocinante::Testing::NoteU64(ctx, __FILE__, __LINE__, "pmm_init_metadata_ticks_all_eager", stats.eager_metadata_ticks);
+
+	pmm.SetEagerFrameMetadataLimitBytes(0);
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.InitializeFromBootMemoryMap(map, kernel_physical_base, kernel_physical_end, 0, 0));
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.InitializeDeferredFrameMetadata(1), 1);
+	stats = pmm.GetInitializationStatistics();
+	Rocinante::Testing::NoteU64(ctx, __FILE__, __LINE__, "pmm_init_metadata_ticks_deferred", stats.eager_metadata_ticks);
+	Rocinante::Testing::NoteU64(ctx, __FILE__, __LINE__, "pmm_deferred_section_ticks", stats.deferred_metadata_ticks);
+	pmm.SetEagerFrameMetadataLimitBytes(PhysicalMemoryManager::kDefaultEagerFrameMetadataLimitBytes);
+}
+
+static void Test_PMM_Benchmark_ZeroedPageLatency(TestContext* ctx) {
+	using Rocinante::Memory::BootMemoryRegion;
+	using Rocinante::Memory::BootMemoryMap;
+	using Rocinante::Memory::PhysicalMemoryManager;
+
+	// Benchmark (reported, not asserted):
+	// Average AllocateZeroedPage() cost when the pool is empty (synchronous
+	// 4 KiB clear) versus when it was refilled ahead of time.
+	static constexpr std::uintptr_t kUsableBase = 0x01000000; // 16 MiB
+	static constexpr std::size_t kUsableSizeBytes = 8u * 1024u * 1024u; // 8 MiB
+	static constexpr std::size_t kIterations = PhysicalMemoryManager::kZeroedPoolCapacityFrames;
+
+	const std::uintptr_t kernel_physical_base = reinterpret_cast<std::uintptr_t>(&_start);
+	const std::uintptr_t kernel_physical_end = reinterpret_cast<std::uintptr_t>(&_end);
+
+	BootMemoryMap map;
+	map.Clear();
+	ROCINANTE_EXPECT_TRUE(ctx, map.AddRegion(BootMemoryRegion{.physical_base = kUsableBase, .size_bytes = kUsableSizeBytes, .type = BootMemoryRegion::Type::UsableRAM}));
+
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.InitializeFromBootMemoryMap(map, kernel_physical_base, kernel_physical_end, 0, 0));
+
+	std::uint64_t start_ticks = Rocinante::ReadStableCounterTicks();
+	for (std::size_t i = 0; i < kIterations; i++) {
+		ROCINANTE_EXPECT_TRUE(ctx, pmm.AllocateZeroedPage().has_value());
+	}
+	const std::uint64_t miss_ticks = Rocinante::ReadStableCounterTicks() - start_ticks;
+
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.RefillZeroedPool(kIterations), kIterations);
+	start_ticks = Rocinante::ReadStableCounterTicks();
+	for (std::size_t i = 0; i < kIterations; i++) {
+		ROCINANTE_EXPECT_TRUE(ctx, pmm.AllocateZeroedPage().has_value());
+	}
+	const std::uint64_t hit_ticks = Rocinante::ReadStableCounterTicks() - start_ticks;
+
+	Rocinante::Testing::NoteU64(ctx, __FILE__, __LINE__, "zeroed_page_avg_ticks_pool_empty", miss_ticks / kIterations);
+	Rocinante::Testing::NoteU64(ctx, __FILE__, __LINE__, "zeroed_page_avg_ticks_pool_hit", hit_ticks / kIterations);
+}
+
+static void Test_PMM_Benchmark_FrameMetadataFootprintAndRefCountThroughput(TestContext* ctx) {
+	using Rocinante::Memory::BootMemoryRegion;
+	using Rocinante::Memory::BootMemoryMap;
+	using Rocinante::Memory::PhysicalMemoryManager;
+
+	// Benchmark (reported, not asserted):
+	// Frame-metadata footprint for the scratch region, and the average cost of
+	// a Retain/Increment/Decrement/Release round on pages spread across it.
+	// Build with ROCINANTE_PMM_COMPACT_METADATA=1 to compare layouts.
+	static constexpr std::uintptr_t kUsableBase = 0x01000000; // 16 MiB
+	static constexpr std::size_t kUsableSizeBytes = 8u * 1024u * 1024u; // 8 MiB
+	static constexpr std::size_t kPagesTouched = 512;
+	static constexpr std::size_t kRounds = 8;
+
+	const std::uintptr_t kernel_physical_base = reinterpret_cast<std::uintptr_t>(&_start);
+	const std::uintptr_t kernel_physical_end = reinterpret_cast<std::uintptr_t>(&_end);
+
+	BootMemoryMap map;
+	map.Clear();
+	ROCINANTE_EXPECT_TRUE(ctx, map.AddRegion(BootMemoryRegion{.physical_base = kUsableBase, .size_bytes = kUsableSizeBytes, .type = BootMemoryRegion::Type::UsableRAM}));
+
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.InitializeFromBootMemoryMap(map, kernel_physical_base, kernel_physical_end, 0, 0));
+
+	const std::size_t tracked_pages = kUsableSizeBytes / PhysicalMemoryManager::kPageSizeBytes;
+	Rocinante::Testing::NoteU64(ctx, __FILE__, __LINE__, "frame_metadata_bytes_per_page", PhysicalMemoryManager::kPageFrameMetadataSizeBytes);
+	Rocinante::Testing::NoteU64(ctx, __FILE__, __LINE__, "frame_metadata_pages_for_8mib", FrameMetadataReservedPagesForTrackedPages(tracked_pages));
+
+	// Take pages from across the region so the counters do not all share a
+	// cache line.
+	static std::uintptr_t pages[kPagesTouched];
+	for (std::size_t i = 0; i < kPagesTouched; i++) {
+		const auto page_or = pmm.AllocatePage();
+		ROCINANTE_EXPECT_TRUE(ctx, page_or.has_value());
+		if (!page_or.has_value()) return;
+		pages[i] = page_or.value();
+	}
+
+	const std::uint64_t start_ticks = Rocinante::ReadStableCounterTicks();
+	for (std::size_t round = 0; round < kRounds; round++) {
+		for (std::size_t i = 0; i < kPagesTouched; i++) {
+			(void)pmm.RetainPhysicalPage(pages[i]);
+			(void)pmm.IncrementMapCountForPhysical(pages[i]);
+		}
+		for (std::size_t i = 0; i < kPagesTouched; i++) {
+			(void)pmm.DecrementMapCountForPhysical(pages[i]);
+			(void)pmm.ReleasePhysicalPage(pages[i]);
+		}
+	}
+	const std::uint64_t elapsed_ticks = Rocinante::ReadStableCounterTicks() - start_ticks;
+
+	for (std::size_t i = 0; i < kPagesTouched; i++) {
+		const auto ref_count = pmm.ReferenceCountForPhysical(pages[i]);
+		ROCINANTE_EXPECT_TRUE(ctx, ref_count.has_value());
+		if (ref_count.has_value()) ROCINANTE_EXPECT_EQ_U64(ctx, ref_count.value(), 1);
+		ROCINANTE_EXPECT_TRUE(ctx, pmm.FreePage(pages[i]));
+	}
+
+	// Four counter updates per page per round.
+	Rocinante::Testing::NoteU64(ctx, __FILE__, __LINE__, "refcount_update_avg_ticks_x1000", (elapsed_ticks * 1000) / (kRounds * kPagesTouched * 4));
+}
+
+// Label for the i-th occupancy level. A switch rather than a table of string
+// pointers: pointer tables put absolute addresses in .rodata (see the
+// audit-abs-ptrs make target).
+static const char* OccupancyBenchmarkLabel(std::size_t occupancy_index) {
+	switch (occupancy_index) {
+		case 0: return "alloc_free_avg_ticks_at_10pct";
+		case 1: return "alloc_free_avg_ticks_at_50pct";
+		default: return "alloc_free_avg_ticks_at_99pct";
+	}
+}
+
+static void Test_PMM_Benchmark_AllocationLatencyByOccupancy(TestContext* ctx) {
+	using Rocinante::Memory::BootMemoryRegion;
+	using Rocinante::Memory::BootMemoryMap;
+	using Rocinante::Memory::PhysicalMemoryManager;
+
+	// Benchmark (reported, not asserted):
+	// Average AllocatePage()+FreePage() cost at increasing occupancy. Before the
+	// buddy allocator and summary bitmap this grew with the number of used pages
+	// in front of the search cursor; now it should stay roughly flat.
+	//
+	// Use the same scratch region as the KernelMappings tests (real RAM that the
+	// kernel image does not occupy).
+	static constexpr std::uintptr_t kUsableBase = 0x01000000; // 16 MiB
+	static constexpr std::size_t kUsableSizeBytes = 8u * 1024u * 1024u; // 8 MiB
+
+	const std::uintptr_t kernel_physical_base = reinterpret_cast<std::uintptr_t>(&_start);
+	const std::uintptr_t kernel_physical_end = reinterpret_cast<std::uintptr_t>(&_end);
+
+	BootMemoryMap map;
+	map.Clear();
+	ROCINANTE_EXPECT_TRUE(ctx, map.AddRegion(BootMemoryRegion{.physical_base = kUsableBase, .size_bytes = kUsableSizeBytes, .type = BootMemoryRegion::Type::UsableRAM}));
+
+	static constexpr std::size_t kOccupancyPercents[] = {10, 50, 99};
+	static constexpr std::size_t kIterations = 256;
+
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+	for (std::size_t i = 0; i < (sizeof(kOccupancyPercents) / sizeof(kOccupancyPercents[0])); i++) {
+		ROCINANTE_EXPECT_TRUE(ctx, pmm.InitializeFromBootMemoryMap(map, kernel_physical_base, kernel_physical_end, 0, 0));
+
+		// Fill to the target occupancy. The pages are not freed: the next
+		// iteration re-initializes the PMM.
+		const std::size_t free_at_start = pmm.FreePages();
+		const std::size_t pages_to_occupy = (free_at_start * kOccupancyPercents[i]) / 100;
+		for (std::size_t p = 0; p < pages_to_occupy; p++) {
+			ROCINANTE_EXPECT_TRUE(ctx, pmm.AllocatePage().has_value());
+		}
+		ROCINANTE_EXPECT_TRUE(ctx, pmm.FreePages() != 0);
+
+		const std::uint64_t start_ticks = Rocinante::ReadStableCounterTicks();
+		for (std::size_t iteration = 0; iteration < kIterations; iteration++) {
+			const auto page_or = pmm.AllocatePage();
+			if (!page_or.has_value()) {
+				ROCINANTE_EXPECT_TRUE(ctx, page_or.has_value());
+				break;
+			}
+			(void)pmm.FreePage(page_or.value());
+		}
+		const std::uint64_t elapsed_ticks = Rocinante::ReadStableCounterTicks() - start_ticks;
+
+		Rocinante::Testing::NoteU64(ctx, __FILE__, __LINE__, OccupancyBenchmarkLabel(i), elapsed_ticks / kIterations);
+	}
+}
+
 } // namespace
 
 void TestEntry_PMM_RespectsReservedKernelAndDTB(TestContext* ctx) {
@@ -449,4 +1072,44 @@ void TestEntry_PMM_ReferenceCount_RetainRelease(TestContext* ctx) {
 	Test_PMM_ReferenceCount_RetainRelease(ctx);
 }
 
+void TestEntry_PMM_Buddy_AllocatePagesReturnsAlignedContiguousBlock(TestContext* ctx) {
+	Test_PMM_Buddy_AllocatePagesReturnsAlignedContiguousBlock(ctx);
+}
+
+void TestEntry_PMM_Buddy_FreeCoalescesIntoLargerBlocks(TestContext* ctx) {
+	Test_PMM_Buddy_FreeCoalescesIntoLargerBlocks(ctx);
+}
+
+void TestEntry_PMM_Buddy_FreePagesRejectsInvalidBlocks(TestContext* ctx) {
+	Test_PMM_Buddy_FreePagesRejectsInvalidBlocks(ctx);
+}
+
+void TestEntry_PMM_Numa_PrefersCoreNodeAndFallsBack(TestContext* ctx) {
+	Test_PMM_Numa_PrefersCoreNodeAndFallsBack(ctx);
+}
+
+void TestEntry_PMM_ZeroedPool_ServesZeroedFrames(TestContext* ctx) {
+	Test_PMM_ZeroedPool_ServesZeroedFrames(ctx);
+}
+
+void TestEntry_PMM_DeferredMetadata_InitializesOnDemand(TestContext* ctx) {
+	Test_PMM_DeferredMetadata_InitializesOnDemand(ctx);
+}
+
+void TestEntry_PMM_Benchmark_InitializationPhases(TestContext* ctx) {
+	Test_PMM_Benchmark_InitializationPhases(ctx);
+}
+
+void TestEntry_PMM_Benchmark_ZeroedPageLatency(TestContext* ctx) {
+	Test_PMM_Benchmark_ZeroedPageLatency(ctx);
+}
+
+void TestEntry_PMM_Benchmark_FrameMetadataFootprintAndRefCountThroughput(TestContext* ctx) {
+	Test_PMM_Benchmark_FrameMetadataFootprintAndRefCountThroughput(ctx);
+}
+
+void TestEntry_PMM_Benchmark_AllocationLatencyByOccupancy(TestContext* ctx) {
+	Test_PMM_Benchmark_AllocationLatencyByOccupancy(ctx);
+}
+
 } // namespace Rocinante::Testing
@@ -0,0 +1,185 @@
+/**
+ * Copyright (C) 2026 Andrew S. Rightenburg
+ * GPL-3.0-or-later
+ */
+
+#include <src/testing/scratch_pmm.h>
+#include <src/testing/test.h>
+
+#include <src/sp/cpuid.h>
+
+#include <src/memory/page_frame_cache.h>
+#include <src/memory/pmm.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Rocinante::Testing {
+
+namespace {
+
+// A test-private cache instance.
+//
+// The kernel singleton (GetPageFrameCache()) must stay unbound during the test
+// run: other tests re-initialize the global PMM, and a bound singleton would
+// keep handing out frames from a stale PMM state.
+static Rocinante::Memory::PageFrameCache g_test_frame_cache;
+
+static bool InitializePmmForFrameCacheTest(TestContext* ctx) {
+	if (!InitializeScratchPmm(ctx, 8u * 1024u * 1024u)) return false;
+
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+	g_test_frame_cache.Initialize(&pmm);
+	return true;
+}
+
+static void Test_PageFrameCache_RefillsAndServesHitsFromMagazine(TestContext* ctx) {
+	using Rocinante::Memory::PageFrameCache;
+
+	if (!InitializePmmForFrameCacheTest(ctx)) return;
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+	const std::size_t core_id = Rocinante::ReadCurrentProcessorCoreId();
+
+	static constexpr std::size_t kBatchFrames = 8;
+	ROCINANTE_EXPECT_TRUE(ctx, g_test_frame_cache.SetTuning(PageFrameCache::Tuning{.refill_batch_frames = kBatchFrames, .drain_batch_frames = kBatchFrames}));
+	ROCINANTE_EXPECT_TRUE(ctx, !g_test_frame_cache.SetTuning(PageFrameCache::Tuning{.refill_batch_frames = 0, .drain_batch_frames = kBatchFrames}));
+	ROCINANTE_EXPECT_TRUE(ctx, !g_test_frame_cache.SetTuning(PageFrameCache::Tuning{.refill_batch_frames = kBatchFrames, .drain_batch_frames = PageFrameCache::kMagazineCapacityFrames + 1}));
+	ROCINANTE_EXPECT_EQ_U64(ctx, g_test_frame_cache.GetTuning().refill_batch_frames, kBatchFrames);
+
+	const std::size_t pmm_free_before = pmm.FreePages();
+
+	// The first allocation misses and refills one batch; the rest of the batch
+	// is served without touching the PMM.
+	std::uintptr_t frames[kBatchFrames] = {};
+	for (std::size_t i = 0; i < kBatchFrames; i++) {
+		const auto frame_or = g_test_frame_cache.AllocatePage();
+		ROCINANTE_EXPECT_TRUE(ctx, frame_or.has_value());
+		if (!frame_or.has_value()) return;
+		frames[i] = frame_or.value();
+
+		const auto ref = pmm.ReferenceCountForPhysical(frames[i]);
+		ROCINANTE_EXPECT_TRUE(ctx, ref.has_value());
+		ROCINANTE_EXPECT_EQ_U64(ctx, ref.value(), 1);
+	}
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), pmm_free_before - kBatchFrames);
+
+	auto stats = g_test_frame_cache.StatisticsForCpu(core_id);
+	ROCINANTE_EXPECT_EQ_U64(ctx, stats.allocation_misses, 1);
+	ROCINANTE_EXPECT_EQ_U64(ctx, stats.allocation_hits, kBatchFrames - 1);
+	ROCINANTE_EXPECT_EQ_U64(ctx, stats.refill_batches, 1);
+	ROCINANTE_EXPECT_EQ_U64(ctx, g_test_frame_cache.CachedFrameCount(), 0);
+
+	// Frees are absorbed by the magazine, not returned to the PMM.
+	for (std::size_t i = 0; i < kBatchFrames; i++) {
+		ROCINANTE_EXPECT_TRUE(ctx, g_test_frame_cache.FreePage(frames[i]));
+	}
+	stats = g_test_frame_cache.StatisticsForCpu(core_id);
+	ROCINANTE_EXPECT_EQ_U64(ctx, stats.free_hits, kBatchFrames);
+	ROCINANTE_EXPECT_EQ_U64(ctx, g_test_frame_cache.CachedFrameCountForCpu(core_id), kBatchFrames);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), pmm_free_before - kBatchFrames);
+
+	// LIFO: the most recently freed frame comes back first, without a refill.
+	const auto reused_or = g_test_frame_cache.AllocatePage();
+	ROCINANTE_EXPECT_TRUE(ctx, reused_or.has_value());
+	if (reused_or.has_value()) {
+		ROCINANTE_EXPECT_EQ_U64(ctx, reused_or.value(), frames[kBatchFrames - 1]);
+		ROCINANTE_EXPECT_TRUE(ctx, g_test_frame_cache.FreePage(reused_or.value()));
+	}
+	ROCINANTE_EXPECT_EQ_U64(ctx, g_test_frame_cache.StatisticsForCpu(core_id).refill_batches, 1);
+
+	g_test_frame_cache.DrainCurrentCpu();
+	ROCINANTE_EXPECT_EQ_U64(ctx, g_test_frame_cache.CachedFrameCount(), 0);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), pmm_free_before);
+}
+
+static void Test_PageFrameCache_DrainsBatchWhenFull(TestContext* ctx) {
+	using Rocinante::Memory::PageFrameCache;
+
+	if (!InitializePmmForFrameCacheTest(ctx)) return;
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+	const std::size_t core_id = Rocinante::ReadCurrentProcessorCoreId();
+
+	static constexpr std::size_t kDrainBatchFrames = 4;
+	ROCINANTE_EXPECT_TRUE(ctx, g_test_frame_cache.SetTuning(PageFrameCache::Tuning{.refill_batch_frames = 1, .drain_batch_frames = kDrainBatchFrames}));
+
+	// Allocate capacity+1 frames straight from the PMM, then free them through
+	// the cache: the last free finds the magazine full and drains one batch.
+	static constexpr std::size_t kFrameCount = PageFrameCache::kMagazineCapacityFrames + 1;
+	std::uintptr_t frames[kFrameCount] = {};
+	for (std::size_t i = 0; i < kFrameCount; i++) {
+		const auto frame_or = pmm.AllocatePage();
+		ROCINANTE_EXPECT_TRUE(ctx, frame_or.has_value());
+		if (!frame_or.has_value()) return;
+		frames[i] = frame_or.value();
+	}
+	const std::size_t pmm_free_after_allocation = pmm.FreePages();
+
+	for (std::size_t i = 0; i < kFrameCount; i++) {
+		ROCINANTE_EXPECT_TRUE(ctx, g_test_frame_cache.FreePage(frames[i]));
+	}
+
+	const auto stats = g_test_frame_cache.StatisticsForCpu(core_id);
+	ROCINANTE_EXPECT_EQ_U64(ctx, stats.drain_batches, 1);
+	ROCINANTE_EXPECT_EQ_U64(ctx, stats.free_hits, kFrameCount);
+	ROCINANTE_EXPECT_EQ_U64(ctx, g_test_frame_cache.CachedFrameCountForCpu(core_id), kFrameCount - kDrainBatchFrames);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), pmm_free_after_allocation + kDrainBatchFrames);
+
+	// The drained frames are the oldest ones (bottom of the stack).
+	for (std::size_t i = 0; i < kDrainBatchFrames; i++) {
+		const auto ref = pmm.ReferenceCountForPhysical(frames[i]);
+		ROCINANTE_EXPECT_TRUE(ctx, ref.has_value());
+		ROCINANTE_EXPECT_EQ_U64(ctx, ref.value(), 0);
+	}
+
+	g_test_frame_cache.DrainAll();
+	ROCINANTE_EXPECT_EQ_U64(ctx, g_test_frame_cache.CachedFrameCount(), 0);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), pmm_free_after_allocation + kFrameCount);
+}
+
+static void Test_PageFrameCache_SharedOrMappedFramesBypassMagazine(TestContext* ctx) {
+	if (!InitializePmmForFrameCacheTest(ctx)) return;
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+	const std::size_t core_id = Rocinante::ReadCurrentProcessorCoreId();
+
+	const auto frame_or = g_test_frame_cache.AllocatePage();
+	ROCINANTE_EXPECT_TRUE(ctx, frame_or.has_value());
+	if (!frame_or.has_value()) return;
+	const std::uintptr_t frame = frame_or.value();
+	const std::size_t cached_before = g_test_frame_cache.CachedFrameCount();
+
+	// A shared frame is only dereferenced, never cached.
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.RetainPhysicalPage(frame));
+	ROCINANTE_EXPECT_TRUE(ctx, g_test_frame_cache.FreePage(frame));
+	ROCINANTE_EXPECT_EQ_U64(ctx, g_test_frame_cache.CachedFrameCount(), cached_before);
+	const auto ref = pmm.ReferenceCountForPhysical(frame);
+	ROCINANTE_EXPECT_TRUE(ctx, ref.has_value());
+	ROCINANTE_EXPECT_EQ_U64(ctx, ref.value(), 1);
+
+	// A mapped frame is rejected by the PMM policy and not cached either.
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.IncrementMapCountForPhysical(frame));
+	ROCINANTE_EXPECT_TRUE(ctx, !g_test_frame_cache.FreePage(frame));
+	ROCINANTE_EXPECT_EQ_U64(ctx, g_test_frame_cache.CachedFrameCount(), cached_before);
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.DecrementMapCountForPhysical(frame));
+
+	ROCINANTE_EXPECT_EQ_U64(ctx, g_test_frame_cache.StatisticsForCpu(core_id).free_bypasses, 2);
+
+	ROCINANTE_EXPECT_TRUE(ctx, g_test_frame_cache.FreePage(frame));
+	ROCINANTE_EXPECT_EQ_U64(ctx, g_test_frame_cache.CachedFrameCount(), cached_before + 1);
+	g_test_frame_cache.DrainAll();
+}
+
+} // namespace
+
+void TestEntry_PageFrameCache_RefillsAndServesHitsFromMagazine(TestContext* ctx) {
+	Test_PageFrameCache_RefillsAndServesHitsFromMagazine(ctx);
+}
+
+void TestEntry_PageFrameCache_DrainsBatchWhenFull(TestContext* ctx) {
+	Test_PageFrameCache_DrainsBatchWhenFull(ctx);
+}
+
+void TestEntry_PageFrameCache_SharedOrMappedFramesBypassMagazine(TestContext* ctx) {
+	Test_PageFrameCache_SharedOrMappedFramesBypassMagazine(ctx);
+}
+
+} // namespace Rocinante::Testing
@@ -0,0 +1,366 @@
+/**
+ * Copyright (C) 2026 Andrew S. Rightenburg
+ * GPL-3.0-or-later
+ */
+
+#include <src/testing/scratch_pmm.h>
+#include <src/testing/test.h>
+
+#include <src/sp/cpuid.h>
+#include <src/sp/stable_counter.h>
+
+#include <src/memory/page_table_pool.h>
+#include <src/memory/paging.h>
+#include <src/memory/pmm.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Rocinante::Testing {
+
+namespace {
+
+// A test-private pool for the pool-only tests. The tests that go through
+// Paging have to bind the kernel pool (Paging always uses that one) and
+// unbind it again before returning, so later tests that re-initialize the
+// global PMM never see pages from a stale PMM state.
+static Rocinante::Memory::PageTablePagePool g_test_pool;
+
+static constexpr std::size_t kUsableSizeBytes = 4u * 1024u * 1024u;
+
+static bool PageIsZero(std::uintptr_t physical_page_base) {
+	// The tests run before paging: physical addresses are directly usable.
+	const auto* words = reinterpret_cast<const std::uint64_t*>(physical_page_base);
+	for (std::size_t i = 0; i < Rocinante::Memory::Paging::kPageSizeBytes / sizeof(std::uint64_t); i++) {
+		if (words[i] != 0) return false;
+	}
+	return true;
+}
+
+static void Test_PageTablePool_ReserveTracksWatermarks(TestContext* ctx) {
+	using Rocinante::Memory::PageTablePagePool;
+
+	if (!InitializeScratchPmm(ctx, kUsableSizeBytes)) return;
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+	const std::size_t core_id = Rocinante::ReadCurrentProcessorCoreId();
+	g_test_pool.Initialize(&pmm);
+
+	ROCINANTE_EXPECT_TRUE(ctx, !g_test_pool.SetWatermarks(PageTablePagePool::Watermarks{.low_pages = 4, .high_pages = 2}));
+	ROCINANTE_EXPECT_TRUE(ctx, !g_test_pool.SetWatermarks(PageTablePagePool::Watermarks{.low_pages = 0, .high_pages = 0}));
+	ROCINANTE_EXPECT_TRUE(ctx, !g_test_pool.SetWatermarks(PageTablePagePool::Watermarks{.low_pages = 1, .high_pages = PageTablePagePool::kReserveCapacityPages + 1}));
+	ROCINANTE_EXPECT_TRUE(ctx, g_test_pool.SetWatermarks(PageTablePagePool::Watermarks{.low_pages = 2, .high_pages = 6}));
+	ROCINANTE_EXPECT_EQ_U64(ctx, g_test_pool.GetWatermarks().high_pages, 6);
+
+	const std::size_t pmm_free_before = pmm.FreePages();
+
+	// An empty reserve is below the low watermark: it fills to the high one.
+	ROCINANTE_EXPECT_TRUE(ctx, g_test_pool.Reserve(1));
+	ROCINANTE_EXPECT_EQ_U64(ctx, g_test_pool.ReservedPageCountForCpu(core_id), 6);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm_free_before - pmm.FreePages(), 6);
+
+	std::uintptr_t pages[5] = {};
+	for (std::size_t i = 0; i < 4; i++) {
+		const auto page_or = g_test_pool.AllocatePage();
+		ROCINANTE_EXPECT_TRUE(ctx, page_or.has_value());
+		if (!page_or.has_value()) return;
+		pages[i] = page_or.value();
+		ROCINANTE_EXPECT_TRUE(ctx, PageIsZero(pages[i]));
+	}
+
+	// At the low watermark and holding enough: nothing to do.
+	ROCINANTE_EXPECT_TRUE(ctx, g_test_pool.Reserve(2));
+	ROCINANTE_EXPECT_EQ_U64(ctx, g_test_pool.ReservedPageCountForCpu(core_id), 2);
+
+	// Below the low watermark: back up to the high one in one batch.
+	const auto page_or = g_test_pool.AllocatePage();
+	ROCINANTE_EXPECT_TRUE(ctx, page_or.has_value());
+	if (!page_or.has_value()) return;
+	pages[4] = page_or.value();
+	ROCINANTE_EXPECT_TRUE(ctx, g_test_pool.Reserve(1));
+	ROCINANTE_EXPECT_EQ_U64(ctx, g_test_pool.ReservedPageCountForCpu(core_id), 6);
+
+	// A request above the high watermark fills to the request instead.
+	ROCINANTE_EXPECT_TRUE(ctx, g_test_pool.Reserve(8));
+	ROCINANTE_EXPECT_EQ_U64(ctx, g_test_pool.ReservedPageCountForCpu(core_id), 8);
+	ROCINANTE_EXPECT_TRUE(ctx, !g_test_pool.Reserve(PageTablePagePool::kReserveCapacityPages + 1));
+
+	const auto statistics = g_test_pool.StatisticsForCpu(core_id);
+	ROCINANTE_EXPECT_EQ_U64(ctx, statistics.allocation_hits, 5);
+	ROCINANTE_EXPECT_EQ_U64(ctx, statistics.allocation_misses, 0);
+	ROCINANTE_EXPECT_EQ_U64(ctx, statistics.refill_batches, 3);
+
+	for (std::size_t i = 0; i < 5; i++) {
+		ROCINANTE_EXPECT_TRUE(ctx, pmm.FreePage(pages[i]));
+	}
+	g_test_pool.DrainAll();
+	ROCINANTE_EXPECT_EQ_U64(ctx, g_test_pool.ReservedPageCount(), 0);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), pmm_free_before);
+}
+
+static void Test_PageTablePool_DeferredPagesWaitForReclaim(TestContext* ctx) {
+	using Rocinante::Memory::PageTablePagePool;
+
+	if (!InitializeScratchPmm(ctx, kUsableSizeBytes)) return;
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+	const std::size_t core_id = Rocinante::ReadCurrentProcessorCoreId();
+	g_test_pool.Initialize(&pmm);
+	ROCINANTE_EXPECT_TRUE(ctx, g_test_pool.SetWatermarks(PageTablePagePool::Watermarks{.low_pages = 1, .high_pages = 4}));
+
+	const std::size_t pmm_free_before = pmm.FreePages();
+
+	static constexpr std::size_t kPageCount = 6;
+	std::uintptr_t pages[kPageCount] = {};
+	for (std::size_t i = 0; i < kPageCount; i++) {
+		const auto page_or = g_test_pool.AllocatePage();
+		ROCINANTE_EXPECT_TRUE(ctx, page_or.has_value());
+		if (!page_or.has_value()) return;
+		pages[i] = page_or.value();
+	}
+	const std::size_t reserved_after_allocation = g_test_pool.ReservedPageCountForCpu(core_id);
+
+	{
+		// Released tables are neither reusable nor back in the PMM yet.
+		PageTablePagePool::DeferredBatch first_batch(g_test_pool);
+		for (std::size_t i = 0; i < 4; i++) {
+			ROCINANTE_EXPECT_TRUE(ctx, g_test_pool.DeferFreePage(pages[i]));
+		}
+		{
+			PageTablePagePool::DeferredBatch second_batch(g_test_pool);
+			for (std::size_t i = 4; i < kPageCount; i++) {
+				ROCINANTE_EXPECT_TRUE(ctx, g_test_pool.DeferFreePage(pages[i]));
+			}
+			ROCINANTE_EXPECT_EQ_U64(ctx, g_test_pool.DeferredPageCount(), kPageCount);
+			ROCINANTE_EXPECT_EQ_U64(ctx, g_test_pool.ReservedPageCountForCpu(core_id), reserved_after_allocation);
+			ROCINANTE_EXPECT_EQ_U64(ctx, pmm_free_before - pmm.FreePages(), kPageCount + reserved_after_allocation);
+
+			// A batch recycles only the pages it released.
+			ROCINANTE_EXPECT_EQ_U64(ctx, second_batch.Reclaim(), kPageCount - 4);
+			ROCINANTE_EXPECT_EQ_U64(ctx, second_batch.Reclaim(), 0);
+			ROCINANTE_EXPECT_EQ_U64(ctx, g_test_pool.DeferredPageCount(), 4);
+		}
+
+		// The outer batch is open again once the inner one closes. The reserve
+		// fills to the high watermark, the rest goes back.
+		ROCINANTE_EXPECT_EQ_U64(ctx, first_batch.Reclaim(), 4);
+		ROCINANTE_EXPECT_EQ_U64(ctx, g_test_pool.DeferredPageCount(), 0);
+		ROCINANTE_EXPECT_EQ_U64(ctx, g_test_pool.ReservedPageCountForCpu(core_id), 4);
+		ROCINANTE_EXPECT_EQ_U64(ctx, pmm_free_before - pmm.FreePages(), 4);
+	}
+
+	const auto statistics = g_test_pool.StatisticsForCpu(core_id);
+	ROCINANTE_EXPECT_EQ_U64(ctx, statistics.deferred_pages, kPageCount);
+	ROCINANTE_EXPECT_EQ_U64(ctx, statistics.deferred_overflows, 0);
+	ROCINANTE_EXPECT_EQ_U64(ctx, statistics.reclaim_batches, 2);
+
+	g_test_pool.DrainAll();
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), pmm_free_before);
+}
+
+static void Test_PageTablePool_FullDeferredListFlushesAndRecycles(TestContext* ctx) {
+	using Rocinante::Memory::PageTablePagePool;
+
+	if (!InitializeScratchPmm(ctx, kUsableSizeBytes)) return;
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+	const std::size_t core_id = Rocinante::ReadCurrentProcessorCoreId();
+	g_test_pool.Initialize(&pmm);
+
+	const std::size_t pmm_free_before = pmm.FreePages();
+
+	// Released outside any batch: nobody reclaims these until the list fills.
+	static constexpr std::size_t kPageCount = PageTablePagePool::kDeferredCapacityPages + 1;
+	static std::uintptr_t pages[kPageCount];
+	for (std::size_t i = 0; i < kPageCount; i++) {
+		const auto page_or = pmm.AllocateZeroedPage();
+		ROCINANTE_EXPECT_TRUE(ctx, page_or.has_value());
+		if (!page_or.has_value()) return;
+		pages[i] = page_or.value();
+	}
+	for (std::size_t i = 0; i + 1 < kPageCount; i++) {
+		ROCINANTE_EXPECT_TRUE(ctx, g_test_pool.DeferFreePage(pages[i]));
+	}
+	ROCINANTE_EXPECT_EQ_U64(ctx, g_test_pool.DeferredPageCount(), PageTablePagePool::kDeferredCapacityPages);
+	ROCINANTE_EXPECT_EQ_U64(ctx, g_test_pool.StatisticsForCpu(core_id).deferred_overflows, 0);
+
+	// The overflowing page flushes the TLB and recycles the whole list.
+	ROCINANTE_EXPECT_TRUE(ctx, g_test_pool.DeferFreePage(pages[kPageCount - 1]));
+	ROCINANTE_EXPECT_EQ_U64(ctx, g_test_pool.DeferredPageCount(), 0);
+	ROCINANTE_EXPECT_EQ_U64(ctx, g_test_pool.StatisticsForCpu(core_id).deferred_overflows, 1);
+	ROCINANTE_EXPECT_EQ_U64(ctx, g_test_pool.ReservedPageCountForCpu(core_id), PageTablePagePool::kDefaultHighWatermarkPages);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm_free_before - pmm.FreePages(), PageTablePagePool::kDefaultHighWatermarkPages);
+
+	g_test_pool.DrainAll();
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), pmm_free_before);
+}
+
+static void Test_PageTablePool_PagingWalkFailsBeforeBuildingTables(TestContext* ctx) {
+	using Rocinante::Memory::PageTablePagePool;
+	using namespace Rocinante::Memory::Paging;
+
+	static constexpr AddressSpaceBits kAddressBits{.virtual_address_bits = 48, .physical_address_bits = 48};
+	static constexpr std::uintptr_t kVirtualAddress = 0x0000123456789000ull;
+	static constexpr std::uintptr_t kPhysicalAddress = kScratchPmmBase + 0x100000;
+
+	if (!InitializeScratchPmm(ctx, kUsableSizeBytes)) return;
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+	const std::size_t core_id = Rocinante::ReadCurrentProcessorCoreId();
+	const std::size_t pmm_free_before = pmm.FreePages();
+
+	auto& pool = Rocinante::Memory::GetPageTablePagePool();
+	pool.Initialize(&pmm);
+	ROCINANTE_EXPECT_TRUE(ctx, pool.SetWatermarks(PageTablePagePool::Watermarks{.low_pages = 0, .high_pages = 1}));
+
+	const auto root_or = AllocateRootPageTable(&pmm);
+	ROCINANTE_EXPECT_TRUE(ctx, root_or.has_value());
+	if (!root_or.has_value()) {
+		pool.Initialize(nullptr);
+		return;
+	}
+	const PageTableRoot root = root_or.value();
+
+	const PagePermissions permissions{
+		.access = AccessPermissions::ReadWrite,
+		.execute = ExecutePermissions::NoExecute,
+		.cache = CacheMode::CoherentCached,
+		.global = false,
+	};
+
+	// Leave the PMM two pages short of the three tables the walk needs.
+	static std::uintptr_t hoarded[kUsableSizeBytes / kPageSizeBytes];
+	std::size_t hoarded_count = 0;
+	for (;;) {
+		const auto page_or = pmm.AllocatePage();
+		if (!page_or.has_value()) break;
+		hoarded[hoarded_count++] = page_or.value();
+	}
+	ROCINANTE_EXPECT_TRUE(ctx, hoarded_count >= 2);
+	for (std::size_t i = 0; i < 2 && hoarded_count != 0; i++) {
+		ROCINANTE_EXPECT_TRUE(ctx, pmm.FreePage(hoarded[--hoarded_count]));
+	}
+
+	// The reservation fails before any table is linked in, so the root is
+	// still empty rather than holding a dead-end path.
+	ROCINANTE_EXPECT_TRUE(ctx, !MapPage4KiB(&pmm, root, kVirtualAddress, kPhysicalAddress, permissions, kAddressBits));
+	ROCINANTE_EXPECT_EQ_U64(ctx, pool.StatisticsForCpu(core_id).reserve_failures, 1);
+
+	// The PMM is now empty: a refill adds nothing and is not counted as a batch.
+	const std::uint64_t refill_batches_before = pool.StatisticsForCpu(core_id).refill_batches;
+	ROCINANTE_EXPECT_TRUE(ctx, !pool.Reserve(3));
+	ROCINANTE_EXPECT_EQ_U64(ctx, pool.StatisticsForCpu(core_id).refill_batches, refill_batches_before);
+
+	const auto* root_table = reinterpret_cast<const PageTablePage*>(root.root_physical_address);
+	bool root_empty = true;
+	for (std::size_t i = 0; i < kEntriesPerTable; i++) {
+		if (root_table->entries[i] != 0) root_empty = false;
+	}
+	ROCINANTE_EXPECT_TRUE(ctx, root_empty);
+
+	while (hoarded_count != 0) {
+		ROCINANTE_EXPECT_TRUE(ctx, pmm.FreePage(hoarded[--hoarded_count]));
+	}
+
+	// With memory back, the walk builds its whole path from the reserve.
+	ROCINANTE_EXPECT_TRUE(ctx, MapPage4KiB(&pmm, root, kVirtualAddress, kPhysicalAddress, permissions, kAddressBits));
+	const auto translated = Translate(root, kVirtualAddress, kAddressBits);
+	ROCINANTE_EXPECT_TRUE(ctx, translated.has_value());
+	if (translated.has_value()) ROCINANTE_EXPECT_EQ_U64(ctx, translated.value(), kPhysicalAddress);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pool.StatisticsForCpu(core_id).allocation_misses, 0);
+
+	// The three emptied tables wait for the (here notional) TLB flush.
+	{
+		PageTablePagePool::DeferredBatch table_batch(pool);
+		const std::size_t pmm_free_mapped = pmm.FreePages();
+		ROCINANTE_EXPECT_TRUE(ctx, UnmapPage4KiB(&pmm, root, kVirtualAddress, kAddressBits));
+		ROCINANTE_EXPECT_EQ_U64(ctx, pool.DeferredPageCount(), 3);
+		ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), pmm_free_mapped);
+		ROCINANTE_EXPECT_EQ_U64(ctx, table_batch.Reclaim(), 3);
+
+		ROCINANTE_EXPECT_TRUE(ctx, FreeAllPageTables4KiB(&pmm, root, kAddressBits));
+		ROCINANTE_EXPECT_EQ_U64(ctx, table_batch.Reclaim(), 1);
+	}
+	pool.DrainAll();
+	pool.Initialize(nullptr);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), pmm_free_before);
+}
+
+static void Test_PageTablePool_Benchmark_MapUnmapFreshPath(TestContext* ctx) {
+	// Benchmark (reported, not asserted):
+	// Average cost of mapping one page where no tables exist yet (three new
+	// tables) and unmapping it again (three tables released), with tables
+	// straight from the PMM (4 KiB clear each, the zeroed pool is left empty)
+	// versus through the pool, reclaiming after each unmap as a TLB flush
+	// would.
+	using namespace Rocinante::Memory::Paging;
+
+	static constexpr std::size_t kIterations = 128;
+	static constexpr AddressSpaceBits kAddressBits{.virtual_address_bits = 48, .physical_address_bits = 48};
+	static constexpr std::uintptr_t kVirtualAddress = 0x0000123456789000ull;
+	static constexpr std::uintptr_t kPhysicalAddress = kScratchPmmBase + 0x100000;
+
+	if (!InitializeScratchPmm(ctx, kUsableSizeBytes)) return;
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+
+	const auto root_or = AllocateRootPageTable(&pmm);
+	ROCINANTE_EXPECT_TRUE(ctx, root_or.has_value());
+	if (!root_or.has_value()) return;
+	const PageTableRoot root = root_or.value();
+
+	const PagePermissions permissions{
+		.access = AccessPermissions::ReadWrite,
+		.execute = ExecutePermissions::NoExecute,
+		.cache = CacheMode::CoherentCached,
+		.global = false,
+	};
+
+	std::uint64_t start_ticks = Rocinante::ReadStableCounterTicks();
+	for (std::size_t i = 0; i < kIterations; i++) {
+		ROCINANTE_EXPECT_TRUE(ctx, MapPage4KiB(&pmm, root, kVirtualAddress, kPhysicalAddress, permissions, kAddressBits));
+		ROCINANTE_EXPECT_TRUE(ctx, UnmapPage4KiB(&pmm, root, kVirtualAddress, kAddressBits));
+	}
+	const std::uint64_t pmm_ticks = Rocinante::ReadStableCounterTicks() - start_ticks;
+
+	auto& pool = Rocinante::Memory::GetPageTablePagePool();
+	pool.Initialize(&pmm);
+	ROCINANTE_EXPECT_TRUE(ctx, pool.Reserve(3));
+
+	start_ticks = Rocinante::ReadStableCounterTicks();
+	for (std::size_t i = 0; i < kIterations; i++) {
+		Rocinante::Memory::PageTablePagePool::DeferredBatch table_batch(pool);
+		ROCINANTE_EXPECT_TRUE(ctx, MapPage4KiB(&pmm, root, kVirtualAddress, kPhysicalAddress, permissions, kAddressBits));
+		ROCINANTE_EXPECT_TRUE(ctx, UnmapPage4KiB(&pmm, root, kVirtualAddress, kAddressBits));
+		(void)table_batch.Reclaim();
+	}
+	const std::uint64_t pool_ticks = Rocinante::ReadStableCounterTicks() - start_ticks;
+
+	const std::size_t misses = pool.StatisticsForCpu(Rocinante::ReadCurrentProcessorCoreId()).allocation_misses;
+	pool.DrainAll();
+	pool.Initialize(nullptr);
+	ROCINANTE_EXPECT_EQ_U64(ctx, misses, 0);
+	ROCINANTE_EXPECT_TRUE(ctx, FreeAllPageTables4KiB(&pmm, root, kAddressBits));
+
+	Rocinante::Testing::NoteU64(ctx, __FILE__, __LINE__, "fresh_path_map_unmap_avg_ticks_pmm", pmm_ticks / kIterations);
+	Rocinante::Testing::NoteU64(ctx, __FILE__, __LINE__, "fresh_path_map_unmap_avg_ticks_pool", pool_ticks / kIterations);
+}
+
+} // namespace
+
+void TestEntry_PageTablePool_ReserveTracksWatermarks(TestContext* ctx) {
+	Test_PageTablePool_ReserveTracksWatermarks(ctx);
+}
+
+void TestEntry_PageTablePool_DeferredPagesWaitForReclaim(TestContext* ctx) {
+	Test_PageTablePool_DeferredPagesWaitForReclaim(ctx);
+}
+
+void TestEntry_PageTablePool_FullDeferredListFlushesAndRecycles(TestContext* ctx) {
+	Test_PageTablePool_FullDeferredListFlushesAndRecycles(ctx);
+}
+
+void TestEntry_PageTablePool_PagingWalkFailsBeforeBuildingTables(TestContext* ctx) {
+	Test_PageTablePool_PagingWalkFailsBeforeBuildingTables(ctx);
+}
+
+void TestEntry_PageTablePool_Benchmark_MapUnmapFreshPath(TestContext* ctx) {
+	Test_PageTablePool_Benchmark_MapUnmapFreshPath(ctx);
+}
+
+} // namespace Rocinante::Testing
@@ -6,6 +6,7 @@
 #include <src/testing/test.h>
 
 #include <src/sp/cpucfg.h>
+#include <src/sp/stable_counter.h>
 
 #include <src/memory/boot_memory_map.h>
 #include <src/memory/address_space.h>
@@ -264,10 +265,9 @@ static void Test_AddressSpace_DestroyPageTables_FreesRootAndSubtables(TestContex
 	ROCINANTE_EXPECT_TRUE(ctx, pmm.InitializeFromBootMemoryMap(map, kKernelBase, kKernelEnd, kDeviceTreeBase, kDeviceTreeSizeBytes));
 
 	const AddressSpaceBits bits{.virtual_address_bits = 39, .physical_address_bits = 44};
-	static constexpr std::uint16_t kAsid = 1;
 
 	const std::size_t free_before_create = pmm.FreePages();
-	auto as_or = AddressSpace::Create(&pmm, bits, kAsid);
+	auto as_or = AddressSpace::Create(&pmm, bits);
 	ROCINANTE_EXPECT_TRUE(ctx, as_or.has_value());
 	if (!as_or.has_value()) return;
 	AddressSpace address_space = as_or.value();
@@ -566,6 +566,656 @@ static void Test_Paging_Physmap_MapsRootPageTableAndAttributes(TestContext* ctx)
 	ROCINANTE_EXPECT_EQ_U64(ctx, cache_field, static_cast<std::uint64_t>(CacheMode::CoherentCached));
 }
 
+static void Test_Paging_HugeLeaves_MapTranslateSplitAndFree(TestContext* ctx) {
+	// Spec anchor (LoongArch-Vol1-EN.html, CPUCFG word 0x1):
+	// - Bit 24 (HP): page sizes other than STLBPS are supported.
+	// Without it MapRange() only builds 4 KiB leaves, which this test's PMM
+	// is far too small to hold for a 1 GiB range.
+	if (!Rocinante::GetCPUCFG().SupportsHugePage()) {
+		Rocinante::Testing::Warn(ctx, __FILE__, __LINE__,
+			"CPU does not support huge pages (CPUCFG.HP=0); skipping huge-leaf test");
+		return;
+	}
+
+	using Rocinante::Memory::BootMemoryRegion;
+	using Rocinante::Memory::BootMemoryMap;
+	using Rocinante::Memory::PhysicalMemoryManager;
+	using namespace Rocinante::Memory::Paging;
+
+	static constexpr std::uintptr_t kUsableBase = 0x01000000; // 16 MiB
+	static constexpr std::size_t kUsableSizeBytes = 4u * 1024u * 1024u;
+	static constexpr AddressSpaceBits kAddressBits{.virtual_address_bits = 48, .physical_address_bits = 48};
+
+	const std::uintptr_t kernel_physical_base = reinterpret_cast<std::uintptr_t>(&_start);
+	const std::uintptr_t kernel_physical_end = reinterpret_cast<std::uintptr_t>(&_end);
+
+	BootMemoryMap map;
+	map.Clear();
+	ROCINANTE_EXPECT_TRUE(ctx, map.AddRegion(BootMemoryRegion{.physical_base = kUsableBase, .size_bytes = kUsableSizeBytes, .type = BootMemoryRegion::Type::UsableRAM}));
+
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.InitializeFromBootMemoryMap(map, kernel_physical_base, kernel_physical_end, 0, 0));
+	const std::size_t free_pages_before_root = pmm.FreePages();
+
+	const auto root_or = AllocateRootPageTable(&pmm);
+	ROCINANTE_EXPECT_TRUE(ctx, root_or.has_value());
+	if (!root_or.has_value()) return;
+	const PageTableRoot root = root_or.value();
+	const std::size_t free_pages_after_root = pmm.FreePages();
+
+	const PagePermissions permissions{
+		.access = AccessPermissions::ReadWrite,
+		.execute = ExecutePermissions::NoExecute,
+		.cache = CacheMode::CoherentCached,
+		.global = true,
+	};
+
+	// 1 GiB + 2 MiB + 4 KiB onto untracked physical memory: one leaf of each
+	// size, so only the level-2, level-1 and level-0 tables get allocated.
+	static constexpr std::uintptr_t kVirtualBase = 0x0000004000000000ull; // 256 GiB
+	static constexpr std::uintptr_t kPhysicalBase = 0x0000000100000000ull; // 4 GiB
+	static constexpr std::size_t kSizeBytes = kHugePageSizeBytes1GiB + kHugePageSizeBytes2MiB + kPageSizeBytes;
+	ROCINANTE_EXPECT_TRUE(ctx, MapRange(&pmm, root, kVirtualBase, kPhysicalBase, kSizeBytes, permissions, kAddressBits));
+	ROCINANTE_EXPECT_EQ_U64(ctx, free_pages_after_root - pmm.FreePages(), 3);
+
+	const std::uintptr_t probe_offsets[] = {
+		0x1234,
+		kHugePageSizeBytes1GiB - 8,
+		kHugePageSizeBytes1GiB + 0x12345,
+		kHugePageSizeBytes1GiB + kHugePageSizeBytes2MiB + 0x10,
+	};
+	for (const std::uintptr_t offset : probe_offsets) {
+		const auto translated = Translate(root, kVirtualBase + offset, kAddressBits);
+		ROCINANTE_EXPECT_TRUE(ctx, translated.has_value());
+		if (translated.has_value()) ROCINANTE_EXPECT_EQ_U64(ctx, translated.value(), kPhysicalBase + offset);
+	}
+	ROCINANTE_EXPECT_TRUE(ctx, !Translate(root, kVirtualBase + kSizeBytes, kAddressBits).has_value());
+
+	// Already covered by the 1 GiB leaf.
+	ROCINANTE_EXPECT_TRUE(ctx, !MapPage4KiB(&pmm, root, kVirtualBase + kPageSizeBytes, kPhysicalBase, permissions, kAddressBits));
+
+	// Unmapping one 4 KiB page splits 1 GiB -> 2 MiB leaves -> 4 KiB leaves.
+	static constexpr std::uintptr_t kHoleOffset = 3 * kPageSizeBytes;
+	ROCINANTE_EXPECT_TRUE(ctx, UnmapPage4KiB(&pmm, root, kVirtualBase + kHoleOffset, kAddressBits));
+	ROCINANTE_EXPECT_EQ_U64(ctx, free_pages_after_root - pmm.FreePages(), 5);
+	ROCINANTE_EXPECT_TRUE(ctx, !Translate(root, kVirtualBase + kHoleOffset, kAddressBits).has_value());
+	const std::uintptr_t split_probe_offsets[] = {
+		kHoleOffset - kPageSizeBytes,
+		kHoleOffset + kPageSizeBytes + 0x20,
+		kHugePageSizeBytes2MiB + 0x40,
+		kHugePageSizeBytes1GiB - kPageSizeBytes,
+	};
+	for (const std::uintptr_t offset : split_probe_offsets) {
+		const auto translated = Translate(root, kVirtualBase + offset, kAddressBits);
+		ROCINANTE_EXPECT_TRUE(ctx, translated.has_value());
+		if (translated.has_value()) ROCINANTE_EXPECT_EQ_U64(ctx, translated.value(), kPhysicalBase + offset);
+	}
+
+	// A 2 MiB leaf over PMM-tracked frames counts every 4 KiB frame it covers.
+	static constexpr std::uintptr_t kTrackedVirtualBase = 0x0000008000000000ull; // 512 GiB
+	static constexpr std::uintptr_t kTrackedPhysicalBase = kUsableBase + kHugePageSizeBytes2MiB;
+	ROCINANTE_EXPECT_TRUE(ctx, MapRange(&pmm, root, kTrackedVirtualBase, kTrackedPhysicalBase, kHugePageSizeBytes2MiB, permissions, kAddressBits));
+	const auto first_count = pmm.MapCountForPhysical(kTrackedPhysicalBase);
+	const auto last_count = pmm.MapCountForPhysical(kTrackedPhysicalBase + kHugePageSizeBytes2MiB - kPageSizeBytes);
+	ROCINANTE_EXPECT_TRUE(ctx, first_count.has_value() && last_count.has_value());
+	if (first_count.has_value()) ROCINANTE_EXPECT_EQ_U64(ctx, first_count.value(), 1);
+	if (last_count.has_value()) ROCINANTE_EXPECT_EQ_U64(ctx, last_count.value(), 1);
+
+	// A physmap leaf (the alias of its own PA) counts nothing, so freeing the
+	// tables must not drop counts from those frames either.
+	const std::uintptr_t physmap_virtual_base =
+		Rocinante::Memory::VirtualLayout::ToPhysMapVirtual(kUsableBase, kAddressBits.virtual_address_bits);
+	ROCINANTE_EXPECT_TRUE(ctx, MapRange(&pmm, root, physmap_virtual_base, kUsableBase, kHugePageSizeBytes2MiB, permissions, kAddressBits));
+	const auto physmap_count = pmm.MapCountForPhysical(kUsableBase);
+	ROCINANTE_EXPECT_TRUE(ctx, physmap_count.has_value() && physmap_count.value() == 0);
+
+	bool had_global_leaf_mappings = false;
+	ROCINANTE_EXPECT_TRUE(ctx, FreeAllPageTables4KiB(&pmm, root, kAddressBits, &had_global_leaf_mappings));
+	ROCINANTE_EXPECT_TRUE(ctx, had_global_leaf_mappings);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), free_pages_before_root);
+	const auto first_count_after = pmm.MapCountForPhysical(kTrackedPhysicalBase);
+	if (first_count_after.has_value()) ROCINANTE_EXPECT_EQ_U64(ctx, first_count_after.value(), 0);
+}
+
+static void Test_Paging_UnmapRange_SkipsHolesAndReclaimsTables(TestContext* ctx) {
+	using Rocinante::Memory::BootMemoryRegion;
+	using Rocinante::Memory::BootMemoryMap;
+	using Rocinante::Memory::PhysicalMemoryManager;
+	using namespace Rocinante::Memory::Paging;
+
+	static constexpr std::uintptr_t kUsableBase = 0x01000000; // 16 MiB
+	static constexpr std::size_t kUsableSizeBytes = 4u * 1024u * 1024u;
+	static constexpr AddressSpaceBits kAddressBits{.virtual_address_bits = 48, .physical_address_bits = 48};
+
+	const std::uintptr_t kernel_physical_base = reinterpret_cast<std::uintptr_t>(&_start);
+	const std::uintptr_t kernel_physical_end = reinterpret_cast<std::uintptr_t>(&_end);
+
+	BootMemoryMap map;
+	map.Clear();
+	ROCINANTE_EXPECT_TRUE(ctx, map.AddRegion(BootMemoryRegion{.physical_base = kUsableBase, .size_bytes = kUsableSizeBytes, .type = BootMemoryRegion::Type::UsableRAM}));
+
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.InitializeFromBootMemoryMap(map, kernel_physical_base, kernel_physical_end, 0, 0));
+
+	const auto root_or = AllocateRootPageTable(&pmm);
+	ROCINANTE_EXPECT_TRUE(ctx, root_or.has_value());
+	if (!root_or.has_value()) return;
+	const PageTableRoot root = root_or.value();
+	const std::size_t free_pages_after_root = pmm.FreePages();
+
+	const PagePermissions permissions{
+		.access = AccessPermissions::ReadWrite,
+		.execute = ExecutePermissions::NoExecute,
+		.cache = CacheMode::CoherentCached,
+		.global = false,
+	};
+
+	// 16 tracked pages straddling a leaf-table boundary: root + dir2 + dir1
+	// tables plus two leaf tables.
+	static constexpr std::size_t kPageCount = 16;
+	static constexpr std::uintptr_t kVirtualBase = kHugePageSizeBytes2MiB - (8 * kPageSizeBytes);
+	static constexpr std::uintptr_t kPhysicalBase = kUsableBase + 0x10000;
+	static constexpr std::size_t kSizeBytes = kPageCount * kPageSizeBytes;
+	ROCINANTE_EXPECT_TRUE(ctx, MapRange4KiB(&pmm, root, kVirtualBase, kPhysicalBase, kSizeBytes, permissions, kAddressBits));
+	ROCINANTE_EXPECT_EQ_U64(ctx, free_pages_after_root - pmm.FreePages(), 4);
+	for (std::size_t i = 0; i < kPageCount; i++) {
+		const auto translated = Translate(root, kVirtualBase + (i * kPageSizeBytes) + 0x10, kAddressBits);
+		ROCINANTE_EXPECT_TRUE(ctx, translated.has_value());
+		if (translated.has_value()) ROCINANTE_EXPECT_EQ_U64(ctx, translated.value(), kPhysicalBase + (i * kPageSizeBytes) + 0x10);
+	}
+	const auto mapped_count = pmm.MapCountForPhysical(kPhysicalBase);
+	ROCINANTE_EXPECT_TRUE(ctx, mapped_count.has_value());
+	if (mapped_count.has_value()) ROCINANTE_EXPECT_EQ_U64(ctx, mapped_count.value(), 1);
+
+	// Unmapping the first leaf table's pages releases only that table.
+	ROCINANTE_EXPECT_TRUE(ctx, UnmapRange(&pmm, root, kVirtualBase, 8 * kPageSizeBytes, kAddressBits));
+	ROCINANTE_EXPECT_EQ_U64(ctx, free_pages_after_root - pmm.FreePages(), 3);
+	ROCINANTE_EXPECT_TRUE(ctx, !Translate(root, kVirtualBase, kAddressBits).has_value());
+	ROCINANTE_EXPECT_TRUE(ctx, Translate(root, kHugePageSizeBytes2MiB, kAddressBits).has_value());
+
+	// A range wider than what is mapped, with a hole inside: holes are
+	// skipped and every table below the root goes away.
+	ROCINANTE_EXPECT_TRUE(ctx, UnmapPage4KiB(&pmm, root, kHugePageSizeBytes2MiB + (2 * kPageSizeBytes), kAddressBits));
+	ROCINANTE_EXPECT_TRUE(ctx, UnmapRange(&pmm, root, 0, 2 * kHugePageSizeBytes2MiB, kAddressBits));
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), free_pages_after_root);
+	for (std::size_t i = 0; i < kPageCount; i++) {
+		const auto count = pmm.MapCountForPhysical(kPhysicalBase + (i * kPageSizeBytes));
+		if (count.has_value()) ROCINANTE_EXPECT_EQ_U64(ctx, count.value(), 0);
+	}
+
+	// Misaligned or wrapping ranges are rejected up front.
+	ROCINANTE_EXPECT_TRUE(ctx, !UnmapRange(&pmm, root, kVirtualBase + 1, kPageSizeBytes, kAddressBits));
+	ROCINANTE_EXPECT_TRUE(ctx, !MapRange4KiB(&pmm, root, 0x00007FFFFFFFF000ull, kPhysicalBase, 2 * kPageSizeBytes, permissions, kAddressBits));
+
+	// Huge-aware: removing a few pages from the middle of a 2 MiB leaf splits
+	// it; removing the rest gives back the split table too.
+	if (Rocinante::GetCPUCFG().SupportsHugePage()) {
+		static constexpr std::uintptr_t kHugeVirtualBase = 0x0000004000000000ull; // 256 GiB
+		static constexpr std::uintptr_t kHugePhysicalBase = 0x0000000100000000ull; // 4 GiB, untracked
+		static constexpr std::uintptr_t kHoleOffset = 0x100000;
+		ROCINANTE_EXPECT_TRUE(ctx, MapRange(&pmm, root, kHugeVirtualBase, kHugePhysicalBase, kHugePageSizeBytes2MiB, permissions, kAddressBits));
+		ROCINANTE_EXPECT_EQ_U64(ctx, free_pages_after_root - pmm.FreePages(), 2);
+		ROCINANTE_EXPECT_TRUE(ctx, UnmapRange(&pmm, root, kHugeVirtualBase + kHoleOffset, 4 * kPageSizeBytes, kAddressBits));
+		ROCINANTE_EXPECT_EQ_U64(ctx, free_pages_after_root - pmm.FreePages(), 3);
+		ROCINANTE_EXPECT_TRUE(ctx, !Translate(root, kHugeVirtualBase + kHoleOffset, kAddressBits).has_value());
+		const auto below = Translate(root, kHugeVirtualBase + kHoleOffset - kPageSizeBytes, kAddressBits);
+		const auto above = Translate(root, kHugeVirtualBase + kHoleOffset + (4 * kPageSizeBytes), kAddressBits);
+		ROCINANTE_EXPECT_TRUE(ctx, below.has_value() && above.has_value());
+		if (above.has_value()) ROCINANTE_EXPECT_EQ_U64(ctx, above.value(), kHugePhysicalBase + kHoleOffset + (4 * kPageSizeBytes));
+		ROCINANTE_EXPECT_TRUE(ctx, UnmapRange(&pmm, root, kHugeVirtualBase, kHugePageSizeBytes2MiB, kAddressBits));
+		ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), free_pages_after_root);
+	}
+
+	ROCINANTE_EXPECT_TRUE(ctx, FreeAllPageTables4KiB(&pmm, root, kAddressBits));
+}
+
+static void Test_Paging_Benchmark_RangeMapVersusPerPage(TestContext* ctx) {
+	// Benchmark (reported, not asserted beyond correctness):
+	// Mapping and unmapping 4 MiB of 4 KiB pages one page at a time (a full
+	// root-to-leaf walk per page) versus MapRange4KiB()/UnmapRange(), which
+	// walk each table once.
+	using Rocinante::Memory::BootMemoryRegion;
+	using Rocinante::Memory::BootMemoryMap;
+	using Rocinante::Memory::PhysicalMemoryManager;
+	using namespace Rocinante::Memory::Paging;
+
+	static constexpr std::size_t kRounds = 8;
+	static constexpr std::size_t kPageCount = 1024;
+	static constexpr std::size_t kSizeBytes = kPageCount * kPageSizeBytes;
+	static constexpr std::uintptr_t kVirtualBase = 0x0000004000000000ull; // 256 GiB
+	static constexpr std::uintptr_t kPhysicalBase = 0x0000000100000000ull; // 4 GiB, untracked
+	static constexpr std::uintptr_t kUsableBase = 0x01000000; // 16 MiB
+	static constexpr std::size_t kUsableSizeBytes = 4u * 1024u * 1024u;
+	static constexpr AddressSpaceBits kAddressBits{.virtual_address_bits = 48, .physical_address_bits = 48};
+
+	const std::uintptr_t kernel_physical_base = reinterpret_cast<std::uintptr_t>(&_start);
+	const std::uintptr_t kernel_physical_end = reinterpret_cast<std::uintptr_t>(&_end);
+
+	BootMemoryMap map;
+	map.Clear();
+	ROCINANTE_EXPECT_TRUE(ctx, map.AddRegion(BootMemoryRegion{.physical_base = kUsableBase, .size_bytes = kUsableSizeBytes, .type = BootMemoryRegion::Type::UsableRAM}));
+
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.InitializeFromBootMemoryMap(map, kernel_physical_base, kernel_physical_end, 0, 0));
+
+	const auto root_or = AllocateRootPageTable(&pmm);
+	ROCINANTE_EXPECT_TRUE(ctx, root_or.has_value());
+	if (!root_or.has_value()) return;
+	const PageTableRoot root = root_or.value();
+	const std::size_t free_pages_after_root = pmm.FreePages();
+
+	const PagePermissions permissions{
+		.access = AccessPermissions::ReadWrite,
+		.execute = ExecutePermissions::NoExecute,
+		.cache = CacheMode::CoherentCached,
+		.global = false,
+	};
+
+	std::uint64_t per_page_map_ticks = 0;
+	std::uint64_t per_page_unmap_ticks = 0;
+	std::uint64_t range_map_ticks = 0;
+	std::uint64_t range_unmap_ticks = 0;
+	for (std::size_t round = 0; round < kRounds; round++) {
+		std::uint64_t start_ticks = Rocinante::ReadStableCounterTicks();
+		for (std::size_t i = 0; i < kPageCount; i++) {
+			const std::uintptr_t offset = i * kPageSizeBytes;
+			ROCINANTE_EXPECT_TRUE(ctx, MapPage4KiB(&pmm, root, kVirtualBase + offset, kPhysicalBase + offset, permissions, kAddressBits));
+		}
+		per_page_map_ticks += Rocinante::ReadStableCounterTicks() - start_ticks;
+
+		start_ticks = Rocinante::ReadStableCounterTicks();
+		for (std::size_t i = 0; i < kPageCount; i++) {
+			ROCINANTE_EXPECT_TRUE(ctx, UnmapPage4KiB(&pmm, root, kVirtualBase + (i * kPageSizeBytes), kAddressBits));
+		}
+		per_page_unmap_ticks += Rocinante::ReadStableCounterTicks() - start_ticks;
+		ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), free_pages_after_root);
+
+		start_ticks = Rocinante::ReadStableCounterTicks();
+		ROCINANTE_EXPECT_TRUE(ctx, MapRange4KiB(&pmm, root, kVirtualBase, kPhysicalBase, kSizeBytes, permissions, kAddressBits));
+		range_map_ticks += Rocinante::ReadStableCounterTicks() - start_ticks;
+
+		const auto translated = Translate(root, kVirtualBase + kSizeBytes - 8, kAddressBits);
+		ROCINANTE_EXPECT_TRUE(ctx, translated.has_value());
+		if (translated.has_value()) ROCINANTE_EXPECT_EQ_U64(ctx, translated.value(), kPhysicalBase + kSizeBytes - 8);
+
+		start_ticks = Rocinante::ReadStableCounterTicks();
+		ROCINANTE_EXPECT_TRUE(ctx, UnmapRange(&pmm, root, kVirtualBase, kSizeBytes, kAddressBits));
+		range_unmap_ticks += Rocinante::ReadStableCounterTicks() - start_ticks;
+		ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), free_pages_after_root);
+	}
+
+	ROCINANTE_EXPECT_TRUE(ctx, FreeAllPageTables4KiB(&pmm, root, kAddressBits));
+
+	Rocinante::Testing::NoteU64(ctx, __FILE__, __LINE__, "map_4mib_avg_ticks_per_page_calls", per_page_map_ticks / kRounds);
+	Rocinante::Testing::NoteU64(ctx, __FILE__, __LINE__, "map_4mib_avg_ticks_range", range_map_ticks / kRounds);
+	Rocinante::Testing::NoteU64(ctx, __FILE__, __LINE__, "unmap_4mib_avg_ticks_per_page_calls", per_page_unmap_ticks / kRounds);
+	Rocinante::Testing::NoteU64(ctx, __FILE__, __LINE__, "unmap_4mib_avg_ticks_range", range_unmap_ticks / kRounds);
+}
+
+static void Test_Paging_Walkers_SpecializedMatchesGeneric(TestContext* ctx) {
+	using Rocinante::Memory::BootMemoryRegion;
+	using Rocinante::Memory::BootMemoryMap;
+	using Rocinante::Memory::PhysicalMemoryManager;
+	using namespace Rocinante::Memory::Paging;
+
+	static constexpr std::uintptr_t kUsableBase = 0x01000000; // 16 MiB
+	static constexpr std::size_t kUsableSizeBytes = 4u * 1024u * 1024u;
+
+	// Selection: four and three levels at PALEN 48 are specialized, anything
+	// else falls back to the run-time layout.
+	static constexpr AddressSpaceBits kFourLevelBits{.virtual_address_bits = 48, .physical_address_bits = 48};
+	static constexpr AddressSpaceBits kThreeLevelBits{.virtual_address_bits = 39, .physical_address_bits = 48};
+	const Walkers four_level = SelectWalkers(kFourLevelBits);
+	const Walkers three_level = SelectWalkers(kThreeLevelBits);
+	ROCINANTE_EXPECT_TRUE(ctx, four_level.specialized);
+	ROCINANTE_EXPECT_TRUE(ctx, three_level.specialized);
+	const Walkers other = SelectWalkers(AddressSpaceBits{.virtual_address_bits = 48, .physical_address_bits = 44});
+	ROCINANTE_EXPECT_TRUE(ctx, !other.specialized);
+	ROCINANTE_EXPECT_EQ_U64(ctx, other.address_bits.physical_address_bits, 44);
+	ROCINANTE_EXPECT_TRUE(ctx, other.translate != nullptr && other.map_page_4kib != nullptr && other.unmap_page_4kib != nullptr);
+
+	const std::uintptr_t kernel_physical_base = reinterpret_cast<std::uintptr_t>(&_start);
+	const std::uintptr_t kernel_physical_end = reinterpret_cast<std::uintptr_t>(&_end);
+
+	BootMemoryMap map;
+	map.Clear();
+	ROCINANTE_EXPECT_TRUE(ctx, map.AddRegion(BootMemoryRegion{.physical_base = kUsableBase, .size_bytes = kUsableSizeBytes, .type = BootMemoryRegion::Type::UsableRAM}));
+
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.InitializeFromBootMemoryMap(map, kernel_physical_base, kernel_physical_end, 0, 0));
+
+	const PagePermissions permissions{
+		.access = AccessPermissions::ReadWrite,
+		.execute = ExecutePermissions::NoExecute,
+		.cache = CacheMode::CoherentCached,
+		.global = false,
+	};
+
+	const struct {
+		const Walkers* walkers;
+		AddressSpaceBits bits;
+		std::uintptr_t virtual_base;
+	} cases[] = {
+		{&four_level, kFourLevelBits, 0x0000004000000000ull},   // 256 GiB
+		{&three_level, kThreeLevelBits, 0x0000000040000000ull}, // 1 GiB
+	};
+	static constexpr std::uintptr_t kPhysicalBase = kUsableBase + 0x20000;
+	static constexpr std::size_t kPageCount = 4;
+
+	for (const auto& c : cases) {
+		const std::size_t free_pages_before_root = pmm.FreePages();
+		const auto root_or = AllocateRootPageTable(&pmm);
+		ROCINANTE_EXPECT_TRUE(ctx, root_or.has_value());
+		if (!root_or.has_value()) return;
+		const PageTableRoot root = root_or.value();
+		const std::size_t free_pages_after_root = pmm.FreePages();
+
+		for (std::size_t i = 0; i < kPageCount; i++) {
+			const std::uintptr_t offset = i * kPageSizeBytes;
+			ROCINANTE_EXPECT_TRUE(ctx, c.walkers->map_page_4kib(&pmm, root, c.virtual_base + offset, kPhysicalBase + offset, permissions, c.bits));
+		}
+		// Already mapped; PA beyond PALEN; non-canonical VA.
+		ROCINANTE_EXPECT_TRUE(ctx, !c.walkers->map_page_4kib(&pmm, root, c.virtual_base, kPhysicalBase, permissions, c.bits));
+		ROCINANTE_EXPECT_TRUE(ctx, !c.walkers->map_page_4kib(&pmm, root, c.virtual_base + (kPageCount * kPageSizeBytes), 1ull << 48, permissions, c.bits));
+		const std::uintptr_t non_canonical = 1ull << c.bits.virtual_address_bits;
+		ROCINANTE_EXPECT_TRUE(ctx, !c.walkers->translate(root, non_canonical, c.bits).has_value());
+
+		for (std::size_t i = 0; i <= kPageCount; i++) {
+			const std::uintptr_t virtual_address = c.virtual_base + (i * kPageSizeBytes) + 0x18;
+			const auto specialized = c.walkers->translate(root, virtual_address, c.bits);
+			const auto generic = Translate(root, virtual_address, c.bits);
+			ROCINANTE_EXPECT_TRUE(ctx, specialized.has_value() == generic.has_value());
+			ROCINANTE_EXPECT_TRUE(ctx, specialized.has_value() == (i < kPageCount));
+			if (specialized.has_value() && generic.has_value()) {
+				ROCINANTE_EXPECT_EQ_U64(ctx, specialized.value(), generic.value());
+				ROCINANTE_EXPECT_EQ_U64(ctx, specialized.value(), kPhysicalBase + (i * kPageSizeBytes) + 0x18);
+			}
+		}
+		const auto count = pmm.MapCountForPhysical(kPhysicalBase);
+		if (count.has_value()) ROCINANTE_EXPECT_EQ_U64(ctx, count.value(), 1);
+
+		// Unmapping every page reclaims the intermediate tables, as the
+		// generic walker does.
+		for (std::size_t i = 0; i < kPageCount; i++) {
+			ROCINANTE_EXPECT_TRUE(ctx, c.walkers->unmap_page_4kib(&pmm, root, c.virtual_base + (i * kPageSizeBytes), c.bits));
+		}
+		ROCINANTE_EXPECT_TRUE(ctx, !c.walkers->unmap_page_4kib(&pmm, root, c.virtual_base, c.bits));
+		ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), free_pages_after_root);
+
+		// Huge leaves: translation stops at the leaf, and unmapping one page
+		// splits it.
+		if (Rocinante::GetCPUCFG().SupportsHugePage()) {
+			static constexpr std::uintptr_t kHugePhysicalBase = 0x0000000100000000ull; // 4 GiB, untracked
+			ROCINANTE_EXPECT_TRUE(ctx, MapRange(&pmm, root, c.virtual_base, kHugePhysicalBase, kHugePageSizeBytes2MiB, permissions, c.bits));
+			const auto inside = c.walkers->translate(root, c.virtual_base + 0x123456, c.bits);
+			ROCINANTE_EXPECT_TRUE(ctx, inside.has_value());
+			if (inside.has_value()) ROCINANTE_EXPECT_EQ_U64(ctx, inside.value(), kHugePhysicalBase + 0x123456);
+			ROCINANTE_EXPECT_TRUE(ctx, c.walkers->unmap_page_4kib(&pmm, root, c.virtual_base + kPageSizeBytes, c.bits));
+			ROCINANTE_EXPECT_TRUE(ctx, !c.walkers->translate(root, c.virtual_base + kPageSizeBytes, c.bits).has_value());
+			ROCINANTE_EXPECT_TRUE(ctx, c.walkers->translate(root, c.virtual_base, c.bits).has_value());
+		}
+
+		ROCINANTE_EXPECT_TRUE(ctx, FreeAllPageTables4KiB(&pmm, root, c.bits));
+		ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), free_pages_before_root);
+	}
+}
+
+static void Test_Paging_Benchmark_SpecializedTranslate(TestContext* ctx) {
+	// Benchmark (reported, not asserted beyond correctness):
+	// Translate() through the walkers that derive the layout at run time
+	// versus the ones SelectWalkers() specializes for VALEN = PALEN = 48.
+	using Rocinante::Memory::BootMemoryRegion;
+	using Rocinante::Memory::BootMemoryMap;
+	using Rocinante::Memory::PhysicalMemoryManager;
+	using namespace Rocinante::Memory::Paging;
+
+	static constexpr std::size_t kIterations = 4096;
+	static constexpr std::size_t kPageCount = 64;
+	static constexpr std::uintptr_t kVirtualBase = 0x0000004000000000ull; // 256 GiB
+	static constexpr std::uintptr_t kPhysicalBase = 0x0000000100000000ull; // 4 GiB, untracked
+	static constexpr std::uintptr_t kUsableBase = 0x01000000; // 16 MiB
+	static constexpr std::size_t kUsableSizeBytes = 4u * 1024u * 1024u;
+	static constexpr AddressSpaceBits kAddressBits{.virtual_address_bits = 48, .physical_address_bits = 48};
+
+	const std::uintptr_t kernel_physical_base = reinterpret_cast<std::uintptr_t>(&_start);
+	const std::uintptr_t kernel_physical_end = reinterpret_cast<std::uintptr_t>(&_end);
+
+	BootMemoryMap map;
+	map.Clear();
+	ROCINANTE_EXPECT_TRUE(ctx, map.AddRegion(BootMemoryRegion{.physical_base = kUsableBase, .size_bytes = kUsableSizeBytes, .type = BootMemoryRegion::Type::UsableRAM}));
+
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.InitializeFromBootMemoryMap(map, kernel_physical_base, kernel_physical_end, 0, 0));
+
+	const auto root_or = AllocateRootPageTable(&pmm);
+	ROCINANTE_EXPECT_TRUE(ctx, root_or.has_value());
+	if (!root_or.has_value()) return;
+	const PageTableRoot root = root_or.value();
+
+	const PagePermissions permissions{
+		.access = AccessPermissions::ReadWrite,
+		.execute = ExecutePermissions::NoExecute,
+		.cache = CacheMode::CoherentCached,
+		.global = false,
+	};
+	ROCINANTE_EXPECT_TRUE(ctx, MapRange4KiB(&pmm, root, kVirtualBase, kPhysicalBase, kPageCount * kPageSizeBytes, permissions, kAddressBits));
+
+	const Walkers generic = SelectWalkers(AddressSpaceBits{.virtual_address_bits = 48, .physical_address_bits = 44});
+	const Walkers specialized = SelectWalkers(kAddressBits);
+	ROCINANTE_EXPECT_TRUE(ctx, specialized.specialized);
+
+	std::uint64_t checksum_generic = 0;
+	std::uint64_t start_ticks = Rocinante::ReadStableCounterTicks();
+	for (std::size_t i = 0; i < kIterations; i++) {
+		const auto translated = generic.translate(root, kVirtualBase + ((i % kPageCount) * kPageSizeBytes), kAddressBits);
+		if (translated.has_value()) checksum_generic += translated.value();
+	}
+	const std::uint64_t generic_ticks = Rocinante::ReadStableCounterTicks() - start_ticks;
+
+	std::uint64_t checksum_specialized = 0;
+	start_ticks = Rocinante::ReadStableCounterTicks();
+	for (std::size_t i = 0; i < kIterations; i++) {
+		const auto translated = specialized.translate(root, kVirtualBase + ((i % kPageCount) * kPageSizeBytes), kAddressBits);
+		if (translated.has_value()) checksum_specialized += translated.value();
+	}
+	const std::uint64_t specialized_ticks = Rocinante::ReadStableCounterTicks() - start_ticks;
+
+	ROCINANTE_EXPECT_EQ_U64(ctx, checksum_specialized, checksum_generic);
+	ROCINANTE_EXPECT_TRUE(ctx, FreeAllPageTables4KiB(&pmm, root, kAddressBits));
+
+	Rocinante::Testing::NoteU64(ctx, __FILE__, __LINE__, "translate_avg_ticks_runtime_layout", generic_ticks / kIterations);
+	Rocinante::Testing::NoteU64(ctx, __FILE__, __LINE__, "translate_avg_ticks_specialized", specialized_ticks / kIterations);
+}
+
+static void Test_Paging_Cursor_SequentialMapQueryUnmap(TestContext* ctx) {
+	using Rocinante::Memory::BootMemoryRegion;
+	using Rocinante::Memory::BootMemoryMap;
+	using Rocinante::Memory::PhysicalMemoryManager;
+	using namespace Rocinante::Memory::Paging;
+
+	static constexpr std::uintptr_t kUsableBase = 0x01000000; // 16 MiB
+	static constexpr std::size_t kUsableSizeBytes = 4u * 1024u * 1024u;
+	static constexpr AddressSpaceBits kAddressBits{.virtual_address_bits = 48, .physical_address_bits = 48};
+
+	const std::uintptr_t kernel_physical_base = reinterpret_cast<std::uintptr_t>(&_start);
+	const std::uintptr_t kernel_physical_end = reinterpret_cast<std::uintptr_t>(&_end);
+
+	BootMemoryMap map;
+	map.Clear();
+	ROCINANTE_EXPECT_TRUE(ctx, map.AddRegion(BootMemoryRegion{.physical_base = kUsableBase, .size_bytes = kUsableSizeBytes, .type = BootMemoryRegion::Type::UsableRAM}));
+
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.InitializeFromBootMemoryMap(map, kernel_physical_base, kernel_physical_end, 0, 0));
+
+	const auto root_or = AllocateRootPageTable(&pmm);
+	ROCINANTE_EXPECT_TRUE(ctx, root_or.has_value());
+	if (!root_or.has_value()) return;
+	const PageTableRoot root = root_or.value();
+	const std::size_t free_pages_after_root = pmm.FreePages();
+
+	const PagePermissions permissions{
+		.access = AccessPermissions::ReadWrite,
+		.execute = ExecutePermissions::NoExecute,
+		.cache = CacheMode::CoherentCached,
+		.global = false,
+	};
+
+	// 600 tracked pages starting 8 pages below a 2 MiB boundary: the run
+	// spans two leaf tables.
+	static constexpr std::size_t kPageCount = 600;
+	static constexpr std::uintptr_t kVirtualBase = 0x0000004000000000ull - (8 * kPageSizeBytes);
+	static constexpr std::uintptr_t kPhysicalBase = kUsableBase + 0x100000;
+
+	{
+		Cursor cursor(&pmm, root, kAddressBits);
+		ROCINANTE_EXPECT_TRUE(ctx, cursor.IsValid());
+		ROCINANTE_EXPECT_TRUE(ctx, !cursor.Seek(kVirtualBase + 1));
+		ROCINANTE_EXPECT_TRUE(ctx, !cursor.Seek(1ull << 48));
+		ROCINANTE_EXPECT_TRUE(ctx, cursor.Seek(kVirtualBase));
+		for (std::size_t i = 0; i < kPageCount; i++) {
+			ROCINANTE_EXPECT_TRUE(ctx, !cursor.Query().has_value());
+			ROCINANTE_EXPECT_TRUE(ctx, cursor.Map(kPhysicalBase + (i * kPageSizeBytes), permissions));
+			if (i + 1 < kPageCount) ROCINANTE_EXPECT_TRUE(ctx, cursor.Next());
+		}
+		ROCINANTE_EXPECT_TRUE(ctx, !cursor.Map(kPhysicalBase, permissions));
+		ROCINANTE_EXPECT_TRUE(ctx, cursor.Flush());
+	}
+	// 256 GiB - 32 KiB and 256 GiB share a dir2 table but not a dir1 table,
+	// and the 592 pages above the boundary need two leaf tables: one dir2,
+	// two dir1 and three leaf tables.
+	ROCINANTE_EXPECT_EQ_U64(ctx, free_pages_after_root - pmm.FreePages(), 6);
+
+	{
+		Cursor cursor(&pmm, root, kAddressBits);
+		ROCINANTE_EXPECT_TRUE(ctx, cursor.Seek(kVirtualBase));
+		for (std::size_t i = 0; i < kPageCount; i++) {
+			const auto physical = cursor.Query();
+			const auto expected = Translate(root, cursor.VirtualAddress(), kAddressBits);
+			ROCINANTE_EXPECT_TRUE(ctx, physical.has_value() && expected.has_value());
+			if (physical.has_value() && expected.has_value()) {
+				ROCINANTE_EXPECT_EQ_U64(ctx, physical.value(), expected.value());
+				ROCINANTE_EXPECT_EQ_U64(ctx, physical.value(), kPhysicalBase + (i * kPageSizeBytes));
+			}
+			ROCINANTE_EXPECT_TRUE(ctx, cursor.Next());
+		}
+		ROCINANTE_EXPECT_TRUE(ctx, !cursor.Query().has_value());
+
+		// Unmap everything; the first leaf table and its dir1 table go as soon
+		// as the cursor crosses out of them, the rest on Flush().
+		ROCINANTE_EXPECT_TRUE(ctx, cursor.Seek(kVirtualBase));
+		for (std::size_t i = 0; i < kPageCount; i++) {
+			ROCINANTE_EXPECT_TRUE(ctx, cursor.Unmap());
+			ROCINANTE_EXPECT_TRUE(ctx, !cursor.Unmap());
+			ROCINANTE_EXPECT_TRUE(ctx, cursor.Next());
+			if (i == 8) ROCINANTE_EXPECT_EQ_U64(ctx, free_pages_after_root - pmm.FreePages(), 4);
+		}
+		ROCINANTE_EXPECT_EQ_U64(ctx, free_pages_after_root - pmm.FreePages(), 3);
+		ROCINANTE_EXPECT_TRUE(ctx, cursor.Flush());
+		ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), free_pages_after_root);
+	}
+	const auto count = pmm.MapCountForPhysical(kPhysicalBase);
+	if (count.has_value()) ROCINANTE_EXPECT_EQ_U64(ctx, count.value(), 0);
+
+	// Huge leaves: Query() reports the covered page, Map() refuses, Unmap()
+	// splits, and the destructor reclaims what Unmap() emptied.
+	if (Rocinante::GetCPUCFG().SupportsHugePage()) {
+		static constexpr std::uintptr_t kHugeVirtualBase = 0x0000008000000000ull; // 512 GiB
+		static constexpr std::uintptr_t kHugePhysicalBase = 0x0000000100000000ull; // 4 GiB, untracked
+		ROCINANTE_EXPECT_TRUE(ctx, MapRange(&pmm, root, kHugeVirtualBase, kHugePhysicalBase, kHugePageSizeBytes2MiB, permissions, kAddressBits));
+		{
+			Cursor cursor(&pmm, root, kAddressBits);
+			ROCINANTE_EXPECT_TRUE(ctx, cursor.Seek(kHugeVirtualBase + (5 * kPageSizeBytes)));
+			const auto physical = cursor.Query();
+			ROCINANTE_EXPECT_TRUE(ctx, physical.has_value());
+			if (physical.has_value()) ROCINANTE_EXPECT_EQ_U64(ctx, physical.value(), kHugePhysicalBase + (5 * kPageSizeBytes));
+			ROCINANTE_EXPECT_TRUE(ctx, !cursor.Map(kHugePhysicalBase, permissions));
+			ROCINANTE_EXPECT_TRUE(ctx, cursor.Unmap());
+			ROCINANTE_EXPECT_TRUE(ctx, !cursor.Query().has_value());
+			ROCINANTE_EXPECT_TRUE(ctx, cursor.Next());
+			ROCINANTE_EXPECT_TRUE(ctx, cursor.Query().has_value());
+		}
+		ROCINANTE_EXPECT_TRUE(ctx, UnmapRange(&pmm, root, kHugeVirtualBase, kHugePageSizeBytes2MiB, kAddressBits));
+		ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), free_pages_after_root);
+	}
+
+	ROCINANTE_EXPECT_TRUE(ctx, FreeAllPageTables4KiB(&pmm, root, kAddressBits));
+}
+
+static void Test_Paging_Benchmark_CursorVersusPerPageWalk(TestContext* ctx) {
+	// Benchmark (reported, not asserted beyond correctness):
+	// Querying and unmapping 4 MiB of 4 KiB pages with a fresh root-to-leaf
+	// walk per page (Translate() + UnmapPage4KiB()) versus one Cursor.
+	using Rocinante::Memory::BootMemoryRegion;
+	using Rocinante::Memory::BootMemoryMap;
+	using Rocinante::Memory::PhysicalMemoryManager;
+	using namespace Rocinante::Memory::Paging;
+
+	static constexpr std::size_t kRounds = 8;
+	static constexpr std::size_t kPageCount = 1024;
+	static constexpr std::size_t kSizeBytes = kPageCount * kPageSizeBytes;
+	static constexpr std::uintptr_t kVirtualBase = 0x0000004000000000ull; // 256 GiB
+	static constexpr std::uintptr_t kPhysicalBase = 0x0000000100000000ull; // 4 GiB, untracked
+	static constexpr std::uintptr_t kUsableBase = 0x01000000; // 16 MiB
+	static constexpr std::size_t kUsableSizeBytes = 4u * 1024u * 1024u;
+	static constexpr AddressSpaceBits kAddressBits{.virtual_address_bits = 48, .physical_address_bits = 48};
+
+	const std::uintptr_t kernel_physical_base = reinterpret_cast<std::uintptr_t>(&_start);
+	const std::uintptr_t kernel_physical_end = reinterpret_cast<std::uintptr_t>(&_end);
+
+	BootMemoryMap map;
+	map.Clear();
+	ROCINANTE_EXPECT_TRUE(ctx, map.AddRegion(BootMemoryRegion{.physical_base = kUsableBase, .size_bytes = kUsableSizeBytes, .type = BootMemoryRegion::Type::UsableRAM}));
+
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.InitializeFromBootMemoryMap(map, kernel_physical_base, kernel_physical_end, 0, 0));
+
+	const auto root_or = AllocateRootPageTable(&pmm);
+	ROCINANTE_EXPECT_TRUE(ctx, root_or.has_value());
+	if (!root_or.has_value()) return;
+	const PageTableRoot root = root_or.value();
+	const std::size_t free_pages_after_root = pmm.FreePages();
+
+	const PagePermissions permissions{
+		.access = AccessPermissions::ReadWrite,
+		.execute = ExecutePermissions::NoExecute,
+		.cache = CacheMode::CoherentCached,
+		.global = false,
+	};
+
+	std::uint64_t per_page_ticks = 0;
+	std::uint64_t cursor_ticks = 0;
+	for (std::size_t round = 0; round < kRounds; round++) {
+		ROCINANTE_EXPECT_TRUE(ctx, MapRange4KiB(&pmm, root, kVirtualBase, kPhysicalBase, kSizeBytes, permissions, kAddressBits));
+		std::uint64_t start_ticks = Rocinante::ReadStableCounterTicks();
+		for (std::size_t i = 0; i < kPageCount; i++) {
+			const std::uintptr_t virtual_page = kVirtualBase + (i * kPageSizeBytes);
+			if (Translate(root, virtual_page, kAddressBits).has_value()) {
+				ROCINANTE_EXPECT_TRUE(ctx, UnmapPage4KiB(&pmm, root, virtual_page, kAddressBits));
+			}
+		}
+		per_page_ticks += Rocinante::ReadStableCounterTicks() - start_ticks;
+		ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), free_pages_after_root);
+
+		ROCINANTE_EXPECT_TRUE(ctx, MapRange4KiB(&pmm, root, kVirtualBase, kPhysicalBase, kSizeBytes, permissions, kAddressBits));
+		start_ticks = Rocinante::ReadStableCounterTicks();
+		{
+			Cursor cursor(&pmm, root, kAddressBits);
+			for (std::size_t i = 0; i < kPageCount; i++) {
+				ROCINANTE_EXPECT_TRUE(ctx, cursor.Seek(kVirtualBase + (i * kPageSizeBytes)));
+				if (cursor.Query().has_value()) ROCINANTE_EXPECT_TRUE(ctx, cursor.Unmap());
+			}
+			ROCINANTE_EXPECT_TRUE(ctx, cursor.Flush());
+		}
+		cursor_ticks += Rocinante::ReadStableCounterTicks() - start_ticks;
+		ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), free_pages_after_root);
+	}
+
+	ROCINANTE_EXPECT_TRUE(ctx, FreeAllPageTables4KiB(&pmm, root, kAddressBits));
+
+	Rocinante::Testing::NoteU64(ctx, __FILE__, __LINE__, "query_unmap_4mib_avg_ticks_per_page_walks", per_page_ticks / kRounds);
+	Rocinante::Testing::NoteU64(ctx, __FILE__, __LINE__, "query_unmap_4mib_avg_ticks_cursor", cursor_ticks / kRounds);
+}
+
 } // namespace
 
 void TestEntry_Paging_MapTranslateUnmap(TestContext* ctx) {
@@ -592,4 +1242,32 @@ void TestEntry_Paging_Physmap_MapsRootPageTableAndAttributes(TestContext* ctx) {
 	Test_Paging_Physmap_MapsRootPageTableAndAttributes(ctx);
 }
 
+void TestEntry_Paging_HugeLeaves_MapTranslateSplitAndFree(TestContext* ctx) {
+	Test_Paging_HugeLeaves_MapTranslateSplitAndFree(ctx);
+}
+
+void TestEntry_Paging_UnmapRange_SkipsHolesAndReclaimsTables(TestContext* ctx) {
+	Test_Paging_UnmapRange_SkipsHolesAndReclaimsTables(ctx);
+}
+
+void TestEntry_Paging_Benchmark_RangeMapVersusPerPage(TestContext* ctx) {
+	Test_Paging_Benchmark_RangeMapVersusPerPage(ctx);
+}
+
+void TestEntry_Paging_Walkers_SpecializedMatchesGeneric(TestContext* ctx) {
+	Test_Paging_Walkers_SpecializedMatchesGeneric(ctx);
+}
+
+void TestEntry_Paging_Benchmark_SpecializedTranslate(TestContext* ctx) {
+	Test_Paging_Benchmark_SpecializedTranslate(ctx);
+}
+
+void TestEntry_Paging_Cursor_SequentialMapQueryUnmap(TestContext* ctx) {
+	Test_Paging_Cursor_SequentialMapQueryUnmap(ctx);
+}
+
+void TestEntry_Paging_Benchmark_CursorVersusPerPageWalk(TestContext* ctx) {
+	Test_Paging_Benchmark_CursorVersusPerPageWalk(ctx);
+}
+
 } // namespace Rocinante::Testing
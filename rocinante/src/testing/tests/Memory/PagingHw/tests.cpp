@@ -6,17 +6,24 @@
 #include <src/testing/test.h>
 
 #include <src/sp/cpucfg.h>
+#include <src/sp/cpuid.h>
+#include <src/sp/stable_counter.h>
 #include <src/trap/trap.h>
 
 #include <src/memory/boot_memory_map.h>
 #include <src/memory/address_space.h>
+#include <src/memory/asid_allocator.h>
 #include <src/memory/pmm.h>
 #include <src/memory/paging.h>
+#include <src/memory/page_table_pool.h>
 #include <src/memory/paging_hw.h>
 #include <src/memory/kernel_pager.h>
 #include <src/memory/vm_object.h>
 #include <src/memory/vma.h>
+#include <src/memory/vmm_clone.h>
 #include <src/memory/vmm_pager.h>
+#include <src/memory/vmm_populate.h>
+#include <src/memory/vmm_unmap.h>
 #include <src/memory/virtual_layout.h>
 
 #include <cstddef>
@@ -561,19 +568,21 @@ static void Test_PagingHw_AddressSpaces_SwitchPgdlChangesTranslation(TestContext
 
 	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
 
-	// Create two address spaces with different ASIDs.
-	static constexpr std::uint16_t kAsidA = 1;
-	static constexpr std::uint16_t kAsidB = 2;
+	// Create two address spaces; their ASIDs come from the allocator on first
+	// activation. Paging bring-up re-initializes the allocator later, and its
+	// first activation flushes whatever this test leaves in the TLB.
+	auto& asid_allocator = Rocinante::Memory::GetAsidAllocator();
+	asid_allocator.Initialize(Rocinante::Memory::PagingHw::GetAddressSpaceIdBits());
 
-	const auto address_space_a_or = AddressSpace::Create(&pmm, address_bits, kAsidA);
+	const auto address_space_a_or = AddressSpace::Create(&pmm, address_bits);
 	ROCINANTE_EXPECT_TRUE(ctx, address_space_a_or.has_value());
 	if (!address_space_a_or.has_value()) return;
-	const auto address_space_b_or = AddressSpace::Create(&pmm, address_bits, kAsidB);
+	const auto address_space_b_or = AddressSpace::Create(&pmm, address_bits);
 	ROCINANTE_EXPECT_TRUE(ctx, address_space_b_or.has_value());
 	if (!address_space_b_or.has_value()) return;
 
-	const AddressSpace address_space_a = address_space_a_or.value();
-	const AddressSpace address_space_b = address_space_b_or.value();
+	AddressSpace address_space_a = address_space_a_or.value();
+	AddressSpace address_space_b = address_space_b_or.value();
 
 	const PagePermissions kernel_identity_permissions{
 		.access = AccessPermissions::ReadWrite,
@@ -698,14 +707,25 @@ static void Test_PagingHw_AddressSpaces_SwitchPgdlChangesTranslation(TestContext
 	asm volatile("csrrd %0, %1" : "=r"(old_pgdl) : "i"(kCsrPgdl));
 
 	// Switch to A and observe sentinel A.
-	Rocinante::Memory::PagingHw::ActivateLowHalfAddressSpace(address_space_a.LowHalfRoot(), address_space_a.AddressSpaceId());
+	ROCINANTE_EXPECT_TRUE(ctx, address_space_a.Activate());
 	const std::uint64_t observed_a = *reinterpret_cast<volatile std::uint64_t*>(kTestVirtualPageBase);
 	ROCINANTE_EXPECT_EQ_U64(ctx, observed_a, kSentinelA);
 
 	// Switch to B and observe sentinel B.
-	Rocinante::Memory::PagingHw::ActivateLowHalfAddressSpace(address_space_b.LowHalfRoot(), address_space_b.AddressSpaceId());
+	ROCINANTE_EXPECT_TRUE(ctx, address_space_b.Activate());
 	const std::uint64_t observed_b = *reinterpret_cast<volatile std::uint64_t*>(kTestVirtualPageBase);
 	ROCINANTE_EXPECT_EQ_U64(ctx, observed_b, kSentinelB);
+	ROCINANTE_EXPECT_TRUE(ctx, address_space_a.AddressSpaceId() != address_space_b.AddressSpaceId());
+
+	// Back to A without a flush: A keeps its ASID, and the TLB entry cached
+	// for B under B's ASID must not leak into A.
+	const std::uint16_t asid_a = address_space_a.AddressSpaceId();
+	const std::uint64_t flushes_before = asid_allocator.GetStatistics().flushes;
+	ROCINANTE_EXPECT_TRUE(ctx, address_space_a.Activate());
+	ROCINANTE_EXPECT_EQ_U64(ctx, address_space_a.AddressSpaceId(), asid_a);
+	ROCINANTE_EXPECT_EQ_U64(ctx, asid_allocator.GetStatistics().flushes, flushes_before);
+	const std::uint64_t observed_a_again = *reinterpret_cast<volatile std::uint64_t*>(kTestVirtualPageBase);
+	ROCINANTE_EXPECT_EQ_U64(ctx, observed_a_again, kSentinelA);
 
 	// Restore the previous address space/root.
 	asm volatile("csrwr %0, %1" :: "r"(old_asid), "i"(kCsrAsid));
@@ -1232,6 +1252,361 @@ static void Test_PagingHw_VmmPager_MapsViaVmaAndVmObject(TestContext* ctx) {
 	ROCINANTE_EXPECT_TRUE(ctx, object.ReleaseAllOwnedFrames(&pmm));
 }
 
+static void Test_PagingHw_VmmPager_FaultAroundMapsResidentNeighbours(TestContext* ctx) {
+	// With a fault-around window, one load fault maps every neighbour that
+	// already has a frame in the VM object, and one store fault can allocate
+	// the pages after it. Fault counts come from Trap::PagingStatistics.
+	using Rocinante::Memory::AnonymousVmObject;
+	using Rocinante::Memory::VirtualMemoryArea;
+	using Rocinante::Memory::VirtualMemoryAreaSet;
+	using Rocinante::Memory::Paging::AccessPermissions;
+	using Rocinante::Memory::Paging::AddressSpaceBits;
+	using Rocinante::Memory::Paging::CacheMode;
+	using Rocinante::Memory::Paging::ExecutePermissions;
+	using Rocinante::Memory::Paging::PagePermissions;
+	using Rocinante::Memory::Paging::PageTableRoot;
+	using Rocinante::Memory::Paging::Translate;
+	using Rocinante::Memory::Paging::kPageSizeBytes;
+
+	static constexpr std::uint64_t kExceptionCodePil = 0x1;
+	static constexpr std::uint64_t kExceptionCodePis = 0x2;
+
+	if (g_paging_hw_root_page_table_physical == 0 || g_paging_hw_virtual_address_bits == 0) {
+		Rocinante::Testing::Fail(ctx, __FILE__, __LINE__, "paging not enabled / address bits not initialized");
+		return;
+	}
+	const std::size_t core_id = Rocinante::ReadCurrentProcessorCoreId();
+
+	const AddressSpaceBits address_bits{
+		.virtual_address_bits = g_paging_hw_virtual_address_bits,
+		.physical_address_bits = g_paging_hw_physical_address_bits,
+	};
+	const PageTableRoot root{.root_physical_address = g_paging_hw_root_page_table_physical};
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+
+	// A 2 MiB-aligned region no other test uses, so the VMA starts a leaf table.
+	static constexpr std::uintptr_t kVmaBase = 0x0000000280000000ull; // 10 GiB
+	static constexpr std::size_t kVmaPages = 32;
+	static constexpr std::size_t kResidentPages = 16;
+	static constexpr std::size_t kLoadFaultPage = 5;
+	static constexpr std::size_t kStoreFaultPage = 20;
+	static constexpr std::size_t kPrefaultPages = 4;
+
+	AnonymousVmObject object;
+	VirtualMemoryAreaSet areas;
+	VirtualMemoryArea vma;
+	vma.virtual_base = kVmaBase;
+	vma.virtual_limit = kVmaBase + (kVmaPages * kPageSizeBytes);
+	vma.permissions = PagePermissions{
+		.access = AccessPermissions::ReadWrite,
+		.execute = ExecutePermissions::NoExecute,
+		.cache = CacheMode::CoherentCached,
+		.global = false,
+	};
+	vma.backing_type = VirtualMemoryArea::BackingType::Anonymous;
+	vma.anonymous_object = &object;
+	vma.owns_frames = true;
+	ROCINANTE_EXPECT_TRUE(ctx, areas.Insert(&vma));
+
+	// Resident but unmapped: pages 0..15 have frames.
+	for (std::size_t i = 0; i < kResidentPages; i++) {
+		ROCINANTE_EXPECT_TRUE(ctx, object.GetOrCreateFrameForPageOffset(&pmm, i).has_value());
+		ROCINANTE_EXPECT_TRUE(ctx, !Translate(root, kVmaBase + (i * kPageSizeBytes), address_bits).has_value());
+	}
+	ROCINANTE_EXPECT_TRUE(ctx, !object.FindFrameForPageOffset(kResidentPages).has_value());
+
+	ROCINANTE_EXPECT_TRUE(ctx, !Rocinante::Memory::VmmPager::ConfigureFaultAround({.window_pages = 3}));
+	ROCINANTE_EXPECT_TRUE(ctx, Rocinante::Memory::VmmPager::ConfigureFaultAround({.window_pages = kResidentPages}));
+	Rocinante::Memory::VmmPager::ConfigureKernelVirtualMemoryAreas(&areas);
+	Rocinante::Trap::SetPagingFaultObserver(&Rocinante::Memory::VmmPager::PagingFaultObserver);
+	Rocinante::Memory::PagingHw::InvalidateNonGlobalTlbEntries();
+
+	// One load fault maps the whole resident window.
+	const auto pager_before = Rocinante::Memory::VmmPager::GetStatistics();
+	const auto faults_before = Rocinante::Trap::PagingStatisticsForCpu(core_id);
+	for (std::size_t i = 0; i < kResidentPages; i++) {
+		const std::size_t page = (kLoadFaultPage + i) % kResidentPages;
+		(void)*reinterpret_cast<const volatile std::uint64_t*>(kVmaBase + (page * kPageSizeBytes));
+	}
+	const auto faults_after_loads = Rocinante::Trap::PagingStatisticsForCpu(core_id);
+	const auto pager_after_loads = Rocinante::Memory::VmmPager::GetStatistics();
+	ROCINANTE_EXPECT_EQ_U64(ctx,
+		faults_after_loads.faults_by_exception_code[kExceptionCodePil] - faults_before.faults_by_exception_code[kExceptionCodePil], 1);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pager_after_loads.pages_mapped_around - pager_before.pages_mapped_around, kResidentPages - 1);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pager_after_loads.pages_prefaulted - pager_before.pages_prefaulted, 0);
+	ROCINANTE_EXPECT_TRUE(ctx, !Translate(root, kVmaBase + (kResidentPages * kPageSizeBytes), address_bits).has_value());
+
+	// A store fault outside the resident window allocates the next pages too.
+	ROCINANTE_EXPECT_TRUE(ctx, Rocinante::Memory::VmmPager::ConfigureFaultAround({.store_prefault_pages = kPrefaultPages}));
+	const std::uint64_t store_value = 0xfa017a0d00000000ull;
+	for (std::size_t i = 0; i <= kPrefaultPages; i++) {
+		const std::uintptr_t va = kVmaBase + ((kStoreFaultPage + i) * kPageSizeBytes);
+		asm volatile("st.d %0, %1, 0" :: "r"(store_value + i), "r"(va) : "memory");
+	}
+	const auto faults_after_stores = Rocinante::Trap::PagingStatisticsForCpu(core_id);
+	const auto pager_after_stores = Rocinante::Memory::VmmPager::GetStatistics();
+
+	Rocinante::Trap::SetPagingFaultObserver(nullptr);
+	Rocinante::Memory::VmmPager::ConfigureKernelVirtualMemoryAreas(nullptr);
+	(void)Rocinante::Memory::VmmPager::ConfigureFaultAround({});
+
+	ROCINANTE_EXPECT_EQ_U64(ctx,
+		faults_after_stores.faults_by_exception_code[kExceptionCodePis] - faults_after_loads.faults_by_exception_code[kExceptionCodePis], 1);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pager_after_stores.pages_prefaulted - pager_after_loads.pages_prefaulted, kPrefaultPages);
+	ROCINANTE_EXPECT_EQ_U64(ctx, object.PageCount(), kResidentPages + kPrefaultPages + 1);
+	for (std::size_t i = 0; i <= kPrefaultPages; i++) {
+		const auto* p = reinterpret_cast<const volatile std::uint64_t*>(kVmaBase + ((kStoreFaultPage + i) * kPageSizeBytes));
+		ROCINANTE_EXPECT_EQ_U64(ctx, *p, store_value + i);
+	}
+	ROCINANTE_EXPECT_TRUE(ctx,
+		!Translate(root, kVmaBase + ((kStoreFaultPage + kPrefaultPages + 1) * kPageSizeBytes), address_bits).has_value());
+
+	ROCINANTE_EXPECT_TRUE(ctx, Rocinante::Memory::Paging::UnmapRange(
+		&pmm, root, kVmaBase, kVmaPages * kPageSizeBytes, address_bits));
+	Rocinante::Memory::PagingHw::InvalidateNonGlobalTlbEntries();
+	ROCINANTE_EXPECT_TRUE(ctx, object.ReleaseAllOwnedFrames(&pmm));
+}
+
+static void Test_PagingHw_VmmPager_SharedZeroPageUntilFirstStore(TestContext* ctx) {
+	// With the shared zero page enabled, load faults on never-written pages map
+	// one read-only zero frame; the first store raises PME and the observer
+	// gives that page its own zeroed frame.
+	using Rocinante::Memory::AnonymousVmObject;
+	using Rocinante::Memory::VirtualMemoryArea;
+	using Rocinante::Memory::VirtualMemoryAreaSet;
+	using Rocinante::Memory::Paging::AccessPermissions;
+	using Rocinante::Memory::Paging::AddressSpaceBits;
+	using Rocinante::Memory::Paging::CacheMode;
+	using Rocinante::Memory::Paging::ExecutePermissions;
+	using Rocinante::Memory::Paging::PagePermissions;
+	using Rocinante::Memory::Paging::PageTableRoot;
+	using Rocinante::Memory::Paging::Translate;
+	using Rocinante::Memory::Paging::kPageSizeBytes;
+
+	static constexpr std::uint64_t kExceptionCodePil = 0x1;
+	static constexpr std::uint64_t kExceptionCodePme = 0x4;
+
+	if (g_paging_hw_root_page_table_physical == 0 || g_paging_hw_virtual_address_bits == 0) {
+		Rocinante::Testing::Fail(ctx, __FILE__, __LINE__, "paging not enabled / address bits not initialized");
+		return;
+	}
+	const std::size_t core_id = Rocinante::ReadCurrentProcessorCoreId();
+
+	const AddressSpaceBits address_bits{
+		.virtual_address_bits = g_paging_hw_virtual_address_bits,
+		.physical_address_bits = g_paging_hw_physical_address_bits,
+	};
+	const PageTableRoot root{.root_physical_address = g_paging_hw_root_page_table_physical};
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+
+	// A region no other test uses.
+	static constexpr std::uintptr_t kVmaBase = 0x00000002c0000000ull; // 11 GiB
+	static constexpr std::size_t kVmaPages = 8;
+	static constexpr std::size_t kLoadedPages = 4;
+	static constexpr std::size_t kStoredPage = 1;
+
+	AnonymousVmObject object;
+	VirtualMemoryAreaSet areas;
+	VirtualMemoryArea vma;
+	vma.virtual_base = kVmaBase;
+	vma.virtual_limit = kVmaBase + (kVmaPages * kPageSizeBytes);
+	vma.permissions = PagePermissions{
+		.access = AccessPermissions::ReadWrite,
+		.execute = ExecutePermissions::NoExecute,
+		.cache = CacheMode::CoherentCached,
+		.global = false,
+	};
+	vma.backing_type = VirtualMemoryArea::BackingType::Anonymous;
+	vma.anonymous_object = &object;
+	vma.owns_frames = true;
+	ROCINANTE_EXPECT_TRUE(ctx, areas.Insert(&vma));
+
+	ROCINANTE_EXPECT_TRUE(ctx, Rocinante::Memory::VmmPager::EnableSharedZeroPage(&pmm));
+	const auto zero_page_or = Rocinante::Memory::VmmPager::SharedZeroPage();
+	ROCINANTE_EXPECT_TRUE(ctx, zero_page_or.has_value());
+	if (!zero_page_or.has_value()) return;
+	const std::uintptr_t zero_page = zero_page_or.value();
+	const auto zero_map_count_before = pmm.MapCountForPhysical(zero_page);
+	ROCINANTE_EXPECT_TRUE(ctx, zero_map_count_before.has_value());
+	if (!zero_map_count_before.has_value()) return;
+
+	Rocinante::Memory::VmmPager::ConfigureKernelVirtualMemoryAreas(&areas);
+	Rocinante::Trap::SetPagingFaultObserver(&Rocinante::Memory::VmmPager::PagingFaultObserver);
+	Rocinante::Memory::PagingHw::InvalidateNonGlobalTlbEntries();
+
+	// Loads read zeros without giving the object any frames.
+	const auto pager_before = Rocinante::Memory::VmmPager::GetStatistics();
+	const auto faults_before = Rocinante::Trap::PagingStatisticsForCpu(core_id);
+	for (std::size_t i = 0; i < kLoadedPages; i++) {
+		const auto* p = reinterpret_cast<const volatile std::uint64_t*>(kVmaBase + (i * kPageSizeBytes));
+		ROCINANTE_EXPECT_EQ_U64(ctx, *p, 0);
+	}
+	const auto faults_after_loads = Rocinante::Trap::PagingStatisticsForCpu(core_id);
+	const auto pager_after_loads = Rocinante::Memory::VmmPager::GetStatistics();
+
+	// One store replaces the zero page for that page only.
+	const std::uint64_t store_value = 0x2e20da9e00000001ull;
+	const std::uintptr_t stored_va = kVmaBase + (kStoredPage * kPageSizeBytes);
+	asm volatile("st.d %0, %1, 0" :: "r"(store_value), "r"(stored_va) : "memory");
+	const auto faults_after_store = Rocinante::Trap::PagingStatisticsForCpu(core_id);
+	const auto pager_after_store = Rocinante::Memory::VmmPager::GetStatistics();
+
+	Rocinante::Trap::SetPagingFaultObserver(nullptr);
+	Rocinante::Memory::VmmPager::ConfigureKernelVirtualMemoryAreas(nullptr);
+
+	ROCINANTE_EXPECT_EQ_U64(ctx,
+		faults_after_loads.faults_by_exception_code[kExceptionCodePil] - faults_before.faults_by_exception_code[kExceptionCodePil], kLoadedPages);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pager_after_loads.zero_page_maps - pager_before.zero_page_maps, kLoadedPages);
+	ROCINANTE_EXPECT_EQ_U64(ctx,
+		faults_after_store.faults_by_exception_code[kExceptionCodePme] - faults_after_loads.faults_by_exception_code[kExceptionCodePme], 1);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pager_after_store.zero_page_replacements - pager_after_loads.zero_page_replacements, 1);
+	ROCINANTE_EXPECT_EQ_U64(ctx, object.PageCount(), 1);
+
+	const auto stored_physical = Translate(root, stored_va, address_bits);
+	ROCINANTE_EXPECT_TRUE(ctx, stored_physical.has_value() && stored_physical.value() != zero_page);
+	ROCINANTE_EXPECT_EQ_U64(ctx, *reinterpret_cast<const volatile std::uint64_t*>(stored_va), store_value);
+	ROCINANTE_EXPECT_EQ_U64(ctx, *reinterpret_cast<const volatile std::uint64_t*>(stored_va + 8), 0);
+	for (std::size_t i = 0; i < kLoadedPages; i++) {
+		if (i == kStoredPage) continue;
+		const auto physical = Translate(root, kVmaBase + (i * kPageSizeBytes), address_bits);
+		ROCINANTE_EXPECT_TRUE(ctx, physical.has_value() && physical.value() == zero_page);
+	}
+	const auto zero_map_count_after = pmm.MapCountForPhysical(zero_page);
+	ROCINANTE_EXPECT_TRUE(ctx, zero_map_count_after.has_value() &&
+		zero_map_count_after.value() == zero_map_count_before.value() + kLoadedPages - 1);
+
+	// The zero page stays while anything maps it.
+	ROCINANTE_EXPECT_TRUE(ctx, !Rocinante::Memory::VmmPager::DisableSharedZeroPage(&pmm));
+	ROCINANTE_EXPECT_TRUE(ctx, Rocinante::Memory::Paging::UnmapRange(
+		&pmm, root, kVmaBase, kVmaPages * kPageSizeBytes, address_bits));
+	Rocinante::Memory::PagingHw::InvalidateNonGlobalTlbEntries();
+	ROCINANTE_EXPECT_TRUE(ctx, object.ReleaseAllOwnedFrames(&pmm));
+	ROCINANTE_EXPECT_TRUE(ctx, Rocinante::Memory::VmmPager::DisableSharedZeroPage(&pmm));
+	ROCINANTE_EXPECT_TRUE(ctx, !Rocinante::Memory::VmmPager::SharedZeroPage().has_value());
+}
+
+static void Test_PagingHw_VmmPager_CopyOnWriteAfterClone(TestContext* ctx) {
+	// A cloned VMA reads the source's data through the same frames; the first
+	// store on one side copies the frame (PME), and the other side's later
+	// store reuses the frame it is now the only owner of.
+	using Rocinante::Memory::AnonymousVmObject;
+	using Rocinante::Memory::VirtualMemoryArea;
+	using Rocinante::Memory::VirtualMemoryAreaSet;
+	using Rocinante::Memory::Paging::AccessPermissions;
+	using Rocinante::Memory::Paging::AddressSpaceBits;
+	using Rocinante::Memory::Paging::CacheMode;
+	using Rocinante::Memory::Paging::ExecutePermissions;
+	using Rocinante::Memory::Paging::PagePermissions;
+	using Rocinante::Memory::Paging::PageTableRoot;
+	using Rocinante::Memory::Paging::Translate;
+	using Rocinante::Memory::Paging::kPageSizeBytes;
+
+	static constexpr std::uint64_t kExceptionCodePil = 0x1;
+	static constexpr std::uint64_t kExceptionCodePme = 0x4;
+
+	if (g_paging_hw_root_page_table_physical == 0 || g_paging_hw_virtual_address_bits == 0) {
+		Rocinante::Testing::Fail(ctx, __FILE__, __LINE__, "paging not enabled / address bits not initialized");
+		return;
+	}
+	const std::size_t core_id = Rocinante::ReadCurrentProcessorCoreId();
+
+	const AddressSpaceBits address_bits{
+		.virtual_address_bits = g_paging_hw_virtual_address_bits,
+		.physical_address_bits = g_paging_hw_physical_address_bits,
+	};
+	const PageTableRoot root{.root_physical_address = g_paging_hw_root_page_table_physical};
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+
+	// Two regions no other test uses, in the same page table.
+	static constexpr std::uintptr_t kSourceBase = 0x0000000300000000ull; // 12 GiB
+	static constexpr std::uintptr_t kCloneBase = 0x0000000340000000ull;  // 13 GiB
+	static constexpr std::size_t kVmaPages = 4;
+	static constexpr std::size_t kStoredPage = 0;
+	static constexpr std::uint64_t kPattern = 0xc0e0c0e000000000ull;
+
+	const PagePermissions permissions{
+		.access = AccessPermissions::ReadWrite,
+		.execute = ExecutePermissions::NoExecute,
+		.cache = CacheMode::CoherentCached,
+		.global = false,
+	};
+
+	AnonymousVmObject source_object;
+	AnonymousVmObject clone_object;
+	VirtualMemoryAreaSet areas;
+	VirtualMemoryArea source_vma;
+	source_vma.virtual_base = kSourceBase;
+	source_vma.virtual_limit = kSourceBase + (kVmaPages * kPageSizeBytes);
+	source_vma.permissions = permissions;
+	source_vma.backing_type = VirtualMemoryArea::BackingType::Anonymous;
+	source_vma.anonymous_object = &source_object;
+	source_vma.owns_frames = true;
+	VirtualMemoryArea clone_vma = source_vma;
+	clone_vma.virtual_base = kCloneBase;
+	clone_vma.virtual_limit = kCloneBase + (kVmaPages * kPageSizeBytes);
+	clone_vma.anonymous_object = &clone_object;
+	ROCINANTE_EXPECT_TRUE(ctx, areas.Insert(&source_vma));
+	ROCINANTE_EXPECT_TRUE(ctx, areas.Insert(&clone_vma));
+
+	const auto populated_or = Rocinante::Memory::VmmPopulate::PopulateVma4KiB(&pmm, root, source_vma);
+	ROCINANTE_EXPECT_TRUE(ctx, populated_or.has_value() && populated_or.value().complete);
+	Rocinante::Memory::PagingHw::InvalidateNonGlobalTlbEntries();
+	for (std::size_t i = 0; i < kVmaPages; i++) {
+		*reinterpret_cast<volatile std::uint64_t*>(kSourceBase + (i * kPageSizeBytes)) = kPattern + i;
+	}
+
+	ROCINANTE_EXPECT_TRUE(ctx, Rocinante::Memory::VmmClone::CloneVma4KiB(&pmm, root, source_vma, root, clone_vma));
+	// The source's pages were write-protected.
+	Rocinante::Memory::PagingHw::InvalidateNonGlobalTlbEntries();
+
+	Rocinante::Memory::VmmPager::ConfigureKernelVirtualMemoryAreas(&areas);
+	Rocinante::Trap::SetPagingFaultObserver(&Rocinante::Memory::VmmPager::PagingFaultObserver);
+
+	// The clone reads the source's data without a page-invalid fault.
+	const auto pager_before = Rocinante::Memory::VmmPager::GetStatistics();
+	const auto faults_before = Rocinante::Trap::PagingStatisticsForCpu(core_id);
+	for (std::size_t i = 0; i < kVmaPages; i++) {
+		const auto* p = reinterpret_cast<const volatile std::uint64_t*>(kCloneBase + (i * kPageSizeBytes));
+		ROCINANTE_EXPECT_EQ_U64(ctx, *p, kPattern + i);
+	}
+
+	// The source's store copies; the clone's store then reuses.
+	const std::uintptr_t source_va = kSourceBase + (kStoredPage * kPageSizeBytes);
+	const std::uintptr_t clone_va = kCloneBase + (kStoredPage * kPageSizeBytes);
+	asm volatile("st.d %0, %1, 0" :: "r"(kPattern + 0x100), "r"(source_va) : "memory");
+	asm volatile("st.d %0, %1, 0" :: "r"(kPattern + 0x200), "r"(clone_va) : "memory");
+	const auto faults_after = Rocinante::Trap::PagingStatisticsForCpu(core_id);
+	const auto pager_after = Rocinante::Memory::VmmPager::GetStatistics();
+
+	Rocinante::Trap::SetPagingFaultObserver(nullptr);
+	Rocinante::Memory::VmmPager::ConfigureKernelVirtualMemoryAreas(nullptr);
+
+	ROCINANTE_EXPECT_EQ_U64(ctx,
+		faults_after.faults_by_exception_code[kExceptionCodePil] - faults_before.faults_by_exception_code[kExceptionCodePil], 0);
+	ROCINANTE_EXPECT_EQ_U64(ctx,
+		faults_after.faults_by_exception_code[kExceptionCodePme] - faults_before.faults_by_exception_code[kExceptionCodePme], 2);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pager_after.copy_on_write_copies - pager_before.copy_on_write_copies, 1);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pager_after.copy_on_write_reuses - pager_before.copy_on_write_reuses, 1);
+
+	ROCINANTE_EXPECT_EQ_U64(ctx, *reinterpret_cast<const volatile std::uint64_t*>(source_va), kPattern + 0x100);
+	ROCINANTE_EXPECT_EQ_U64(ctx, *reinterpret_cast<const volatile std::uint64_t*>(clone_va), kPattern + 0x200);
+	const auto source_physical = Translate(root, source_va, address_bits);
+	const auto clone_physical = Translate(root, clone_va, address_bits);
+	ROCINANTE_EXPECT_TRUE(ctx, source_physical.has_value() && clone_physical.has_value() &&
+		source_physical.value() != clone_physical.value());
+	for (std::size_t i = 0; i < kVmaPages; i++) {
+		if (i == kStoredPage) continue;
+		const auto frame_or = source_object.FindFrameForPageOffset(i);
+		ROCINANTE_EXPECT_TRUE(ctx, frame_or.has_value() && AnonymousVmObject::IsFrameShared(&pmm, frame_or.value()));
+	}
+
+	ROCINANTE_EXPECT_TRUE(ctx, Rocinante::Memory::VmmUnmap::UnmapVma4KiB(&pmm, root, clone_vma));
+	ROCINANTE_EXPECT_TRUE(ctx, Rocinante::Memory::VmmUnmap::UnmapVma4KiB(&pmm, root, source_vma));
+	Rocinante::Memory::PagingHw::InvalidateNonGlobalTlbEntries();
+	ROCINANTE_EXPECT_TRUE(ctx, clone_object.IsEmpty());
+	ROCINANTE_EXPECT_TRUE(ctx, source_object.IsEmpty());
+}
+
 static void Test_PagingHw_ReadOnlyStore_RaisesPme(TestContext* ctx) {
 	// This test runs after paging has been enabled.
 	// It maps a page with D=0 (no-dirty / no-write) and asserts that a store
@@ -1580,6 +1955,349 @@ nx_resume:
 	Rocinante::Memory::PagingHw::InvalidateGlobalTlbEntries();
 	Rocinante::Memory::PagingHw::InvalidateNonGlobalTlbEntries();
 }
+
+// TLB refill handler probes: kTlbRefillProbePageCount 4 KiB pages in the low
+// half of the smoke test's root, each backed by its own frame that holds
+// TlbRefillProbeTag(i). They are non-global, so INVTLB op=0x3 drops exactly
+// these entries and leaves the kernel's global ones.
+static constexpr std::uintptr_t kTlbRefillProbeVirtualBase = 0x0000000200000000ull; // 8 GiB
+static constexpr std::size_t kTlbRefillProbePageCount = 64;
+
+// Frames behind the probe pages while a test has them mapped.
+static std::uintptr_t g_tlb_refill_probe_frames[kTlbRefillProbePageCount] = {};
+static std::size_t g_tlb_refill_probe_frame_count = 0;
+
+static constexpr std::uint64_t TlbRefillProbeTag(std::size_t page_index) {
+	return 0x7162000000000000ull | page_index;
+}
+
+// Unmaps the probe pages and returns their frames (and any emptied tables)
+// once the probe TLB entries are gone.
+static void ReleaseTlbRefillProbeMappings() {
+	const Rocinante::Memory::Paging::AddressSpaceBits address_bits{
+		.virtual_address_bits = g_paging_hw_virtual_address_bits,
+		.physical_address_bits = g_paging_hw_physical_address_bits,
+	};
+	const Rocinante::Memory::Paging::PageTableRoot root{.root_physical_address = g_paging_hw_root_page_table_physical};
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+
+	Rocinante::Memory::PageTablePagePool::DeferredBatch table_batch(Rocinante::Memory::GetPageTablePagePool());
+	for (std::size_t i = 0; i < g_tlb_refill_probe_frame_count; i++) {
+		(void)Rocinante::Memory::Paging::UnmapPage4KiB(
+			&pmm, root, kTlbRefillProbeVirtualBase + (i * Rocinante::Memory::Paging::kPageSizeBytes), address_bits);
+	}
+	Rocinante::Memory::PagingHw::InvalidateNonGlobalTlbEntries();
+	(void)table_batch.Reclaim();
+
+	for (std::size_t i = 0; i < g_tlb_refill_probe_frame_count; i++) {
+		(void)pmm.FreePage(g_tlb_refill_probe_frames[i]);
+	}
+	g_tlb_refill_probe_frame_count = 0;
+}
+
+// Maps the probe pages; the caller releases them with
+// ReleaseTlbRefillProbeMappings() before it returns.
+static bool MapTlbRefillProbeMappings(TestContext* ctx) {
+	using Rocinante::Memory::Paging::AccessPermissions;
+	using Rocinante::Memory::Paging::AddressSpaceBits;
+	using Rocinante::Memory::Paging::CacheMode;
+	using Rocinante::Memory::Paging::ExecutePermissions;
+	using Rocinante::Memory::Paging::PagePermissions;
+	using Rocinante::Memory::Paging::PageTableRoot;
+
+	if (g_paging_hw_root_page_table_physical == 0 || g_paging_hw_virtual_address_bits == 0) {
+		Rocinante::Testing::Fail(ctx, __FILE__, __LINE__, "paging not enabled / address bits not initialized");
+		return false;
+	}
+
+	const AddressSpaceBits address_bits{
+		.virtual_address_bits = g_paging_hw_virtual_address_bits,
+		.physical_address_bits = g_paging_hw_physical_address_bits,
+	};
+	const PageTableRoot root{.root_physical_address = g_paging_hw_root_page_table_physical};
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+
+	const PagePermissions permissions{
+		.access = AccessPermissions::ReadOnly,
+		.execute = ExecutePermissions::NoExecute,
+		.cache = CacheMode::CoherentCached,
+		.global = false,
+	};
+
+	for (std::size_t i = 0; i < kTlbRefillProbePageCount; i++) {
+		const auto page_or = pmm.AllocatePage();
+		ROCINANTE_EXPECT_TRUE(ctx, page_or.has_value());
+		if (!page_or.has_value()) {
+			ReleaseTlbRefillProbeMappings();
+			return false;
+		}
+
+		// Mapped mode: write the frame through the physmap.
+		*reinterpret_cast<volatile std::uint64_t*>(Rocinante::Memory::VirtualLayout::ToPhysMapVirtual(
+			page_or.value(), address_bits.virtual_address_bits)) = TlbRefillProbeTag(i);
+
+		const bool mapped = Rocinante::Memory::Paging::MapPage4KiB(
+			&pmm,
+			root,
+			kTlbRefillProbeVirtualBase + (i * Rocinante::Memory::Paging::kPageSizeBytes),
+			page_or.value(),
+			permissions,
+			address_bits);
+		ROCINANTE_EXPECT_TRUE(ctx, mapped);
+		if (!mapped) {
+			(void)pmm.FreePage(page_or.value());
+			ReleaseTlbRefillProbeMappings();
+			return false;
+		}
+		g_tlb_refill_probe_frames[g_tlb_refill_probe_frame_count++] = page_or.value();
+	}
+	return true;
+}
+
+// Installs `handler`, returning false if this CPU cannot run it.
+static bool InstallTlbRefillHandlerForTest(Rocinante::Trap::TlbRefillHandler handler) {
+	if (handler == Rocinante::Trap::TlbRefillHandler::SoftwareWalk) {
+		Rocinante::Trap::InstallSoftwareWalkTlbRefillHandler();
+		return true;
+	}
+
+	const auto config_or = Rocinante::Memory::PagingHw::Make4KiBPageWalkerConfig(Rocinante::Memory::Paging::AddressSpaceBits{
+		.virtual_address_bits = g_paging_hw_virtual_address_bits,
+		.physical_address_bits = g_paging_hw_physical_address_bits,
+	});
+	if (!config_or.has_value()) return false;
+	return Rocinante::Trap::InstallLddirTlbRefillHandler(
+		Rocinante::Memory::PagingHw::DirectoryLevelCount(config_or.value()));
+}
+
+static void RestoreTlbRefillHandlerForTest(Rocinante::Trap::TlbRefillHandler handler) {
+	if (!InstallTlbRefillHandlerForTest(handler)) Rocinante::Trap::InstallSoftwareWalkTlbRefillHandler();
+	Rocinante::Memory::PagingHw::InvalidateNonGlobalTlbEntries();
+}
+
+static void Test_PagingHw_TlbRefill_LddirMatchesSoftwareWalk(TestContext* ctx) {
+	using Rocinante::Memory::Paging::AccessPermissions;
+	using Rocinante::Memory::Paging::AddressSpaceBits;
+	using Rocinante::Memory::Paging::CacheMode;
+	using Rocinante::Memory::Paging::ExecutePermissions;
+	using Rocinante::Memory::Paging::PagePermissions;
+	using Rocinante::Memory::Paging::PageTableRoot;
+	using Rocinante::Memory::Paging::kHugePageSizeBytes2MiB;
+	using Rocinante::Trap::TlbRefillHandler;
+
+	// The LDDIR/LDPTE refill entry must install the same translations as the
+	// software walk: every probe page (both halves of each dual-page entry) and
+	// both halves of a huge leaf.
+	if (!Rocinante::GetCPUCFG().SupportsSoftwarePageTableWalkInstruction()) {
+		Rocinante::Testing::Note(ctx, __FILE__, __LINE__, "CPUCFG.2.LSPW=0; LDDIR/LDPTE refill not available");
+		return;
+	}
+	if (!MapTlbRefillProbeMappings(ctx)) return;
+
+	const AddressSpaceBits address_bits{
+		.virtual_address_bits = g_paging_hw_virtual_address_bits,
+		.physical_address_bits = g_paging_hw_physical_address_bits,
+	};
+	const PageTableRoot root{.root_physical_address = g_paging_hw_root_page_table_physical};
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+
+	// A 2 MiB alias of the start of the smoke test's PMM pool, compared
+	// against the physmap. MapRange() makes it a huge leaf when CPUCFG reports
+	// huge-page support. Unmapped again below, so the pool's map counts are
+	// left as they were.
+	static constexpr std::uintptr_t kHugeVirtualBase = 0x0000000240000000ull; // 9 GiB
+	static constexpr std::uintptr_t kHugePhysicalBase = 0x01000000; // 16 MiB
+	static_assert((kHugeVirtualBase % kHugePageSizeBytes2MiB) == 0);
+	static_assert((kHugePhysicalBase % kHugePageSizeBytes2MiB) == 0);
+	static constexpr std::size_t kHugeProbeOffsets[] = {
+		0,
+		(kHugePageSizeBytes2MiB / 2) - sizeof(std::uint64_t),
+		kHugePageSizeBytes2MiB / 2,
+		kHugePageSizeBytes2MiB - sizeof(std::uint64_t),
+	};
+	const bool huge_mapped = Rocinante::Memory::Paging::MapRange(
+		&pmm,
+		root,
+		kHugeVirtualBase,
+		kHugePhysicalBase,
+		kHugePageSizeBytes2MiB,
+		PagePermissions{
+			.access = AccessPermissions::ReadOnly,
+			.execute = ExecutePermissions::NoExecute,
+			.cache = CacheMode::CoherentCached,
+			.global = false,
+		},
+		address_bits);
+	ROCINANTE_EXPECT_TRUE(ctx, huge_mapped);
+	if (!huge_mapped) {
+		ReleaseTlbRefillProbeMappings();
+		return;
+	}
+	const std::uintptr_t huge_physmap_base =
+		Rocinante::Memory::VirtualLayout::ToPhysMapVirtual(kHugePhysicalBase, address_bits.virtual_address_bits);
+
+	const TlbRefillHandler previous = Rocinante::Trap::InstalledTlbRefillHandler();
+	for (const TlbRefillHandler handler : {TlbRefillHandler::SoftwareWalk, TlbRefillHandler::Lddir}) {
+		const bool installed = InstallTlbRefillHandlerForTest(handler);
+		ROCINANTE_EXPECT_TRUE(ctx, installed);
+		if (!installed) break;
+		ROCINANTE_EXPECT_TRUE(ctx, Rocinante::Trap::InstalledTlbRefillHandler() == handler);
+		Rocinante::Memory::PagingHw::InvalidateNonGlobalTlbEntries();
+
+		for (std::size_t i = 0; i < kTlbRefillProbePageCount; i++) {
+			const auto* page = reinterpret_cast<const volatile std::uint64_t*>(
+				kTlbRefillProbeVirtualBase + (i * Rocinante::Memory::Paging::kPageSizeBytes));
+			ROCINANTE_EXPECT_EQ_U64(ctx, *page, TlbRefillProbeTag(i));
+		}
+		for (const std::size_t offset : kHugeProbeOffsets) {
+			const auto mapped = *reinterpret_cast<const volatile std::uint64_t*>(kHugeVirtualBase + offset);
+			const auto expected = *reinterpret_cast<const volatile std::uint64_t*>(huge_physmap_base + offset);
+			ROCINANTE_EXPECT_EQ_U64(ctx, mapped, expected);
+		}
+	}
+
+	ROCINANTE_EXPECT_TRUE(ctx, Rocinante::Memory::Paging::UnmapRange(
+		&pmm, root, kHugeVirtualBase, kHugePageSizeBytes2MiB, address_bits));
+	RestoreTlbRefillHandlerForTest(previous);
+	ReleaseTlbRefillProbeMappings();
+}
+
+static void Test_PagingHw_Benchmark_TlbRefillLddirVersusSoftwareWalk(TestContext* ctx) {
+	using Rocinante::Trap::TlbRefillHandler;
+
+	// Benchmark (reported, not asserted beyond correctness):
+	// Cost of a TLB refill with the software walk versus LDDIR/LDPTE. Each
+	// round drops the probe entries and touches every probe page; one refill
+	// covers an even/odd page pair.
+	if (!Rocinante::GetCPUCFG().SupportsSoftwarePageTableWalkInstruction()) {
+		Rocinante::Testing::Note(ctx, __FILE__, __LINE__, "CPUCFG.2.LSPW=0; LDDIR/LDPTE refill not available");
+		return;
+	}
+	if (!MapTlbRefillProbeMappings(ctx)) return;
+
+	static constexpr std::size_t kRounds = 64;
+	static constexpr std::size_t kRefillsPerRound = kTlbRefillProbePageCount / 2;
+
+	const TlbRefillHandler previous = Rocinante::Trap::InstalledTlbRefillHandler();
+	std::uint64_t ticks[2] = {};
+	const TlbRefillHandler handlers[2] = {TlbRefillHandler::SoftwareWalk, TlbRefillHandler::Lddir};
+	for (std::size_t h = 0; h < 2; h++) {
+		const bool installed = InstallTlbRefillHandlerForTest(handlers[h]);
+		ROCINANTE_EXPECT_TRUE(ctx, installed);
+		if (!installed) break;
+
+		std::uint64_t sum = 0;
+		for (std::size_t round = 0; round < kRounds; round++) {
+			Rocinante::Memory::PagingHw::InvalidateNonGlobalTlbEntries();
+			const std::uint64_t start_ticks = Rocinante::ReadStableCounterTicks();
+			for (std::size_t i = 0; i < kTlbRefillProbePageCount; i++) {
+				sum += *reinterpret_cast<const volatile std::uint64_t*>(
+					kTlbRefillProbeVirtualBase + (i * Rocinante::Memory::Paging::kPageSizeBytes));
+			}
+			ticks[h] += Rocinante::ReadStableCounterTicks() - start_ticks;
+		}
+
+		std::uint64_t expected_sum = 0;
+		for (std::size_t i = 0; i < kTlbRefillProbePageCount; i++) expected_sum += TlbRefillProbeTag(i);
+		ROCINANTE_EXPECT_EQ_U64(ctx, sum, expected_sum * kRounds);
+	}
+
+	RestoreTlbRefillHandlerForTest(previous);
+	ReleaseTlbRefillProbeMappings();
+
+	Rocinante::Testing::NoteU64(ctx, __FILE__, __LINE__, "refills", kRounds * kRefillsPerRound);
+	Rocinante::Testing::NoteU64(ctx, __FILE__, __LINE__, "software_walk_ticks", ticks[0]);
+	Rocinante::Testing::NoteU64(ctx, __FILE__, __LINE__, "lddir_ticks", ticks[1]);
+	Rocinante::Testing::NoteU64(ctx, __FILE__, __LINE__, "software_walk_ticks_per_refill", ticks[0] / (kRounds * kRefillsPerRound));
+	Rocinante::Testing::NoteU64(ctx, __FILE__, __LINE__, "lddir_ticks_per_refill", ticks[1] / (kRounds * kRefillsPerRound));
+}
+
+static void Test_PagingHw_PagingStatistics_CountsRefillsAndFaults(TestContext* ctx) {
+	using Rocinante::Trap::PagingStatistics;
+	using Rocinante::Trap::TlbRefillHandler;
+
+	// Both refill entries count into this CPU's statistics, and
+	// DispatchPagingFault() counts each paging exception by code and by
+	// outcome. Counters are never reset here: the harness dumps the totals
+	// for the whole run.
+	static constexpr std::uint64_t kExceptionCodePil = 0x1;
+	static constexpr std::uint64_t kExceptionCodePis = 0x2;
+	static constexpr std::size_t kRefillsPerTouch = kTlbRefillProbePageCount / 2;
+
+	if (!MapTlbRefillProbeMappings(ctx)) return;
+	const std::size_t core_id = Rocinante::ReadCurrentProcessorCoreId();
+	if (core_id >= Rocinante::kMaxCpuCount) {
+		Rocinante::Testing::Note(ctx, __FILE__, __LINE__, "core ID has no statistics slot");
+		ReleaseTlbRefillProbeMappings();
+		return;
+	}
+
+	const TlbRefillHandler previous = Rocinante::Trap::InstalledTlbRefillHandler();
+	for (const TlbRefillHandler handler : {TlbRefillHandler::SoftwareWalk, TlbRefillHandler::Lddir}) {
+		if (!InstallTlbRefillHandlerForTest(handler)) continue;
+		Rocinante::Memory::PagingHw::InvalidateNonGlobalTlbEntries();
+
+		// Other refills (for kernel pages evicted meanwhile) may land in the
+		// window too, so this is a lower bound.
+		const PagingStatistics before = Rocinante::Trap::PagingStatisticsForCpu(core_id);
+		for (std::size_t i = 0; i < kTlbRefillProbePageCount; i++) {
+			(void)*reinterpret_cast<const volatile std::uint64_t*>(
+				kTlbRefillProbeVirtualBase + (i * Rocinante::Memory::Paging::kPageSizeBytes));
+		}
+		const PagingStatistics after = Rocinante::Trap::PagingStatisticsForCpu(core_id);
+		ROCINANTE_EXPECT_TRUE(ctx, after.tlb_refills - before.tlb_refills >= kRefillsPerTouch);
+	}
+	RestoreTlbRefillHandlerForTest(previous);
+	ReleaseTlbRefillProbeMappings();
+
+	// Not handled: no observer, so the expected-trap hook consumes the PIL.
+	// The scratch-adjacent page at +1 is unmapped (see
+	// UnmappedAccess_FaultsAndReportsBadV).
+	static constexpr std::uintptr_t kUnmappedVirtualAddress =
+		kPagingHwScratchVirtualPageBase + Rocinante::Memory::Paging::kPageSizeBytes;
+	Rocinante::Trap::SetPagingFaultObserver(nullptr);
+	const PagingStatistics before_not_handled = Rocinante::Trap::PagingStatisticsForCpu(core_id);
+	ArmExpectedTrap(kExceptionCodePil);
+	std::uint64_t tmp = 0;
+	asm volatile("ld.d %0, %1, 0" : "=r"(tmp) : "r"(kUnmappedVirtualAddress) : "memory");
+	ROCINANTE_EXPECT_TRUE(ctx, ExpectedTrapObserved());
+	const PagingStatistics after_not_handled = Rocinante::Trap::PagingStatisticsForCpu(core_id);
+	ROCINANTE_EXPECT_EQ_U64(ctx,
+		after_not_handled.faults_by_exception_code[kExceptionCodePil] - before_not_handled.faults_by_exception_code[kExceptionCodePil], 1);
+	ROCINANTE_EXPECT_EQ_U64(ctx, after_not_handled.not_handled - before_not_handled.not_handled, 1);
+	ROCINANTE_EXPECT_EQ_U64(ctx, after_not_handled.handled - before_not_handled.handled, 0);
+
+	// Handled: the kernel pager maps a fresh page on a PIS.
+	static constexpr std::uintptr_t kLazyVirtualPageBase =
+		kPagingHwScratchVirtualPageBase + (9 * Rocinante::Memory::Paging::kPageSizeBytes);
+	Rocinante::Memory::KernelPager::ConfigureLazyMappingRegion(
+		Rocinante::Memory::KernelPager::LazyMappingRegion{
+			.virtual_base = kLazyVirtualPageBase,
+			.size_bytes = Rocinante::Memory::Paging::kPageSizeBytes,
+		}
+	);
+	Rocinante::Memory::KernelPager::Install();
+	const PagingStatistics before_handled = Rocinante::Trap::PagingStatisticsForCpu(core_id);
+	const std::uint64_t store_value = 0x5a7a000000000021ull;
+	asm volatile("st.d %0, %1, 0" :: "r"(store_value), "r"(kLazyVirtualPageBase) : "memory");
+	const PagingStatistics after_handled = Rocinante::Trap::PagingStatisticsForCpu(core_id);
+	Rocinante::Trap::SetPagingFaultObserver(nullptr);
+	Rocinante::Memory::KernelPager::ConfigureLazyMappingRegion(Rocinante::Memory::KernelPager::LazyMappingRegion{});
+
+	ROCINANTE_EXPECT_EQ_U64(ctx, *reinterpret_cast<volatile std::uint64_t*>(kLazyVirtualPageBase), store_value);
+	ROCINANTE_EXPECT_EQ_U64(ctx,
+		after_handled.faults_by_exception_code[kExceptionCodePis] - before_handled.faults_by_exception_code[kExceptionCodePis], 1);
+	ROCINANTE_EXPECT_EQ_U64(ctx, after_handled.handled - before_handled.handled, 1);
+	ROCINANTE_EXPECT_EQ_U64(ctx, after_handled.not_handled - before_handled.not_handled, 0);
+	Rocinante::Testing::NoteU64(ctx, __FILE__, __LINE__, "kernel_pager_fault_ticks",
+		after_handled.handler_ticks - before_handled.handler_ticks);
+
+	// The total covers at least this CPU.
+	const PagingStatistics total = Rocinante::Trap::PagingStatisticsTotal();
+	ROCINANTE_EXPECT_TRUE(ctx, total.tlb_refills >= after_handled.tlb_refills);
+	ROCINANTE_EXPECT_TRUE(ctx, total.handled >= after_handled.handled);
+}
+
 } // namespace
 
 void TestEntry_PagingHw_EnablePaging_TlbRefillSmoke(TestContext* ctx) {
@@ -1618,6 +2336,18 @@ void TestEntry_PagingHw_VmmPager_MapsViaVmaAndVmObject(TestContext* ctx) {
 	Test_PagingHw_VmmPager_MapsViaVmaAndVmObject(ctx);
 }
 
+void TestEntry_PagingHw_VmmPager_FaultAroundMapsResidentNeighbours(TestContext* ctx) {
+	Test_PagingHw_VmmPager_FaultAroundMapsResidentNeighbours(ctx);
+}
+
+void TestEntry_PagingHw_VmmPager_SharedZeroPageUntilFirstStore(TestContext* ctx) {
+	Test_PagingHw_VmmPager_SharedZeroPageUntilFirstStore(ctx);
+}
+
+void TestEntry_PagingHw_VmmPager_CopyOnWriteAfterClone(TestContext* ctx) {
+	Test_PagingHw_VmmPager_CopyOnWriteAfterClone(ctx);
+}
+
 void TestEntry_PagingHw_ReadOnlyStore_RaisesPme(TestContext* ctx) {
 	Test_PagingHw_ReadOnlyStore_RaisesPme(ctx);
 }
@@ -1626,4 +2356,16 @@ void TestEntry_PagingHw_NonExecutableFetch_RaisesPnx(TestContext* ctx) {
 	Test_PagingHw_NonExecutableFetch_RaisesPnx(ctx);
 }
 
+void TestEntry_PagingHw_TlbRefill_LddirMatchesSoftwareWalk(TestContext* ctx) {
+	Test_PagingHw_TlbRefill_LddirMatchesSoftwareWalk(ctx);
+}
+
+void TestEntry_PagingHw_Benchmark_TlbRefillLddirVersusSoftwareWalk(TestContext* ctx) {
+	Test_PagingHw_Benchmark_TlbRefillLddirVersusSoftwareWalk(ctx);
+}
+
+void TestEntry_PagingHw_PagingStatistics_CountsRefillsAndFaults(TestContext* ctx) {
+	Test_PagingHw_PagingStatistics_CountsRefillsAndFaults(ctx);
+}
+
 } // namespace Rocinante::Testing
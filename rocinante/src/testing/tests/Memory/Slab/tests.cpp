@@ -0,0 +1,201 @@
+/**
+ * Copyright (C) 2026 Andrew S. Rightenburg
+ * GPL-3.0-or-later
+ */
+
+#include <src/testing/scratch_pmm.h>
+#include <src/testing/test.h>
+
+#include <src/memory/heap.h>
+#include <src/memory/pmm.h>
+#include <src/memory/slab.h>
+#include <src/sp/stable_counter.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Rocinante::Testing {
+
+namespace {
+
+// A test-private slab allocator.
+//
+// The kernel singleton (GetSlabAllocator()) must stay unbound during the test
+// run so Heap::Alloc() keeps using the boundary-tag path, and because other
+// tests re-initialize the global PMM underneath it.
+static Rocinante::Memory::SlabAllocator g_test_slabs;
+
+static bool InitializePmmForSlabTest(TestContext* ctx) {
+	if (!InitializeScratchPmm(ctx, 8u * 1024u * 1024u)) return false;
+
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+	g_test_slabs.Initialize(&pmm);
+	return true;
+}
+
+static void Test_Slab_AllocateFreeReusesSlots(TestContext* ctx) {
+	using Rocinante::Memory::SlabAllocator;
+
+	if (!InitializePmmForSlabTest(ctx)) return;
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+	const std::size_t pmm_free_before = pmm.FreePages();
+
+	// 40 bytes rounds up to the 48-byte class.
+	static constexpr std::size_t kClass48 = 2;
+	ROCINANTE_EXPECT_EQ_U64(ctx, SlabAllocator::SizeClassObjectSize(kClass48), 48);
+	const std::size_t capacity = (SlabAllocator::kSlabSizeBytes - 64) / 48;
+
+	void* objects[3] = {};
+	for (std::size_t i = 0; i < 3; i++) {
+		objects[i] = g_test_slabs.Allocate(40);
+		ROCINANTE_EXPECT_TRUE(ctx, objects[i] != nullptr);
+		if (!objects[i]) return;
+		ROCINANTE_EXPECT_EQ_U64(ctx, reinterpret_cast<std::uintptr_t>(objects[i]) % SlabAllocator::kObjectAlignmentBytes, 0);
+		ROCINANTE_EXPECT_TRUE(ctx, g_test_slabs.Owns(objects[i]));
+	}
+	ROCINANTE_EXPECT_TRUE(ctx, objects[0] != objects[1] && objects[1] != objects[2]);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), pmm_free_before - 1);
+
+	auto stats = g_test_slabs.StatisticsForSizeClass(kClass48);
+	ROCINANTE_EXPECT_EQ_U64(ctx, stats.objects_in_use, 3);
+	ROCINANTE_EXPECT_EQ_U64(ctx, stats.objects_free, capacity - 3);
+	ROCINANTE_EXPECT_EQ_U64(ctx, stats.slab_count, 1);
+
+	// LIFO: a freed slot is the next one handed out.
+	ROCINANTE_EXPECT_TRUE(ctx, g_test_slabs.Free(objects[1]));
+	void* reused = g_test_slabs.Allocate(48);
+	ROCINANTE_EXPECT_TRUE(ctx, reused == objects[1]);
+
+	for (std::size_t i = 0; i < 3; i++) {
+		ROCINANTE_EXPECT_TRUE(ctx, g_test_slabs.Free(objects[i]));
+	}
+	stats = g_test_slabs.StatisticsForSizeClass(kClass48);
+	ROCINANTE_EXPECT_EQ_U64(ctx, stats.objects_in_use, 0);
+
+	// The class's only slab is kept even when empty; ReleaseEmptySlabs() hands
+	// it back.
+	ROCINANTE_EXPECT_EQ_U64(ctx, stats.slab_count, 1);
+	g_test_slabs.ReleaseEmptySlabs();
+	ROCINANTE_EXPECT_EQ_U64(ctx, g_test_slabs.StatisticsForSizeClass(kClass48).slab_count, 0);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), pmm_free_before);
+
+	// Size limits.
+	ROCINANTE_EXPECT_TRUE(ctx, g_test_slabs.Allocate(SlabAllocator::kMaxObjectSizeBytes + 1) == nullptr);
+	void* smallest = g_test_slabs.Allocate(0);
+	ROCINANTE_EXPECT_TRUE(ctx, smallest != nullptr);
+	ROCINANTE_EXPECT_EQ_U64(ctx, g_test_slabs.StatisticsForSizeClass(0).objects_in_use, 1);
+	ROCINANTE_EXPECT_TRUE(ctx, g_test_slabs.Free(smallest));
+	g_test_slabs.ReleaseEmptySlabs();
+	ROCINANTE_EXPECT_TRUE(ctx, SlabAllocator::Handles(SlabAllocator::kMaxObjectSizeBytes, 16));
+	ROCINANTE_EXPECT_TRUE(ctx, !SlabAllocator::Handles(SlabAllocator::kMaxObjectSizeBytes + 1, 16));
+	ROCINANTE_EXPECT_TRUE(ctx, !SlabAllocator::Handles(64, 64));
+}
+
+static void Test_Slab_GrowsReleasesAndRejectsForeignPointers(TestContext* ctx) {
+	using Rocinante::Memory::SlabAllocator;
+
+	if (!InitializePmmForSlabTest(ctx)) return;
+	auto& pmm = Rocinante::Memory::GetPhysicalMemoryManager();
+	const std::size_t pmm_free_before = pmm.FreePages();
+
+	// 1024-byte objects fit three to a slab, so seven need three slabs.
+	static constexpr std::size_t kClass1024 = SlabAllocator::kSizeClassCount - 1;
+	static constexpr std::size_t kObjectCount = 7;
+	void* objects[kObjectCount] = {};
+	for (std::size_t i = 0; i < kObjectCount; i++) {
+		objects[i] = g_test_slabs.Allocate(1000);
+		ROCINANTE_EXPECT_TRUE(ctx, objects[i] != nullptr);
+		if (!objects[i]) return;
+
+		// Touch the whole object to catch overlapping slots.
+		auto* bytes = static_cast<std::uint8_t*>(objects[i]);
+		for (std::size_t b = 0; b < 1024; b++) bytes[b] = static_cast<std::uint8_t>(i);
+	}
+	for (std::size_t i = 0; i < kObjectCount; i++) {
+		const auto* bytes = static_cast<const std::uint8_t*>(objects[i]);
+		ROCINANTE_EXPECT_EQ_U64(ctx, bytes[1023], i);
+	}
+	ROCINANTE_EXPECT_EQ_U64(ctx, g_test_slabs.StatisticsForSizeClass(kClass1024).slab_count, 3);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), pmm_free_before - 3);
+
+	// Pointers that are not slot starts, or not in a slab at all, are rejected.
+	ROCINANTE_EXPECT_TRUE(ctx, !g_test_slabs.Free(static_cast<std::uint8_t*>(objects[0]) + 16));
+	ROCINANTE_EXPECT_TRUE(ctx, !g_test_slabs.Free(reinterpret_cast<void*>(reinterpret_cast<std::uintptr_t>(objects[0]) & ~std::uintptr_t{4095})));
+	const auto foreign_page_or = pmm.AllocatePage();
+	ROCINANTE_EXPECT_TRUE(ctx, foreign_page_or.has_value());
+	if (foreign_page_or.has_value()) {
+		ROCINANTE_EXPECT_TRUE(ctx, !g_test_slabs.Owns(reinterpret_cast<void*>(foreign_page_or.value() + 64)));
+		ROCINANTE_EXPECT_TRUE(ctx, pmm.FreePage(foreign_page_or.value()));
+	}
+	ROCINANTE_EXPECT_EQ_U64(ctx, g_test_slabs.StatisticsForSizeClass(kClass1024).objects_in_use, kObjectCount);
+
+	// Emptied slabs go back to the PMM as they drain, except the last one.
+	for (std::size_t i = 0; i < kObjectCount; i++) {
+		ROCINANTE_EXPECT_TRUE(ctx, g_test_slabs.Free(objects[i]));
+	}
+	ROCINANTE_EXPECT_EQ_U64(ctx, g_test_slabs.StatisticsForSizeClass(kClass1024).slab_count, 1);
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), pmm_free_before - 1);
+	g_test_slabs.ReleaseEmptySlabs();
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), pmm_free_before);
+}
+
+static void Test_Slab_Benchmark_SmallObjectLatencyVersusHeap(TestContext* ctx) {
+	// Benchmark (reported, not asserted):
+	// Average alloc+free cost of a 200-byte object from the slab layer versus
+	// the boundary-tag heap, with the heap fragmented into small holes the
+	// request does not fit in.
+	static constexpr std::size_t kHeapBufferBytes = 64u * 1024u;
+	static constexpr std::size_t kFragmentCount = 128;
+	static constexpr std::size_t kIterations = 256;
+	alignas(16) static std::uint8_t heap_buffer[kHeapBufferBytes];
+
+	if (!InitializePmmForSlabTest(ctx)) return;
+
+	// The global slab allocator is unbound, so this is the boundary-tag path.
+	Rocinante::Memory::Heap::Init(heap_buffer, sizeof(heap_buffer));
+	void* fragments[kFragmentCount * 2] = {};
+	for (std::size_t i = 0; i < kFragmentCount * 2; i++) {
+		fragments[i] = Rocinante::Memory::Heap::Alloc(32);
+		ROCINANTE_EXPECT_TRUE(ctx, fragments[i] != nullptr);
+		if (!fragments[i]) return;
+	}
+	for (std::size_t i = 0; i < kFragmentCount * 2; i += 2) {
+		Rocinante::Memory::Heap::Free(fragments[i]);
+	}
+
+	std::uint64_t start_ticks = Rocinante::ReadStableCounterTicks();
+	for (std::size_t i = 0; i < kIterations; i++) {
+		void* ptr = Rocinante::Memory::Heap::Alloc(200);
+		ROCINANTE_EXPECT_TRUE(ctx, ptr != nullptr);
+		Rocinante::Memory::Heap::Free(ptr);
+	}
+	const std::uint64_t heap_ticks = Rocinante::ReadStableCounterTicks() - start_ticks;
+
+	start_ticks = Rocinante::ReadStableCounterTicks();
+	for (std::size_t i = 0; i < kIterations; i++) {
+		void* ptr = g_test_slabs.Allocate(200);
+		ROCINANTE_EXPECT_TRUE(ctx, ptr != nullptr);
+		ROCINANTE_EXPECT_TRUE(ctx, g_test_slabs.Free(ptr));
+	}
+	const std::uint64_t slab_ticks = Rocinante::ReadStableCounterTicks() - start_ticks;
+	g_test_slabs.ReleaseEmptySlabs();
+
+	Rocinante::Testing::NoteU64(ctx, __FILE__, __LINE__, "small_alloc_free_avg_ticks_heap_fragmented", heap_ticks / kIterations);
+	Rocinante::Testing::NoteU64(ctx, __FILE__, __LINE__, "small_alloc_free_avg_ticks_slab", slab_ticks / kIterations);
+}
+
+} // namespace
+
+void TestEntry_Slab_AllocateFreeReusesSlots(TestContext* ctx) {
+	Test_Slab_AllocateFreeReusesSlots(ctx);
+}
+
+void TestEntry_Slab_GrowsReleasesAndRejectsForeignPointers(TestContext* ctx) {
+	Test_Slab_GrowsReleasesAndRejectsForeignPointers(ctx);
+}
+
+void TestEntry_Slab_Benchmark_SmallObjectLatencyVersusHeap(TestContext* ctx) {
+	Test_Slab_Benchmark_SmallObjectLatencyVersusHeap(ctx);
+}
+
+} // namespace Rocinante::Testing
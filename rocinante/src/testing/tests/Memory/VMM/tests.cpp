@@ -8,6 +8,9 @@
 #include <src/memory/boot_memory_map.h>
 #include <src/memory/pmm.h>
 #include <src/memory/paging.h>
+#include <src/memory/vmm_clone.h>
+#include <src/memory/vmm_pager.h>
+#include <src/memory/vmm_populate.h>
 #include <src/memory/vmm_unmap.h>
 #include <src/memory/vm_object.h>
 #include <src/memory/vma.h>
@@ -367,6 +370,387 @@ static void Test_VMM_UnmapVma4KiB_ReleasesAnonymousFrames(TestContext* ctx) {
 	ROCINANTE_EXPECT_TRUE(ctx, object.IsEmpty());
 }
 
+static void Test_VMM_PopulateVma4KiB_MapsEveryPageAndReportsPartial(TestContext* ctx) {
+	using Rocinante::Memory::AnonymousVmObject;
+	using Rocinante::Memory::BootMemoryMap;
+	using Rocinante::Memory::BootMemoryRegion;
+	using Rocinante::Memory::GetPhysicalMemoryManager;
+	using Rocinante::Memory::PhysicalMemoryManager;
+	using Rocinante::Memory::VirtualMemoryArea;
+	using Rocinante::Memory::Paging::AccessPermissions;
+	using Rocinante::Memory::Paging::AllocateRootPageTable;
+	using Rocinante::Memory::Paging::CacheMode;
+	using Rocinante::Memory::Paging::ExecutePermissions;
+	using Rocinante::Memory::Paging::MapPage4KiB;
+	using Rocinante::Memory::Paging::PagePermissions;
+	using Rocinante::Memory::Paging::Translate;
+	using Rocinante::Memory::VmmPopulate::PopulateRange4KiB;
+	using Rocinante::Memory::VmmPopulate::PopulateVma4KiB;
+	using Rocinante::Memory::VmmUnmap::UnmapVma4KiB;
+
+	// This test exercises the software page table builder/walker.
+	// It does not enable paging in hardware.
+
+	static constexpr std::uintptr_t kUsableBase = 0x00100000;
+	static constexpr std::size_t kUsableSizeBytes = 256 * PhysicalMemoryManager::kPageSizeBytes;
+	static constexpr std::uintptr_t kKernelBase = 0x00400000;
+	static constexpr std::uintptr_t kKernelEnd = 0x00401000;
+	static constexpr std::uintptr_t kDeviceTreeBase = 0x00500000;
+	static constexpr std::size_t kDeviceTreeSizeBytes = PhysicalMemoryManager::kPageSizeBytes;
+
+	BootMemoryMap map;
+	map.Clear();
+	ROCINANTE_EXPECT_TRUE(ctx, map.AddRegion(BootMemoryRegion{.physical_base = kUsableBase, .size_bytes = kUsableSizeBytes, .type = BootMemoryRegion::Type::UsableRAM}));
+
+	auto& pmm = GetPhysicalMemoryManager();
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.InitializeFromBootMemoryMap(map, kKernelBase, kKernelEnd, kDeviceTreeBase, kDeviceTreeSizeBytes));
+
+	const auto root_or = AllocateRootPageTable(&pmm);
+	ROCINANTE_EXPECT_TRUE(ctx, root_or.has_value());
+	if (!root_or.has_value()) return;
+	const auto root = root_or.value();
+
+	static constexpr PagePermissions kPermissions{
+		.access = AccessPermissions::ReadWrite,
+		.execute = ExecutePermissions::NoExecute,
+		.cache = CacheMode::CoherentCached,
+		.global = true,
+	};
+
+	// 40 pages straddling a leaf-table boundary (8 below 4 MiB, 32 above).
+	static constexpr std::uintptr_t kVmaBase = 0x003f8000;
+	static constexpr std::size_t kVmaPages = 40;
+	static constexpr std::size_t kResidentPage = 3;
+	static constexpr std::size_t kMappedPage = 5;
+
+	AnonymousVmObject object;
+	VirtualMemoryArea vma;
+	vma.virtual_base = kVmaBase;
+	vma.virtual_limit = kVmaBase + (kVmaPages * PhysicalMemoryManager::kPageSizeBytes);
+	vma.permissions = kPermissions;
+	vma.backing_type = VirtualMemoryArea::BackingType::Anonymous;
+	vma.anonymous_object = &object;
+	vma.owns_frames = true;
+
+	const std::size_t free_before = pmm.FreePages();
+
+	// One page resident but unmapped, one already mapped.
+	const auto resident_or = object.GetOrCreateFrameForPageOffset(&pmm, kResidentPage);
+	const auto mapped_or = object.GetOrCreateFrameForPageOffset(&pmm, kMappedPage);
+	ROCINANTE_EXPECT_TRUE(ctx, resident_or.has_value() && mapped_or.has_value());
+	if (!resident_or.has_value() || !mapped_or.has_value()) return;
+	ROCINANTE_EXPECT_TRUE(ctx, MapPage4KiB(&pmm, root, kVmaBase + (kMappedPage * PhysicalMemoryManager::kPageSizeBytes), mapped_or.value().physical_page_base, kPermissions));
+
+	// Bad arguments: outside the VMA, misaligned, empty.
+	ROCINANTE_EXPECT_TRUE(ctx, !PopulateRange4KiB(&pmm, root, vma, vma.virtual_limit, PhysicalMemoryManager::kPageSizeBytes).has_value());
+	ROCINANTE_EXPECT_TRUE(ctx, !PopulateRange4KiB(&pmm, root, vma, kVmaBase + 1, PhysicalMemoryManager::kPageSizeBytes).has_value());
+	ROCINANTE_EXPECT_TRUE(ctx, !PopulateRange4KiB(&pmm, root, vma, kVmaBase, 0).has_value());
+
+	const auto result_or = PopulateVma4KiB(&pmm, root, vma);
+	ROCINANTE_EXPECT_TRUE(ctx, result_or.has_value());
+	if (!result_or.has_value()) return;
+	const auto result = result_or.value();
+	ROCINANTE_EXPECT_TRUE(ctx, result.complete);
+	ROCINANTE_EXPECT_EQ_U64(ctx, result.pages_requested, kVmaPages);
+	ROCINANTE_EXPECT_EQ_U64(ctx, result.pages_populated, kVmaPages - 2);
+	ROCINANTE_EXPECT_EQ_U64(ctx, result.pages_mapped_resident, 1);
+	ROCINANTE_EXPECT_EQ_U64(ctx, result.pages_already_mapped, 1);
+	ROCINANTE_EXPECT_EQ_U64(ctx, object.PageCount(), kVmaPages);
+
+	// Every page is mapped to the frame the object owns, once.
+	for (std::size_t i = 0; i < kVmaPages; i++) {
+		const auto physical_or = Translate(root, kVmaBase + (i * PhysicalMemoryManager::kPageSizeBytes));
+		const auto frame_or = object.FindFrameForPageOffset(i);
+		ROCINANTE_EXPECT_TRUE(ctx, physical_or.has_value() && frame_or.has_value());
+		if (!physical_or.has_value() || !frame_or.has_value()) continue;
+		ROCINANTE_EXPECT_EQ_U64(ctx, physical_or.value(), frame_or.value());
+		const auto map_count = pmm.MapCountForPhysical(frame_or.value());
+		ROCINANTE_EXPECT_TRUE(ctx, map_count.has_value() && map_count.value() == 1);
+	}
+
+	// Populating again changes nothing.
+	const auto again_or = PopulateVma4KiB(&pmm, root, vma);
+	ROCINANTE_EXPECT_TRUE(ctx, again_or.has_value() && again_or.value().complete);
+	if (again_or.has_value()) {
+		ROCINANTE_EXPECT_EQ_U64(ctx, again_or.value().pages_already_mapped, kVmaPages);
+		ROCINANTE_EXPECT_EQ_U64(ctx, again_or.value().pages_populated, 0);
+	}
+
+	// A VMA larger than free memory: partial success, and what was populated
+	// stays mapped and owned.
+	static constexpr std::uintptr_t kLargeVmaBase = 0x01000000;
+	static constexpr std::size_t kLargeVmaPages = 512;
+	AnonymousVmObject large_object;
+	VirtualMemoryArea large_vma;
+	large_vma.virtual_base = kLargeVmaBase;
+	large_vma.virtual_limit = kLargeVmaBase + (kLargeVmaPages * PhysicalMemoryManager::kPageSizeBytes);
+	large_vma.permissions = kPermissions;
+	large_vma.backing_type = VirtualMemoryArea::BackingType::Anonymous;
+	large_vma.anonymous_object = &large_object;
+	large_vma.owns_frames = true;
+
+	const auto partial_or = PopulateVma4KiB(&pmm, root, large_vma);
+	ROCINANTE_EXPECT_TRUE(ctx, partial_or.has_value());
+	if (partial_or.has_value()) {
+		const auto partial = partial_or.value();
+		ROCINANTE_EXPECT_TRUE(ctx, !partial.complete);
+		ROCINANTE_EXPECT_TRUE(ctx, partial.pages_populated != 0);
+		ROCINANTE_EXPECT_TRUE(ctx, partial.pages_populated < kLargeVmaPages);
+		ROCINANTE_EXPECT_TRUE(ctx, large_object.PageCount() >= partial.pages_populated);
+		ROCINANTE_EXPECT_TRUE(ctx, Translate(root, kLargeVmaBase).has_value());
+	}
+
+	// Unmapping both VMAs gives every frame, object directory page and page
+	// table back.
+	ROCINANTE_EXPECT_TRUE(ctx, UnmapVma4KiB(&pmm, root, large_vma));
+	ROCINANTE_EXPECT_TRUE(ctx, UnmapVma4KiB(&pmm, root, vma));
+	ROCINANTE_EXPECT_TRUE(ctx, object.IsEmpty());
+	ROCINANTE_EXPECT_TRUE(ctx, large_object.IsEmpty());
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), free_before);
+}
+
+static void Test_VMM_PopulateRange4KiB_ZeroPageMappingsStillReadZero(TestContext* ctx) {
+	using Rocinante::Memory::AnonymousVmObject;
+	using Rocinante::Memory::BootMemoryMap;
+	using Rocinante::Memory::BootMemoryRegion;
+	using Rocinante::Memory::GetPhysicalMemoryManager;
+	using Rocinante::Memory::PhysicalMemoryManager;
+	using Rocinante::Memory::VirtualMemoryArea;
+	using Rocinante::Memory::Paging::AccessPermissions;
+	using Rocinante::Memory::Paging::AllocateRootPageTable;
+	using Rocinante::Memory::Paging::CacheMode;
+	using Rocinante::Memory::Paging::ExecutePermissions;
+	using Rocinante::Memory::Paging::MapPage4KiB;
+	using Rocinante::Memory::Paging::PagePermissions;
+	using Rocinante::Memory::Paging::Translate;
+	using Rocinante::Memory::Paging::WithoutWriteAccess;
+	using Rocinante::Memory::VmmPopulate::PopulateRange4KiB;
+	using Rocinante::Memory::VmmUnmap::UnmapVma4KiB;
+
+	// Software walker only, in direct-address mode (frames are read through
+	// their physical addresses).
+
+	static constexpr std::uintptr_t kUsableBase = 0x00100000;
+	static constexpr std::size_t kUsableSizeBytes = 256 * PhysicalMemoryManager::kPageSizeBytes;
+	static constexpr std::uintptr_t kKernelBase = 0x00400000;
+	static constexpr std::uintptr_t kKernelEnd = 0x00401000;
+	static constexpr std::uintptr_t kDeviceTreeBase = 0x00500000;
+	static constexpr std::size_t kDeviceTreeSizeBytes = PhysicalMemoryManager::kPageSizeBytes;
+	static constexpr std::size_t kWordsPerPage = PhysicalMemoryManager::kPageSizeBytes / sizeof(std::uint64_t);
+
+	BootMemoryMap map;
+	map.Clear();
+	ROCINANTE_EXPECT_TRUE(ctx, map.AddRegion(BootMemoryRegion{.physical_base = kUsableBase, .size_bytes = kUsableSizeBytes, .type = BootMemoryRegion::Type::UsableRAM}));
+
+	auto& pmm = GetPhysicalMemoryManager();
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.InitializeFromBootMemoryMap(map, kKernelBase, kKernelEnd, kDeviceTreeBase, kDeviceTreeSizeBytes));
+
+	const auto root_or = AllocateRootPageTable(&pmm);
+	ROCINANTE_EXPECT_TRUE(ctx, root_or.has_value());
+	if (!root_or.has_value()) return;
+	const auto root = root_or.value();
+
+	// Leave stale data in every free frame, so a frame that is not cleared
+	// before use shows through.
+	{
+		std::uintptr_t frames[256] = {};
+		std::size_t frame_count = 0;
+		while (frame_count < 256) {
+			const auto frame_or = pmm.AllocatePage();
+			if (!frame_or.has_value()) break;
+			frames[frame_count++] = frame_or.value();
+		}
+		for (std::size_t i = 0; i < frame_count; i++) {
+			auto* words = reinterpret_cast<volatile std::uint64_t*>(frames[i]);
+			for (std::size_t w = 0; w < kWordsPerPage; w++) words[w] = 0xa5a5a5a5a5a5a5a5ull;
+			(void)pmm.FreePage(frames[i]);
+		}
+	}
+
+	const std::size_t free_before = pmm.FreePages();
+	ROCINANTE_EXPECT_TRUE(ctx, Rocinante::Memory::VmmPager::EnableSharedZeroPage(&pmm));
+	const auto zero_page_or = Rocinante::Memory::VmmPager::SharedZeroPage();
+	ROCINANTE_EXPECT_TRUE(ctx, zero_page_or.has_value());
+	if (!zero_page_or.has_value()) return;
+
+	static constexpr PagePermissions kPermissions{
+		.access = AccessPermissions::ReadWrite,
+		.execute = ExecutePermissions::NoExecute,
+		.cache = CacheMode::CoherentCached,
+		.global = true,
+	};
+
+	static constexpr std::uintptr_t kVmaBase = 0x00800000;
+	static constexpr std::size_t kVmaPages = 8;
+
+	AnonymousVmObject object;
+	VirtualMemoryArea vma;
+	vma.virtual_base = kVmaBase;
+	vma.virtual_limit = kVmaBase + (kVmaPages * PhysicalMemoryManager::kPageSizeBytes);
+	vma.permissions = kPermissions;
+	vma.backing_type = VirtualMemoryArea::BackingType::Anonymous;
+	vma.anonymous_object = &object;
+	vma.owns_frames = true;
+
+	// Every page has been loaded from (what the pager does with the shared
+	// zero page enabled) but never stored to.
+	for (std::size_t i = 0; i < kVmaPages; i++) {
+		ROCINANTE_EXPECT_TRUE(ctx, MapPage4KiB(
+			&pmm, root, kVmaBase + (i * PhysicalMemoryManager::kPageSizeBytes), zero_page_or.value(), WithoutWriteAccess(kPermissions)));
+	}
+
+	const auto result_or = PopulateRange4KiB(&pmm, root, vma, kVmaBase, kVmaPages * PhysicalMemoryManager::kPageSizeBytes);
+	ROCINANTE_EXPECT_TRUE(ctx, result_or.has_value());
+	if (result_or.has_value()) {
+		ROCINANTE_EXPECT_TRUE(ctx, result_or.value().complete);
+		ROCINANTE_EXPECT_EQ_U64(ctx, result_or.value().pages_populated, kVmaPages);
+	}
+
+	// Each page now has its own frame, and still reads as zeros.
+	for (std::size_t i = 0; i < kVmaPages; i++) {
+		const auto physical_or = Translate(root, kVmaBase + (i * PhysicalMemoryManager::kPageSizeBytes));
+		ROCINANTE_EXPECT_TRUE(ctx, physical_or.has_value());
+		if (!physical_or.has_value()) continue;
+		ROCINANTE_EXPECT_TRUE(ctx, physical_or.value() != zero_page_or.value());
+
+		const auto* words = reinterpret_cast<const volatile std::uint64_t*>(physical_or.value());
+		std::size_t nonzero_words = 0;
+		for (std::size_t w = 0; w < kWordsPerPage; w++) {
+			if (words[w] != 0) nonzero_words++;
+		}
+		ROCINANTE_EXPECT_EQ_U64(ctx, nonzero_words, 0);
+	}
+
+	const auto zero_map_count = pmm.MapCountForPhysical(zero_page_or.value());
+	ROCINANTE_EXPECT_TRUE(ctx, zero_map_count.has_value() && zero_map_count.value() == 0);
+
+	ROCINANTE_EXPECT_TRUE(ctx, UnmapVma4KiB(&pmm, root, vma));
+	ROCINANTE_EXPECT_TRUE(ctx, object.IsEmpty());
+	ROCINANTE_EXPECT_TRUE(ctx, Rocinante::Memory::VmmPager::DisableSharedZeroPage(&pmm));
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), free_before);
+}
+
+static void Test_VMM_CloneVma4KiB_SharesFramesCopyOnWrite(TestContext* ctx) {
+	using Rocinante::Memory::AnonymousVmObject;
+	using Rocinante::Memory::BootMemoryMap;
+	using Rocinante::Memory::BootMemoryRegion;
+	using Rocinante::Memory::GetPhysicalMemoryManager;
+	using Rocinante::Memory::PhysicalMemoryManager;
+	using Rocinante::Memory::VirtualMemoryArea;
+	using Rocinante::Memory::Paging::AccessPermissions;
+	using Rocinante::Memory::Paging::AllocateRootPageTable;
+	using Rocinante::Memory::Paging::CacheMode;
+	using Rocinante::Memory::Paging::ExecutePermissions;
+	using Rocinante::Memory::Paging::PagePermissions;
+	using Rocinante::Memory::Paging::Translate;
+	using Rocinante::Memory::VmmClone::CloneVma4KiB;
+	using Rocinante::Memory::VmmPopulate::PopulateVma4KiB;
+	using Rocinante::Memory::VmmUnmap::UnmapVma4KiB;
+
+	// This test exercises the software page table builder/walker.
+	// It does not enable paging in hardware.
+
+	static constexpr std::uintptr_t kUsableBase = 0x00100000;
+	static constexpr std::size_t kUsableSizeBytes = 256 * PhysicalMemoryManager::kPageSizeBytes;
+	static constexpr std::uintptr_t kKernelBase = 0x00400000;
+	static constexpr std::uintptr_t kKernelEnd = 0x00401000;
+	static constexpr std::uintptr_t kDeviceTreeBase = 0x00500000;
+	static constexpr std::size_t kDeviceTreeSizeBytes = PhysicalMemoryManager::kPageSizeBytes;
+
+	BootMemoryMap map;
+	map.Clear();
+	ROCINANTE_EXPECT_TRUE(ctx, map.AddRegion(BootMemoryRegion{.physical_base = kUsableBase, .size_bytes = kUsableSizeBytes, .type = BootMemoryRegion::Type::UsableRAM}));
+
+	auto& pmm = GetPhysicalMemoryManager();
+	ROCINANTE_EXPECT_TRUE(ctx, pmm.InitializeFromBootMemoryMap(map, kKernelBase, kKernelEnd, kDeviceTreeBase, kDeviceTreeSizeBytes));
+
+	const auto source_root_or = AllocateRootPageTable(&pmm);
+	const auto clone_root_or = AllocateRootPageTable(&pmm);
+	ROCINANTE_EXPECT_TRUE(ctx, source_root_or.has_value() && clone_root_or.has_value());
+	if (!source_root_or.has_value() || !clone_root_or.has_value()) return;
+	const auto source_root = source_root_or.value();
+	const auto clone_root = clone_root_or.value();
+
+	static constexpr PagePermissions kPermissions{
+		.access = AccessPermissions::ReadWrite,
+		.execute = ExecutePermissions::NoExecute,
+		.cache = CacheMode::CoherentCached,
+		.global = false,
+	};
+
+	static constexpr std::uintptr_t kVmaBase = 0x00200000;
+	static constexpr std::size_t kVmaPages = 32;
+	static constexpr std::size_t kCopiedPage = 3;
+
+	AnonymousVmObject source_object;
+	VirtualMemoryArea source_vma;
+	source_vma.virtual_base = kVmaBase;
+	source_vma.virtual_limit = kVmaBase + (kVmaPages * PhysicalMemoryManager::kPageSizeBytes);
+	source_vma.permissions = kPermissions;
+	source_vma.backing_type = VirtualMemoryArea::BackingType::Anonymous;
+	source_vma.anonymous_object = &source_object;
+	source_vma.owns_frames = true;
+
+	AnonymousVmObject clone_object;
+	VirtualMemoryArea clone_vma = source_vma;
+	clone_vma.anonymous_object = &clone_object;
+
+	const std::size_t free_before = pmm.FreePages();
+
+	const auto populated_or = PopulateVma4KiB(&pmm, source_root, source_vma);
+	ROCINANTE_EXPECT_TRUE(ctx, populated_or.has_value() && populated_or.value().complete);
+	for (std::size_t i = 0; i < kVmaPages; i++) {
+		const auto frame_or = source_object.FindFrameForPageOffset(i);
+		ROCINANTE_EXPECT_TRUE(ctx, frame_or.has_value());
+		if (!frame_or.has_value()) return;
+		*reinterpret_cast<volatile std::uint64_t*>(frame_or.value()) = 0xc0e0000000000000ull + i;
+	}
+
+	// Overlapping ranges in one page table are rejected.
+	ROCINANTE_EXPECT_TRUE(ctx, !CloneVma4KiB(&pmm, source_root, source_vma, source_root, clone_vma));
+	ROCINANTE_EXPECT_TRUE(ctx, clone_object.IsEmpty());
+
+	// The clone costs directory and page-table pages, no frames.
+	const std::size_t free_before_clone = pmm.FreePages();
+	ROCINANTE_EXPECT_TRUE(ctx, CloneVma4KiB(&pmm, source_root, source_vma, clone_root, clone_vma));
+	ROCINANTE_EXPECT_TRUE(ctx, free_before_clone - pmm.FreePages() < kVmaPages);
+	ROCINANTE_EXPECT_EQ_U64(ctx, clone_object.PageCount(), kVmaPages);
+
+	for (std::size_t i = 0; i < kVmaPages; i++) {
+		const std::uintptr_t va = kVmaBase + (i * PhysicalMemoryManager::kPageSizeBytes);
+		const auto frame_or = source_object.FindFrameForPageOffset(i);
+		const auto source_physical = Translate(source_root, va);
+		const auto clone_physical = Translate(clone_root, va);
+		ROCINANTE_EXPECT_TRUE(ctx, frame_or.has_value() && source_physical.has_value() && clone_physical.has_value());
+		if (!frame_or.has_value() || !source_physical.has_value() || !clone_physical.has_value()) return;
+		ROCINANTE_EXPECT_EQ_U64(ctx, source_physical.value(), frame_or.value());
+		ROCINANTE_EXPECT_EQ_U64(ctx, clone_physical.value(), frame_or.value());
+		ROCINANTE_EXPECT_TRUE(ctx, AnonymousVmObject::IsFrameShared(&pmm, frame_or.value()));
+		const auto map_count = pmm.MapCountForPhysical(frame_or.value());
+		ROCINANTE_EXPECT_TRUE(ctx, map_count.has_value() && map_count.value() == 2);
+	}
+
+	// Breaking copy-on-write copies the data into a private frame, after which
+	// the other side is the frame's only owner and keeps it.
+	const auto shared_or = source_object.FindFrameForPageOffset(kCopiedPage);
+	const auto copied_or = clone_object.BreakCopyOnWriteForPageOffset(&pmm, kCopiedPage);
+	ROCINANTE_EXPECT_TRUE(ctx, shared_or.has_value() && copied_or.has_value());
+	if (!shared_or.has_value() || !copied_or.has_value()) return;
+	ROCINANTE_EXPECT_TRUE(ctx, copied_or.value() != shared_or.value());
+	ROCINANTE_EXPECT_EQ_U64(ctx, *reinterpret_cast<volatile std::uint64_t*>(copied_or.value()), 0xc0e0000000000000ull + kCopiedPage);
+	ROCINANTE_EXPECT_TRUE(ctx, !AnonymousVmObject::IsFrameShared(&pmm, shared_or.value()));
+	const auto kept_or = source_object.BreakCopyOnWriteForPageOffset(&pmm, kCopiedPage);
+	ROCINANTE_EXPECT_TRUE(ctx, kept_or.has_value() && kept_or.value() == shared_or.value());
+
+	// Tearing down both sides (the clone first) gives everything back.
+	ROCINANTE_EXPECT_TRUE(ctx, UnmapVma4KiB(&pmm, clone_root, clone_vma));
+	ROCINANTE_EXPECT_TRUE(ctx, clone_object.IsEmpty());
+	ROCINANTE_EXPECT_TRUE(ctx, !AnonymousVmObject::IsFrameShared(&pmm, shared_or.value()));
+	ROCINANTE_EXPECT_TRUE(ctx, UnmapVma4KiB(&pmm, source_root, source_vma));
+	ROCINANTE_EXPECT_TRUE(ctx, source_object.IsEmpty());
+	ROCINANTE_EXPECT_EQ_U64(ctx, pmm.FreePages(), free_before);
+}
+
 } // namespace
 
 void TestEntry_VMM_VMA_InsertLookup(TestContext* ctx) {
@@ -381,4 +765,16 @@ void TestEntry_VMM_UnmapVma4KiB_ReleasesAnonymousFrames(TestContext* ctx) {
 	Test_VMM_UnmapVma4KiB_ReleasesAnonymousFrames(ctx);
 }
 
+void TestEntry_VMM_PopulateVma4KiB_MapsEveryPageAndReportsPartial(TestContext* ctx) {
+	Test_VMM_PopulateVma4KiB_MapsEveryPageAndReportsPartial(ctx);
+}
+
+void TestEntry_VMM_PopulateRange4KiB_ZeroPageMappingsStillReadZero(TestContext* ctx) {
+	Test_VMM_PopulateRange4KiB_ZeroPageMappingsStillReadZero(ctx);
+}
+
+void TestEntry_VMM_CloneVma4KiB_SharesFramesCopyOnWrite(TestContext* ctx) {
+	Test_VMM_CloneVma4KiB_SharesFramesCopyOnWrite(ctx);
+}
+
 } // namespace Rocinante::Testing
@@ -5,6 +5,10 @@
 
 #include <src/trap/trap.h>
 
+#include <src/sp/cpucfg.h>
+#include <src/sp/cpuid.h>
+#include <src/sp/stable_counter.h>
+
 #include <cstdint>
 
 namespace {
@@ -87,9 +91,44 @@ inline void ClearPendingTimerInterruptInCsr() {
 
 extern "C" void __exception_entry();
 extern "C" void __tlb_refill_entry();
+extern "C" void __tlb_refill_lddir_entry_1();
+extern "C" void __tlb_refill_lddir_entry_2();
+extern "C" void __tlb_refill_lddir_entry_3();
+extern "C" void __tlb_refill_lddir_entry_4();
+
+// Spec behavior (LoongArch-Vol1-EN.html):
+// - CSR.EENTRY[11:0] is read-only constant 0 (writes ignored)
+// - CSR.TLBRENTRY[11:0] is read-only constant 0 (writes ignored)
+//
+// Masking here ensures we write the *effective* entry base address the CPU
+// will use, even if the symbol address were ever to become misaligned.
+constexpr std::uint64_t k4KiBPageOffsetMask = 0xfffull;
+constexpr std::uint64_t k4KiBPageBaseMask = ~k4KiBPageOffsetMask;
+
+Rocinante::Trap::TlbRefillHandler g_installed_tlb_refill_handler = Rocinante::Trap::TlbRefillHandler::SoftwareWalk;
 
 Rocinante::Trap::PagingFaultObserver g_paging_fault_observer = nullptr;
 
+// Paging-fault counters, one per-CPU slot each (see Rocinante::kMaxCpuCount).
+struct alignas(Rocinante::kCacheLineBytes) CpuPagingFaultCounters final {
+	std::uint64_t faults_by_exception_code[Rocinante::Trap::PagingStatistics::kExceptionCodeCount];
+	std::uint64_t handled;
+	std::uint64_t not_handled;
+	std::uint64_t handler_ticks;
+};
+
+CpuPagingFaultCounters g_paging_fault_counters[Rocinante::kMaxCpuCount];
+
+// Refill counts live in trap.S's .bss: the refill entries run with direct
+// addressing and reach them PC-relative. Each CPU's count is the first word
+// of its own 64-byte line (TLB_REFILL_COUNT_STRIDE_SHIFT).
+extern "C" std::uint64_t __tlb_refill_counts[];
+constexpr std::size_t kTlbRefillCountStrideWords = 64 / sizeof(std::uint64_t);
+
+volatile std::uint64_t* TlbRefillCount(std::size_t core_id) {
+	return &__tlb_refill_counts[core_id * kTlbRefillCountStrideWords];
+}
+
 } // namespace
 
 namespace Rocinante::Trap {
@@ -99,8 +138,61 @@ void SetPagingFaultObserver(PagingFaultObserver observer) {
 }
 
 PagingFaultResult DispatchPagingFault(TrapFrame* tf, const PagingFaultEvent& event) {
-	if (g_paging_fault_observer == nullptr) return PagingFaultResult::NotHandled;
-	return g_paging_fault_observer(tf, event);
+	const std::uint64_t start_ticks = Rocinante::ReadStableCounterTicks();
+	const PagingFaultResult result =
+		(g_paging_fault_observer == nullptr) ? PagingFaultResult::NotHandled : g_paging_fault_observer(tf, event);
+
+	const std::size_t core_id = Rocinante::ReadCurrentProcessorCoreId();
+	if (core_id < Rocinante::kMaxCpuCount) {
+		CpuPagingFaultCounters& counters = g_paging_fault_counters[core_id];
+		if (event.exception_code < PagingStatistics::kExceptionCodeCount) {
+			counters.faults_by_exception_code[event.exception_code]++;
+		}
+		if (result == PagingFaultResult::Handled) {
+			counters.handled++;
+		} else {
+			counters.not_handled++;
+		}
+		counters.handler_ticks += Rocinante::ReadStableCounterTicks() - start_ticks;
+	}
+	return result;
+}
+
+PagingStatistics PagingStatisticsForCpu(std::size_t core_id) {
+	if (core_id >= Rocinante::kMaxCpuCount) return PagingStatistics{};
+
+	const CpuPagingFaultCounters& counters = g_paging_fault_counters[core_id];
+	PagingStatistics statistics{};
+	statistics.tlb_refills = *TlbRefillCount(core_id);
+	for (std::size_t code = 0; code < PagingStatistics::kExceptionCodeCount; code++) {
+		statistics.faults_by_exception_code[code] = counters.faults_by_exception_code[code];
+	}
+	statistics.handled = counters.handled;
+	statistics.not_handled = counters.not_handled;
+	statistics.handler_ticks = counters.handler_ticks;
+	return statistics;
+}
+
+PagingStatistics PagingStatisticsTotal() {
+	PagingStatistics total{};
+	for (std::size_t core_id = 0; core_id < Rocinante::kMaxCpuCount; core_id++) {
+		const PagingStatistics cpu = PagingStatisticsForCpu(core_id);
+		total.tlb_refills += cpu.tlb_refills;
+		for (std::size_t code = 0; code < PagingStatistics::kExceptionCodeCount; code++) {
+			total.faults_by_exception_code[code] += cpu.faults_by_exception_code[code];
+		}
+		total.handled += cpu.handled;
+		total.not_handled += cpu.not_handled;
+		total.handler_ticks += cpu.handler_ticks;
+	}
+	return total;
+}
+
+void ResetPagingStatistics() {
+	for (std::size_t core_id = 0; core_id < Rocinante::kMaxCpuCount; core_id++) {
+		g_paging_fault_counters[core_id] = CpuPagingFaultCounters{};
+		*TlbRefillCount(core_id) = 0;
+	}
 }
 
 void Initialize() {
@@ -112,22 +204,45 @@ void Initialize() {
 	// We also start with all interrupt lines masked.
 	WriteExceptionConfiguration(0);
 
-	// Spec behavior (LoongArch-Vol1-EN.html):
-	// - CSR.EENTRY[11:0] is read-only constant 0 (writes ignored)
-	// - CSR.TLBRENTRY[11:0] is read-only constant 0 (writes ignored)
-	//
-	// Masking here ensures we write the *effective* entry base address the CPU
-	// will use, even if the symbol address were ever to become misaligned.
-	constexpr std::uint64_t k4KiBPageOffsetMask = 0xfffull;
-	constexpr std::uint64_t k4KiBPageBaseMask = ~k4KiBPageOffsetMask;
 	const auto entry = reinterpret_cast<std::uint64_t>(&__exception_entry) & k4KiBPageBaseMask;
 	WriteExceptionEntryAddress(entry);
 
 	// The TLB refill exception has a distinct entry point and distinct CSRs.
 	// Install a dedicated refill stub that performs software-led TLB refill.
+	InstallSoftwareWalkTlbRefillHandler();
+	WriteMachineErrorEntryAddress(entry);
+}
+
+bool InstallLddirTlbRefillHandler(std::uint8_t directory_level_count) {
+#if defined(ROCINANTE_TLBREFILL_UART_BREADCRUMBS)
+	(void)directory_level_count;
+	return false;
+#else
+	if (!Rocinante::GetCPUCFG().SupportsSoftwarePageTableWalkInstruction()) return false;
+
+	void (*entry_function)() = nullptr;
+	switch (directory_level_count) {
+		case 1: entry_function = &__tlb_refill_lddir_entry_1; break;
+		case 2: entry_function = &__tlb_refill_lddir_entry_2; break;
+		case 3: entry_function = &__tlb_refill_lddir_entry_3; break;
+		case 4: entry_function = &__tlb_refill_lddir_entry_4; break;
+		default: return false;
+	}
+
+	WriteTlbRefillEntryAddress(reinterpret_cast<std::uint64_t>(entry_function) & k4KiBPageBaseMask);
+	g_installed_tlb_refill_handler = TlbRefillHandler::Lddir;
+	return true;
+#endif
+}
+
+void InstallSoftwareWalkTlbRefillHandler() {
 	const auto tlb_refill_entry = reinterpret_cast<std::uint64_t>(&__tlb_refill_entry) & k4KiBPageBaseMask;
 	WriteTlbRefillEntryAddress(tlb_refill_entry);
-	WriteMachineErrorEntryAddress(entry);
+	g_installed_tlb_refill_handler = TlbRefillHandler::SoftwareWalk;
+}
+
+TlbRefillHandler InstalledTlbRefillHandler() {
+	return g_installed_tlb_refill_handler;
 }
 
 void SetGeneralAndMachineErrorExceptionEntryPageBase(std::uint64_t entry_page_base) {
@@ -136,8 +251,6 @@ void SetGeneralAndMachineErrorExceptionEntryPageBase(std::uint64_t entry_page_ba
 	// - CSR.MERRENTRY[11:0] is read-only constant 0 (writes ignored)
 	//
 	// Masking here ensures we write the effective page base the CPU will use.
-	constexpr std::uint64_t k4KiBPageOffsetMask = 0xfffull;
-	constexpr std::uint64_t k4KiBPageBaseMask = ~k4KiBPageOffsetMask;
 	const std::uint64_t entry = entry_page_base & k4KiBPageBaseMask;
 	WriteExceptionEntryAddress(entry);
 	WriteMachineErrorEntryAddress(entry);
@@ -8,6 +8,8 @@
 #include <cstddef>
 #include <cstdint>
 
+#include <src/sp/per_cpu.h>
+
 namespace Rocinante {
 
 /**
@@ -59,6 +61,7 @@ namespace Trap {
  *   - PIL: page invalid for load
  *   - PIS: page invalid for store
  *   - PIF: page invalid for fetch
+ *   - PME: page modification exception (reported as Store)
  */
 enum class PagingAccessType : std::uint8_t {
 	Unknown = 0,
@@ -136,6 +139,39 @@ void SetPagingFaultObserver(PagingFaultObserver observer);
 // and retry the faulting instruction after the observer has repaired state.
 PagingFaultResult DispatchPagingFault(TrapFrame* tf, const PagingFaultEvent& event);
 
+/**
+ * @brief TLB refill and paging-fault counters for one CPU.
+ *
+ * - tlb_refills: TLB refill exceptions taken, counted by both refill entries
+ *   in trap.S (software walk and LDDIR/LDPTE).
+ * - faults_by_exception_code[c]: paging exceptions with ESTAT.Ecode c,
+ *   0x1 (PIL) through 0x7 (PPI). Slot 0 is unused.
+ * - handled / not_handled: what DispatchPagingFault() returned. A fault with
+ *   no observer installed counts as not handled.
+ * - handler_ticks: Stable Counter ticks spent in DispatchPagingFault().
+ *
+ * Each CPU only writes its own counters, and without atomics: reads of
+ * another CPU's counters (and the reset) are exact when it is quiescent.
+ */
+struct PagingStatistics final {
+	static constexpr std::size_t kExceptionCodeCount = 8;
+
+	std::uint64_t tlb_refills = 0;
+	std::uint64_t faults_by_exception_code[kExceptionCodeCount] = {};
+	std::uint64_t handled = 0;
+	std::uint64_t not_handled = 0;
+	std::uint64_t handler_ticks = 0;
+};
+
+// CPUs with a core ID of Rocinante::kMaxCpuCount or above are not counted;
+// their statistics read as zero.
+PagingStatistics PagingStatisticsForCpu(std::size_t core_id);
+
+// Sum over all CPUs.
+PagingStatistics PagingStatisticsTotal();
+
+void ResetPagingStatistics();
+
 /**
  * @brief Installs exception/interrupt entry points into the relevant CSRs.
  *
@@ -165,6 +201,44 @@ void Initialize();
  */
 void SetGeneralAndMachineErrorExceptionEntryPageBase(std::uint64_t entry_page_base);
 
+/**
+ * @brief TLB refill handlers that can be installed in CSR.TLBRENTRY.
+ *
+ * - SoftwareWalk: walks the tables with ld.d on a private refill stack.
+ *   Works on any implementation and supports the UART breadcrumbs build.
+ * - Lddir: walks the tables with LDDIR/LDPTE and touches no stack.
+ */
+enum class TlbRefillHandler : std::uint8_t {
+	SoftwareWalk = 0,
+	Lddir,
+};
+
+/**
+ * @brief Points CSR.TLBRENTRY at the LDDIR/LDPTE refill entry for a table shape.
+ *
+ * directory_level_count is the number of directory levels PWCL/PWCH enable
+ * (1..4; see PagingHw::DirectoryLevelCount()).
+ *
+ * Returns false, leaving the installed handler unchanged, if:
+ * - CPUCFG does not report LDDIR/LDPTE support (CPUCFG.2.LSPW),
+ * - directory_level_count is out of range, or
+ * - the kernel was built with ROCINANTE_TLBREFILL_UART_BREADCRUMBS (the
+ *   breadcrumbs live in the software walk).
+ *
+ * CSR.TLBRENTRY is used with direct addressing: call this while running from
+ * the kernel's physical (identity) alias, as Initialize() is.
+ */
+bool InstallLddirTlbRefillHandler(std::uint8_t directory_level_count);
+
+/**
+ * @brief Points CSR.TLBRENTRY back at the software-walk refill entry.
+ *
+ * Initialize() installs this one. The same addressing note applies.
+ */
+void InstallSoftwareWalkTlbRefillHandler();
+
+TlbRefillHandler InstalledTlbRefillHandler();
+
 // Global interrupt enable in CSR.CRMD.
 void EnableInterrupts();
 void DisableInterrupts();